@@ -30,6 +30,14 @@ $(TEST_OUTPUT)_SRC := \
 	tests/test_common/test_logger.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 
+ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
+    $(TEST_OUTPUT)_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/split_simulator.c
+endif
+
+ifeq ($(strip $(ANALOG_MATRIX_ENABLE)), yes)
+    $(TEST_OUTPUT)_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/analog_matrix_mock.c
+endif
+
 $(TEST_OUTPUT)_DEFS := $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
 
 $(TEST_OUTPUT)_CONFIG := $(TEST_PATH)/config.h
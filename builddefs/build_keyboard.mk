@@ -568,6 +568,26 @@ $(eval $(call add_qmk_prefix_defs,MCU_SERIES,MCU_SERIES))
 $(eval $(call add_qmk_prefix_defs,BOARD,BOARD))
 $(eval $(call add_qmk_prefix_defs,OPT,OPT))
 
+# Pack the keymaps array, taken from a standalone compile of the keymap so that it comes out the same for keymap.c and keymap.json
+ifeq ($(strip $(KEYMAP_PACKED_ENABLE)), yes)
+$(INTERMEDIATE_OUTPUT)/keymap_packed/keymap_introspection.o: $(QUANTUM_DIR)/keymap_introspection.c $(KEYMAP_C) $(INTROSPECTION_KEYMAP_C) $(INTERMEDIATE_OUTPUT)/cflags.txt generated-files
+	@mkdir -p $(@D)
+	@$(SILENT) || printf "$(MSG_COMPILING) $< (keymaps)" | $(AWK_CMD)
+	$(eval CMD=$(CC) -c $($(INTERMEDIATE_OUTPUT)_CFLAGS) -fno-lto -fdata-sections $< -o $@)
+	@$(BUILD_CMD)
+
+$(INTERMEDIATE_OUTPUT)/keymap_packed/keymaps.bin: $(INTERMEDIATE_OUTPUT)/keymap_packed/keymap_introspection.o
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=$(OBJCOPY) -O binary -j .rodata.keymaps -j .progmem.data.keymaps $< $@)
+	@$(BUILD_CMD)
+
+$(INTERMEDIATE_OUTPUT)/src/keymap_packed.c: $(INTERMEDIATE_OUTPUT)/keymap_packed/keymaps.bin
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=$(QMK_BIN) generate-keymap-packed-c --quiet --keyboard $(KEYBOARD) --output $@ $<)
+	@$(BUILD_CMD)
+	@$(SILENT) || $(SED) -n 's|^// \(Packed keymap: .*\)|\1|p' $@
+endif
+
 # Control whether intermediate file listings are generated
 # e.g.:
 #    make handwired/onekey/blackpill_f411:default KEEP_INTERMEDIATES=yes
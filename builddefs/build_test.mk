@@ -62,9 +62,13 @@ include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
+include $(QUANTUM_PATH)/audio/tests/rules.mk
 include $(QUANTUM_PATH)/battery/tests/rules.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/keymap_packed/tests/rules.mk
+include $(QUANTUM_PATH)/logging/tests/rules.mk
+include $(QUANTUM_PATH)/midi/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
@@ -90,6 +94,33 @@ $(TEST_OBJ)/$(TEST_OUTPUT)_CONFIG := $($(TEST_OUTPUT)_CONFIG)
 include $(PLATFORM_PATH)/$(PLATFORM_KEY)/platform.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
+ifneq ($(filter $(FULL_TESTS),$(TEST)),)
+ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
+# Split keyboard tests link in a second copy of the firmware, which the split simulator runs as the slave half.
+# Every C object is partially linked into one, and each global symbol it defines is prefixed with "slave_". Anything
+# left undefined, such as the test clock, the simulated serial line and the test harness, is shared by both halves.
+# This needs binutils that can rename symbols, such as the GNU or LLVM ones.
+ifeq ($(shell $(OBJCOPY) --help 2>&1 | grep -c -e --redefine-syms),0)
+    $(error Split keyboard tests need an objcopy that supports --redefine-syms, set LD, NM and OBJCOPY to use GNU or LLVM binutils)
+endif
+
+SPLIT_SIMULATOR_SHARED_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/split_simulator.c
+
+SPLIT_SIMULATOR_FIRMWARE_OBJ := $(patsubst %.c,$(TEST_OBJ)/$(TEST_OUTPUT)/%.o,$(filter-out $(SPLIT_SIMULATOR_SHARED_SRC),$(filter %.c,$($(TEST_OUTPUT)_SRC))))
+SPLIT_SIMULATOR_SLAVE_OBJ := $(TEST_OBJ)/$(TEST_OUTPUT)/split_simulator_slave.o
+
+$(SPLIT_SIMULATOR_SLAVE_OBJ): $(SPLIT_SIMULATOR_FIRMWARE_OBJ)
+	@$(SILENT) || printf "Linking slave half: $@" | $(AWK_CMD)
+	$(eval CMD=$(LD) -r $(call uniq,$^) -o $@.firmware && $(NM) -g --defined-only $@.firmware | awk '{ print $$$$3 " slave_" $$$$3 }' > $@.symbols && $(OBJCOPY) --redefine-syms=$@.symbols $@.firmware $@)
+	@$(BUILD_CMD)
+
+$(BUILD_DIR)/$(TARGET).elf: $(SPLIT_SIMULATOR_SLAVE_OBJ)
+OBJ += $(SPLIT_SIMULATOR_SLAVE_OBJ)
+endif
+endif
+
 
 $(shell mkdir -p $(BUILD_DIR)/test 2>/dev/null)
 $(shell mkdir -p $(TEST_OBJ) 2>/dev/null)
@@ -42,6 +42,15 @@ else
     include $(PLATFORM_PATH)/$(PLATFORM_KEY)/printf.mk
 endif
 
+ifeq ($(strip $(DEFERRED_PRINT_ENABLE)), yes)
+    ifeq ($(strip $(PLATFORM_KEY)), avr)
+        $(call CATASTROPHIC_ERROR,Invalid DEFERRED_PRINT_ENABLE,DEFERRED_PRINT_ENABLE is not supported on AVR)
+    endif
+    OPT_DEFS += -DDEFERRED_PRINT_ENABLE
+    SRC += $(QUANTUM_DIR)/logging/print_deferred.c
+    CONSOLE_ENABLE = yes
+endif
+
 ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), yes)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
     CONSOLE_ENABLE = yes
@@ -57,6 +66,7 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
         else ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
             OPT_DEFS += -DAUDIO_DRIVER_DAC
+            SRC += $(QUANTUM_DIR)/audio/audio_synth.c
         ## stm32f2 and above have a usable DAC unit, f1 do not, and need to use pwm instead
         else ifeq ($(strip $(AUDIO_DRIVER)), pwm_software)
             OPT_DEFS += -DAUDIO_DRIVER_PWM
@@ -92,7 +102,6 @@ ifeq ($(strip $(MIDI_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/midi/qmk_midi.c
     SRC += $(QUANTUM_DIR)/midi/sysex_tools.c
     SRC += $(QUANTUM_DIR)/midi/bytequeue/bytequeue.c
-    SRC += $(QUANTUM_DIR)/midi/bytequeue/interrupt_setting.c
     SRC += $(QUANTUM_DIR)/process_keycode/process_midi.c
 endif
 
@@ -193,12 +202,12 @@ ifneq ($(strip $(EEPROM_DRIVER)),none)
       # External I2C EEPROM implementation
       OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_I2C
       I2C_DRIVER_REQUIRED = yes
-      SRC += eeprom_driver.c eeprom_i2c.c
+      SRC += eeprom_driver.c eeprom_i2c.c eeprom_external_cache.c
     else ifeq ($(strip $(EEPROM_DRIVER)), spi)
       # External SPI EEPROM implementation
       OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_SPI
       SPI_DRIVER_REQUIRED = yes
-      SRC += eeprom_driver.c eeprom_spi.c
+      SRC += eeprom_driver.c eeprom_spi.c eeprom_external_cache.c
     else ifeq ($(strip $(EEPROM_DRIVER)), legacy_stm32_flash)
       # STM32 Emulated EEPROM, backed by MCU flash (soon to be deprecated)
       OPT_DEFS += -DEEPROM_DRIVER -DEEPROM_LEGACY_EMULATED_FLASH
@@ -649,6 +658,51 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(KEYMAP_PACKED_ENABLE)), yes)
+    OPT_DEFS += -DKEYMAP_PACKED_ENABLE
+    COMMON_VPATH += $(QUANTUM_DIR)/keymap_packed
+    SRC += $(INTERMEDIATE_OUTPUT)/src/keymap_packed.c
+endif
+
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    SEND_STRING_ENABLE := yes
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SRC += $(QUANTUM_DIR)/send_string/send_string_async.c
+endif
+
+ANALOG_MATRIX_ENABLE ?= no
+VALID_ANALOG_MATRIX_DRIVER_TYPES := adc_dma custom
+ifeq ($(strip $(ANALOG_MATRIX_ENABLE)), yes)
+    ANALOG_MATRIX_DRIVER ?= adc_dma
+    ifeq ($(filter $(ANALOG_MATRIX_DRIVER),$(VALID_ANALOG_MATRIX_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid ANALOG_MATRIX_DRIVER,ANALOG_MATRIX_DRIVER="$(ANALOG_MATRIX_DRIVER)" is not a valid analog matrix driver)
+    endif
+    OPT_DEFS += -DANALOG_MATRIX_ENABLE
+    OPT_DEFS += -DANALOG_MATRIX_DRIVER_$(strip $(shell echo $(ANALOG_MATRIX_DRIVER) | tr '[:lower:]' '[:upper:]'))
+    CUSTOM_MATRIX := lite
+    SRC += $(QUANTUM_DIR)/analog_matrix.c
+
+    ifeq ($(strip $(ANALOG_MATRIX_DRIVER)), adc_dma)
+        ANALOG_DRIVER_REQUIRED = yes
+        SRC += analog_matrix_adc_dma.c
+    endif
+endif
+
+EXPANDER_MATRIX_ENABLE ?= no
+VALID_EXPANDER_MATRIX_DRIVER_TYPES := mcp23018 pca9555
+ifeq ($(strip $(EXPANDER_MATRIX_ENABLE)), yes)
+    ifeq ($(filter $(EXPANDER_MATRIX_DRIVER),$(VALID_EXPANDER_MATRIX_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid EXPANDER_MATRIX_DRIVER,EXPANDER_MATRIX_DRIVER="$(EXPANDER_MATRIX_DRIVER)" is not a valid expander matrix driver)
+    endif
+    OPT_DEFS += -DEXPANDER_MATRIX_ENABLE
+    OPT_DEFS += -DEXPANDER_MATRIX_DRIVER_$(strip $(shell echo $(EXPANDER_MATRIX_DRIVER) | tr '[:lower:]' '[:upper:]'))
+    CUSTOM_MATRIX := lite
+    I2C_DRIVER_REQUIRED = yes
+    COMMON_VPATH += $(DRIVER_PATH)/gpio
+    SRC += $(QUANTUM_DIR)/expander_matrix.c
+    SRC += $(strip $(EXPANDER_MATRIX_DRIVER)).c
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -710,6 +764,7 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
             QUANTUM_LIB_SRC += serial.c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
+            QUANTUM_LIB_SRC += serial_protocol_framed.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
         endif
     endif
@@ -945,6 +1000,12 @@ ifeq ($(strip $(DIP_SWITCH_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(LEADER_ENABLE)), yes)
+    ifeq ($(strip $(LEADER_MAP_ENABLE)), yes)
+        OPT_DEFS += -DLEADER_MAP_ENABLE
+    endif
+endif
+
 ifeq ($(strip $(BATTERY_ENABLE)), yes)
     BATTERY_DRIVER_REQUIRED := yes
 endif
@@ -989,6 +1050,9 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
             OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
         endif
+        ifeq ($(strip $(WS2812_DRIVER)), spi)
+            SRC += ws2812_encode.c
+        endif
     endif
 
     # add extra deps
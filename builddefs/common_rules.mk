@@ -191,6 +191,13 @@ lib: $(LIBNAME)
 
 cpfirmware: cpfirmware_qmk
 
+ifeq ($(strip $(DEFERRED_PRINT_ENABLE)), yes)
+cpfirmware: cpfirmware_print_formats
+cpfirmware_print_formats: $(BUILD_DIR)/$(TARGET).fmt
+	$(SILENT) || printf "Copying $(TARGET).fmt to qmk_firmware folder" | $(AWK_CMD)
+	$(COPY) $(BUILD_DIR)/$(TARGET).fmt $(TARGET).fmt && $(PRINT_OK)
+endif
+
 ifneq ($(QMK_USERSPACE),)
 cpfirmware: cpfirmware_userspace
 cpfirmware_userspace: cpfirmware_qmk
@@ -257,6 +264,13 @@ gccversion :
 	#$(SILENT) || printf "$(MSG_EXECUTING) '$(DFU_SUFFIX) $(DFU_SUFFIX_ARGS) -a $(BUILD_DIR)/$(TARGET).bin 1>/dev/null':\n" ;\
 	$(COPY) $(BUILD_DIR)/$(TARGET).bin $(TARGET).bin;
 
+# Extract the format strings that the host needs to decode deferred print output
+%.fmt: %.elf
+	$(eval CMD=$(OBJCOPY) -O binary -j qmk_print_formats $< $@)
+	#@$(SILENT) || printf "$(MSG_EXECUTING) '$(CMD)':\n"
+	@$(SILENT) || printf "$(MSG_PRINT_FORMATS) $@" | $(AWK_CMD)
+	@$(BUILD_CMD)
+
 BEGIN = gccversion sizebefore
 
 # Link: create ELF output file from object files.
@@ -45,6 +45,7 @@ GENERIC_FEATURES = \
     MOUSEKEY \
     MUSIC \
     OS_DETECTION \
+    POWER_STATE \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
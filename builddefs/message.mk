@@ -54,6 +54,7 @@ MSG_FLASH = Creating load file for flashing:
 MSG_UF2 = Creating UF2 file for deployment:
 MSG_EEPROM = Creating load file for EEPROM:
 MSG_BIN = Creating binary load file for flashing:
+MSG_PRINT_FORMATS = Extracting deferred print format strings:
 MSG_EXTENDED_LISTING = Creating Extended Listing:
 MSG_SYMBOL_TABLE = Creating Symbol Table:
 MSG_EXECUTING = Executing:
@@ -0,0 +1,242 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "timer.h"
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "eeprom_external_cache.h"
+
+/*
+    Serves eeprom_read_block() and eeprom_write_block() for the i2c and spi
+    drivers from a few page-sized lines of RAM.
+
+    Reads fill a whole line at a time, so that nearby reads -- such as the
+    keycodes read while resolving layers -- don't go to the bus. Reads that
+    cover whole lines which aren't cached go straight into the caller's
+    buffer, in as few transfers as possible, so that bulk reads don't evict
+    everything else.
+
+    Writes only change the line, and mark the bytes that actually changed as
+    dirty. Dirty lines are written back with a single page write, in the order
+    they were first written. Writing to a dirty line other than the newest one
+    writes back everything first, so that writes reach the EEPROM in the order
+    they were made, and data written before a magic number or checksum can't
+    end up being written after it.
+*/
+
+#if EXTERNAL_EEPROM_CACHE_LINE_COUNT > 0
+
+_Static_assert(EXTERNAL_EEPROM_PAGE_SIZE % EXTERNAL_EEPROM_CACHE_LINE_SIZE == 0, "EXTERNAL_EEPROM_CACHE_LINE_SIZE must divide EXTERNAL_EEPROM_PAGE_SIZE");
+
+typedef struct cache_line_t {
+    uintptr_t base;
+    uint16_t  last_used;
+    uint16_t  dirty_order;
+    uint16_t  dirty_start;
+    uint16_t  dirty_end; // equal to dirty_start when the line is clean
+    bool      valid;
+    uint8_t   data[EXTERNAL_EEPROM_CACHE_LINE_SIZE];
+} cache_line_t;
+
+static cache_line_t  lines[EXTERNAL_EEPROM_CACHE_LINE_COUNT];
+static cache_line_t *newest_dirty = NULL;
+static uint16_t      use_count    = 0;
+static uint16_t      dirty_count  = 0;
+static uint32_t      last_write   = 0;
+
+static inline bool line_is_dirty(const cache_line_t *line) {
+    return line->dirty_end != line->dirty_start;
+}
+
+static void line_write_back(cache_line_t *line) {
+    eeprom_external_write(line->base + line->dirty_start, &line->data[line->dirty_start], line->dirty_end - line->dirty_start);
+    line->dirty_start = 0;
+    line->dirty_end   = 0;
+}
+
+static void cache_write_back(void) {
+    // Oldest first
+    while (newest_dirty) {
+        cache_line_t *oldest = NULL;
+        for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+            if (line_is_dirty(&lines[i]) && (!oldest || (uint16_t)(dirty_count - lines[i].dirty_order) > (uint16_t)(dirty_count - oldest->dirty_order))) {
+                oldest = &lines[i];
+            }
+        }
+        if (!oldest) {
+            newest_dirty = NULL;
+            break;
+        }
+        line_write_back(oldest);
+    }
+}
+
+static cache_line_t *line_find(uintptr_t base) {
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+        if (lines[i].valid && lines[i].base == base) {
+            lines[i].last_used = ++use_count;
+            return &lines[i];
+        }
+    }
+    return NULL;
+}
+
+static cache_line_t *line_allocate(uintptr_t base) {
+    // Least recently used
+    cache_line_t *victim = &lines[0];
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+        if (!lines[i].valid) {
+            victim = &lines[i];
+            break;
+        }
+        if ((uint16_t)(use_count - lines[i].last_used) > (uint16_t)(use_count - victim->last_used)) {
+            victim = &lines[i];
+        }
+    }
+
+    if (victim->valid && line_is_dirty(victim)) {
+        cache_write_back();
+    }
+
+    victim->base        = base;
+    victim->last_used   = ++use_count;
+    victim->dirty_start = 0;
+    victim->dirty_end   = 0;
+    victim->valid       = true;
+    return victim;
+}
+
+static void line_mark_dirty(cache_line_t *line, uint16_t start, uint16_t end) {
+    if (!line_is_dirty(line)) {
+        line->dirty_order = ++dirty_count;
+        line->dirty_start = start;
+        line->dirty_end   = end;
+        newest_dirty      = line;
+        return;
+    }
+    if (start < line->dirty_start) {
+        line->dirty_start = start;
+    }
+    if (end > line->dirty_end) {
+        line->dirty_end = end;
+    }
+}
+
+void eeprom_external_cache_invalidate(void) {
+    memset(lines, 0, sizeof(lines));
+    newest_dirty = NULL;
+}
+
+void eeprom_driver_flush(void) {
+    cache_write_back();
+}
+
+void eeprom_driver_task(void) {
+    if (newest_dirty && TIMER_DIFF_32(timer_read32(), last_write) >= EXTERNAL_EEPROM_CACHE_WRITE_DELAY) {
+        cache_write_back();
+    }
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uint8_t  *destination    = (uint8_t *)buf;
+    uintptr_t address        = (uintptr_t)addr;
+    uint8_t  *direct_buf     = NULL;
+    uintptr_t direct_address = 0;
+    size_t    direct_length  = 0;
+
+    while (len > 0) {
+        uintptr_t     base   = address - address % EXTERNAL_EEPROM_CACHE_LINE_SIZE;
+        size_t        offset = address - base;
+        size_t        length = EXTERNAL_EEPROM_CACHE_LINE_SIZE - offset;
+        cache_line_t *line   = line_find(base);
+        if (length > len) {
+            length = len;
+        }
+
+        if (!line && length == EXTERNAL_EEPROM_CACHE_LINE_SIZE) {
+            if (direct_length == 0) {
+                direct_buf     = destination;
+                direct_address = address;
+            }
+            direct_length += length;
+        } else {
+            if (direct_length > 0) {
+                eeprom_external_read(direct_address, direct_buf, direct_length);
+                direct_length = 0;
+            }
+            if (!line) {
+                line = line_allocate(base);
+                eeprom_external_read(base, line->data, EXTERNAL_EEPROM_CACHE_LINE_SIZE);
+            }
+            memcpy(destination, &line->data[offset], length);
+        }
+
+        destination += length;
+        address += length;
+        len -= length;
+    }
+
+    if (direct_length > 0) {
+        eeprom_external_read(direct_address, direct_buf, direct_length);
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source  = (const uint8_t *)buf;
+    uintptr_t      address = (uintptr_t)addr;
+
+    while (len > 0) {
+        uintptr_t     base   = address - address % EXTERNAL_EEPROM_CACHE_LINE_SIZE;
+        uint16_t      offset = address - base;
+        uint16_t      length = EXTERNAL_EEPROM_CACHE_LINE_SIZE - offset;
+        cache_line_t *line   = line_find(base);
+        if (length > len) {
+            length = len;
+        }
+
+        if (line && line_is_dirty(line) && line != newest_dirty) {
+            cache_write_back();
+        }
+
+        if (!line && length == EXTERNAL_EEPROM_CACHE_LINE_SIZE) {
+            // Nothing to keep from what is on the EEPROM
+            line = line_allocate(base);
+            memcpy(line->data, source, length);
+            line_mark_dirty(line, 0, length);
+        } else {
+            if (!line) {
+                line = line_allocate(base);
+                eeprom_external_read(base, line->data, EXTERNAL_EEPROM_CACHE_LINE_SIZE);
+            }
+            for (uint16_t i = 0; i < length; i++) {
+                if (line->data[offset + i] != source[i]) {
+                    line->data[offset + i] = source[i];
+                    line_mark_dirty(line, offset + i, offset + i + 1);
+                }
+            }
+        }
+
+        source += length;
+        address += length;
+        len -= length;
+    }
+
+    last_write = timer_read32();
+}
+
+#else
+
+void eeprom_external_cache_invalidate(void) {}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_external_read((uintptr_t)addr, buf, len);
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    eeprom_external_write((uintptr_t)addr, buf, len);
+}
+
+#endif // EXTERNAL_EEPROM_CACHE_LINE_COUNT > 0
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    The number of lines in the RAM cache in front of an external EEPROM. Reads
+    are served from the cache, and writes are gathered in it until they are
+    written back by eeprom_driver_task(), so that each line goes to the EEPROM
+    in a single page write. Set to 0 to go straight to the EEPROM every time.
+*/
+#ifndef EXTERNAL_EEPROM_CACHE_LINE_COUNT
+#    ifdef __AVR__
+#        define EXTERNAL_EEPROM_CACHE_LINE_COUNT 0
+#    else
+#        define EXTERNAL_EEPROM_CACHE_LINE_COUNT 4
+#    endif
+#endif
+
+/*
+    The size of each cache line in bytes. A line never crosses a page of the
+    EEPROM, so this must divide EXTERNAL_EEPROM_PAGE_SIZE.
+*/
+#ifndef EXTERNAL_EEPROM_CACHE_LINE_SIZE
+#    define EXTERNAL_EEPROM_CACHE_LINE_SIZE EXTERNAL_EEPROM_PAGE_SIZE
+#endif
+
+/*
+    How long in milliseconds written data is held in the cache, waiting for
+    further writes to the same line, before eeprom_driver_task() writes it back.
+*/
+#ifndef EXTERNAL_EEPROM_CACHE_WRITE_DELAY
+#    define EXTERNAL_EEPROM_CACHE_WRITE_DELAY 0
+#endif
+
+/*
+    Implemented by each external EEPROM driver, these go straight to the chip.
+*/
+void eeprom_external_read(uintptr_t addr, void *buf, size_t len);
+void eeprom_external_write(uintptr_t addr, const void *buf, size_t len);
+
+/*
+    Drops everything in the cache, without writing it back. Used when the
+    EEPROM is changed behind the cache's back, such as when it is erased.
+*/
+void eeprom_external_cache_invalidate(void);
@@ -33,19 +33,22 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
 #include "eeprom.h"
 #include "eeprom_driver.h"
 #include "eeprom_i2c.h"
+#include "eeprom_external_cache.h"
 
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+static bool     write_in_progress = false;
+static uint32_t write_started     = 0;
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -54,6 +57,24 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+/*
+    The EEPROM doesn't acknowledge its address while a write cycle is in
+    progress, so rather than always waiting for the longest write time in the
+    datasheet, poll it until it answers.
+*/
+static void wait_for_write_cycle(uintptr_t addr) {
+    if (!write_in_progress) {
+        return;
+    }
+    write_in_progress = false;
+
+    while (i2c_ping_address(EXTERNAL_EEPROM_I2C_ADDRESS(addr), 1) != I2C_STATUS_SUCCESS) {
+        if (TIMER_DIFF_32(timer_read32(), write_started) > EXTERNAL_EEPROM_WRITE_TIME) {
+            break;
+        }
+    }
+}
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -77,8 +98,9 @@ void eeprom_driver_erase(void) {
 
     uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
     memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
+    eeprom_external_cache_invalidate();
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        eeprom_external_write(addr, buf, EXTERNAL_EEPROM_PAGE_SIZE);
     }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
@@ -86,12 +108,13 @@ void eeprom_driver_erase(void) {
 #endif
 }
 
-void eeprom_read_block(void *buf, const void *addr, size_t len) {
+void eeprom_external_read(uintptr_t addr, void *buf, size_t len) {
     uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
+    fill_target_address(complete_packet, (const void *)addr);
 
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+    wait_for_write_cycle(addr);
+    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
+    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS(addr), buf, len, 100);
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
@@ -102,10 +125,10 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 #endif // DEBUG_EEPROM_OUTPUT
 }
 
-void eeprom_write_block(const void *buf, void *addr, size_t len) {
+void eeprom_external_write(uintptr_t addr, const void *buf, size_t len) {
     uint8_t   complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
     uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
+    uintptr_t target_addr = addr;
 
 #if defined(EXTERNAL_EEPROM_WP_PIN)
     gpio_set_pin_output(EXTERNAL_EEPROM_WP_PIN);
@@ -132,8 +155,10 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        wait_for_write_cycle(target_addr);
+        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
+        write_in_progress = EXTERNAL_EEPROM_WRITE_TIME > 0;
+        write_started     = timer_read32();
 
         read_buf += write_length;
         target_addr += write_length;
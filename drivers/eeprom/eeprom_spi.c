@@ -37,6 +37,7 @@
 #include "eeprom.h"
 #include "eeprom_driver.h"
 #include "eeprom_spi.h"
+#include "eeprom_external_cache.h"
 
 #define CMD_WREN 6
 #define CMD_WRDI 4
@@ -107,8 +108,9 @@ void eeprom_driver_erase(void) {
 
     uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
     memset(buf, 0x00, EXTERNAL_EEPROM_PAGE_SIZE);
+    eeprom_external_cache_invalidate();
     for (uint32_t addr = 0; addr < EXTERNAL_EEPROM_BYTE_COUNT; addr += EXTERNAL_EEPROM_PAGE_SIZE) {
-        eeprom_write_block(buf, (void *)(uintptr_t)addr, EXTERNAL_EEPROM_PAGE_SIZE);
+        eeprom_external_write(addr, buf, EXTERNAL_EEPROM_PAGE_SIZE);
     }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
@@ -116,7 +118,7 @@ void eeprom_driver_erase(void) {
 #endif
 }
 
-void eeprom_read_block(void *buf, const void *addr, size_t len) {
+void eeprom_external_read(uintptr_t addr, void *buf, size_t len) {
     //-------------------------------------------------
     // Wait for the write-in-progress bit to be cleared
     spi_status_t response = spi_eeprom_wait_while_busy(EXTERNAL_EEPROM_SPI_TIMEOUT);
@@ -138,11 +140,11 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     }
 
     spi_write(CMD_READ);
-    spi_eeprom_transmit_address((uintptr_t)addr);
+    spi_eeprom_transmit_address(addr);
     spi_receive(buf, len);
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-    dprintf("[EEPROM R] 0x%08lX: ", ((uint32_t)(uintptr_t)addr));
+    dprintf("[EEPROM R] 0x%08lX: ", ((uint32_t)addr));
     for (size_t i = 0; i < len; ++i) {
         dprintf(" %02X", (int)(((uint8_t *)buf)[i]));
     }
@@ -152,10 +154,10 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
     spi_stop();
 }
 
-void eeprom_write_block(const void *buf, void *addr, size_t len) {
+void eeprom_external_write(uintptr_t addr, const void *buf, size_t len) {
     bool      res;
     uint8_t * read_buf    = (uint8_t *)buf;
-    uintptr_t target_addr = (uintptr_t)addr;
+    uintptr_t target_addr = addr;
 
     while (len > 0) {
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
@@ -10,12 +10,20 @@
 #define TIMEOUT 100
 
 enum {
-    CMD_IODIRA = 0x00, // i/o direction register
-    CMD_IODIRB = 0x01,
-    CMD_GPPUA  = 0x0C, // GPIO pull-up resistor register
-    CMD_GPPUB  = 0x0D,
-    CMD_GPIOA  = 0x12, // general purpose i/o port register (write modifies OLAT)
-    CMD_GPIOB  = 0x13,
+    CMD_IODIRA   = 0x00, // i/o direction register
+    CMD_IODIRB   = 0x01,
+    CMD_GPINTENA = 0x04, // interrupt-on-change enable register
+    CMD_GPINTENB = 0x05,
+    CMD_IOCON    = 0x0A, // configuration register
+    CMD_GPPUA    = 0x0C, // GPIO pull-up resistor register
+    CMD_GPPUB    = 0x0D,
+    CMD_GPIOA    = 0x12, // general purpose i/o port register (write modifies OLAT)
+    CMD_GPIOB    = 0x13,
+};
+
+enum {
+    IOCON_ODR    = 1 << 2, // INT pins are open-drain
+    IOCON_MIRROR = 1 << 6, // INT pins are internally connected
 };
 
 void mcp23018_init(uint8_t addr) {
@@ -74,6 +82,26 @@ bool mcp23018_set_output_all(uint8_t slave_addr, uint8_t confA, uint8_t confB) {
     return true;
 }
 
+bool mcp23018_set_interrupt_on_change(uint8_t slave_addr, uint16_t mask) {
+    uint8_t addr    = SLAVE_TO_ADDR(slave_addr);
+    uint8_t iocon   = IOCON_MIRROR | IOCON_ODR;
+    uint8_t conf[2] = {mask & 0xFF, mask >> 8};
+
+    i2c_status_t ret = i2c_write_register(addr, CMD_IOCON, &iocon, sizeof(iocon), TIMEOUT);
+    if (ret != I2C_STATUS_SUCCESS) {
+        dprintf("mcp23018_set_interrupt_on_change::configFAILED::%u\n", ret);
+        return false;
+    }
+
+    ret = i2c_write_register(addr, CMD_GPINTENA, &conf[0], sizeof(conf), TIMEOUT);
+    if (ret != I2C_STATUS_SUCCESS) {
+        dprintf("mcp23018_set_interrupt_on_change::enableFAILED::%u\n", ret);
+        return false;
+    }
+
+    return true;
+}
+
 bool mcp23018_read_pins(uint8_t slave_addr, mcp23018_port_t port, uint8_t* out) {
     uint8_t addr = SLAVE_TO_ADDR(slave_addr);
     uint8_t cmd  = port ? CMD_GPIOB : CMD_GPIOA;
@@ -52,6 +52,13 @@ bool mcp23018_set_output(uint8_t slave_addr, mcp23018_port_t port, uint8_t conf)
  */
 bool mcp23018_set_output_all(uint8_t slave_addr, uint8_t confA, uint8_t confB);
 
+/**
+ * Enable interrupt-on-change for the given pins of both ports
+ *
+ *  - INTA and INTB are mirrored and open-drain, going low until the pins are read
+ */
+bool mcp23018_set_interrupt_on_change(uint8_t slave_addr, uint16_t mask);
+
 /**
  * Read state of a given port
  */
@@ -44,6 +44,19 @@ bool pca9555_set_config(uint8_t slave_addr, pca9555_port_t port, uint8_t conf) {
     return true;
 }
 
+bool pca9555_set_config_all(uint8_t slave_addr, uint8_t confA, uint8_t confB) {
+    uint8_t addr    = SLAVE_TO_ADDR(slave_addr);
+    uint8_t conf[2] = {confA, confB};
+
+    i2c_status_t ret = i2c_write_register(addr, CMD_CONFIG_0, &conf[0], sizeof(conf), TIMEOUT);
+    if (ret != I2C_STATUS_SUCCESS) {
+        dprintf("pca9555_set_config_all::FAILED::%u\n", ret);
+        return false;
+    }
+
+    return true;
+}
+
 bool pca9555_set_output(uint8_t slave_addr, pca9555_port_t port, uint8_t conf) {
     uint8_t addr = SLAVE_TO_ADDR(slave_addr);
     uint8_t cmd  = port ? CMD_OUTPUT_1 : CMD_OUTPUT_0;
@@ -63,7 +76,7 @@ bool pca9555_set_output_all(uint8_t slave_addr, uint8_t confA, uint8_t confB) {
 
     i2c_status_t ret = i2c_write_register(addr, CMD_OUTPUT_0, &conf[0], sizeof(conf), TIMEOUT);
     if (ret != I2C_STATUS_SUCCESS) {
-        dprintf("pca9555_set_output::FAILED::%u\n", ret);
+        dprintf("pca9555_set_output_all::FAILED::%u\n", ret);
         return false;
     }
 
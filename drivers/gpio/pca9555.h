@@ -63,6 +63,13 @@ void pca9555_init(uint8_t slave_addr);
  */
 bool pca9555_set_config(uint8_t slave_addr, pca9555_port_t port, uint8_t conf);
 
+/**
+ * Configure input/output to both ports sequentially
+ *
+ *  - slightly faster than multiple set_config
+ */
+bool pca9555_set_config_all(uint8_t slave_addr, uint8_t confA, uint8_t confB);
+
 /**
  * Write high/low to a given port
  */
@@ -0,0 +1,33 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812_encode.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#    error "The WS2812 SPI lookup table assumes a little-endian MCU"
+#endif
+
+// A single LED bit as four SPI bits
+#define SPI_BIT(byte, bit) (((byte) >> (bit)) & 1 ? 0b1110 : 0b1000)
+
+// Two LED bits as an SPI byte
+#define SPI_BYTE(byte, bit) (SPI_BIT(byte, bit) << 4 | SPI_BIT(byte, (bit)-1))
+
+// The four SPI bytes for an LED byte, stored so that the most significant bits go out first
+#define SPI_WORD(byte) ((uint32_t)SPI_BYTE(byte, 7) | (uint32_t)SPI_BYTE(byte, 5) << 8 | (uint32_t)SPI_BYTE(byte, 3) << 16 | (uint32_t)SPI_BYTE(byte, 1) << 24)
+
+#define SPI_WORDS_4(n) SPI_WORD(n), SPI_WORD((n) + 1), SPI_WORD((n) + 2), SPI_WORD((n) + 3)
+#define SPI_WORDS_16(n) SPI_WORDS_4(n), SPI_WORDS_4((n) + 4), SPI_WORDS_4((n) + 8), SPI_WORDS_4((n) + 12)
+#define SPI_WORDS_64(n) SPI_WORDS_16(n), SPI_WORDS_16((n) + 16), SPI_WORDS_16((n) + 32), SPI_WORDS_16((n) + 48)
+
+static const uint32_t spi_lut[256] = {SPI_WORDS_64(0), SPI_WORDS_64(64), SPI_WORDS_64(128), SPI_WORDS_64(192)};
+
+void ws2812_encode_spi(uint32_t *out, const ws2812_led_t *leds, uint16_t count) {
+    // The LED struct is already laid out in the order the bytes are sent
+    const uint8_t *data = (const uint8_t *)leds;
+    const uint8_t *end  = data + count * sizeof(ws2812_led_t);
+
+    while (data < end) {
+        *out++ = spi_lut[*data++];
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+#include "ws2812.h"
+
+/**
+ * \file
+ *
+ * \brief Encoding of LED data for drivers that clock WS2812 bits out of a peripheral.
+ *
+ * The SPI encoding sends each WS2812 bit as four SPI bits, `0b1110` for a 1 and `0b1000` for a 0, most significant
+ * first, so each byte of LED data becomes four bytes on the wire. A 256-entry lookup table holds those four bytes for
+ * every byte value.
+ */
+
+// Bytes on the wire for each byte of LED data
+#define WS2812_SPI_BYTES_PER_BYTE 4
+
+// Bytes on the wire for the given number of LEDs
+#define WS2812_SPI_ENCODED_SIZE(count) ((count) * sizeof(ws2812_led_t) * WS2812_SPI_BYTES_PER_BYTE)
+
+/**
+ * \brief Encodes LEDs for SPI, one word per byte of LED data, in the order they are sent.
+ *
+ * \param out where to write the `count * sizeof(ws2812_led_t)` words
+ * \param leds the LEDs to encode
+ * \param count the number of LEDs
+ */
+void ws2812_encode_spi(uint32_t *out, const ws2812_led_t *leds, uint16_t count);
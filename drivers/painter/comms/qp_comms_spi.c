@@ -4,6 +4,7 @@
 #ifdef QUANTUM_PAINTER_SPI_ENABLE
 
 #    include "spi_master.h"
+#    include "qp_comms.h"
 #    include "qp_comms_spi.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,6 +46,30 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+static void qp_comms_spi_send_async_complete(void *cb_arg) {
+    qp_comms_send_async_complete((painter_device_t)cb_arg);
+}
+
+bool qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    const uint8_t *p                = (const uint8_t *)data;
+    const uint32_t max_async_length = UINT16_MAX;
+
+    // A single transfer is limited to 16 bits of length, so anything in front of that goes out synchronously
+    if (byte_count > max_async_length) {
+        uint32_t bytes_sync = byte_count - max_async_length;
+        qp_comms_spi_send_data(device, p, bytes_sync);
+        p += bytes_sync;
+        byte_count -= bytes_sync;
+    }
+
+    if (byte_count == 0) {
+        qp_comms_send_async_complete(device);
+        return true;
+    }
+
+    return spi_transmit_async(p, byte_count, qp_comms_spi_send_async_complete, (void *)device) == SPI_STATUS_SUCCESS;
+}
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -53,10 +78,11 @@ void qp_comms_spi_stop(painter_device_t device) {
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
-    .comms_init  = qp_comms_spi_init,
-    .comms_start = qp_comms_spi_start,
-    .comms_send  = qp_comms_spi_send_data,
-    .comms_stop  = qp_comms_spi_stop,
+    .comms_init       = qp_comms_spi_init,
+    .comms_start      = qp_comms_spi_start,
+    .comms_send       = qp_comms_spi_send_data,
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_stop       = qp_comms_spi_stop,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +123,13 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    gpio_write_pin_high(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
@@ -131,10 +164,11 @@ void qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const
 const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
     .base =
         {
-            .comms_init  = qp_comms_spi_dc_reset_init,
-            .comms_start = qp_comms_spi_start,
-            .comms_send  = qp_comms_spi_dc_reset_send_data,
-            .comms_stop  = qp_comms_spi_stop,
+            .comms_init       = qp_comms_spi_dc_reset_init,
+            .comms_start      = qp_comms_spi_start,
+            .comms_send       = qp_comms_spi_dc_reset_send_data,
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_stop       = qp_comms_spi_stop,
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
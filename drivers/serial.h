@@ -28,6 +28,11 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#if defined(SERIAL_USART_FRAMED)
+// sends the transactions still queued for the slave
+bool soft_serial_flush(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
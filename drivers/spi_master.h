@@ -48,6 +48,8 @@ typedef struct spi_start_config_t {
     bool     cs_active_low;
 } spi_start_config_t;
 
+typedef void (*spi_callback_t)(void *cb_arg);
+
 /**
  * \brief Initialize the SPI driver. This function must be called only once, before any of the below functions can be called.
  */
@@ -93,6 +95,20 @@ spi_status_t spi_read(void);
  */
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
+/**
+ * \brief Start sending multiple bytes to the selected SPI device, returning before the transfer has finished.
+ *
+ * No other SPI function may be called until `callback` has been invoked. On platforms without asynchronous transfers, the data is sent before returning.
+ *
+ * \param data A pointer to the data to write from. It must stay valid until `callback` has been invoked.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ * \param callback The function to invoke, possibly from an interrupt, once the transfer has finished. May be `NULL`.
+ * \param cb_arg The argument passed to `callback`.
+ *
+ * \return `SPI_STATUS_ERROR` if the transfer could not be started, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_callback_t callback, void *cb_arg);
+
 /**
  * \brief Receive multiple bytes from the selected SPI device.
  *
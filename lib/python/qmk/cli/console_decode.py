@@ -0,0 +1,160 @@
+"""Decode the console output of firmware built with DEFERRED_PRINT_ENABLE.
+"""
+import re
+import sys
+
+from milc import cli
+
+import qmk.path
+
+DROPPED_ID = 0xFFFF
+CONSOLE_USAGE_PAGE = 0xFF31
+CONSOLE_USAGE = 0x0074
+
+# Flags, width, precision, length and conversion, as the firmware reads them
+CONVERSION = re.compile(r'%(?P<flags>[-+ #0]*)(?P<width>\*|\d*)(?:\.(?P<precision>\*|\d*))?(?P<length>hh|h|ll|l|z|j|t)?(?P<conversion>.)?')
+
+
+class _Arguments:
+    """Reads the raw arguments of a record in order.
+    """
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def integer(self, size, signed):
+        value = int.from_bytes(self.data[self.offset:self.offset + size], 'little', signed=signed)
+        self.offset += size
+        return value
+
+    def string(self):
+        length = self.data[self.offset]
+        value = self.data[self.offset + 1:self.offset + 1 + length].decode('utf-8', errors='replace')
+        self.offset += 1 + length
+        return value
+
+
+def _format_conversion(match, args):
+    """Formats a single conversion from the arguments it takes.
+    """
+    flags, width, precision, length, conversion = match.group('flags', 'width', 'precision', 'length', 'conversion')
+    if conversion == '%':
+        return '%'
+    if conversion is None:
+        return ''
+
+    if width == '*':
+        width = str(args.integer(4, True))
+    if precision == '*':
+        precision = str(args.integer(4, True))
+    spec = '%' + flags + width + ('.' + precision if precision is not None else '')
+
+    size = {'hh': 1, 'h': 2}.get(length, 4)
+    if conversion in 'di':
+        return (spec + 'd') % args.integer(size, True)
+    if conversion in 'uxXo':
+        return (spec + conversion.replace('u', 'd')) % args.integer(size, False)
+    if conversion == 'b':
+        value = format(args.integer(size, False), ('0' if '0' in flags else '') + width + 'b')
+        return value.ljust(int(width)) if '-' in flags and width else value
+    if conversion == 'c':
+        return (spec + 'c') % chr(args.integer(1, False))
+    if conversion == 'p':
+        return (spec + 's') % hex(args.integer(4, False))
+    if conversion == 's':
+        return (spec + 's') % args.string()
+    return match.group(0)
+
+
+def format_record(formats, record):
+    """Turns a decoded record back into the text the firmware printed.
+    """
+    if len(record) < 2:
+        return None
+
+    format_id = record[0] | record[1] << 8
+    if format_id == DROPPED_ID:
+        return '[%d messages dropped]\n' % int.from_bytes(record[2:4], 'little')
+
+    end = formats.find(b'\0', format_id)
+    if format_id >= len(formats) or end < 0:
+        return '[unknown format %d]\n' % format_id
+
+    args = _Arguments(record[2:])
+    try:
+        return CONVERSION.sub(lambda match: _format_conversion(match, args), formats[format_id:end].decode('utf-8', errors='replace'))
+    except (IndexError, ValueError):
+        return '[malformed record for format %d]\n' % format_id
+
+
+def decode_cobs(frame):
+    """Undoes the COBS encoding of a record, without its terminating zero.
+    """
+    record = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        record += frame[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(frame):
+            record.append(0)
+    return bytes(record)
+
+
+def split_records(chunks):
+    """Yields each record from a stream of console data, split on the zero bytes ending them.
+    """
+    pending = bytearray()
+    for chunk in chunks:
+        for byte in chunk:
+            if byte:
+                pending.append(byte)
+            elif pending:
+                yield decode_cobs(pending)
+                pending.clear()
+
+
+def _read_file(stream):
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            return
+        yield chunk
+
+
+def _read_console():
+    import hid
+
+    for device in hid.enumerate():
+        if device['usage_page'] == CONSOLE_USAGE_PAGE and device['usage'] == CONSOLE_USAGE:
+            cli.log.info('Listening to %s %s', device['manufacturer_string'], device['product_string'])
+            console = hid.Device(path=device['path'])
+            while True:
+                yield console.read(64)
+
+    cli.log.error('No QMK console found.')
+
+
+@cli.argument('-f', '--formats', arg_only=True, required=True, type=qmk.path.normpath, help='The .fmt file built with the firmware')
+@cli.argument('input', nargs='?', arg_only=True, help='File of raw console output to read instead of the console, or - for stdin')
+@cli.subcommand('Decodes the console output of firmware built with DEFERRED_PRINT_ENABLE.')
+def console_decode(cli):
+    """Turns deferred print records back into text, from the firmware's console or a capture of it.
+    """
+    formats = cli.args.formats.read_bytes()
+
+    if cli.args.input == '-':
+        chunks = _read_file(sys.stdin.buffer)
+    elif cli.args.input:
+        chunks = _read_file(open(cli.args.input, 'rb'))
+    else:
+        chunks = _read_console()
+
+    try:
+        for record in split_records(chunks):
+            text = format_record(formats, record)
+            if text:
+                sys.stdout.write(text)
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
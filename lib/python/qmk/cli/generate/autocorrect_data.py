@@ -24,6 +24,9 @@ Example:
   lenght        -> length
   ouput         -> output
   widht         -> width
+With --dawg, identical suffixes of the trie are shared, which makes the data
+smaller for large dictionaries. With --binary, the data is also written as a
+blob that can be loaded into the keyboard's EEPROM at runtime.
 For full documentation, see QMK Docs
 """
 
@@ -43,6 +46,9 @@ KC_A = 4
 KC_SPC = 0x2c
 KC_QUOT = 0x34
 
+# Ends a chain whose next node was serialized elsewhere, and is followed by a link to it.
+CHAIN_LINK = 1
+
 TYPO_CHARS = dict([
     ("'", KC_QUOT),
     (':', KC_SPC),  # "Word break" character.
@@ -124,6 +130,41 @@ def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
     return trie
 
 
+def leaf_data(typo: str, correction: str) -> List[int]:
+    """Makes the serialized data for the leaf of `typo`."""
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    return [backspaces + 128] + list(bytes(correction[i:], 'ascii')) + [0]
+
+
+def make_dawg(trie: Dict[str, Any]) -> Dict[str, Any]:
+    """Turns the trie into a DAWG, by merging subtrees that serialize identically.
+  Typos sharing an ending and a correction of that ending, such as "fales" and
+  "flase", end up sharing the nodes for it.
+  Args:
+    trie: Dict of dicts, as made by make_trie.
+  Returns:
+    The root node, where identical subtrees are the same dict.
+  """
+    registry = {}
+
+    def merge(node):
+        if 'LEAF' in node:
+            key = ('LEAF', tuple(leaf_data(*node['LEAF'])))
+        else:
+            for c in node:
+                node[c] = merge(node[c])
+            key = tuple((c, id(node[c])) for c in sorted(node))
+        return registry.setdefault(key, node)
+
+    return merge(trie)
+
+
 def parse_file_lines(file_name: str) -> Iterator[Tuple[int, str, str]]:
     """Parses lines read from `file_name` into typo-correction pairs."""
 
@@ -167,6 +208,8 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
 
 def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
+  The trie may also be a DAWG, made by make_dawg, in which case each shared
+  node is only serialized once.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
@@ -174,38 +217,45 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
     List of ints in the range 0-255.
   """
     table = []
+    entries = {}  # Maps each node already in the table to its entry.
+    parents = {}  # Counts the nodes linking to each node.
+
+    def count_parents(trie_node):
+        if 'LEAF' in trie_node:
+            return
+        for child in trie_node.values():
+            parents[id(child)] = parents.get(id(child), 0) + 1
+            if parents[id(child)] == 1:
+                count_parents(child)
+
+    count_parents(trie)
 
     # Traverse trie in depth first order.
     def traverse(trie_node):
+        if id(trie_node) in entries:  # Shared node, serialized already.
+            return entries[id(trie_node)]
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
+            entry = {'data': leaf_data(*trie_node['LEAF']), 'links': [], 'byte_offset': 0}
+            entries[id(trie_node)] = entry
             table.append(entry)
         elif len(trie_node) == 1:  # Handle trie node with a single child.
+            entries[id(trie_node)] = entry = {'byte_offset': 0}
             c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
+            entry['chars'] = c
 
             # It's common for a trie to have long chains of single-child nodes. We
             # find the whole chain so that we can serialize it more efficiently.
-            while len(trie_node) == 1 and 'LEAF' not in trie_node:
+            # Shared nodes start chains of their own, so that they can be linked to.
+            while len(trie_node) == 1 and 'LEAF' not in trie_node and parents[id(trie_node)] == 1:
                 c, trie_node = next(iter(trie_node.items()))
                 entry['chars'] += c
 
             table.append(entry)
+            entry['jump'] = id(trie_node) in entries
             entry['links'] = [traverse(trie_node)]
         else:  # Handle trie node with multiple children.
             entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
+            entries[id(trie_node)] = entry
             table.append(entry)
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
         return entry
@@ -216,7 +266,10 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
-            return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
+            chain = [TYPO_CHARS[c] for c in e['chars']]
+            if e['jump']:  # The next node isn't the one that follows.
+                return chain + [CHAIN_LINK] + encode_link(e['links'][0])
+            return chain + [0]
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
@@ -249,16 +302,30 @@ def to_hex(b: int) -> str:
     return f'0x{b:02X}'
 
 
+def binary_blob(autocorrections: List[Tuple[str, str]], data: List[int]) -> bytes:
+    """Packs the data with its header, as taken by autocorrect_dictionary_begin():
+  the minimum and maximum typo lengths, then the data size in little endian.
+  """
+    min_length = len(min(autocorrections, key=typo_len)[0])
+    max_length = len(max(autocorrections, key=typo_len)[0])
+    return bytes([min_length, max_length, len(data) & 255, len(data) >> 8] + data)
+
+
 @cli.argument('filename', type=normpath, help='The autocorrection database file')
 @cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-d', '--dawg', arg_only=True, action='store_true', help="Share identical suffixes of the trie, making the data smaller")
+@cli.argument('-b', '--binary', arg_only=True, type=normpath, help='Also write the data to this file, for loading into EEPROM at runtime')
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
     data = serialize_trie(autocorrections, trie)
+    trie_size = len(data)
+    if cli.args.dawg:
+        data = serialize_trie(autocorrections, make_dawg(trie))
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -279,6 +346,9 @@ def generate_autocorrect_data(cli):
         autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
 
     autocorrect_data_h_lines.append('')
+    if cli.args.dawg:
+        autocorrect_data_h_lines.append(f'// Encoded as a DAWG: {len(data)} bytes, against {trie_size} bytes as a trie.')
+        autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
@@ -289,3 +359,8 @@ def generate_autocorrect_data(cli):
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
+
+    if cli.args.binary:
+        cli.args.binary.write_bytes(binary_blob(autocorrections, data))
+        if not cli.args.quiet:
+            cli.log.info('Wrote %d bytes of autocorrection data to %s', len(data), cli.args.binary)
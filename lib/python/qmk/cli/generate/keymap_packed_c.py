@@ -0,0 +1,130 @@
+"""Used by the make system to generate a packed keymap from the compiled keymaps array.
+"""
+import struct
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+from qmk.info import info_json
+from qmk.commands import dump_lines
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.path import normpath, FileType
+from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+
+KC_NO = 0x0000
+KC_TRNS = 0x0001
+
+
+def _pack_keymap(keycodes, positions):
+    """Splits each layer into a bitmap of the entries it stores, and the stored keycodes in order.
+
+    Entries that aren't stored read back as KC_TRNS, or as KC_NO where that is more common across the layers, such as matrix positions without a key.
+    """
+    layers = len(keycodes) // positions
+    bitmap_bytes = (positions + 7) // 8
+
+    fill_no = [0] * bitmap_bytes
+    for position in range(positions):
+        column = keycodes[position::positions]
+        if column.count(KC_NO) > column.count(KC_TRNS):
+            fill_no[position // 8] |= 1 << (position % 8)
+
+    stored = []
+    rank = []
+    values = []
+    for layer in range(layers):
+        layer_stored = [0] * bitmap_bytes
+        layer_rank = [0] * bitmap_bytes
+        for position in range(positions):
+            if position % 8 == 0:
+                layer_rank[position // 8] = len(values)
+            keycode = keycodes[layer * positions + position]
+            fill = KC_NO if fill_no[position // 8] & (1 << (position % 8)) else KC_TRNS
+            if keycode != fill:
+                layer_stored[position // 8] |= 1 << (position % 8)
+                values.append(keycode)
+        stored.append(layer_stored)
+        rank.append(layer_rank)
+
+    if len(values) > 0xFFFF:
+        raise ValueError('Too many keycodes to pack')
+
+    return fill_no, stored, rank, values
+
+
+def _packed_size(positions, layers, value_count):
+    bitmap_bytes = (positions + 7) // 8
+    return bitmap_bytes * (1 + layers * 3) + value_count * 2
+
+
+def _format_array(values, fmt, per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt.format(v) for v in values[i:i + per_line]) + ',')
+    return lines
+
+
+def _generate_keymap_packed(keycodes, positions):
+    layers = len(keycodes) // positions
+    fill_no, stored, rank, values = _pack_keymap(keycodes, positions)
+
+    dense_size = len(keycodes) * 2
+    packed_size = _packed_size(positions, layers, len(values))
+
+    lines = ['#include "keymap_packed.h"', '#include "compiler_support.h"', '']
+    lines.append(f'// Packed keymap: {layers} layers, {len(values)} of {len(keycodes)} keycodes stored, {packed_size} bytes instead of {dense_size} (saves {dense_size - packed_size} bytes)')
+    lines.append('')
+    lines.append(f'STATIC_ASSERT(KEYMAP_PACKED_BITMAP_BYTES == {len(fill_no)}, "The packed keymap was generated for a different matrix size");')
+    lines.append('')
+
+    lines.append('const uint8_t PROGMEM keymap_packed_fill_no[KEYMAP_PACKED_BITMAP_BYTES] = {')
+    lines.extend(_format_array(fill_no, '0x{:02X}'))
+    lines.append('};')
+    lines.append('')
+
+    lines.append('const uint8_t PROGMEM keymap_packed_stored[][KEYMAP_PACKED_BITMAP_BYTES] = {')
+    for layer_stored in stored:
+        lines.append('    {')
+        lines.extend('    ' + line for line in _format_array(layer_stored, '0x{:02X}'))
+        lines.append('    },')
+    lines.append('};')
+    lines.append('')
+
+    lines.append('const uint16_t PROGMEM keymap_packed_rank[][KEYMAP_PACKED_BITMAP_BYTES] = {')
+    for layer_rank in rank:
+        lines.append('    {')
+        lines.extend('    ' + line for line in _format_array(layer_rank, '{}'))
+        lines.append('    },')
+    lines.append('};')
+    lines.append('')
+
+    lines.append('const uint16_t PROGMEM keymap_packed_values[] = {')
+    # An empty array isn't valid C, and a keymap of nothing but KC_TRNS is possible
+    lines.extend(_format_array(values or [KC_TRNS], '0x{:04X}', 8))
+    lines.append('};')
+
+    return lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate the packed keymap for.')
+@cli.argument('filename', type=FileType('rb'), arg_only=True, completer=FilesCompleter('.bin'), help='The keymaps array, as extracted from the compiled keymap')
+@cli.subcommand('Used by the make system to generate a packed keymap', hidden=True)
+def generate_keymap_packed_c(cli):
+    """Generates keymap_packed.c from the raw keymaps array.
+    """
+    kb_info_json = info_json(cli.args.keyboard)
+    positions = kb_info_json['matrix_size']['rows'] * kb_info_json['matrix_size']['cols']
+
+    data = cli.args.filename.read()
+    if len(data) == 0 or len(data) % (positions * 2) != 0:
+        cli.log.error(f'The extracted keymaps array is {len(data)} bytes, which is not a whole number of {positions} key layers.')
+        return False
+
+    keycodes = list(struct.unpack(f'<{len(data) // 2}H', data))
+
+    keymap_packed_c_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE]
+    keymap_packed_c_lines.extend(_generate_keymap_packed(keycodes, positions))
+
+    dump_lines(cli.args.output, keymap_packed_c_lines, cli.args.quiet)
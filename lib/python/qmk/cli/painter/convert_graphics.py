@@ -2,7 +2,7 @@
 """
 from io import BytesIO
 from qmk.path import normpath
-from qmk.painter import generate_subs, render_header, render_source, valid_formats
+from qmk.painter import generate_subs, render_header, render_source, valid_formats, pick_smallest_format, conversion_cache_key, read_conversion_cache, write_conversion_cache
 from milc import cli
 from PIL import Image
 
@@ -10,10 +10,13 @@ from PIL import Image
 @cli.argument('-v', '--verbose', arg_only=True, action='store_true', help='Turns on verbose output.')
 @cli.argument('-i', '--input', required=True, help='Specify input graphic file.')
 @cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
-@cli.argument('-f', '--format', required=True, help=f'Output format, valid types: {", ".join(valid_formats.keys())}')
+@cli.argument('-f', '--format', required=True, help=f'Output format, valid types: {", ".join(valid_formats.keys())}, or auto to pick the smallest lossless format')
 @cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disables the use of RLE when encoding images.')
 @cli.argument('-d', '--no-deltas', arg_only=True, action='store_true', help='Disables the use of delta frames when encoding animations.')
+@cli.argument('-m', '--no-multi-deltas', arg_only=True, action='store_true', help='Disables the use of multi-rectangle delta frames, keeping the output compatible with firmware only supporting QGF v1.')
 @cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QGF file as raw data instead of c/h combo.')
+@cli.argument('-j', '--parallel', type=int, default=0, help='Set the number of processes used to convert frames; 0 means one per CPU core.')
+@cli.argument('--no-cache', arg_only=True, action='store_true', help='Always convert the input, instead of reusing a previous conversion of identical input.')
 @cli.subcommand('Converts an input image to something QMK understands')
 def painter_convert_graphics(cli):
     """Converts an image file to a format that Quantum Painter understands.
@@ -35,6 +38,19 @@ def painter_convert_graphics(cli):
         cli.args.output = cli.args.input.parent
     cli.args.output = normpath(cli.args.output)
 
+    # Load the input image
+    input_img = Image.open(cli.args.input)
+
+    # Pick the smallest format which can represent the image, if requested
+    if cli.args.format == 'auto':
+        frames = []
+        for idx in range(getattr(input_img, 'n_frames', 1)):
+            input_img.seek(idx)
+            frames.append(input_img.copy())
+        input_img.seek(0)
+        cli.args.format = pick_smallest_format(frames)
+        cli.log.info('Using format %s', cli.args.format)
+
     # Ensure we have a valid format
     if cli.args.format not in valid_formats.keys():
         cli.log.error('Output format %s is invalid. Allowed values: %s' % (cli.args.format, ', '.join(valid_formats.keys())))
@@ -44,14 +60,18 @@ def painter_convert_graphics(cli):
     # Work out the encoding parameters
     format = valid_formats[cli.args.format]
 
-    # Load the input image
-    input_img = Image.open(cli.args.input)
-
-    # Convert the image to QGF using PIL
-    out_data = BytesIO()
-    metadata = []
-    input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata)
-    out_bytes = out_data.getvalue()
+    # Reuse the output of a previous conversion if nothing has changed
+    cache_key = conversion_cache_key(cli.args.input.read_bytes(), generator='qgf', format=cli.args.format, use_rle=(not cli.args.no_rle), use_deltas=(not cli.args.no_deltas), use_multi_deltas=(not cli.args.no_multi_deltas))
+    cached = None if cli.args.no_cache else read_conversion_cache(cache_key)
+    if cached is not None:
+        (out_bytes, metadata) = cached
+    else:
+        # Convert the image to QGF using PIL
+        out_data = BytesIO()
+        metadata = []
+        input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_multi_deltas=(not cli.args.no_multi_deltas), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata, jobs=cli.config.painter_convert_graphics.parallel)
+        out_bytes = out_data.getvalue()
+        write_conversion_cache(cache_key, out_bytes, metadata)
 
     if cli.args.raw:
         raw_file = cli.args.output / f"{cli.args.input.stem}.qgf"
@@ -4,7 +4,7 @@
 from io import BytesIO
 from qmk.path import normpath
 from qmk.painter_qff import _generate_font_glyphs_list, QFFFont
-from qmk.painter import generate_subs, render_header, render_source, valid_formats
+from qmk.painter import generate_subs, render_header, render_source, valid_formats, pick_smallest_format, conversion_cache_key, read_conversion_cache, write_conversion_cache
 from milc import cli
 
 
@@ -29,14 +29,13 @@ def painter_make_font_image(cli):
 @cli.argument('-o', '--output', default='', help='Specify output directory. Defaults to same directory as input.')
 @cli.argument('-n', '--no-ascii', arg_only=True, action='store_true', help='Disables output of the full ASCII character set (0x20..0x7E), exporting only the glyphs specified.')
 @cli.argument('-u', '--unicode-glyphs', default='', help='Also generate the specified unicode glyphs.')
-@cli.argument('-f', '--format', required=True, help=f'Output format, valid types: {", ".join(valid_formats.keys())}')
+@cli.argument('-f', '--format', required=True, help=f'Output format, valid types: {", ".join(valid_formats.keys())}, or auto to pick the smallest lossless format')
 @cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disable the use of RLE to minimise converted image size.')
 @cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QFF file as raw data instead of c/h combo.')
+@cli.argument('-j', '--parallel', type=int, default=0, help='Set the number of processes used to convert glyphs; 0 means one per CPU core.')
+@cli.argument('--no-cache', arg_only=True, action='store_true', help='Always convert the input, instead of reusing a previous conversion of identical input.')
 @cli.subcommand('Converts an input font image to something QMK firmware understands')
 def painter_convert_font_image(cli):
-    # Work out the format
-    format = valid_formats[cli.args.format]
-
     # Create the font object
     font = QFFFont(cli.log)
 
@@ -44,15 +43,35 @@ def painter_convert_font_image(cli):
     cli.args.input = normpath(cli.args.input)
     font.read_from_image(cli.args.input, include_ascii_glyphs=(not cli.args.no_ascii), unicode_glyphs=cli.args.unicode_glyphs)
 
+    # Pick the smallest format which can represent the glyphs (excluding the marker row), if requested
+    if cli.args.format == 'auto' and font.image is not None:
+        cli.args.format = pick_smallest_format([font.image.crop((0, 1, *font.image.size))])
+        cli.log.info('Using format %s', cli.args.format)
+
+    # Work out the format
+    if cli.args.format not in valid_formats.keys():
+        cli.log.error('Output format %s is invalid. Allowed values: %s' % (cli.args.format, ', '.join(valid_formats.keys())))
+        cli.print_usage()
+        return False
+    format = valid_formats[cli.args.format]
+
     # Work out the output directory
     if len(cli.args.output) == 0:
         cli.args.output = cli.args.input.parent
     cli.args.output = normpath(cli.args.output)
 
-    # Render out the data
-    out_data = BytesIO()
-    font.save_to_qff(format, not cli.args.no_rle, out_data)
-    out_bytes = out_data.getvalue()
+    # Reuse the output of a previous conversion if nothing has changed
+    cache_key = conversion_cache_key(cli.args.input.read_bytes(), generator='qff', format=cli.args.format, use_rle=(not cli.args.no_rle), use_ascii=(not cli.args.no_ascii), unicode_glyphs=cli.args.unicode_glyphs)
+    cached = None if cli.args.no_cache else read_conversion_cache(cache_key)
+    if cached is not None:
+        (out_bytes, _) = cached
+    else:
+        # Render out the data
+        out_data = BytesIO()
+        font.save_to_qff(format, not cli.args.no_rle, out_data, jobs=cli.config.painter_convert_font_image.parallel)
+        out_bytes = out_data.getvalue()
+        if out_bytes:
+            write_conversion_cache(cache_key, out_bytes, None)
 
     if cli.args.raw:
         raw_file = cli.args.output / f"{cli.args.input.stem}.qff"
@@ -1,12 +1,17 @@
 """Functions that help us work with Quantum Painter's file formats.
 """
 import datetime
+import hashlib
+import json
 import math
+import multiprocessing
 import re
 from pathlib import Path
 from string import Template
 from PIL import Image, ImageOps
 
+from qmk.constants import QMK_FIRMWARE, BUILD_DIR
+
 # The list of valid formats Quantum Painter supports
 valid_formats = {
     'rgb888': {
@@ -82,6 +87,13 @@ valid_formats = {
 }
 
 
+# Formats considered when picking the smallest lossless encoding, smallest first
+auto_format_candidates = ['mono2', 'pal2', 'mono4', 'pal4', 'mono16', 'pal16', 'mono256', 'pal256', 'rgb565']
+
+# Location of previously-converted outputs, keyed by a hash of the inputs
+conversion_cache_dir = QMK_FIRMWARE / BUILD_DIR / 'painter_cache'
+
+
 def _render_text(values):
     # FIXME: May need more chars with GIFs containing lots of frames (or longer durations)
     return "|".join([f"{i:4d}" for i in values])
@@ -122,14 +134,12 @@ def _render_image_metadata(metadata):
             if not v["delta"]:
                 continue
 
-            # Unpack rect's coords
-            l, t, r, b = v["delta_rect"]
-
-            delta_px = (r - l) * (b - t)
             px = size["width"] * size["height"]
+            for l, t, r, b in v["delta_rects"]:
+                delta_px = (r - l) * (b - t)
 
-            # FIXME: May need need more chars here too
-            deltas.append(f"// Frame {i:3d}: ({l:3d}, {t:3d}) - ({r:3d}, {b:3d}) >> {delta_px:4d}/{px:4d} pixels ({100*delta_px/px:.2f}%)")
+                # FIXME: May need need more chars here too
+                deltas.append(f"// Frame {i:3d}: ({l:3d}, {t:3d}) - ({r:3d}, {b:3d}) >> {delta_px:4d}/{px:4d} pixels ({100*delta_px/px:.2f}%)")
 
         if deltas:
             lines.append("// Areas on delta frames")
@@ -365,6 +375,8 @@ def convert_image_bytes(im, format):
         # Export the palette
         palette = []
         pal = im.getpalette()
+        # Newer versions of PIL only return the palette entries in use, so pad it out to the expected size
+        pal = pal + [0] * (ncolors * 3 - len(pal))
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
@@ -454,3 +466,93 @@ def compress_bytes_qmk_rle(bytearray):
                 temp = []
                 repeat = False
     return output
+
+
+def _is_lossless_mono(colors, num_colors):
+    """Works out if the supplied colors are all grays that survive rescaling to the given number of levels.
+    """
+    for (r, g, b) in colors:
+        if r != g or g != b:
+            return False
+        if round(rescale_byte(r, num_colors - 1) * 255.0 / (num_colors - 1)) != r:
+            return False
+    return True
+
+
+def pick_smallest_format(images):
+    """Picks the smallest format able to represent all the supplied images without losing any colors.
+
+    Grayscale formats are preferred over palette formats of the same depth, as they don't need a palette stored
+    alongside the image data. Images with more than 256 colors fall back to RGB565.
+    """
+    colors = set()
+    for im in images:
+        im_colors = im.convert("RGB").getcolors(maxcolors=256)
+        if im_colors is None:
+            return 'rgb565'
+        colors.update(c for _, c in im_colors)
+        if len(colors) > 256:
+            return 'rgb565'
+
+    for name in auto_format_candidates:
+        fmt = valid_formats[name]
+        if fmt['image_format'] == 'IMAGE_FORMAT_GRAYSCALE':
+            if _is_lossless_mono(colors, fmt['num_colors']):
+                return name
+        elif len(colors) <= fmt['num_colors']:
+            return name
+
+    return 'rgb565'
+
+
+def painter_map(func, items, jobs=1):
+    """Runs `map()` over the supplied items, across `jobs` worker processes if requested.
+
+    Unlike `qmk.util.parallel_map()`, results are returned in the same order as the input, so converters produce
+    identical output regardless of the number of jobs. A `jobs` value of 0 uses one process per CPU core.
+    """
+    items = list(items)
+    if jobs == 0:
+        jobs = multiprocessing.cpu_count()
+    jobs = min(jobs, len(items))
+
+    if jobs <= 1:
+        return list(map(func, items))
+
+    with multiprocessing.Pool(jobs) as pool:
+        return pool.map(func, items, chunksize=max(1, len(items) // (jobs * 4)))
+
+
+def conversion_cache_key(input_bytes, **params):
+    """Generates a key for the conversion cache from the input data and the conversion parameters.
+
+    The converter sources are included in the hash, so that any change to the conversion process invalidates the cache.
+    """
+    h = hashlib.sha256()
+    for src in sorted(Path(__file__).parent.glob('painter*.py')):
+        h.update(src.read_bytes())
+    h.update(json.dumps(params, sort_keys=True).encode('utf-8'))
+    h.update(input_bytes)
+    return h.hexdigest()
+
+
+def read_conversion_cache(key):
+    """Returns the `(out_bytes, metadata)` previously stored for this key, or `None` if there's no cached entry.
+    """
+    data_file = conversion_cache_dir / f'{key}.bin'
+    metadata_file = conversion_cache_dir / f'{key}.json'
+    if not data_file.exists() or not metadata_file.exists():
+        return None
+
+    try:
+        return (data_file.read_bytes(), json.loads(metadata_file.read_text()))
+    except (OSError, ValueError):
+        return None
+
+
+def write_conversion_cache(key, out_bytes, metadata):
+    """Stores the converted output and metadata for this key.
+    """
+    conversion_cache_dir.mkdir(parents=True, exist_ok=True)
+    (conversion_cache_dir / f'{key}.bin').write_bytes(out_bytes)
+    (conversion_cache_dir / f'{key}.json').write_text(json.dumps(metadata))
@@ -4,6 +4,7 @@
 # Quantum Font File "QFF" Font File Format.
 # See https://docs.qmk.fm/#/quantum_painter_qff for more information.
 
+import functools
 from pathlib import Path
 from typing import Dict, Any
 from colorsys import rgb_to_hsv
@@ -177,6 +178,13 @@ def _generate_font_glyphs_list(use_ascii, unicode_glyphs):
     return sorted(glyphs.keys())
 
 
+def _convert_glyph(glyph_img, format):
+    # Worker entrypoint for converting glyphs in parallel
+    this_glyph_image_bytes = qmk.painter.convert_image_bytes(glyph_img, format)[1]
+    this_glyph_rle_bytes = qmk.painter.compress_bytes_qmk_rle(this_glyph_image_bytes)
+    return (this_glyph_image_bytes, this_glyph_rle_bytes)
+
+
 class QFFFont:
     def __init__(self, logger):
         self.logger = logger
@@ -185,18 +193,19 @@ class QFFFont:
         self.glyph_height = 0
         return
 
-    def _extract_glyphs(self, format):
+    def _extract_glyphs(self, format, jobs=1):
         total_data_size = 0
         total_rle_data_size = 0
 
         converted_img = qmk.painter.convert_requested_format(self.image, format)
         (self.palette, _) = qmk.painter.convert_image_bytes(converted_img, format)
 
+        # Convert each glyph, spreading the work across `jobs` worker processes if requested
+        glyph_imgs = [converted_img.crop((glyph_entry.x, 1, glyph_entry.x + glyph_entry.w, 1 + self.glyph_height)) for glyph_entry in self.glyph_data.values()]
+        glyph_bytes = qmk.painter.painter_map(functools.partial(_convert_glyph, format=format), glyph_imgs, jobs)
+
         # Work out how many bytes used for RLE vs. non-RLE
-        for _, glyph_entry in self.glyph_data.items():
-            glyph_img = converted_img.crop((glyph_entry.x, 1, glyph_entry.x + glyph_entry.w, 1 + self.glyph_height))
-            (_, this_glyph_image_bytes) = qmk.painter.convert_image_bytes(glyph_img, format)
-            this_glyph_rle_bytes = qmk.painter.compress_bytes_qmk_rle(this_glyph_image_bytes)
+        for glyph_entry, (this_glyph_image_bytes, this_glyph_rle_bytes) in zip(self.glyph_data.values(), glyph_bytes):
             total_data_size += len(this_glyph_image_bytes)
             total_rle_data_size += len(this_glyph_rle_bytes)
             glyph_entry['image_uncompressed_bytes'] = this_glyph_image_bytes
@@ -325,14 +334,14 @@ class QFFFont:
         self._parse_image(Image.open(str(img_file)), include_ascii_glyphs, unicode_glyphs)
         return
 
-    def save_to_qff(self, format: Dict[str, Any], use_rle: bool, fp):
+    def save_to_qff(self, format: Dict[str, Any], use_rle: bool, fp, jobs: int = 1):
         # Drop out if there's no image loaded
         if self.image is None:
             self.logger.error('No image is loaded.')
             return
 
         # Work out if we want to use RLE at all, skipping it if it's not any smaller (it's applied per-glyph)
-        (total_data_size, total_rle_data_size) = self._extract_glyphs(format)
+        (total_data_size, total_rle_data_size) = self._extract_glyphs(format, jobs)
         if use_rle:
             use_rle = (total_rle_data_size < total_data_size)
 
@@ -147,6 +147,17 @@ class QGFFrameDescriptorV1:
         else:
             self.flags &= ~0x02
 
+    @property
+    def is_multi_delta(self):
+        return (self.flags & 0x04) == 0x04
+
+    @is_multi_delta.setter
+    def is_multi_delta(self, val):
+        if val:
+            self.flags |= 0x04
+        else:
+            self.flags &= ~0x04
+
 
 ########################################################################################################################
 
@@ -208,6 +219,37 @@ class QGFFrameDeltaDescriptorV1:
 ########################################################################################################################
 
 
+class QGFFrameMultiDeltaDescriptorV2:
+    type_id = 0x06
+    max_rects = 8  # See qgf.h, QGF_MAX_DELTA_RECTS
+
+    def __init__(self):
+        self.header = QGFBlockHeader()
+        self.header.type_id = QGFFrameMultiDeltaDescriptorV2.type_id
+        self.rects = []
+
+    @staticmethod
+    def length_for(rect_count):
+        return 1 + rect_count * 8
+
+    def write(self, fp):
+        self.header.length = QGFFrameMultiDeltaDescriptorV2.length_for(len(self.rects))
+        self.header.write(fp)
+        fp.write(b''  # start off with empty bytes...
+                 + o8(len(self.rects))  # rect count
+                 )
+        for left, top, right, bottom in self.rects:
+            fp.write(b''  # start off with empty bytes...
+                     + o16(left)  # left
+                     + o16(top)  # top
+                     + o16(right)  # right
+                     + o16(bottom)  # bottom
+                     )
+
+
+########################################################################################################################
+
+
 class QGFFrameDataDescriptorV1:
     type_id = 0x05
 
@@ -260,13 +302,110 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
+# Approximate cost of each additional delta rectangle, in pixels -- accounts for the extra viewport command sent to the
+# display and the rectangle's entry in the multi-delta descriptor
+DELTA_RECT_COST_PIXELS = 16
+
+# Granularity used when searching for separate changed regions
+DELTA_CELL_SIZE = 8
+
+# Past this many separate changed regions the frame is treated as noise, and a single rectangle is used instead
+DELTA_MAX_REGIONS = 64
+
+
+def _rect_area(rect):
+    return (rect[2] - rect[0]) * (rect[3] - rect[1])
+
+
+def _rect_union(a, b):
+    return (min(a[0], b[0]), min(a[1], b[1]), max(a[2], b[2]), max(a[3], b[3]))
+
+
+def _find_delta_rects(diff):
+    """Works out the set of rectangles covering all the changed pixels in `diff` which minimises the number of pixels
+    sent to the display, taking into account the overhead of each rectangle.
+
+    Returns a list of (left, top, right, bottom) tuples in PIL (exclusive) coordinates, at most
+    `QGFFrameMultiDeltaDescriptorV2.max_rects` long.
+    """
+    # Any change in any channel marks the pixel as changed
+    r, g, b = diff.split()
+    mask = ImageChops.lighter(ImageChops.lighter(r, g), b).point(lambda v: 255 if v else 0)
+
+    # Find the cells containing changes, and group touching cells into regions
+    cells = mask.reduce(DELTA_CELL_SIZE)
+    cells_w, cells_h = cells.size
+    changed = cells.load()
+    seen = set()
+    regions = []
+    for cy in range(cells_h):
+        for cx in range(cells_w):
+            if not changed[cx, cy] or (cx, cy) in seen:
+                continue
+            seen.add((cx, cy))
+            pending = [(cx, cy)]
+            l, t, r, b = cx, cy, cx, cy
+            while pending:
+                px, py = pending.pop()
+                l, t, r, b = min(l, px), min(t, py), max(r, px), max(b, py)
+                for nx in range(max(px - 1, 0), min(px + 2, cells_w)):
+                    for ny in range(max(py - 1, 0), min(py + 2, cells_h)):
+                        if changed[nx, ny] and (nx, ny) not in seen:
+                            seen.add((nx, ny))
+                            pending.append((nx, ny))
+            regions.append((l * DELTA_CELL_SIZE, t * DELTA_CELL_SIZE, min((r + 1) * DELTA_CELL_SIZE, mask.width), min((b + 1) * DELTA_CELL_SIZE, mask.height)))
+            if len(regions) > DELTA_MAX_REGIONS:
+                return [mask.getbbox()]
+
+    # Shrink each region down to the changed pixels it contains
+    rects = []
+    for region in regions:
+        l, t, r, b = mask.crop(region).getbbox()
+        rects.append((region[0] + l, region[1] + t, region[0] + r, region[1] + b))
+
+    # Greedily merge whichever pair of rectangles saves the most, until no merge saves anything and the rectangle count
+    # fits in the descriptor
+    def cost(rect):
+        return _rect_area(rect) + DELTA_RECT_COST_PIXELS
+
+    while len(rects) > 1:
+        best = None
+        for i in range(len(rects)):
+            for j in range(i + 1, len(rects)):
+                merged = _rect_union(rects[i], rects[j])
+                saving = cost(rects[i]) + cost(rects[j]) - cost(merged)
+                if best is None or saving > best[0]:
+                    best = (saving, i, j, merged)
+        saving, i, j, merged = best
+        if saving < 0 and len(rects) <= QGFFrameMultiDeltaDescriptorV2.max_rects:
+            break
+        rects = [rect for n, rect in enumerate(rects) if n not in (i, j)] + [merged]
+
+    # Keep a stable, top-to-bottom ordering
+    return sorted(rects, key=lambda rect: (rect[1], rect[0]))
+
+
+def _compress_rects(converted, origin, rects, *, use_rle, format_):
+    # Each rectangle is encoded separately, so that each one starts on a byte (and RLE) boundary
+    raw_data = []
+    rle_data = []
+    for l, t, r, b in rects:
+        rect_data = qmk.painter.convert_image_bytes(converted.crop((l - origin[0], t - origin[1], r - origin[0], b - origin[1])), format_)[1]
+        raw_data.extend(rect_data)
+        if use_rle:
+            rle_data.extend(qmk.painter.compress_bytes_qmk_rle(rect_data))
+    use_raw = not use_rle or len(raw_data) <= len(rle_data)
+    return raw_data if use_raw else rle_data, use_raw
+
+
+def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, use_multi_deltas=True, **_kwargs):
     # Convert the original frame so we can do comparisons
     converted = qmk.painter.convert_requested_format(frame, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
 
     # Convert the raw data to RLE-encoded if requested
     raw_data = graphic_data[1]
+    rle_data = None
     if use_rle:
         rle_data = qmk.painter.compress_bytes_qmk_rle(graphic_data[1])
     use_raw_this_frame = not use_rle or len(raw_data) <= len(rle_data)
@@ -274,7 +413,10 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
 
     # Work out if a delta frame is smaller than injecting it directly
     use_delta_this_frame = False
+    use_multi_delta_this_frame = False
+    full_frame_size = len(image_data)
     bbox = None
+    rects = None
     if use_deltas and last_frame is not None:
         # If we want to use deltas, then find the difference
         diff = ImageChops.difference(frame, last_frame)
@@ -293,6 +435,7 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
 
             # Work out how large the delta frame is going to be with compression etc.
             delta_raw_data = delta_graphic_data[1]
+            delta_rle_data = None
             if use_rle:
                 delta_rle_data = qmk.painter.compress_bytes_qmk_rle(delta_graphic_data[1])
             delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
@@ -310,6 +453,23 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
                 image_data = delta_image_data
                 use_delta_this_frame = True
 
+            # If the changes are spread out, several smaller rectangles may need fewer pixels sent to the display than
+            # the single bounding box. All rectangles are cut from the same converted delta frame so they share its
+            # palette.
+            if use_multi_deltas:
+                candidate_rects = _find_delta_rects(diff)
+                if len(candidate_rects) > 1 and sum(map(_rect_area, candidate_rects)) < _rect_area(bbox):
+                    multi_image_data, multi_use_raw = _compress_rects(delta_converted, bbox, candidate_rects, use_rle=use_rle, format_=format_)
+
+                    # Same flash size constraint as for single-rectangle deltas
+                    if (len(multi_image_data) + QGFFrameMultiDeltaDescriptorV2.length_for(len(candidate_rects))) < full_frame_size:
+                        graphic_data = delta_graphic_data
+                        use_raw_this_frame = multi_use_raw
+                        image_data = multi_image_data
+                        use_delta_this_frame = False
+                        use_multi_delta_this_frame = True
+                        rects = [[l, t, r - 1, b - 1] for l, t, r, b in candidate_rects]
+
         # Default to whole image
         bbox = bbox or [0, 0, *frame.size]
         # Fix sze (as per #20296), we need to cast first as tuples are inmutable
@@ -319,25 +479,30 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
 
     return {
         "bbox": bbox,
+        "rects": rects,
         "graphic_data": graphic_data,
         "image_data": image_data,
         "use_delta_this_frame": use_delta_this_frame,
+        "use_multi_delta_this_frame": use_multi_delta_this_frame,
         "use_raw_this_frame": use_raw_this_frame,
     }
 
 
-# Helper function to save each frame to the output file
-def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwargs):
-    # Not an argument of the function as it would then not be part of kwargs
-    # This would cause an issue with `_compress_image(**kwargs)` missing an argument
-    format_ = kwargs["format_"]
+def _compress_frame_pair(frames, **kwargs):
+    # Worker entrypoint for compressing frames in parallel, as `map()` only passes a single argument
+    frame, last_frame = frames
+    return _compress_image(frame, last_frame, **kwargs)
 
-    # (potentially) Apply RLE and/or delta, and work out output image's information
-    outputs = _compress_image(frame, last_frame, **kwargs)
+
+# Helper function to save each frame to the output file
+def _write_frame(idx, frame, outputs, *, fp, frame_offsets, metadata, format_):
+    # Unpack the already-compressed frame's information
     bbox = outputs["bbox"]
+    rects = outputs["rects"]
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
     use_delta_this_frame = outputs["use_delta_this_frame"]
+    use_multi_delta_this_frame = outputs["use_multi_delta_this_frame"]
     use_raw_this_frame = outputs["use_raw_this_frame"]
 
     # Write out the frame descriptor
@@ -345,6 +510,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
     vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_descriptor = QGFFrameDescriptorV1()
     frame_descriptor.is_delta = use_delta_this_frame
+    frame_descriptor.is_multi_delta = use_multi_delta_this_frame
     frame_descriptor.is_transparent = False
     frame_descriptor.format = format_['image_format_byte']
     frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
@@ -371,19 +537,30 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
         vprint(f'{f"Frame {idx:3d} delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
         delta_descriptor.write(fp)
 
+    # Write out the multi-rectangle delta info if required
+    if use_multi_delta_this_frame:
+        multi_delta_descriptor = QGFFrameMultiDeltaDescriptorV2()
+        multi_delta_descriptor.rects = rects
+
+        # Write the rectangles to the output
+        vprint(f'{f"Frame {idx:3d} multi-delta":26s} {fp.tell():5d}d / {fp.tell():04X}h')
+        multi_delta_descriptor.write(fp)
+
     # Store metadata, showed later in a comment in the generated file
     frame_metadata = {
         "compression": frame_descriptor.compression,
-        "delta": frame_descriptor.is_delta,
+        "delta": frame_descriptor.is_delta or frame_descriptor.is_multi_delta,
         "delay": frame_descriptor.delay,
     }
-    if frame_metadata["delta"]:
-        frame_metadata.update({"delta_rect": [
+    if frame_descriptor.is_delta:
+        frame_metadata.update({"delta_rects": [[
             delta_descriptor.left,
             delta_descriptor.top,
             delta_descriptor.right,
             delta_descriptor.bottom,
-        ]})
+        ]]})
+    elif frame_descriptor.is_multi_delta:
+        frame_metadata.update({"delta_rects": multi_delta_descriptor.rects})
     metadata.append(frame_metadata)
 
     # Write out the data for this frame to the output
@@ -412,9 +589,10 @@ def _save(im, fp, _filename):
     append_images = list(encoderinfo.get("append_images", []))
     for_all_frames = functools.partial(_for_all_frames, images=[im, *append_images])
 
-    # Collect all the frame sizes
-    frame_sizes = []
-    for_all_frames(lambda _idx, frame, _last_frame: frame_sizes.append(frame.size))
+    # Collect all the frames up-front, so that they can be compressed independently of each other
+    frames = []
+    for_all_frames(lambda _idx, frame, _last_frame: frames.append(frame))
+    frame_sizes = [frame.size for frame in frames]
 
     # Make sure all frames are the same size
     if len(set(frame_sizes)) != 1:
@@ -436,9 +614,18 @@ def _save(im, fp, _filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
+    # Compress each of the input frames against its predecessor -- this is the expensive part, so it's spread across
+    # `jobs` worker processes if requested. Results come back in frame order, so the output is the same either way.
+    compress_frame = functools.partial(_compress_frame_pair, format_=encoderinfo["qmk_format"], use_deltas=encoderinfo.get("use_deltas", True), use_multi_deltas=encoderinfo.get("use_multi_deltas", True), use_rle=encoderinfo.get("use_rle", True))
+    compressed = qmk.painter.painter_map(compress_frame, zip(frames, [None, *frames[:-1]]), encoderinfo.get("jobs", 1))
+
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
-    for_all_frames(write_frame)
+    for idx, (frame, outputs) in enumerate(zip(frames, compressed)):
+        _write_frame(idx, frame, outputs, format_=encoderinfo["qmk_format"], fp=fp, frame_offsets=frame_offsets, metadata=metadata)
+
+    # Multi-rectangle delta frames need QGF v2, everything else stays readable by older firmware
+    if any(outputs["use_multi_delta_this_frame"] for outputs in compressed):
+        graphics_descriptor.version = 2
 
     # Go back and update the graphics descriptor now that we can determine the final file size
     graphics_descriptor.total_file_size = fp.tell()
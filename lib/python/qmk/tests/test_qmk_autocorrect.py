@@ -0,0 +1,96 @@
+import re
+
+from qmk.cli.generate.autocorrect_data import CHAIN_LINK, TYPO_CHARS, leaf_data, make_dawg, make_trie, serialize_trie
+from qmk.constants import QMK_FIRMWARE
+
+# Nodes are linked by 16-bit offsets, in both encodings
+MAX_DATA_SIZE = 0x10000
+
+
+def _make_corpus():
+    """Makes a corpus of transposition typos, from the words used in the docs.
+
+    Typos are made by swapping the two letters in the middle of each word, and skipped when they are words themselves, or substrings of one another.
+    """
+    words = set()
+    for path in sorted((QMK_FIRMWARE / 'docs').rglob('*.md')):
+        words |= set(re.findall(r'\b[a-z]{6,}\b', path.read_text(encoding='utf-8', errors='ignore')))
+
+    corpus = []
+    typos = set()
+    substrings = set()
+    for word in sorted(words):
+        i = len(word) // 2 - 1
+        typo = word[:i] + word[i + 1] + word[i] + word[i + 2:]
+        if typo == word or typo in words or typo in substrings:
+            continue
+        parts = {typo[a:b] for a in range(len(typo)) for b in range(a + 1, len(typo) + 1)}
+        if parts & typos:
+            continue
+        corpus.append((typo, word))
+        typos.add(typo)
+        substrings |= parts
+
+    return corpus
+
+
+def _lookup(data, typo):
+    """Walks the data the way process_autocorrect() does, after `typo` is typed following a space.
+
+    Returns the leaf data found, if any, and the number of bytes read.
+    """
+    keys = [TYPO_CHARS[':']] + [TYPO_CHARS[c] for c in typo.lstrip(':')]
+    state = 0
+    code = data[state]
+    reads = 1
+    for key in reversed(keys):
+        if code & 64:
+            code &= 63
+            while code != key:
+                if not code:
+                    return None, reads
+                state += 3
+                code = data[state]
+                reads += 1
+            state = data[state + 1] | data[state + 2] << 8
+            reads += 2
+        elif code != key:
+            return None, reads
+        else:
+            state += 1
+            code = data[state]
+            reads += 1
+            if not code:
+                state += 1
+            elif code == CHAIN_LINK:
+                state = data[state + 1] | data[state + 2] << 8
+                reads += 2
+
+        code = data[state]
+        reads += 1
+        if code & 128:
+            end = data.index(0, state + 1)
+            return data[state:end + 1], reads + end - state
+
+    return None, reads
+
+
+def test_autocorrect_dawg_benchmark():
+    corpus = _make_corpus()
+    assert len(corpus) >= 3000
+
+    for count in (500, 1000, 2000, 3000):
+        autocorrections = corpus[:count]
+        trie = serialize_trie(autocorrections, make_trie(autocorrections))
+        dawg = serialize_trie(autocorrections, make_dawg(make_trie(autocorrections)))
+        assert len(dawg) <= len(trie) < MAX_DATA_SIZE
+
+        reads = {}
+        for name, data in (('trie', trie), ('dawg', dawg)):
+            reads[name] = 0
+            for typo, correction in autocorrections:
+                leaf, n = _lookup(data, typo)
+                assert leaf == leaf_data(typo, correction)
+                reads[name] += n
+
+        print(f'{count} entries: trie {len(trie)} bytes, {reads["trie"] / count:.1f} reads per lookup; dawg {len(dawg)} bytes, {reads["dawg"] / count:.1f} reads per lookup')
@@ -0,0 +1,80 @@
+import random
+import re
+
+from qmk.cli.generate.keymap_packed_c import KC_NO, KC_TRNS, _generate_keymap_packed, _pack_keymap
+
+
+def _make_keymap(layers=6, positions=61, seed=1):
+    """Makes a keymap that mixes keycodes with runs of KC_TRNS, and has a few matrix positions without a key on any layer.
+    """
+    rng = random.Random(seed)
+    missing = set(rng.sample(range(positions), 5))
+    keycodes = []
+    for layer in range(layers):
+        for position in range(positions):
+            if position in missing:
+                keycodes.append(KC_NO)
+            elif layer > 0 and rng.random() < 0.7:
+                keycodes.append(KC_TRNS)
+            else:
+                keycodes.append(rng.choice([KC_NO, 0x0004, 0x0029, 0x5220, 0x7E00, 0xFFFF]))
+    return keycodes
+
+
+def _lookup(fill_no, stored, rank, values, layer, position):
+    """Reads a keycode back the same way as keymap_packed_keycode().
+    """
+    index = position // 8
+    mask = 1 << (position % 8)
+    if stored[layer][index] & mask:
+        return values[rank[layer][index] + bin(stored[layer][index] & (mask - 1)).count('1')]
+    return KC_NO if fill_no[index] & mask else KC_TRNS
+
+
+def _parse_array(lines, name):
+    """Returns the numbers in a generated C array, flattened.
+    """
+    text = '\n'.join(lines)
+    body = re.search(name + r'\[[^=]*= \{(.*?)\n\};', text, re.S).group(1)
+    return [int(number, 0) for number in re.findall(r'0x[0-9A-F]+|\d+', body)]
+
+
+def test_pack_keymap_round_trip():
+    positions = 61
+    keycodes = _make_keymap(positions=positions)
+    fill_no, stored, rank, values = _pack_keymap(keycodes, positions)
+
+    for i, keycode in enumerate(keycodes):
+        assert _lookup(fill_no, stored, rank, values, i // positions, i % positions) == keycode
+
+    # Only keycodes that differ from their position's fill are stored
+    assert len(values) < len(keycodes) - keycodes.count(KC_TRNS)
+
+
+def test_generate_keymap_packed_round_trip():
+    positions = 61
+    keycodes = _make_keymap(positions=positions)
+    layers = len(keycodes) // positions
+    bitmap_bytes = (positions + 7) // 8
+    lines = _generate_keymap_packed(keycodes, positions)
+
+    fill_no = _parse_array(lines, 'keymap_packed_fill_no')
+    stored = _parse_array(lines, 'keymap_packed_stored')
+    rank = _parse_array(lines, 'keymap_packed_rank')
+    values = _parse_array(lines, 'keymap_packed_values')
+    assert len(fill_no) == bitmap_bytes
+    assert len(stored) == len(rank) == layers * bitmap_bytes
+
+    stored = [stored[i:i + bitmap_bytes] for i in range(0, len(stored), bitmap_bytes)]
+    rank = [rank[i:i + bitmap_bytes] for i in range(0, len(rank), bitmap_bytes)]
+    for i, keycode in enumerate(keycodes):
+        assert _lookup(fill_no, stored, rank, values, i // positions, i % positions) == keycode
+
+
+def test_generate_keymap_packed_all_transparent():
+    positions = 16
+    lines = _generate_keymap_packed([KC_TRNS] * positions * 2, positions)
+
+    # Nothing is stored, but the values array still has to be valid C
+    assert _parse_array(lines, 'keymap_packed_stored') == [0] * 4
+    assert _parse_array(lines, 'keymap_packed_values') == [KC_TRNS]
@@ -0,0 +1,154 @@
+from io import BytesIO
+
+from PIL import Image, ImageChops, ImageDraw
+
+import qmk.painter
+import qmk.painter_qgf  # noqa: F401 -- registers the QGF format with PIL
+from qmk.painter_qff import QFFFont
+
+
+class _NullLogger:
+    def error(self, *args, **kwargs):
+        raise AssertionError(args)
+
+
+def _make_animation(frame_count=8, size=(64, 48)):
+    """Generates an animation with a moving shape, so that delta frames and RLE both get exercised.
+    """
+    frames = []
+    for n in range(frame_count):
+        im = Image.new('RGB', size, (0, 0, 0))
+        draw = ImageDraw.Draw(im)
+        draw.rectangle((4 + n * 3, 4, 20 + n * 3, 20), fill=(255, 0, 0))
+        draw.ellipse((30, 10 + n, 50, 30 + n), fill=(0, 0, 255))
+        draw.line((0, size[1] - 1, n * 8, 0), fill=(0, 255, 0))
+        im.info['duration'] = 50 + n
+        frames.append(im)
+    return frames
+
+
+def _convert_animation(frames, format_name, jobs, **kwargs):
+    out = BytesIO()
+    metadata = []
+    frames[0].save(out, 'QGF', append_images=frames[1:], qmk_format=qmk.painter.valid_formats[format_name], metadata=metadata, jobs=jobs, **kwargs)
+    return out.getvalue(), metadata
+
+
+def _make_font_image(glyph_count=95, glyph_height=10):
+    """Generates a font image in the layout produced by `qmk painter-make-font-image`, with a marker row on top.
+    """
+    widths = [3 + (n % 5) for n in range(glyph_count)]
+    im = Image.new('RGB', (sum(widths), glyph_height + 1), (0, 0, 0))
+    draw = ImageDraw.Draw(im)
+    x = 0
+    for n, w in enumerate(widths):
+        im.putpixel((x, 0), (255, 0, 255))
+        draw.rectangle((x, 1 + (n % glyph_height), x + w - 2, glyph_height), fill=(255, 255, 255) if n % 3 else (128, 128, 128))
+        x += w
+    return im
+
+
+def _convert_font(im, format_name, jobs):
+    font = QFFFont(_NullLogger())
+    font._parse_image(im)
+    out = BytesIO()
+    font.save_to_qff(qmk.painter.valid_formats[format_name], True, out, jobs=jobs)
+    return out.getvalue()
+
+
+def test_parallel_qgf_matches_serial():
+    frames = _make_animation()
+    for format_name in ['pal16', 'mono4', 'rgb565']:
+        serial = _convert_animation(frames, format_name, 1)
+        parallel = _convert_animation(frames, format_name, 4)
+        assert len(serial[0]) > 0
+        assert serial == parallel
+
+
+def test_parallel_qgf_matches_serial_without_rle():
+    frames = _make_animation()
+    assert _convert_animation(frames, 'pal4', 1, use_rle=False) == _convert_animation(frames, 'pal4', 4, use_rle=False)
+
+
+def test_parallel_qff_matches_serial():
+    im = _make_font_image()
+    for format_name in ['mono2', 'mono16', 'pal4']:
+        serial = _convert_font(im, format_name, 1)
+        parallel = _convert_font(im, format_name, 4)
+        assert len(serial) > 0
+        assert serial == parallel
+
+
+def test_multi_delta_rects():
+    base = Image.new('RGB', (64, 32), (0, 0, 0))
+    changed = base.copy()
+    draw = ImageDraw.Draw(changed)
+    draw.rectangle((2, 2, 5, 5), fill=(255, 255, 255))
+    draw.rectangle((56, 24, 61, 29), fill=(255, 255, 255))
+
+    # Distant changes get their own rectangles...
+    rects = qmk.painter_qgf._find_delta_rects(ImageChops.difference(changed, base))
+    assert rects == [(2, 2, 6, 6), (56, 24, 62, 30)]
+
+    # ...nearby ones are cheaper to send as one
+    draw.rectangle((7, 2, 8, 5), fill=(255, 255, 255))
+    rects = qmk.painter_qgf._find_delta_rects(ImageChops.difference(changed, base))
+    assert rects[0] == (2, 2, 9, 6)
+
+    # No more rectangles than the firmware can handle
+    noisy = base.copy()
+    for n in range(12):
+        noisy.putpixel((n * 5, (n * 7) % 32), (255, 255, 255))
+    rects = qmk.painter_qgf._find_delta_rects(ImageChops.difference(noisy, base))
+    assert 1 <= len(rects) <= qmk.painter_qgf.QGFFrameMultiDeltaDescriptorV2.max_rects
+
+
+def test_multi_delta_qgf_version():
+    base = Image.new('RGB', (64, 32), (0, 0, 0))
+    changed = base.copy()
+    draw = ImageDraw.Draw(changed)
+    draw.rectangle((2, 2, 5, 5), fill=(255, 255, 255))
+    draw.rectangle((56, 24, 61, 29), fill=(255, 255, 255))
+
+    # Byte 8 is the graphics descriptor's version
+    multi, metadata = _convert_animation([base, changed], 'mono2', 1)
+    assert multi[8] == 2
+    assert metadata[2]['delta_rects'] == [[2, 2, 5, 5], [56, 24, 61, 29]]
+
+    single, metadata = _convert_animation([base, changed], 'mono2', 1, use_multi_deltas=False)
+    assert single[8] == 1
+    assert len(metadata[2].get('delta_rects', [])) <= 1
+
+
+def test_pick_smallest_format():
+    two_color = Image.new('RGB', (8, 8), (0, 0, 0))
+    two_color.putpixel((1, 1), (255, 255, 255))
+    assert qmk.painter.pick_smallest_format([two_color]) == 'mono2'
+
+    two_color.putpixel((2, 2), (255, 0, 0))
+    assert qmk.painter.pick_smallest_format([two_color]) == 'pal4'
+
+    # Colors across all frames are taken into account
+    frames = _make_animation()
+    assert qmk.painter.pick_smallest_format(frames) == 'pal4'
+
+    gradient = Image.new('RGB', (256, 2))
+    for x in range(256):
+        gradient.putpixel((x, 0), (x, x, x))
+        gradient.putpixel((x, 1), (x, 0, 255 - x))
+    assert qmk.painter.pick_smallest_format([gradient]) == 'rgb565'
+
+
+def test_conversion_cache(tmp_path, monkeypatch):
+    monkeypatch.setattr(qmk.painter, 'conversion_cache_dir', tmp_path)
+
+    key = qmk.painter.conversion_cache_key(b'input', format='pal16', use_rle=True)
+    assert qmk.painter.read_conversion_cache(key) is None
+
+    qmk.painter.write_conversion_cache(key, b'\x01\x02\x03', [{'width': 1, 'height': 2}])
+    assert qmk.painter.read_conversion_cache(key) == (b'\x01\x02\x03', [{'width': 1, 'height': 2}])
+
+    # Any change to the input or parameters results in a different key
+    assert qmk.painter.conversion_cache_key(b'input2', format='pal16', use_rle=True) != key
+    assert qmk.painter.conversion_cache_key(b'input', format='pal16', use_rle=False) != key
+    assert qmk.painter.conversion_cache_key(b'input', use_rle=True, format='pal16') == key
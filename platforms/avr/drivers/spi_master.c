@@ -40,6 +40,8 @@ static pin_t   current_slave_pin     = NO_PIN;
 static bool    current_cs_active_low = true;
 static uint8_t current_slave_config  = 0;
 static bool    current_slave_2x      = false;
+// The current transaction has sent asynchronously, and is kept open until its device gets round to stopping it
+static bool async_transaction = false;
 
 static inline void spi_select(void) {
     gpio_write_pin(current_slave_pin, current_cs_active_low ? 0 : 1);
@@ -69,6 +71,11 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 }
 
 bool spi_start_extended(spi_start_config_t *start_config) {
+    // The asynchronous transfer finished before it returned, so its transaction can be ended on its device's behalf
+    if (async_transaction) {
+        spi_stop();
+    }
+
     if (current_slave_pin != NO_PIN || start_config->slave_pin == NO_PIN) {
         return false;
     }
@@ -171,6 +178,18 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_callback_t callback, void *cb_arg) {
+    // No DMA, so the transfer is finished before returning
+    spi_status_t status = spi_transmit(data, length);
+    async_transaction   = current_slave_pin != NO_PIN;
+
+    if (callback) {
+        callback(cb_arg);
+    }
+
+    return status < 0 ? SPI_STATUS_ERROR : SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spi_status_t status;
 
@@ -196,5 +215,6 @@ void spi_stop(void) {
         SPCR &= ~(current_slave_config);
         current_slave_config = 0;
         current_slave_2x     = false;
+        async_transaction    = false;
     }
 }
@@ -15,6 +15,8 @@
  */
 
 #include "platform_deps.h"
+#include <avr/sleep.h>
+#include "timer.h"
 
 static void disable_jtag(void) {
 // To use PF4-7 (PC2-5 on ATmega32A), disable JTAG by writing JTD bit twice within four cycles.
@@ -30,3 +32,13 @@ static void disable_jtag(void) {
 void platform_setup(void) {
     disable_jtag();
 }
+
+void platform_low_power_wait_ms(uint16_t ms) {
+    uint16_t start = timer_read();
+
+    // The 1ms timer interrupt wakes the CPU from idle sleep, as does USB, so this ends within 1ms of the deadline
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while (timer_elapsed(start) < ms) {
+        sleep_mode();
+    }
+}
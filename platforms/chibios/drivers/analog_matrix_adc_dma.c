@@ -0,0 +1,188 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include <ch.h>
+#include <hal.h>
+
+#include "analog.h"
+#include "analog_matrix.h"
+#include "gpio.h"
+#include "util.h"
+
+/* Sweeps an analog matrix with the ADC in the background.
+ *
+ * Each row is an ADC input fed by an analog multiplexer, whose select lines pick the column. A single conversion group
+ * reads every row at once into a DMA buffer, and its end callback moves on to the next column and restarts it, so
+ * sweeps run back to back without the CPU waiting on them. Every ANALOG_MATRIX_OVERSAMPLE sweeps are averaged and
+ * published through a triple buffer: the matrix always takes the newest complete sweep, and the ADC never writes into
+ * the one it is reading. */
+
+#if !HAL_USE_ADC
+#    error "You need to set HAL_USE_ADC to TRUE in your halconf.h to use the analog matrix."
+#endif
+
+#if !defined(ANALOG_MATRIX_INPUT_PINS) || !defined(ANALOG_MATRIX_MUX_PINS)
+#    error "ANALOG_MATRIX_INPUT_PINS and ANALOG_MATRIX_MUX_PINS need to be defined for the analog matrix."
+#endif
+
+#if defined(STM32F4XX) || defined(STM32F2XX)
+#    define USE_ADCV2
+#elif defined(STM32F3XX) || defined(STM32L4XX) || defined(STM32L4XXP) || defined(STM32G4XX)
+#    define USE_ADCV3
+#else
+#    error "The analog matrix ADC driver does not support this MCU yet."
+#endif
+
+#if ANALOG_MATRIX_RESOLUTION != 12
+#    error "The analog matrix ADC driver only samples at 12 bits."
+#endif
+
+// The ADC that every row is wired to
+#ifndef ANALOG_MATRIX_ADC_DRIVER
+#    define ANALOG_MATRIX_ADC_DRIVER ADCD1
+#endif
+
+// Sweeps averaged into each one the matrix sees
+#ifndef ANALOG_MATRIX_OVERSAMPLE
+#    define ANALOG_MATRIX_OVERSAMPLE 4
+#endif
+
+// Needs to cover the multiplexer settling on a new column. For more options, look at hal_adc_lld.h in ChibiOS
+#ifndef ANALOG_MATRIX_SAMPLING_RATE
+#    if defined(ADC_SAMPLE_56) // ADCv2
+#        define ANALOG_MATRIX_SAMPLING_RATE ADC_SAMPLE_56
+#    elif defined(ADC_SMPR_SMP_61P5) // STM32F3XX
+#        define ANALOG_MATRIX_SAMPLING_RATE ADC_SMPR_SMP_61P5
+#    elif defined(ADC_SMPR_SMP_47P5) // STM32L4XX, STM32G4XX
+#        define ANALOG_MATRIX_SAMPLING_RATE ADC_SMPR_SMP_47P5
+#    else
+#        error "Cannot determine the default ANALOG_MATRIX_SAMPLING_RATE for this MCU."
+#    endif
+#endif
+
+_Static_assert(((uint32_t)ANALOG_MATRIX_OVERSAMPLE << ANALOG_MATRIX_RESOLUTION) <= 65536, "ANALOG_MATRIX_OVERSAMPLE is too large");
+_Static_assert(MATRIX_ROWS <= 16, "The ADC sequences at most 16 rows");
+
+static const pin_t input_pins[MATRIX_ROWS] = ANALOG_MATRIX_INPUT_PINS;
+static const pin_t mux_pins[]              = ANALOG_MATRIX_MUX_PINS;
+
+_Static_assert((1 << ARRAY_SIZE(mux_pins)) >= MATRIX_COLS, "ANALOG_MATRIX_MUX_PINS cannot select every column");
+
+static ADCConfig   adc_config = {};
+static adcsample_t samples[MATRIX_ROWS];
+
+static uint16_t      accumulator[MATRIX_ROWS * MATRIX_COLS];
+static uint16_t      sweeps[3][MATRIX_ROWS * MATRIX_COLS];
+static uint8_t       writing     = 0;
+static uint8_t       ready       = 1;
+static uint8_t       reading     = 2;
+static volatile bool fresh       = false;
+static uint8_t       column      = 0;
+static uint8_t       accumulated = 0;
+
+static void adc_matrix_end_cb(ADCDriver *adcp);
+
+static ADCConversionGroup conversion_group = {
+    .circular     = FALSE,
+    .num_channels = MATRIX_ROWS,
+    .end_cb       = adc_matrix_end_cb,
+#if defined(USE_ADCV2)
+    .cr2   = ADC_CR2_SWSTART,
+    .smpr2 = ADC_SMPR2_SMP_AN0(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN1(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN2(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN3(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN4(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN5(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN6(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN7(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN8(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN9(ANALOG_MATRIX_SAMPLING_RATE),
+    .smpr1 = ADC_SMPR1_SMP_AN10(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN11(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN12(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN13(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN14(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN15(ANALOG_MATRIX_SAMPLING_RATE),
+#else
+    .cfgr = ADC_CFGR_RES_12BITS,
+    .smpr = {ADC_SMPR1_SMP_AN0(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN1(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN2(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN3(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN4(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN5(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN6(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN7(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN8(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR1_SMP_AN9(ANALOG_MATRIX_SAMPLING_RATE), ADC_SMPR2_SMP_AN10(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN11(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN12(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN13(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN14(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN15(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN16(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN17(ANALOG_MATRIX_SAMPLING_RATE) | ADC_SMPR2_SMP_AN18(ANALOG_MATRIX_SAMPLING_RATE)},
+#endif
+};
+
+/**
+ * \brief Puts a channel at a position in the regular sequence, which holds one row per position.
+ */
+static void sequence_channel(uint8_t position, uint8_t channel) {
+#if defined(USE_ADCV2)
+    // SQ1 to SQ6 in SQR3, SQ7 to SQ12 in SQR2, SQ13 to SQ16 in SQR1, five bits apart
+    if (position < 6) {
+        conversion_group.sqr3 |= (uint32_t)channel << (5 * position);
+    } else if (position < 12) {
+        conversion_group.sqr2 |= (uint32_t)channel << (5 * (position - 6));
+    } else {
+        conversion_group.sqr1 |= (uint32_t)channel << (5 * (position - 12));
+    }
+#else
+    // SQ1 to SQ4 follow the length in SQR1, then five to a register, six bits apart
+    uint8_t slot = position + 1;
+    conversion_group.sqr[slot / 5] |= (uint32_t)channel << (6 * (slot % 5));
+#endif
+}
+
+static inline void select_column(uint8_t col) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(mux_pins); i++) {
+        palWriteLine(mux_pins[i], (col >> i) & 1);
+    }
+}
+
+static void adc_matrix_end_cb(ADCDriver *adcp) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        accumulator[row * MATRIX_COLS + column] += samples[row];
+    }
+
+    if (++column == MATRIX_COLS) {
+        column = 0;
+        if (++accumulated == ANALOG_MATRIX_OVERSAMPLE) {
+            accumulated = 0;
+            for (uint16_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+                sweeps[writing][key] = accumulator[key] / ANALOG_MATRIX_OVERSAMPLE;
+            }
+            memset(accumulator, 0, sizeof(accumulator));
+
+            // Publish, and carry on in whichever buffer the matrix isn't holding
+            uint8_t published = writing;
+            writing           = ready;
+            ready             = published;
+            fresh             = true;
+        }
+    }
+
+    select_column(column);
+
+    osalSysLockFromISR();
+    adcStartConversionI(adcp, &conversion_group, samples, 1);
+    osalSysUnlockFromISR();
+}
+
+void analog_matrix_driver_init(void) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(mux_pins); i++) {
+        gpio_set_pin_output(mux_pins[i]);
+    }
+    select_column(0);
+
+#if defined(USE_ADCV2)
+    conversion_group.sqr1 = ADC_SQR1_NUM_CH(MATRIX_ROWS);
+#else
+    conversion_group.sqr[0] = ADC_SQR1_NUM_CH(MATRIX_ROWS);
+#endif
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        palSetLineMode(input_pins[row], PAL_MODE_INPUT_ANALOG);
+        sequence_channel(row, pinToMux(input_pins[row]).input);
+    }
+
+    adcStart(&ANALOG_MATRIX_ADC_DRIVER, &adc_config);
+    adcStartConversion(&ANALOG_MATRIX_ADC_DRIVER, &conversion_group, samples, 1);
+}
+
+const uint16_t *analog_matrix_driver_sweep(void) {
+    chSysLock();
+    if (!fresh) {
+        chSysUnlock();
+        return NULL;
+    }
+    uint8_t newest = ready;
+    ready          = reading;
+    reading        = newest;
+    fresh          = false;
+    chSysUnlock();
+
+    return sweeps[reading];
+}
@@ -16,8 +16,8 @@
  */
 
 #include "audio.h"
+#include "audio_synth.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
@@ -31,7 +31,8 @@
 
   it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
 
-  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis
+  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis,
+  with the fixed-point synthesizer from audio_synth.c
 */
 
 #if !defined(AUDIO_PIN)
@@ -90,8 +91,23 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 
 static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define dac_wavetable dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define dac_wavetable dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define dac_wavetable dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define dac_wavetable dac_buffer_square
+#endif
+
+_Static_assert((ARRAY_SIZE(dac_wavetable) & (ARRAY_SIZE(dac_wavetable) - 1)) == 0, "The wavetable length needs to be a power of two");
+
+/*Note: the 2/3 are necessary to get the correct frequencies on the
+ *      DAC output (as measured with an oscilloscope), since the gpt
+ *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
+ *      is called twice per conversion.*/
+#define AUDIO_DAC_GENERATED_SAMPLE_RATE (AUDIO_DAC_SAMPLE_RATE * 3 / 2)
 
 static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
 static uint8_t active_tones_snapshot_length                        = 0;
@@ -123,64 +139,11 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
-
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
-
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
-    }
-
-    return value;
+     * wavetable-samples for each frequency, scaled by the number of active tones
+     *
+     * Note: a user implementation does not have to rely on the active_tones_snapshot, but
+     * could directly query the active frequencies through audio_get_processed_frequency */
+    return audio_synth_sample();
 }
 
 /**
@@ -247,6 +210,8 @@ static void dac_end(DACDriver *dacp) {
                 }
             }
 
+            audio_synth_set_tones(active_tones_snapshot, active_tones_snapshot_length);
+
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
             }
@@ -325,6 +290,8 @@ void audio_driver_initialize_impl(void) {
     DACD1.params->dac->CR &= ~DAC_CR_BOFF1;
     DACD2.params->dac->CR &= ~DAC_CR_BOFF2;
 
+    audio_synth_init(dac_wavetable, ARRAY_SIZE(dac_wavetable), AUDIO_DAC_GENERATED_SAMPLE_RATE);
+
     /* Start the DAC output with all off values. This buffer will then get fed
      * with samples from dac_end, which will play notes.
      */
@@ -358,11 +325,13 @@ void audio_driver_start_impl(void) {
     gptStartContinuous(&GPTD6, 2U);
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
         active_tones_snapshot[i] = 0.0f;
     }
     active_tones_snapshot_length = 0;
     state                        = OUTPUT_SHOULD_START;
+
+    audio_synth_set_tones(active_tones_snapshot, 0);
+    audio_synth_reset();
 }
 
 #pragma GCC diagnostic pop
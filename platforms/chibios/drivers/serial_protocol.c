@@ -20,7 +20,11 @@ static THD_FUNCTION(SlaveThread, arg) {
     chRegSetThreadName("split_protocol_tx_rx");
 
     while (true) {
+#if defined(SERIAL_USART_FRAMED)
+        if (unlikely(!serial_protocol_framed_react())) {
+#else
         if (unlikely(!react_to_transaction())) {
+#endif
             /* Clear the receive queue, to start with a clean slate.
              * Parts of failed transactions or spurious bytes could still be in it. */
             serial_transport_driver_clear();
@@ -100,13 +104,28 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SERIAL_USART_FRAMED)
+    return serial_protocol_framed_transaction((uint8_t)index);
+#else
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
     return initiate_transaction((uint8_t)index);
+#endif
 }
 
+#if defined(SERIAL_USART_FRAMED)
+/**
+ * @brief Send the transactions that are still waiting for a read to carry them.
+ *
+ * @return bool Indicates success of the frame.
+ */
+bool soft_serial_flush(void) {
+    return serial_protocol_framed_flush();
+}
+#endif
+
 /**
  * @brief Initiate transaction to slave half.
  */
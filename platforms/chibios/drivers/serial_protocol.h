@@ -47,3 +47,32 @@ bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* de
  * @return false Send failed, e.g. by timeout or bit errors.
  */
 bool __attribute__((nonnull, hot)) serial_transport_send(const uint8_t* source, const size_t size);
+
+#if defined(SERIAL_USART_FRAMED)
+/**
+ * @brief Queue a transaction into the current frame. The frame is sent, and the
+ * slave's reply awaited, once a transaction that expects data back is queued.
+ *
+ * @return true Transaction queued, or frame exchanged, successfully.
+ * @return false The frame was lost or failed its checks.
+ */
+bool serial_protocol_framed_transaction(uint8_t transaction_id);
+
+/**
+ * @brief Send the transactions still queued in the current frame, and await
+ * the slave's reply.
+ *
+ * @return true Nothing was queued, or the frame was exchanged successfully.
+ * @return false The frame was lost or failed its checks, and stays queued.
+ */
+bool serial_protocol_framed_flush(void);
+
+/**
+ * @brief Receive a frame from the master, run its transactions and send back
+ * the reply.
+ *
+ * @return true Frame handled successfully.
+ * @return false Frame was incomplete or failed its checks.
+ */
+bool serial_protocol_framed_react(void);
+#endif
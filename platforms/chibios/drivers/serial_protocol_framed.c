@@ -0,0 +1,214 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial.h"
+#include "serial_protocol.h"
+#include "synchronization_util.h"
+#include "crc.h"
+
+#if defined(SERIAL_USART_FRAMED)
+
+#    if !defined(SERIAL_USART_FULL_DUPLEX)
+#        error SERIAL_USART_FRAMED requires SERIAL_USART_FULL_DUPLEX
+#    endif
+
+/* Framed transactions
+ *
+ * Rather than a handshake per transaction, the master batches transactions into a single frame:
+ *
+ *   master -> slave:  SERIAL_FRAME_START | count | (id | initiator2target buffer) * count | crc8
+ *   slave -> master:  count ^ NUM_TOTAL_TRANSACTIONS | (target2initiator buffer) * count | crc8
+ *
+ * Buffer sizes come from the transaction table, which both halves share. Transactions that only send data to the
+ * slave are held back, and go out with the next transaction that needs an answer, so each frame costs a single
+ * turnaround and a single acknowledgement. Whatever is still held back at the end of the master's pass is sent then,
+ * so that it isn't a scan late. The slave applies nothing until the whole frame has passed its CRC check. */
+
+#    define SERIAL_FRAME_START 0xA5
+#    define SERIAL_FRAME_MAX_TRANSACTIONS NUM_TOTAL_TRANSACTIONS
+#    define SERIAL_FRAME_BUFFER_SIZE (3 + SERIAL_FRAME_MAX_TRANSACTIONS + sizeof(split_shared_memory_t))
+
+static uint8_t  frame[SERIAL_FRAME_BUFFER_SIZE];
+static uint16_t frame_length = 0;
+static uint8_t  frame_count  = 0;
+static uint8_t  reply[SERIAL_FRAME_BUFFER_SIZE];
+
+static inline uint8_t initiator2target_size(uint8_t transaction_id) {
+    return split_transaction_table[transaction_id].initiator2target_buffer_size;
+}
+
+static inline uint8_t target2initiator_size(uint8_t transaction_id) {
+    return split_transaction_table[transaction_id].target2initiator_buffer_size;
+}
+
+/**
+ * @brief Send the pending frame to the slave half, and unpack its reply. The frame is only
+ * dropped once the slave has acknowledged it.
+ */
+static bool flush_frame(void) {
+    if (frame_count == 0) {
+        return true;
+    }
+
+    uint16_t length = frame_length;
+    frame[1]        = frame_count;
+    frame[length++] = crc8(frame, frame_length);
+
+    uint16_t reply_length = 1;
+    for (uint16_t position = 2; position < frame_length; position += 1 + initiator2target_size(frame[position])) {
+        reply_length += target2initiator_size(frame[position]);
+    }
+    reply_length++;
+
+    /* Clear the receive queue, to start with a clean slate.
+     * Parts of failed transactions or spurious bytes could still be in it. */
+    serial_transport_driver_clear();
+
+    if (!serial_transport_send(frame, length)) {
+        serial_dprintf("SPLIT: sending frame failed\n");
+        return false;
+    }
+
+    if (!serial_transport_receive(reply, reply_length)) {
+        serial_dprintf("SPLIT: receiving frame failed\n");
+        return false;
+    }
+
+    if (reply[0] != (frame_count ^ NUM_TOTAL_TRANSACTIONS) || reply[reply_length - 1] != crc8(reply, reply_length - 1)) {
+        serial_dprintf("SPLIT: frame acknowledgement failed\n");
+        return false;
+    }
+
+    uint16_t reply_position = 1;
+    for (uint16_t position = 2; position < frame_length; position += 1 + initiator2target_size(frame[position])) {
+        split_transaction_desc_t *transaction = &split_transaction_table[frame[position]];
+        memcpy(split_trans_target2initiator_buffer(transaction), &reply[reply_position], transaction->target2initiator_buffer_size);
+        reply_position += transaction->target2initiator_buffer_size;
+    }
+
+    frame_count = 0;
+    return true;
+}
+
+bool serial_protocol_framed_transaction(uint8_t transaction_id) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    split_transaction_desc_t *transaction = &split_transaction_table[transaction_id];
+
+    /* Send what is already pending if this transaction won't fit. If that fails, the pending writes stay queued for
+     * the next frame, and this transaction fails so that the caller tries it again. */
+    if (frame_count == SERIAL_FRAME_MAX_TRANSACTIONS || frame_length + 1 + transaction->initiator2target_buffer_size + 1 > SERIAL_FRAME_BUFFER_SIZE) {
+        if (!flush_frame()) {
+            return false;
+        }
+    }
+
+    if (frame_count == 0) {
+        frame[0]     = SERIAL_FRAME_START;
+        frame_length = 2;
+    }
+
+    uint16_t pending_length = frame_length;
+    uint8_t  pending_count  = frame_count;
+
+    frame[frame_length++] = transaction_id;
+    memcpy(&frame[frame_length], split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+    frame_length += transaction->initiator2target_buffer_size;
+    frame_count++;
+
+    /* Nothing to wait for, so let it ride along with the next frame. */
+    if (transaction->target2initiator_buffer_size == 0) {
+        return true;
+    }
+
+    /* The caller retries a failed read, but already considers the pending writes done, so keep those for the next
+     * frame. */
+    if (!flush_frame()) {
+        frame_length = pending_length;
+        frame_count  = pending_count;
+        return false;
+    }
+
+    return true;
+}
+
+bool serial_protocol_framed_flush(void) {
+    split_shared_memory_lock_autounlock();
+
+    return flush_frame();
+}
+
+bool serial_protocol_framed_react(void) {
+    static uint8_t received[SERIAL_FRAME_BUFFER_SIZE];
+
+    /* Wait until there is a frame for us. */
+    if (!serial_transport_receive_blocking(received, 2)) {
+        return false;
+    }
+
+    uint8_t count = received[1];
+    if (received[0] != SERIAL_FRAME_START || count == 0 || count > SERIAL_FRAME_MAX_TRANSACTIONS) {
+        return false;
+    }
+
+    uint16_t length       = 2;
+    uint16_t reply_length = 2;
+    for (uint8_t i = 0; i < count; i++) {
+        if (!serial_transport_receive(&received[length], 1)) {
+            return false;
+        }
+
+        /* Sanity check that we are actually responding to a valid transaction. */
+        uint8_t transaction_id = received[length++];
+        if (transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+            return false;
+        }
+
+        uint8_t size = initiator2target_size(transaction_id);
+        reply_length += target2initiator_size(transaction_id);
+        if (length + size + 1 > SERIAL_FRAME_BUFFER_SIZE || reply_length > SERIAL_FRAME_BUFFER_SIZE || !serial_transport_receive(&received[length], size)) {
+            return false;
+        }
+        length += size;
+    }
+
+    uint8_t checksum;
+    if (!serial_transport_receive(&checksum, 1) || checksum != crc8(received, length)) {
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    reply_length          = 0;
+    reply[reply_length++] = count ^ NUM_TOTAL_TRANSACTIONS;
+
+    for (uint16_t position = 2; position < length;) {
+        split_transaction_desc_t *transaction = &split_transaction_table[received[position++]];
+
+        memcpy(split_trans_initiator2target_buffer(transaction), &received[position], transaction->initiator2target_buffer_size);
+        position += transaction->initiator2target_buffer_size;
+
+        /* Allow any slave processing to occur. */
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+
+        memcpy(&reply[reply_length], split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        reply_length += transaction->target2initiator_buffer_size;
+    }
+
+    reply[reply_length] = crc8(reply, reply_length);
+    reply_length++;
+
+    return serial_transport_send(reply, reply_length);
+}
+
+#endif // defined(SERIAL_USART_FRAMED)
@@ -16,6 +16,7 @@
 
 #include "spi_master.h"
 #include "chibios_config.h"
+#include "timer.h"
 #include <ch.h>
 #include <hal.h>
 
@@ -59,6 +60,10 @@
 #    endif
 #endif
 
+#ifndef SPI_TIMEOUT
+#    define SPI_TIMEOUT 100
+#endif
+
 static bool spiStarted = false;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t current_slave_pin     = NO_PIN;
@@ -67,6 +72,31 @@ static bool  current_cs_active_low = true;
 
 static SPIConfig spiConfig;
 
+static spi_callback_t transmit_callback = NULL;
+static void *         transmit_cb_arg   = NULL;
+static volatile bool  transmit_pending  = false;
+// The current transaction has an asynchronous transfer, and is kept open until its device gets round to stopping it
+static bool async_transaction = false;
+
+// Only set while an asynchronous transfer is running, as the synchronous calls refuse a config with a callback
+static inline void spi_set_complete_callback(spicallback_t callback) {
+#ifdef HAL_LLD_SELECT_SPI_V2
+    spiConfig.data_cb = callback;
+#else
+    spiConfig.end_cb = callback;
+#endif
+}
+
+static void spi_transmit_complete(SPIDriver *spip) {
+    spi_set_complete_callback(NULL);
+    transmit_pending        = false;
+    spi_callback_t callback = transmit_callback;
+    if (callback) {
+        transmit_callback = NULL;
+        callback(transmit_cb_arg);
+    }
+}
+
 static inline void spi_select(void) {
     spiSelect(&SPI_DRIVER);
 
@@ -124,7 +154,26 @@ __attribute__((weak)) void spi_init(void) {
     }
 }
 
+static bool spi_wait_transmit(void) {
+    uint16_t timeout_timer = timer_read();
+    while (transmit_pending) {
+        if (timer_elapsed(timeout_timer) >= SPI_TIMEOUT) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool spi_start_extended(spi_start_config_t *start_config) {
+    // A device that sent asynchronously keeps its transaction open until it polls for completion. Once the transfer is
+    // done, end that transaction on its behalf, rather than turning everyone else away until then.
+    if (async_transaction) {
+        if (!spi_wait_transmit()) {
+            return false;
+        }
+        spi_stop();
+    }
+
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
     spiAcquireBus(&SPI_DRIVER);
 #endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
@@ -420,6 +469,9 @@ bool spi_start_extended(spi_start_config_t *start_config) {
 #    error "Unsupported SPI_SELECT_MODE"
 #endif
 
+    // Left over from an asynchronous transfer that never completed
+    spi_set_complete_callback(NULL);
+
     spiStart(&SPI_DRIVER, &spiConfig);
     spi_select();
 
@@ -455,18 +507,37 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_callback_t callback, void *cb_arg) {
+    if (!spiStarted || !spi_wait_transmit()) {
+        return SPI_STATUS_ERROR;
+    }
+
+    transmit_cb_arg   = cb_arg;
+    transmit_callback = callback;
+    transmit_pending  = true;
+    async_transaction = true;
+    spi_set_complete_callback(spi_transmit_complete);
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
-    if (spiStarted) {
-        spi_unselect();
-        spiStop(&SPI_DRIVER);
-        spiStarted = false;
+    // Already ended, if another device's transaction took over from an asynchronous one
+    if (!spiStarted) {
+        return;
     }
 
+    spi_wait_transmit();
+    spi_unselect();
+    spiStop(&SPI_DRIVER);
+    spiStarted        = false;
+    async_transaction = false;
+
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
     spiReleaseBus(&SPI_DRIVER);
 #endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
@@ -1,6 +1,8 @@
 #include "ws2812.h"
+#include "ws2812_encode.h"
 #include "gpio.h"
 #include "util.h"
+#include "timer.h"
 #include "chibios_config.h"
 
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
@@ -22,6 +24,11 @@
 #    define WS2812_SPI_DIVISOR 16
 #endif
 
+// How long to wait for the previous frame to finish sending, in milliseconds
+#ifndef WS2812_SPI_TIMEOUT
+#    define WS2812_SPI_TIMEOUT 100
+#endif
+
 // Push Pull or Open Drain Configuration
 // Default Push Pull
 #ifndef WS2812_EXTERNAL_PULLUP
@@ -102,68 +109,36 @@
 #    define WS2812_SCK_OUTPUT_MODE PAL_MODE_ALTERNATE(WS2812_SPI_SCK_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL
 #endif
 
-#define BYTES_FOR_LED_BYTE 4
-#ifdef WS2812_RGBW
-#    define WS2812_CHANNELS 4
-#else
-#    define WS2812_CHANNELS 3
-#endif
-#define BYTES_FOR_LED (BYTES_FOR_LED_BYTE * WS2812_CHANNELS)
-#define DATA_SIZE (BYTES_FOR_LED * WS2812_LED_COUNT)
+#define DATA_SIZE WS2812_SPI_ENCODED_SIZE(WS2812_LED_COUNT)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TX_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// While one frame is being sent, the next is encoded into the other buffer. A circular buffer is sent continuously, so
+// it can only be updated in place.
+#ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
+#    define TX_BUFFER_COUNT 1
+#else
+#    define TX_BUFFER_COUNT 2
+#endif
 
-/*
- * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
- */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
-}
+// Words, so that the encoder can write whole words after the preamble
+static uint32_t txbuf[TX_BUFFER_COUNT][(TX_SIZE + 3) / 4] = {0};
 
-static void set_led_color_rgb(ws2812_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
+static uint8_t       tx_next     = 0;
+static volatile bool tx_busy     = false;
+static bool          tx_timedout = false;
 
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
-#endif
-#ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
-#endif
+static void ws2812_spi_end(SPIDriver* spip) {
+    tx_busy = false;
 }
 
+#    define WS2812_SPI_END_CB ws2812_spi_end
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
+
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
 void ws2812_init(void) {
@@ -180,7 +155,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -199,7 +174,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_END_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -220,7 +195,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TX_SIZE, txbuf[0]);
 #endif
 }
 
@@ -240,17 +215,38 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void ws2812_flush(void) {
-    for (int i = 0; i < WS2812_LED_COUNT; i++) {
-        set_led_color_rgb(ws2812_leds[i], i);
+#ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
+    ws2812_encode_spi(&txbuf[0][PREAMBLE_SIZE / 4], ws2812_leds, WS2812_LED_COUNT);
+#else
+    // Encode into the buffer that isn't being sent, while the previous frame is still on the wire
+    uint32_t* frame = txbuf[tx_next];
+    ws2812_encode_spi(&frame[PREAMBLE_SIZE / 4], ws2812_leds, WS2812_LED_COUNT);
+    tx_next ^= 1;
+
+    // A frame that timed out may still be on the wire, and starting another one would corrupt the driver's state, so
+    // frames are dropped without waiting until the driver is idle again
+    if (tx_timedout) {
+        if (WS2812_SPI_DRIVER.state == SPI_ACTIVE) {
+            return;
+        }
+        tx_timedout = false;
+        tx_busy     = false;
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
+    // Each led takes ~0.03ms to send, so this only waits when flushing faster than that
+    uint16_t start = timer_read();
+    while (tx_busy) {
+        if (timer_elapsed(start) > WS2812_SPI_TIMEOUT) {
+            tx_timedout = true;
+            return;
+        }
+    }
+    tx_busy = true;
+
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, TX_SIZE, frame);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TX_SIZE, frame);
 #    endif
 #endif
 }
@@ -15,8 +15,14 @@
  */
 
 #include "platform_deps.h"
+#include "wait.h"
 
 void platform_setup(void) {
     halInit();
     chSysInit();
 }
+
+void platform_low_power_wait_ms(uint16_t ms) {
+    // Sleeping the thread hands over to the idle thread, which waits for interrupts with WFI
+    wait_ms(ms);
+}
@@ -0,0 +1,114 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix_mock.h"
+
+#include <string.h>
+
+#include "analog_matrix.h"
+#include "timer.h"
+
+matrix_row_t analog_matrix_mock_switches[MATRIX_ROWS];
+
+typedef struct key_curve_t {
+    const analog_matrix_mock_point_t *points;
+    uint8_t                           length;
+    uint32_t                          start;
+} key_curve_t;
+
+static key_curve_t  curves[MATRIX_ROWS * MATRIX_COLS];
+static matrix_row_t disconnected[MATRIX_ROWS];
+static uint16_t     readings[MATRIX_ROWS * MATRIX_COLS];
+static uint16_t     noise = ANALOG_MATRIX_MOCK_NOISE;
+static uint32_t     sweeps;
+static uint32_t     random_state;
+
+void analog_matrix_mock_reset(void) {
+    memset(curves, 0, sizeof(curves));
+    memset(disconnected, 0, sizeof(disconnected));
+    memset(analog_matrix_mock_switches, 0, sizeof(analog_matrix_mock_switches));
+    noise        = ANALOG_MATRIX_MOCK_NOISE;
+    sweeps       = 0;
+    random_state = 1;
+}
+
+void analog_matrix_mock_play(uint8_t row, uint8_t col, const analog_matrix_mock_point_t *curve, uint8_t length) {
+    curves[row * MATRIX_COLS + col] = (key_curve_t){
+        .points = curve,
+        .length = length,
+        .start  = timer_read32(),
+    };
+}
+
+void analog_matrix_mock_disconnect(uint8_t row, uint8_t col) {
+    disconnected[row] |= MATRIX_ROW_SHIFTER << col;
+}
+
+void analog_matrix_mock_set_noise(uint16_t peak) {
+    noise = peak;
+}
+
+uint32_t analog_matrix_mock_get_sweeps(void) {
+    return sweeps;
+}
+
+uint16_t analog_matrix_mock_get_travel_um(uint8_t row, uint8_t col) {
+    const key_curve_t *curve = &curves[row * MATRIX_COLS + col];
+    if (!curve->length) {
+        return (analog_matrix_mock_switches[row] & (MATRIX_ROW_SHIFTER << col)) ? ANALOG_MATRIX_MOCK_FULL_TRAVEL_UM : 0;
+    }
+
+    uint32_t elapsed = timer_read32() - curve->start;
+    if (elapsed <= curve->points[0].time_ms) {
+        return curve->points[0].travel_um;
+    }
+
+    for (uint8_t i = 1; i < curve->length; i++) {
+        const analog_matrix_mock_point_t *from = &curve->points[i - 1];
+        const analog_matrix_mock_point_t *to   = &curve->points[i];
+        if (elapsed <= to->time_ms) {
+            int32_t span = to->time_ms - from->time_ms;
+            return from->travel_um + ((int32_t)to->travel_um - from->travel_um) * (int32_t)(elapsed - from->time_ms) / span;
+        }
+    }
+
+    return curve->points[curve->length - 1].travel_um;
+}
+
+uint16_t analog_matrix_mock_get_reading(uint8_t row, uint8_t col) {
+    if (disconnected[row] & (MATRIX_ROW_SHIFTER << col)) {
+        return 0;
+    }
+
+    // The field grows faster as the magnet closes in, modelled as x * (1 + x) / 2 of the full swing
+    uint32_t travel = analog_matrix_mock_get_travel_um(row, col);
+    uint32_t full   = ANALOG_MATRIX_MOCK_FULL_TRAVEL_UM;
+    return ANALOG_MATRIX_MOCK_REST + (uint64_t)ANALOG_MATRIX_MOCK_SWING * travel * (full + travel) / (2 * full * full);
+}
+
+static uint32_t next_random(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+void analog_matrix_driver_init(void) {
+    random_state = random_state ? random_state : 1;
+}
+
+const uint16_t *analog_matrix_driver_sweep(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            int32_t reading = analog_matrix_mock_get_reading(row, col);
+            if (noise) {
+                reading += (int32_t)(next_random() % (2 * noise + 1)) - noise;
+            }
+            readings[row * MATRIX_COLS + col] = reading < 0 ? 0 : reading;
+        }
+    }
+
+    sweeps++;
+    return readings;
+}
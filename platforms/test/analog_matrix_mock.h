@@ -0,0 +1,82 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Stands in for the ADC of an analog matrix within a unit test.
+ *
+ * Each key has a Hall-effect sensor whose reading grows, more steeply towards the bottom, as the key travels down.
+ * Keys follow recorded travel curves, which start playing when they are handed to the mock and are interpolated on the
+ * test clock. Keys without a curve sit at rest, or bottom out while they are pressed through the test's switches.
+ * Every sweep reads each key at the current time and adds deterministic noise.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "matrix.h"
+
+// Reading with the key at rest
+#ifndef ANALOG_MATRIX_MOCK_REST
+#    define ANALOG_MATRIX_MOCK_REST 2000
+#endif
+
+// Change in reading from rest to bottom-out
+#ifndef ANALOG_MATRIX_MOCK_SWING
+#    define ANALOG_MATRIX_MOCK_SWING 900
+#endif
+
+// Travel from rest to bottom-out
+#ifndef ANALOG_MATRIX_MOCK_FULL_TRAVEL_UM
+#    define ANALOG_MATRIX_MOCK_FULL_TRAVEL_UM 4000
+#endif
+
+// Largest noise added to a reading, either way
+#ifndef ANALOG_MATRIX_MOCK_NOISE
+#    define ANALOG_MATRIX_MOCK_NOISE 3
+#endif
+
+typedef struct analog_matrix_mock_point_t {
+    uint16_t time_ms;   // since the curve started playing
+    uint16_t travel_um; // how far the key is down
+} analog_matrix_mock_point_t;
+
+/**
+ * \brief The switches pressed by the test, which bottom out keys that aren't playing a curve.
+ */
+extern matrix_row_t analog_matrix_mock_switches[MATRIX_ROWS];
+
+/**
+ * \brief Returns every key to rest, stops every curve and clears the sweep count.
+ */
+void analog_matrix_mock_reset(void);
+
+/**
+ * \brief Starts a key following a travel curve from now. It holds the last point's travel once the curve is over.
+ */
+void analog_matrix_mock_play(uint8_t row, uint8_t col, const analog_matrix_mock_point_t *curve, uint8_t length);
+
+/**
+ * \brief Leaves a key's channel without a sensor, so that it only reads noise around zero.
+ */
+void analog_matrix_mock_disconnect(uint8_t row, uint8_t col);
+
+void analog_matrix_mock_set_noise(uint16_t noise);
+
+/**
+ * \brief Returns how far a key is down right now.
+ */
+uint16_t analog_matrix_mock_get_travel_um(uint8_t row, uint8_t col);
+
+/**
+ * \brief Returns what a key's sensor reads right now, without noise.
+ */
+uint16_t analog_matrix_mock_get_reading(uint8_t row, uint8_t col);
+
+/**
+ * \brief Returns the number of sweeps taken.
+ */
+uint32_t analog_matrix_mock_get_sweeps(void);
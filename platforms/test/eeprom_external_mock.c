@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "eeprom_external_mock.h"
+#include "timer.h"
+#include "wait.h"
+
+uint8_t             eeprom_mock_data[EXTERNAL_EEPROM_BYTE_COUNT];
+eeprom_mock_stats_t eeprom_mock_stats;
+uint32_t            eeprom_mock_elapsed_us;
+uintptr_t           eeprom_mock_write_log[EEPROM_MOCK_WRITE_LOG_SIZE];
+
+static uint32_t clock_us   = 0;
+static uint32_t busy_until = 0;
+
+void eeprom_mock_reset(uint8_t value) {
+    memset(eeprom_mock_data, value, sizeof(eeprom_mock_data));
+    busy_until = clock_us;
+    eeprom_mock_reset_stats();
+}
+
+void eeprom_mock_reset_stats(void) {
+    memset(&eeprom_mock_stats, 0, sizeof(eeprom_mock_stats));
+    memset(eeprom_mock_write_log, 0, sizeof(eeprom_mock_write_log));
+    eeprom_mock_elapsed_us = 0;
+}
+
+static void advance(uint32_t us) {
+    clock_us += us;
+    eeprom_mock_elapsed_us += us;
+}
+
+void eeprom_mock_transaction(uint16_t bytes, uint32_t us_per_byte) {
+    eeprom_mock_stats.transactions++;
+    eeprom_mock_stats.bytes += bytes;
+    advance(bytes * us_per_byte);
+}
+
+bool eeprom_mock_busy(void) {
+    return (int32_t)(busy_until - clock_us) > 0;
+}
+
+void eeprom_mock_program(uintptr_t addr, const uint8_t *data, uint16_t length) {
+    // Writes past the end of a page wrap around to its start
+    uintptr_t page = addr - addr % EXTERNAL_EEPROM_PAGE_SIZE;
+    for (uint16_t i = 0; i < length; i++) {
+        eeprom_mock_data[(page + (addr - page + i) % EXTERNAL_EEPROM_PAGE_SIZE) % EXTERNAL_EEPROM_BYTE_COUNT] = data[i];
+    }
+    if (eeprom_mock_stats.page_writes < EEPROM_MOCK_WRITE_LOG_SIZE) {
+        eeprom_mock_write_log[eeprom_mock_stats.page_writes] = page;
+    }
+    eeprom_mock_stats.page_writes++;
+    busy_until = clock_us + EEPROM_MOCK_WRITE_CYCLE_US;
+}
+
+void wait_ms(uint32_t ms) {
+    advance(ms * 1000);
+}
+
+uint32_t timer_read32(void) {
+    return clock_us / 1000;
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)timer_read32();
+}
@@ -0,0 +1,62 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Simulates an external EEPROM behind the i2c_master or spi_master API, for testing the external EEPROM drivers.
+ *
+ * Like the real chips, the simulated EEPROM wraps page writes around within a page, and is busy for a while after
+ * each one. It counts every transaction on the bus, and keeps a clock of the time spent on the bus and waiting, which
+ * also drives `timer_read32()` and `wait_ms()`.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "eeprom.h"
+
+// Typical time taken by a write cycle. The datasheet's maximum is EXTERNAL_EEPROM_WRITE_TIME.
+#ifndef EEPROM_MOCK_WRITE_CYCLE_US
+#    define EEPROM_MOCK_WRITE_CYCLE_US 3500
+#endif
+
+#define EEPROM_MOCK_WRITE_LOG_SIZE 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct eeprom_mock_stats_t {
+    uint32_t transactions; // on the bus, from start to stop
+    uint32_t reads;        // of which read back data
+    uint32_t page_writes;  // of which started a write cycle
+    uint32_t busy_polls;   // of which found the EEPROM in a write cycle
+    uint32_t bytes;        // sent in either direction
+} eeprom_mock_stats_t;
+
+extern uint8_t             eeprom_mock_data[EXTERNAL_EEPROM_BYTE_COUNT];
+extern eeprom_mock_stats_t eeprom_mock_stats;
+extern uint32_t            eeprom_mock_elapsed_us;
+extern uintptr_t           eeprom_mock_write_log[EEPROM_MOCK_WRITE_LOG_SIZE]; // page address of each write cycle
+
+/**
+ * \brief Fills the EEPROM with the given value, and clears the statistics.
+ */
+void eeprom_mock_reset(uint8_t value);
+
+/**
+ * \brief Clears the statistics and the write log, keeping the contents.
+ */
+void eeprom_mock_reset_stats(void);
+
+// Used by the bus simulations
+void eeprom_mock_transaction(uint16_t bytes, uint32_t us_per_byte);
+bool eeprom_mock_busy(void);
+void eeprom_mock_program(uintptr_t addr, const uint8_t *data, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
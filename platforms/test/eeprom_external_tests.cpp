@@ -0,0 +1,148 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "eeprom_external_cache.h"
+#include "eeprom_external_mock.h"
+}
+
+class EepromExternal : public testing::Test {
+   protected:
+    void SetUp() override {
+        eeprom_mock_reset(0xFF);
+        eeprom_external_cache_invalidate();
+        eeprom_driver_init();
+    }
+};
+
+TEST_F(EepromExternal, RepeatedReadsStayInCache) {
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(eeprom_read_word((const uint16_t *)100), 0xFFFF);
+    }
+    EXPECT_EQ(eeprom_read_word((const uint16_t *)(100 - 100 % EXTERNAL_EEPROM_CACHE_LINE_SIZE)), 0xFFFF);
+    EXPECT_EQ(eeprom_mock_stats.reads, 1);
+    uint32_t cached = eeprom_mock_stats.transactions;
+
+    eeprom_mock_reset_stats();
+    for (int i = 0; i < 100; i++) {
+        uint16_t value;
+        eeprom_external_read(100, &value, sizeof(value));
+    }
+    printf("100 reads of a keycode: %u bus transactions uncached, %u cached\n", eeprom_mock_stats.transactions, cached);
+}
+
+TEST_F(EepromExternal, WholeLinesAreReadDirectly) {
+    uint8_t buf[8 * EXTERNAL_EEPROM_CACHE_LINE_SIZE];
+    eeprom_mock_data[3 * EXTERNAL_EEPROM_CACHE_LINE_SIZE] = 0x42;
+
+    eeprom_read_block(buf, (const void *)0, sizeof(buf));
+    EXPECT_EQ(buf[3 * EXTERNAL_EEPROM_CACHE_LINE_SIZE], 0x42);
+    EXPECT_EQ(eeprom_mock_stats.reads, 1);
+
+    // Nothing was cached along the way
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)0), 0xFF);
+    EXPECT_EQ(eeprom_mock_stats.reads, 2);
+
+    // Partial lines at either end are cached, the whole lines in between are read together
+    eeprom_mock_reset_stats();
+    eeprom_read_block(buf, (const void *)(4 * EXTERNAL_EEPROM_CACHE_LINE_SIZE + 1), 3 * EXTERNAL_EEPROM_CACHE_LINE_SIZE);
+    EXPECT_EQ(eeprom_mock_stats.reads, 3);
+}
+
+TEST_F(EepromExternal, WritesAreCombinedIntoPageWrites) {
+    const uintptr_t base = 2 * EXTERNAL_EEPROM_PAGE_SIZE;
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        eeprom_write_byte((uint8_t *)(base + i), i);
+        EXPECT_EQ(eeprom_read_byte((const uint8_t *)(base + i)), i);
+    }
+    EXPECT_EQ(eeprom_mock_stats.page_writes, 0);
+
+    eeprom_driver_task();
+    EXPECT_EQ(eeprom_mock_stats.page_writes, 1);
+    EXPECT_EQ(eeprom_mock_write_log[0], base);
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_PAGE_SIZE; i++) {
+        EXPECT_EQ(eeprom_mock_data[base + i], i);
+    }
+
+    // Nothing left to write
+    eeprom_driver_task();
+    EXPECT_EQ(eeprom_mock_stats.page_writes, 1);
+}
+
+TEST_F(EepromExternal, UnchangedBytesAreNotWritten) {
+    uint8_t buf[EXTERNAL_EEPROM_PAGE_SIZE];
+    memset(buf, 0xFF, sizeof(buf));
+    eeprom_write_block(buf, (void *)5, sizeof(buf));
+    eeprom_update_dword((uint32_t *)64, 0xFFFFFFFF);
+    eeprom_driver_task();
+    EXPECT_EQ(eeprom_mock_stats.page_writes, 0);
+}
+
+TEST_F(EepromExternal, WritesKeepTheirOrder) {
+    eeprom_write_byte((uint8_t *)0, 1);
+    eeprom_write_byte((uint8_t *)(2 * EXTERNAL_EEPROM_PAGE_SIZE), 2);
+    eeprom_write_byte((uint8_t *)1, 3);
+    eeprom_driver_task();
+
+    ASSERT_EQ(eeprom_mock_stats.page_writes, 3);
+    EXPECT_EQ(eeprom_mock_write_log[0], 0);
+    EXPECT_EQ(eeprom_mock_write_log[1], 2 * EXTERNAL_EEPROM_PAGE_SIZE);
+    EXPECT_EQ(eeprom_mock_write_log[2], 0);
+    EXPECT_EQ(eeprom_mock_data[0], 1);
+    EXPECT_EQ(eeprom_mock_data[1], 3);
+    EXPECT_EQ(eeprom_mock_data[2 * EXTERNAL_EEPROM_PAGE_SIZE], 2);
+}
+
+TEST_F(EepromExternal, EvictionWritesBackInOrder) {
+    for (uint8_t i = 0; i <= EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+        eeprom_write_byte((uint8_t *)(uintptr_t)(i * EXTERNAL_EEPROM_CACHE_LINE_SIZE), i);
+    }
+    ASSERT_EQ(eeprom_mock_stats.page_writes, EXTERNAL_EEPROM_CACHE_LINE_COUNT);
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+        EXPECT_EQ(eeprom_mock_write_log[i], i * EXTERNAL_EEPROM_CACHE_LINE_SIZE);
+    }
+
+    eeprom_driver_flush();
+    EXPECT_EQ(eeprom_mock_stats.page_writes, EXTERNAL_EEPROM_CACHE_LINE_COUNT + 1);
+    for (uint8_t i = 0; i <= EXTERNAL_EEPROM_CACHE_LINE_COUNT; i++) {
+        EXPECT_EQ(eeprom_mock_data[i * EXTERNAL_EEPROM_CACHE_LINE_SIZE], i);
+    }
+}
+
+TEST_F(EepromExternal, EraseDropsCachedData) {
+    eeprom_write_byte((uint8_t *)10, 0x42);
+    eeprom_driver_erase();
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)10), 0);
+
+    eeprom_mock_reset_stats();
+    eeprom_driver_task();
+    EXPECT_EQ(eeprom_mock_stats.page_writes, 0);
+    EXPECT_EQ(eeprom_mock_data[10], 0);
+}
+
+TEST_F(EepromExternal, WriteCyclesArePolled) {
+    const uint32_t pages = 8;
+    uint8_t        buf[pages * EXTERNAL_EEPROM_PAGE_SIZE];
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (uint8_t)i;
+    }
+    eeprom_write_block(buf, (void *)0, sizeof(buf));
+    eeprom_driver_flush();
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)(sizeof(buf) - 1)), (uint8_t)(sizeof(buf) - 1));
+
+    EXPECT_EQ(eeprom_mock_stats.page_writes, pages);
+    EXPECT_EQ(memcmp(eeprom_mock_data, buf, sizeof(buf)), 0);
+    EXPECT_GT(eeprom_mock_stats.busy_polls, 0);
+#ifdef EEPROM_I2C
+    // Rather than the longest write time in the datasheet
+    EXPECT_LT(eeprom_mock_elapsed_us, pages * EXTERNAL_EEPROM_WRITE_TIME * 1000);
+#endif
+    printf("%u page writes: %u bus transactions in %uus\n", pages, eeprom_mock_stats.transactions, eeprom_mock_elapsed_us);
+}
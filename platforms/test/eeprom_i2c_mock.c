@@ -0,0 +1,54 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_master.h"
+#include "eeprom_external_mock.h"
+
+// 400kHz, with 9 bits for each byte
+#define I2C_MOCK_US_PER_BYTE 23
+
+static uintptr_t pointer = 0;
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    eeprom_mock_transaction(1, I2C_MOCK_US_PER_BYTE);
+    if (eeprom_mock_busy()) {
+        eeprom_mock_stats.busy_polls++;
+        return I2C_STATUS_ERROR;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    eeprom_mock_transaction(1 + length, I2C_MOCK_US_PER_BYTE);
+    // The EEPROM doesn't acknowledge anything during a write cycle
+    if (eeprom_mock_busy()) {
+        eeprom_mock_stats.busy_polls++;
+        return I2C_STATUS_ERROR;
+    }
+
+    pointer = 0;
+    for (uint8_t i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE && i < length; i++) {
+        pointer = (pointer << 8) | data[i];
+    }
+    if (length > EXTERNAL_EEPROM_ADDRESS_SIZE) {
+        eeprom_mock_program(pointer, &data[EXTERNAL_EEPROM_ADDRESS_SIZE], length - EXTERNAL_EEPROM_ADDRESS_SIZE);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout) {
+    eeprom_mock_transaction(1 + length, I2C_MOCK_US_PER_BYTE);
+    if (eeprom_mock_busy()) {
+        eeprom_mock_stats.busy_polls++;
+        return I2C_STATUS_ERROR;
+    }
+
+    eeprom_mock_stats.reads++;
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = eeprom_mock_data[pointer];
+        pointer = (pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+    }
+    return I2C_STATUS_SUCCESS;
+}
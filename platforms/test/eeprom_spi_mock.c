@@ -0,0 +1,116 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "spi_master.h"
+#include "eeprom_external_mock.h"
+
+// 8MHz
+#define SPI_MOCK_US_PER_BYTE 1
+
+#define CMD_NONE 0
+#define CMD_WREN 6
+#define CMD_WRDI 4
+#define CMD_RDSR 5
+#define CMD_READ 3
+#define CMD_WRITE 2
+
+static uint8_t   command      = CMD_NONE;
+static bool      write_enable = false;
+static uint8_t   received[EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE];
+static uint16_t  received_length;
+static uintptr_t pointer;
+static uint16_t  bytes;
+
+static void receive_byte(uint8_t data) {
+    bytes++;
+    if (command == CMD_NONE) {
+        command = data;
+        return;
+    }
+    // The driver never sends more than a page at a time
+    if (received_length == sizeof(received)) {
+        return;
+    }
+    received[received_length++] = data;
+    if (received_length == EXTERNAL_EEPROM_ADDRESS_SIZE) {
+        pointer = 0;
+        for (uint8_t i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; i++) {
+            pointer = (pointer << 8) | received[i];
+        }
+    }
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    command         = CMD_NONE;
+    received_length = 0;
+    bytes           = 0;
+    return true;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    receive_byte(data);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    bytes++;
+    if (command == CMD_RDSR) {
+        if (eeprom_mock_busy()) {
+            eeprom_mock_stats.busy_polls++;
+            return 0x01;
+        }
+        return write_enable ? 0x02 : 0x00;
+    }
+    return 0xFF;
+}
+
+spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        receive_byte(data[i]);
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    bytes += length;
+    // The EEPROM ignores reads during a write cycle
+    if (command != CMD_READ || eeprom_mock_busy()) {
+        memset(data, 0xFF, length);
+        return SPI_STATUS_SUCCESS;
+    }
+    eeprom_mock_stats.reads++;
+    for (uint16_t i = 0; i < length; i++) {
+        data[i] = eeprom_mock_data[pointer];
+        pointer = (pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_stop(void) {
+    if (command == CMD_NONE) {
+        return;
+    }
+    eeprom_mock_transaction(bytes + 1, SPI_MOCK_US_PER_BYTE);
+
+    if (!eeprom_mock_busy()) {
+        switch (command) {
+            case CMD_WREN:
+                write_enable = true;
+                break;
+            case CMD_WRDI:
+                write_enable = false;
+                break;
+            case CMD_WRITE:
+                if (write_enable && received_length > EXTERNAL_EEPROM_ADDRESS_SIZE) {
+                    eeprom_mock_program(pointer, &received[EXTERNAL_EEPROM_ADDRESS_SIZE], received_length - EXTERNAL_EEPROM_ADDRESS_SIZE);
+                    write_enable = false;
+                }
+                break;
+        }
+    }
+    command = CMD_NONE;
+}
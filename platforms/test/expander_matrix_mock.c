@@ -0,0 +1,244 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "expander_matrix_mock.h"
+#include "expander_matrix.h"
+#include "i2c_master.h"
+#include "timer.h"
+#include "wait.h"
+#include "util.h"
+
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+enum {
+    REG_DIRECTION = 0x00, // IODIRA, 1 for inputs
+    REG_INTERRUPT = 0x04, // GPINTENA
+    REG_INPUT     = 0x12, // GPIOA, which writes OLATA
+    REG_OUTPUT    = 0x14, // OLATA
+    REG_COUNT     = 0x16,
+};
+#elif defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+enum {
+    REG_INPUT     = 0x00,
+    REG_OUTPUT    = 0x02,
+    REG_DIRECTION = 0x06, // 1 for inputs
+    REG_COUNT     = 0x08,
+};
+#endif
+
+static const pin_t   local_row_pins[]    = MATRIX_ROW_PINS;
+static const pin_t   local_col_pins[]    = MATRIX_COL_PINS;
+static const uint8_t expander_row_pins[] = EXPANDER_MATRIX_ROW_PINS;
+static const uint8_t expander_col_pins[] = EXPANDER_MATRIX_COL_PINS;
+#define LOCAL_ROWS ARRAY_SIZE(local_row_pins)
+
+expander_mock_stats_t expander_mock_stats;
+uint32_t              expander_mock_elapsed_us;
+
+static uint32_t clock_us = 0;
+static uint16_t switches[MATRIX_ROWS];
+static bool     connected;
+static uint8_t  registers[REG_COUNT];
+static uint16_t interrupt_reference; // the inputs as last read, which INT compares against
+static bool     interrupt_latched;
+static uint32_t local_outputs; // MCU pins set as outputs, which are always driven low here
+
+static void advance(uint32_t us) {
+    clock_us += us;
+    expander_mock_elapsed_us += us;
+}
+
+static uint16_t register_pair(uint8_t reg) {
+    return registers[reg] | registers[reg + 1] << 8;
+}
+
+static uint16_t expander_inputs(void) {
+    uint16_t levels = 0xFFFF & ~(~register_pair(REG_DIRECTION) & ~register_pair(REG_OUTPUT));
+    for (uint8_t row = 0; row < ARRAY_SIZE(expander_row_pins); row++) {
+        if (levels & (1 << expander_row_pins[row])) {
+            continue;
+        }
+        for (uint8_t col = 0; col < ARRAY_SIZE(expander_col_pins); col++) {
+            if (switches[LOCAL_ROWS + row] & (1 << col)) {
+                levels &= ~(1 << expander_col_pins[col]);
+            }
+        }
+    }
+    return levels;
+}
+
+static void update_interrupt(void) {
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+    if (connected && ((expander_inputs() ^ interrupt_reference) & register_pair(REG_INTERRUPT))) {
+        interrupt_latched = true;
+    }
+#endif
+}
+
+static void power_up(void) {
+    memset(registers, 0, sizeof(registers));
+    registers[REG_DIRECTION] = registers[REG_DIRECTION + 1] = 0xFF;
+#if defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+    registers[REG_OUTPUT] = registers[REG_OUTPUT + 1] = 0xFF;
+#endif
+    interrupt_reference = expander_inputs();
+    interrupt_latched   = false;
+}
+
+void expander_mock_reset(void) {
+    memset(switches, 0, sizeof(switches));
+    local_outputs = 0;
+    connected     = true;
+    power_up();
+    expander_mock_reset_stats();
+}
+
+void expander_mock_reset_stats(void) {
+    memset(&expander_mock_stats, 0, sizeof(expander_mock_stats));
+    expander_mock_elapsed_us = 0;
+}
+
+void expander_mock_set_switch(uint8_t row, uint8_t col, bool pressed) {
+    if (pressed) {
+        switches[row] |= 1 << col;
+    } else {
+        switches[row] &= ~(1 << col);
+    }
+    update_interrupt();
+}
+
+void expander_mock_set_connected(bool state) {
+    if (state && !connected) {
+        power_up();
+    }
+    connected         = state;
+    interrupt_latched = false;
+}
+
+uint32_t expander_mock_now_us(void) {
+    return clock_us;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// I2C
+
+static bool transaction(uint8_t address, uint16_t bytes) {
+    expander_mock_stats.transactions++;
+    if (!connected || address != EXPANDER_MATRIX_ADDRESS << 1) {
+        // Nothing acknowledges the address
+        expander_mock_stats.bytes++;
+        advance(EXPANDER_MOCK_US_PER_BYTE);
+        return false;
+    }
+    expander_mock_stats.bytes += bytes;
+    advance(bytes * EXPANDER_MOCK_US_PER_BYTE);
+    return true;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    // Address, register, then the data
+    if (!transaction(devaddr, 2 + length)) {
+        return I2C_STATUS_ERROR;
+    }
+
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t reg = regaddr + i;
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+        if (reg == REG_INPUT || reg == REG_INPUT + 1) {
+            reg += REG_OUTPUT - REG_INPUT;
+        }
+#endif
+        if (reg < REG_COUNT && reg != REG_INPUT && reg != REG_INPUT + 1) {
+            registers[reg] = data[i];
+        }
+    }
+    update_interrupt();
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout) {
+    // Address and register, then the address again and the data
+    if (!transaction(devaddr, 3 + length)) {
+        return I2C_STATUS_ERROR;
+    }
+
+    uint16_t inputs = expander_inputs();
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t reg = regaddr + i;
+        if (reg == REG_INPUT || reg == REG_INPUT + 1) {
+            data[i] = reg == REG_INPUT ? inputs & 0xFF : inputs >> 8;
+        } else {
+            data[i] = reg < REG_COUNT ? registers[reg] : 0;
+        }
+    }
+
+    if (regaddr <= REG_INPUT + 1 && regaddr + length > REG_INPUT) {
+        expander_mock_stats.reads++;
+        interrupt_reference = inputs;
+        interrupt_latched   = false;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MCU
+
+void expander_mock_set_pin_output(pin_t pin) {
+    local_outputs |= 1UL << pin;
+}
+
+void expander_mock_set_pin_input_high(pin_t pin) {
+    local_outputs &= ~(1UL << pin);
+}
+
+void expander_mock_write_pin_low(pin_t pin) {}
+
+bool expander_mock_read_pin(pin_t pin) {
+#ifdef EXPANDER_MATRIX_INT_PIN
+    if (pin == EXPANDER_MATRIX_INT_PIN) {
+        return !interrupt_latched;
+    }
+#endif
+
+    for (uint8_t col = 0; col < ARRAY_SIZE(local_col_pins); col++) {
+        if (local_col_pins[col] != pin) {
+            continue;
+        }
+        for (uint8_t row = 0; row < LOCAL_ROWS; row++) {
+            if ((local_outputs & (1UL << local_row_pins[row])) && (switches[row] & (1 << col))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void matrix_output_select_delay(void) {
+    advance(EXPANDER_MOCK_SELECT_DELAY_US);
+}
+
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {
+    advance(EXPANDER_MOCK_UNSELECT_DELAY_US);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Clock
+
+void wait_ms(uint32_t ms) {
+    advance(ms * 1000);
+}
+
+uint32_t timer_read32(void) {
+    return clock_us / 1000;
+}
+
+uint16_t timer_read(void) {
+    return (uint16_t)timer_read32();
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
@@ -0,0 +1,82 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Simulates a keyboard half behind an MCP23018 or PCA9555, plus the MCU's own rows, for testing the expander
+ * matrix.
+ *
+ * The simulated expander answers the i2c_master API with a register file like the real chip's, and its column pins
+ * follow whichever pressed switches connect them to a row pin being driven low. The MCU's pins are simulated the same
+ * way through the gpio API. Every I2C transaction is counted, and a clock of the time spent on the bus and in the
+ * matrix's delays drives `timer_read32()` and `wait_ms()`.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 400kHz, with 9 bits for each byte
+#define EXPANDER_MOCK_US_PER_BYTE 23
+
+// Time taken by each of the matrix's delays
+#define EXPANDER_MOCK_SELECT_DELAY_US 1
+#define EXPANDER_MOCK_UNSELECT_DELAY_US 30
+
+typedef uint8_t pin_t;
+
+#define gpio_set_pin_output(pin) expander_mock_set_pin_output(pin)
+#define gpio_set_pin_input_high(pin) expander_mock_set_pin_input_high(pin)
+#define gpio_write_pin_low(pin) expander_mock_write_pin_low(pin)
+#define gpio_read_pin(pin) expander_mock_read_pin(pin)
+
+typedef struct expander_mock_stats_t {
+    uint32_t transactions; // on the bus, from start to stop
+    uint32_t reads;        // of which read the input registers
+    uint32_t bytes;        // sent in either direction
+} expander_mock_stats_t;
+
+extern expander_mock_stats_t expander_mock_stats;
+extern uint32_t              expander_mock_elapsed_us;
+
+/**
+ * \brief Releases every switch, powers the expander back up with its registers at their defaults, and clears the
+ * statistics.
+ */
+void expander_mock_reset(void);
+
+/**
+ * \brief Clears the statistics, keeping the switches and registers.
+ */
+void expander_mock_reset_stats(void);
+
+/**
+ * \brief Presses or releases a switch, by its position in the matrix.
+ */
+void expander_mock_set_switch(uint8_t row, uint8_t col, bool pressed);
+
+/**
+ * \brief Unplugs the expander, which then doesn't acknowledge anything, or plugs it back in with its registers reset.
+ */
+void expander_mock_set_connected(bool connected);
+
+/**
+ * \brief Returns the simulated time.
+ */
+uint32_t expander_mock_now_us(void);
+
+// Used by the gpio macros
+void expander_mock_set_pin_output(pin_t pin);
+void expander_mock_set_pin_input_high(pin_t pin);
+void expander_mock_write_pin_low(pin_t pin);
+bool expander_mock_read_pin(pin_t pin);
+
+#ifdef __cplusplus
+}
+#endif
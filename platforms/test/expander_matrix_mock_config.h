@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// A split keyboard with six rows of seven keys on each half, like the ErgoDox
+#define MATRIX_ROWS 12
+#define MATRIX_COLS 7
+
+#define MATRIX_ROW_PINS {0, 1, 2, 3, 4, 5}
+#define MATRIX_COL_PINS {6, 7, 8, 9, 10, 11, 12}
+
+#define EXPANDER_MATRIX_ROW_PINS {0, 1, 2, 3, 4, 5}
+#define EXPANDER_MATRIX_COL_PINS {8, 9, 10, 11, 12, 13, 14}
+
+#include "expander_matrix_mock.h"
@@ -0,0 +1,223 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "expander_matrix.h"
+#include "expander_matrix_mock.h"
+#include "wait.h"
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+#    include "mcp23018.h"
+#elif defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+#    include "pca9555.h"
+#endif
+
+void matrix_init_custom(void);
+bool matrix_scan_custom(matrix_row_t current_matrix[]);
+}
+
+static const pin_t   local_row_pins[]    = MATRIX_ROW_PINS;
+static const pin_t   local_col_pins[]    = MATRIX_COL_PINS;
+static const uint8_t expander_row_pins[] = EXPANDER_MATRIX_ROW_PINS;
+static const uint8_t expander_col_pins[] = EXPANDER_MATRIX_COL_PINS;
+
+static const uint8_t local_rows = sizeof(local_row_pins);
+
+class ExpanderMatrix : public testing::Test {
+   protected:
+    matrix_row_t matrix[MATRIX_ROWS];
+
+    void SetUp() override {
+        expander_mock_reset();
+        memset(matrix, 0, sizeof(matrix));
+        matrix_init_custom();
+        matrix_scan_custom(matrix);
+        expander_mock_reset_stats();
+    }
+
+    uint32_t ScanUntilChanged(uint32_t limit = 100) {
+        for (uint32_t scans = 1; scans <= limit; scans++) {
+            if (matrix_scan_custom(matrix)) {
+                return scans;
+            }
+        }
+        return 0;
+    }
+
+    // Every row, every scan, after the MCU's rows, as the keyboards in the tree with an expander on one half do
+    void NaiveScan(matrix_row_t out[]) {
+        for (uint8_t row = 0; row < local_rows; row++) {
+            gpio_set_pin_output(local_row_pins[row]);
+            gpio_write_pin_low(local_row_pins[row]);
+            matrix_output_select_delay();
+            out[row] = 0;
+            for (uint8_t col = 0; col < sizeof(local_col_pins); col++) {
+                out[row] |= gpio_read_pin(local_col_pins[col]) ? 0 : 1 << col;
+            }
+            gpio_set_pin_input_high(local_row_pins[row]);
+            matrix_output_unselect_delay(row, out[row] != 0);
+        }
+
+        for (uint8_t row = 0; row < sizeof(expander_row_pins); row++) {
+            uint16_t pins = 0xFFFF;
+            uint16_t rows = ~(1 << expander_row_pins[row]);
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+            mcp23018_set_output_all(EXPANDER_MATRIX_ADDRESS, rows & 0xFF, rows >> 8);
+            mcp23018_read_pins_all(EXPANDER_MATRIX_ADDRESS, &pins);
+#elif defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+            pca9555_set_config_all(EXPANDER_MATRIX_ADDRESS, rows & 0xFF, rows >> 8);
+            pca9555_read_pins_all(EXPANDER_MATRIX_ADDRESS, &pins);
+#endif
+            out[local_rows + row] = 0;
+            for (uint8_t col = 0; col < sizeof(expander_col_pins); col++) {
+                out[local_rows + row] |= (pins & (1 << expander_col_pins[col])) ? 0 : 1 << col;
+            }
+        }
+    }
+};
+
+TEST_F(ExpanderMatrix, ReadsBothHalves) {
+    expander_mock_set_switch(1, 2, true);
+    expander_mock_set_switch(local_rows + 3, 4, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], row == 1 ? 1 << 2 : row == local_rows + 3 ? 1 << 4 : 0) << "row " << (int)row;
+    }
+
+    expander_mock_set_switch(1, 2, false);
+    expander_mock_set_switch(local_rows + 3, 4, false);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(matrix[row], 0) << "row " << (int)row;
+    }
+    EXPECT_FALSE(matrix_scan_custom(matrix));
+}
+
+TEST_F(ExpanderMatrix, KeysInTheSameColumnStayOnTheirRows) {
+    expander_mock_set_switch(local_rows + 0, 0, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    expander_mock_set_switch(local_rows + 2, 0, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    EXPECT_EQ(matrix[local_rows + 0], 1 << 0);
+    EXPECT_EQ(matrix[local_rows + 1], 0);
+    EXPECT_EQ(matrix[local_rows + 2], 1 << 0);
+
+    expander_mock_set_switch(local_rows + 0, 0, false);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    EXPECT_EQ(matrix[local_rows + 0], 0);
+    EXPECT_EQ(matrix[local_rows + 2], 1 << 0);
+}
+
+TEST_F(ExpanderMatrix, IdleScansBarelyTouchTheBus) {
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_FALSE(matrix_scan_custom(matrix));
+    }
+#ifdef EXPANDER_MATRIX_INT_PIN
+    EXPECT_EQ(expander_mock_stats.transactions, 0);
+#else
+    EXPECT_EQ(expander_mock_stats.transactions, 1000);
+#endif
+
+    // Keys on the MCU's half don't wake the expander
+    expander_mock_reset_stats();
+    expander_mock_set_switch(0, 0, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+#ifdef EXPANDER_MATRIX_INT_PIN
+    EXPECT_EQ(expander_mock_stats.transactions, 0);
+#endif
+}
+
+TEST_F(ExpanderMatrix, ScansFasterThanRowByRow) {
+    const int    scans = 1000;
+    matrix_row_t naive[MATRIX_ROWS];
+
+    for (int i = 0; i < scans; i++) {
+        NaiveScan(naive);
+    }
+    uint32_t naive_us           = expander_mock_elapsed_us;
+    uint32_t naive_transactions = expander_mock_stats.transactions;
+
+    // The naive scan left the rows as it pleased, so start over
+    matrix_init_custom();
+    matrix_scan_custom(matrix);
+    expander_mock_reset_stats();
+    for (int i = 0; i < scans; i++) {
+        matrix_scan_custom(matrix);
+    }
+    uint32_t idle_us = expander_mock_elapsed_us;
+
+    expander_mock_set_switch(local_rows + 5, 6, true);
+    matrix_scan_custom(matrix);
+    expander_mock_reset_stats();
+    for (int i = 0; i < scans; i++) {
+        matrix_scan_custom(matrix);
+    }
+    uint32_t held_us = expander_mock_elapsed_us;
+
+    printf("Scans per second: row by row %u (%u transactions each), expander matrix idle %u, with a key held %u\n", scans * 1000000U / naive_us, naive_transactions / scans, scans * 1000000U / idle_us, scans * 1000000U / held_us);
+    EXPECT_LT(idle_us * 4, naive_us);
+    EXPECT_LT(held_us, naive_us);
+}
+
+TEST_F(ExpanderMatrix, LatencyBeatsRowByRow) {
+    matrix_row_t naive[MATRIX_ROWS];
+    uint32_t     naive_latency = 0;
+    uint32_t     latency       = 0;
+
+    for (uint8_t row = 0; row < sizeof(expander_row_pins); row++) {
+        NaiveScan(naive);
+        uint32_t start = expander_mock_now_us();
+        expander_mock_set_switch(local_rows + row, 3, true);
+        NaiveScan(naive);
+        ASSERT_EQ(naive[local_rows + row], 1 << 3);
+        naive_latency = std::max(naive_latency, expander_mock_now_us() - start);
+        expander_mock_set_switch(local_rows + row, 3, false);
+    }
+
+    matrix_init_custom();
+    matrix_scan_custom(matrix);
+    for (uint8_t row = 0; row < sizeof(expander_row_pins); row++) {
+        matrix_scan_custom(matrix);
+        uint32_t start = expander_mock_now_us();
+        expander_mock_set_switch(local_rows + row, 3, true);
+        ASSERT_EQ(ScanUntilChanged(), 1);
+        ASSERT_EQ(matrix[local_rows + row], 1 << 3);
+        latency = std::max(latency, expander_mock_now_us() - start);
+        expander_mock_set_switch(local_rows + row, 3, false);
+        ASSERT_EQ(ScanUntilChanged(), 1);
+    }
+
+    printf("Worst latency from a key going down on the expander: row by row %uus, expander matrix %uus\n", naive_latency, latency);
+    EXPECT_LT(latency, naive_latency);
+}
+
+TEST_F(ExpanderMatrix, ReconnectsAfterUnplugging) {
+    expander_mock_set_switch(local_rows + 1, 1, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    EXPECT_TRUE(expander_matrix_is_connected());
+
+    expander_mock_set_connected(false);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    EXPECT_FALSE(expander_matrix_is_connected());
+    EXPECT_EQ(matrix[local_rows + 1], 0);
+
+    // The MCU's half carries on without it
+    expander_mock_set_switch(2, 2, true);
+    EXPECT_EQ(ScanUntilChanged(), 1);
+    EXPECT_EQ(matrix[2], 1 << 2);
+
+    // Left alone until the retry interval is up
+    expander_mock_set_connected(true);
+    expander_mock_reset_stats();
+    EXPECT_FALSE(matrix_scan_custom(matrix));
+    EXPECT_EQ(expander_mock_stats.transactions, 0);
+
+    wait_ms(EXPANDER_MATRIX_RETRY_INTERVAL);
+    EXPECT_TRUE(matrix_scan_custom(matrix));
+    EXPECT_TRUE(expander_matrix_is_connected());
+    EXPECT_EQ(matrix[local_rows + 1], 1 << 1);
+}
@@ -15,7 +15,12 @@
  */
 
 #include "platform_deps.h"
+#include "wait.h"
 
 void platform_setup(void) {
     // do nothing
 }
+
+void platform_low_power_wait_ms(uint16_t ms) {
+    wait_ms(ms);
+}
@@ -2,11 +2,13 @@ SYSTEM_TYPE := $(shell gcc -dumpmachine)
 GCC_VERSION := $(shell gcc --version 2>/dev/null)
 
 CC = $(CC_PREFIX) gcc
-OBJCOPY =
+# Host binutils, used to link the slave half of split keyboard tests
+LD ?= ld
+OBJCOPY ?= objcopy
 OBJDUMP =
 SIZE =
 AR =
-NM =
+NM ?= nm
 HEX =
 EEP =
 BIN =
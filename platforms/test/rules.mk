@@ -23,3 +23,64 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+eeprom_external_DEFS := \
+	-DEEPROM_DRIVER \
+	-DEXTERNAL_EEPROM_BYTE_COUNT=1024 \
+	-DEXTERNAL_EEPROM_PAGE_SIZE=32
+eeprom_external_INC := \
+	$(DRIVER_PATH) \
+	$(DRIVER_PATH)/eeprom
+eeprom_external_SRC := \
+	$(DRIVER_PATH)/eeprom/eeprom_driver.c \
+	$(DRIVER_PATH)/eeprom/eeprom_external_cache.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_external_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_external_tests.cpp
+
+eeprom_external_i2c_DEFS := $(eeprom_external_DEFS) -DEEPROM_I2C
+eeprom_external_i2c_INC := $(eeprom_external_INC)
+eeprom_external_i2c_SRC := \
+	$(eeprom_external_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_i2c.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_mock.c
+
+eeprom_external_spi_DEFS := $(eeprom_external_DEFS) -DEEPROM_SPI -DEXTERNAL_EEPROM_SPI_SLAVE_SELECT_PIN=0
+eeprom_external_spi_INC := $(eeprom_external_INC)
+eeprom_external_spi_SRC := \
+	$(eeprom_external_SRC) \
+	$(DRIVER_PATH)/eeprom/eeprom_spi.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_spi_mock.c
+
+expander_matrix_DEFS := -DNO_PRINT -DNO_DEBUG
+expander_matrix_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/expander_matrix_mock_config.h
+expander_matrix_INC := \
+	$(DRIVER_PATH) \
+	$(DRIVER_PATH)/gpio
+expander_matrix_SRC := \
+	$(QUANTUM_PATH)/expander_matrix.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/expander_matrix_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/expander_matrix_tests.cpp
+
+expander_matrix_mcp23018_DEFS := $(expander_matrix_DEFS) -DEXPANDER_MATRIX_DRIVER_MCP23018 -DEXPANDER_MATRIX_INT_PIN=20
+expander_matrix_mcp23018_CONFIG := $(expander_matrix_CONFIG)
+expander_matrix_mcp23018_INC := $(expander_matrix_INC)
+expander_matrix_mcp23018_SRC := \
+	$(expander_matrix_SRC) \
+	$(DRIVER_PATH)/gpio/mcp23018.c
+
+expander_matrix_pca9555_DEFS := $(expander_matrix_DEFS) -DEXPANDER_MATRIX_DRIVER_PCA9555
+expander_matrix_pca9555_CONFIG := $(expander_matrix_CONFIG)
+expander_matrix_pca9555_INC := $(expander_matrix_INC)
+expander_matrix_pca9555_SRC := \
+	$(expander_matrix_SRC) \
+	$(DRIVER_PATH)/gpio/pca9555.c
+
+ws2812_encode_DEFS := -DNO_PRINT -DNO_DEBUG
+ws2812_encode_INC := $(DRIVER_PATH)/led
+ws2812_encode_SRC := \
+	$(DRIVER_PATH)/led/ws2812_encode.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_encode_tests.cpp
+
+ws2812_encode_rgbw_DEFS := $(ws2812_encode_DEFS) -DWS2812_RGBW
+ws2812_encode_rgbw_INC := $(ws2812_encode_INC)
+ws2812_encode_rgbw_SRC := $(ws2812_encode_SRC)
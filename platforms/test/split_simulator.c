@@ -0,0 +1,302 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_simulator.h"
+
+#include <string.h>
+
+#include "serial.h"
+#include "transport.h"
+#include "transactions.h"
+
+void advance_time(uint32_t ms);
+
+// The slave half's copy of the firmware, renamed when it is linked in
+extern split_shared_memory_t *const slave_split_shmem;
+extern split_transaction_desc_t     slave_split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+void                                slave_eeconfig_init_quantum(void);
+void                                slave_keyboard_init(void);
+void                                slave_keyboard_task(void);
+void                                slave_housekeeping_task(void);
+#if defined(SERIAL_USART_FRAMED)
+bool serial_protocol_framed_transaction(uint8_t transaction_id);
+bool serial_protocol_framed_flush(void);
+bool slave_serial_protocol_framed_react(void);
+#endif
+
+matrix_row_t split_simulator_switches[MATRIX_ROWS];
+
+static split_simulator_config_t config;
+static split_simulator_stats_t  stats[NUM_TOTAL_TRANSACTIONS];
+static uint32_t                 random_state;
+static uint32_t                 pending_us;
+static bool                     initiator_ready = false;
+static bool                     target_ready    = false;
+
+// Each half decides its role from USB, which the simulator owns instead
+bool is_keyboard_master_impl(void) {
+    return true;
+}
+
+bool slave_is_keyboard_master_impl(void) {
+    return false;
+}
+
+void split_simulator_init(void) {
+    split_simulator_reset();
+    slave_eeconfig_init_quantum();
+    slave_keyboard_init();
+}
+
+void split_simulator_task(void) {
+    slave_keyboard_task();
+    slave_housekeeping_task();
+}
+
+void split_simulator_reset(void) {
+    config = (split_simulator_config_t){
+        .baud_rate       = SPLIT_SIMULATOR_BAUD_RATE,
+        .latency_us      = SPLIT_SIMULATOR_LATENCY_US,
+        .timeout_us      = SPLIT_SIMULATOR_TIMEOUT_US,
+        .corruption_rate = 0,
+        .seed            = 1,
+        .connected       = true,
+    };
+    random_state = config.seed;
+    pending_us   = 0;
+    memset(stats, 0, sizeof(stats));
+}
+
+void split_simulator_get_config(split_simulator_config_t *out) {
+    *out = config;
+}
+
+void split_simulator_set_config(const split_simulator_config_t *in) {
+    config       = *in;
+    random_state = config.seed ? config.seed : 1;
+}
+
+const split_simulator_stats_t *split_simulator_get_stats(int8_t transaction_id) {
+    static const split_simulator_stats_t none = {0};
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return &none;
+    }
+    return &stats[transaction_id];
+}
+
+void split_simulator_get_total_stats(split_simulator_stats_t *total) {
+    memset(total, 0, sizeof(split_simulator_stats_t));
+    for (uint8_t i = 0; i < NUM_TOTAL_TRANSACTIONS; i++) {
+        total->transactions += stats[i].transactions;
+        total->failures += stats[i].failures;
+        total->transfers += stats[i].transfers;
+        total->bytes += stats[i].bytes;
+        total->corrupted += stats[i].corrupted;
+        total->wire_us += stats[i].wire_us;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Wire
+
+static uint32_t next_random(void) {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static void wire_wait(split_simulator_stats_t *stat, uint32_t us) {
+    stat->wire_us += us;
+    pending_us += us;
+}
+
+// Moves bytes from one half to the other in a single burst, corrupting them as configured
+static void wire_transfer(split_simulator_stats_t *stat, uint8_t *destination, const uint8_t *source, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t byte = source[i];
+        if (config.corruption_rate && next_random() % config.corruption_rate == 0) {
+            byte ^= 1 << (next_random() % 8);
+            stat->corrupted++;
+        }
+        destination[i] = byte;
+    }
+    stat->bytes += length;
+    stat->transfers++;
+    wire_wait(stat, config.latency_us + (uint32_t)(((uint64_t)length * 10 * 1000000 + config.baud_rate - 1) / config.baud_rate));
+}
+
+// Hands the time spent on the wire to the shared clock, in whole milliseconds
+static void wire_settle(void) {
+    if (pending_us >= 1000) {
+        advance_time(pending_us / 1000);
+        pending_us %= 1000;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serial protocol -- mirrors the lock-step handshake of platforms/chibios/drivers/serial_protocol.c
+
+void soft_serial_initiator_init(void) {
+    initiator_ready = true;
+}
+
+void soft_serial_target_init(void) {
+    target_ready = true;
+}
+
+#if defined(SERIAL_USART_FRAMED)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Full-duplex line -- a loopback of the serial_transport_*() layer used by platforms/chibios/drivers/serial_protocol_framed.c
+//
+// Each direction has its own queue. The slave half runs whenever the master waits for bytes that haven't arrived yet.
+
+#    define WIRE_QUEUE_SIZE (2 * sizeof(split_shared_memory_t) + NUM_TOTAL_TRANSACTIONS + 8)
+
+typedef struct wire_queue_t {
+    uint8_t  data[WIRE_QUEUE_SIZE];
+    uint16_t head;
+    uint16_t tail;
+} wire_queue_t;
+
+static wire_queue_t             to_target;
+static wire_queue_t             to_initiator;
+static bool                     in_target = false;
+static split_simulator_stats_t *line_stat;
+
+static inline wire_queue_t *receive_queue(void) {
+    return in_target ? &to_target : &to_initiator;
+}
+
+void serial_transport_driver_clear(void) {
+    wire_queue_t *queue = receive_queue();
+    queue->head         = 0;
+    queue->tail         = 0;
+}
+
+void serial_transport_driver_slave_init(void) {}
+
+void serial_transport_driver_master_init(void) {}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    wire_queue_t *queue = in_target ? &to_initiator : &to_target;
+    if (queue->head == queue->tail) {
+        queue->head = 0;
+        queue->tail = 0;
+    }
+    if (queue->tail + size > WIRE_QUEUE_SIZE) {
+        return false;
+    }
+    wire_transfer(line_stat, &queue->data[queue->tail], source, size);
+    // Nobody hears them when the halves are apart, but they still take their time on the wire
+    if (config.connected) {
+        queue->tail += size;
+    }
+    return true;
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    wire_queue_t *queue = receive_queue();
+
+    if (!in_target && queue->tail - queue->head < size && config.connected && target_ready) {
+        // Whatever the slave couldn't make sense of is thrown away, as its protocol thread does
+        in_target = true;
+        if (!slave_serial_protocol_framed_react()) {
+            serial_transport_driver_clear();
+        }
+        in_target = false;
+    }
+
+    if (queue->tail - queue->head < size) {
+        if (!in_target) {
+            wire_wait(line_stat, config.timeout_us);
+        }
+        return false;
+    }
+
+    memcpy(destination, &queue->data[queue->head], size);
+    queue->head += size;
+    return true;
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return serial_transport_receive(destination, size);
+}
+
+#else
+
+static bool serve_transaction(split_simulator_stats_t *stat, uint8_t transaction_id) {
+    split_transaction_desc_t *initiator = &split_transaction_table[transaction_id];
+    uint8_t                  *shmem     = (uint8_t *)split_shmem;
+    uint8_t                  *target_shmem;
+    uint8_t                   received_id, handshake, reply;
+
+    // The target can only answer what it heard, and stays silent if it wasn't a transaction
+    wire_transfer(stat, &received_id, &transaction_id, sizeof(received_id));
+    if (!config.connected || !target_ready || received_id >= NUM_TOTAL_TRANSACTIONS) {
+        wire_wait(stat, config.timeout_us);
+        return false;
+    }
+
+    split_transaction_desc_t *target = &slave_split_transaction_table[received_id];
+    handshake                        = received_id ^ NUM_TOTAL_TRANSACTIONS;
+    wire_transfer(stat, &reply, &handshake, sizeof(reply));
+    if (reply != (transaction_id ^ NUM_TOTAL_TRANSACTIONS) || received_id != transaction_id) {
+        return false;
+    }
+
+    target_shmem = (uint8_t *)slave_split_shmem;
+    if (initiator->initiator2target_buffer_size) {
+        wire_transfer(stat, target_shmem + target->initiator2target_offset, shmem + initiator->initiator2target_offset, initiator->initiator2target_buffer_size);
+    }
+
+    if (target->slave_callback) {
+        target->slave_callback(target->initiator2target_buffer_size, target_shmem + target->initiator2target_offset, target->target2initiator_buffer_size, target_shmem + target->target2initiator_offset);
+    }
+
+    if (initiator->target2initiator_buffer_size) {
+        wire_transfer(stat, shmem + initiator->target2initiator_offset, target_shmem + target->target2initiator_offset, initiator->target2initiator_buffer_size);
+    }
+
+    return true;
+}
+
+#endif // defined(SERIAL_USART_FRAMED)
+
+bool soft_serial_transaction(int index) {
+    if (!initiator_ready || index < 0 || index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    split_simulator_stats_t *stat = &stats[index];
+    stat->transactions++;
+
+#if defined(SERIAL_USART_FRAMED)
+    line_stat = stat;
+    bool okay = serial_protocol_framed_transaction((uint8_t)index);
+#else
+    bool okay = serve_transaction(stat, (uint8_t)index);
+#endif
+    if (!okay) {
+        stat->failures++;
+    }
+
+    wire_settle();
+    return okay;
+}
+
+#if defined(SERIAL_USART_FRAMED)
+bool soft_serial_flush(void) {
+    if (!initiator_ready) {
+        return false;
+    }
+
+    // The frame's wire time is counted against the last transaction queued into it
+    bool okay = serial_protocol_framed_flush();
+
+    wire_settle();
+    return okay;
+}
+#endif // defined(SERIAL_USART_FRAMED)
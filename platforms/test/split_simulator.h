@@ -0,0 +1,97 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Runs both halves of a split keyboard within a unit test.
+ *
+ * Split keyboard tests link in a second copy of the firmware, with every symbol it defines prefixed by `slave_`, which
+ * is booted as the slave half. The two halves talk over a simulated half-duplex serial line, implemented at the
+ * `soft_serial_*()` level, which models the baud rate, per-transfer latency and byte corruption. Wire time is added to
+ * the shared test clock, so the time spent in split transactions shows up in everything that reads the timer.
+ *
+ * With `SERIAL_USART_FRAMED`, the halves instead run the framed protocol over a loopback of the `serial_transport_*()`
+ * layer, and the wire time of each frame is counted against the transaction that sent it. A frame of writes sent at
+ * the end of the master's pass is counted against the last write in it.
+ *
+ * The halves share their switches: pressing a key in the test presses it on whichever half scans that row.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "matrix.h"
+
+#ifndef SPLIT_SIMULATOR_BAUD_RATE
+#    ifdef SERIAL_USART_SPEED
+#        define SPLIT_SIMULATOR_BAUD_RATE SERIAL_USART_SPEED
+#    else
+#        define SPLIT_SIMULATOR_BAUD_RATE 230400
+#    endif
+#endif
+
+#ifndef SPLIT_SIMULATOR_LATENCY_US
+#    define SPLIT_SIMULATOR_LATENCY_US 20
+#endif
+
+#ifndef SPLIT_SIMULATOR_TIMEOUT_US
+#    ifdef SERIAL_USART_TIMEOUT
+#        define SPLIT_SIMULATOR_TIMEOUT_US (SERIAL_USART_TIMEOUT * 1000)
+#    else
+#        define SPLIT_SIMULATOR_TIMEOUT_US 20000
+#    endif
+#endif
+
+typedef struct split_simulator_config_t {
+    uint32_t baud_rate;       // bits per second, each byte taking 10 bits on the wire
+    uint32_t latency_us;      // added to every transfer, for turning the line around
+    uint32_t timeout_us;      // how long the initiator waits for a reply that never comes
+    uint32_t corruption_rate; // one in this many bytes has a bit flipped, or 0 for a clean line
+    uint32_t seed;            // seeds the corruption, so that runs are repeatable
+    bool     connected;       // when false, the slave half never answers
+} split_simulator_config_t;
+
+typedef struct split_simulator_stats_t {
+    uint32_t transactions; // started by the master half
+    uint32_t failures;     // of which were not completed
+    uint32_t transfers;    // bursts of bytes sent in one direction
+    uint32_t bytes;        // sent in either direction, including the handshake
+    uint32_t corrupted;    // bytes with a bit flipped in flight
+    uint32_t wire_us;      // time spent on the wire, including timeouts
+} split_simulator_stats_t;
+
+/**
+ * \brief The switches of both halves, indexed by the full keyboard's rows.
+ */
+extern matrix_row_t split_simulator_switches[MATRIX_ROWS];
+
+/**
+ * \brief Boots the slave half. Should be called before the master half's `keyboard_init()`.
+ */
+void split_simulator_init(void);
+
+/**
+ * \brief Runs one pass of the slave half's main loop.
+ */
+void split_simulator_task(void);
+
+/**
+ * \brief Restores the default line configuration, and clears the statistics.
+ */
+void split_simulator_reset(void);
+
+void split_simulator_get_config(split_simulator_config_t *config);
+void split_simulator_set_config(const split_simulator_config_t *config);
+
+/**
+ * \brief Returns the statistics for a single transaction ID.
+ */
+const split_simulator_stats_t *split_simulator_get_stats(int8_t transaction_id);
+
+/**
+ * \brief Sums the statistics over every transaction ID.
+ */
+void split_simulator_get_total_stats(split_simulator_stats_t *total);
@@ -1 +1 @@
-TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large eeprom_external_i2c eeprom_external_spi expander_matrix_mcp23018 expander_matrix_pca9555 ws2812_encode ws2812_encode_rgbw
@@ -0,0 +1,110 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_encode.h"
+}
+
+#define LED_COUNT 128
+
+// The encoding the SPI driver used before the lookup table
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+static void reference_encode(uint8_t *out, const ws2812_led_t *leds, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t channels[4] = {leds[i].r, leds[i].g, leds[i].b, 0};
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+        channels[0] = leds[i].g;
+        channels[1] = leds[i].r;
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+        channels[0] = leds[i].b;
+        channels[2] = leds[i].r;
+#endif
+#ifdef WS2812_RGBW
+        channels[3] = leds[i].w;
+#endif
+        for (uint8_t channel = 0; channel < sizeof(ws2812_led_t); channel++) {
+            for (int j = 0; j < 4; j++) {
+                *out++ = get_protocol_eq(channels[channel], j);
+            }
+        }
+    }
+}
+
+class WS2812Encode : public testing::Test {
+   protected:
+    ws2812_led_t leds[LED_COUNT];
+    uint32_t     encoded[LED_COUNT * sizeof(ws2812_led_t)];
+    uint8_t      expected[WS2812_SPI_ENCODED_SIZE(LED_COUNT)];
+
+    void SetUp() override {
+        uint32_t seed = 1;
+        for (uint16_t i = 0; i < sizeof(leds); i++) {
+            seed                  = seed * 1103515245 + 12345;
+            ((uint8_t *)leds)[i] = seed >> 16;
+        }
+    }
+};
+
+TEST_F(WS2812Encode, MatchesBitByBitEncoding) {
+    ws2812_encode_spi(encoded, leds, LED_COUNT);
+    reference_encode(expected, leds, LED_COUNT);
+    EXPECT_EQ(sizeof(encoded), sizeof(expected));
+    EXPECT_EQ(memcmp(encoded, expected, sizeof(expected)), 0);
+}
+
+TEST_F(WS2812Encode, EncodesEveryByteValue) {
+    for (uint16_t i = 0; i < sizeof(leds); i++) {
+        ((uint8_t *)leds)[i] = i;
+    }
+    ws2812_encode_spi(encoded, leds, LED_COUNT);
+    reference_encode(expected, leds, LED_COUNT);
+    EXPECT_EQ(memcmp(encoded, expected, sizeof(expected)), 0);
+
+    // Most significant bit first, four SPI bits for each
+    ws2812_led_t led;
+    memset(&led, 0, sizeof(led));
+    ((uint8_t *)&led)[0] = 0b10100000;
+    ws2812_encode_spi(encoded, &led, 1);
+    const uint8_t first[] = {0b11101000, 0b11101000, 0b10001000, 0b10001000};
+    EXPECT_EQ(memcmp(encoded, first, sizeof(first)), 0);
+}
+
+TEST_F(WS2812Encode, Benchmark) {
+    const int frames = 2000;
+    using clock      = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    for (int i = 0; i < frames; i++) {
+        leds[i % LED_COUNT].r = i;
+        reference_encode(expected, leds, LED_COUNT);
+    }
+    double reference_us = std::chrono::duration<double, std::micro>(clock::now() - start).count() / frames;
+
+    start = clock::now();
+    for (int i = 0; i < frames; i++) {
+        leds[i % LED_COUNT].r = i;
+        ws2812_encode_spi(encoded, leds, LED_COUNT);
+    }
+    double lut_us = std::chrono::duration<double, std::micro>(clock::now() - start).count() / frames;
+
+    printf("Host time to encode %u LEDs: bit by bit %.2fus, lookup table %.2fus\n", LED_COUNT, reference_us, lut_us);
+    EXPECT_EQ(memcmp(encoded, expected, sizeof(expected)), 0);
+}
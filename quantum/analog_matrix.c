@@ -0,0 +1,198 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "analog_matrix.h"
+
+#include <string.h>
+
+#define ANALOG_MATRIX_MAX_READING ((1 << ANALOG_MATRIX_RESOLUTION) - 1)
+
+_Static_assert(ANALOG_MATRIX_RESOLUTION + ANALOG_MATRIX_FILTER_SHIFT <= 16, "ANALOG_MATRIX_FILTER_SHIFT is too large for ANALOG_MATRIX_RESOLUTION");
+_Static_assert(((uint32_t)ANALOG_MATRIX_CALIBRATION_SWEEPS << ANALOG_MATRIX_RESOLUTION) <= 65536, "ANALOG_MATRIX_CALIBRATION_SWEEPS is too large for ANALOG_MATRIX_RESOLUTION");
+_Static_assert(ANALOG_MATRIX_CALIBRATION_SWEEPS > 0, "ANALOG_MATRIX_CALIBRATION_SWEEPS must be at least 1");
+
+static analog_matrix_config_t config = {
+    .actuation_point       = ANALOG_MATRIX_ACTUATION_POINT,
+    .hysteresis            = ANALOG_MATRIX_HYSTERESIS,
+    .rapid_trigger_release = ANALOG_MATRIX_RAPID_TRIGGER_RELEASE,
+    .rapid_trigger_press   = ANALOG_MATRIX_RAPID_TRIGGER_PRESS,
+};
+
+// Per-key state, kept in flat arrays so that each sweep walks memory in order
+static uint16_t filtered[MATRIX_ROWS * MATRIX_COLS];  // readings, scaled up by ANALOG_MATRIX_FILTER_SHIFT
+static uint16_t rest[MATRIX_ROWS * MATRIX_COLS];      // the sum of the readings while calibrating
+static uint16_t range[MATRIX_ROWS * MATRIX_COLS];     // readings between rest and bottom-out
+static uint8_t  travel[MATRIX_ROWS * MATRIX_COLS];    // 0 at rest to 255 at bottom-out
+static uint8_t  extreme[MATRIX_ROWS * MATRIX_COLS];   // deepest travel since pressing, or shallowest since releasing
+static uint8_t  actuation[MATRIX_ROWS * MATRIX_COLS]; // per-key actuation points, or 0 for the configured one
+
+static matrix_row_t pressed[MATRIX_ROWS];
+static matrix_row_t rapid_released[MATRIX_ROWS]; // released by rapid trigger, and not yet back up past the release point
+static uint8_t      calibration_sweeps = 0;
+
+void analog_matrix_get_config(analog_matrix_config_t *out) {
+    *out = config;
+}
+
+void analog_matrix_set_config(const analog_matrix_config_t *in) {
+    config = *in;
+}
+
+void analog_matrix_set_actuation_point(uint8_t row, uint8_t col, uint8_t actuation_point) {
+    actuation[row * MATRIX_COLS + col] = actuation_point;
+}
+
+uint8_t analog_matrix_get_actuation_point(uint8_t row, uint8_t col) {
+    uint8_t point = actuation[row * MATRIX_COLS + col];
+    return point ? point : config.actuation_point;
+}
+
+uint8_t analog_matrix_get_travel(uint8_t row, uint8_t col) {
+    return travel[row * MATRIX_COLS + col];
+}
+
+void analog_matrix_recalibrate(void) {
+    memset(rest, 0, sizeof(rest));
+    memset(travel, 0, sizeof(travel));
+    memset(pressed, 0, sizeof(pressed));
+    memset(rapid_released, 0, sizeof(rapid_released));
+    for (uint16_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+        range[key] = ANALOG_MATRIX_RANGE;
+    }
+    calibration_sweeps = 0;
+}
+
+static inline uint16_t oriented(uint16_t reading) {
+#ifdef ANALOG_MATRIX_PRESSED_LOW
+    return ANALOG_MATRIX_MAX_READING - reading;
+#else
+    return reading;
+#endif
+}
+
+static void calibrate(const uint16_t *readings) {
+    for (uint16_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+        rest[key] += oriented(readings[key]);
+    }
+
+    if (++calibration_sweeps < ANALOG_MATRIX_CALIBRATION_SWEEPS) {
+        return;
+    }
+
+    for (uint16_t key = 0; key < MATRIX_ROWS * MATRIX_COLS; key++) {
+        rest[key] /= ANALOG_MATRIX_CALIBRATION_SWEEPS;
+        filtered[key] = rest[key] << ANALOG_MATRIX_FILTER_SHIFT;
+    }
+}
+
+static uint8_t measure(uint16_t key, uint16_t reading) {
+    filtered[key] += oriented(reading) - (filtered[key] >> ANALOG_MATRIX_FILTER_SHIFT);
+    uint16_t value = filtered[key] >> ANALOG_MATRIX_FILTER_SHIFT;
+
+    // The rest reading follows the key out, so that it recovers from being calibrated while held down
+    if (value <= rest[key]) {
+        rest[key] = value;
+        return 0;
+    }
+
+    uint16_t deviation = value - rest[key];
+    if (deviation > range[key]) {
+        range[key] = deviation;
+    }
+
+    uint8_t depth = (uint32_t)deviation * 255 / range[key];
+    return depth < ANALOG_MATRIX_DEADZONE ? 0 : depth;
+}
+
+/**
+ * \brief Decides whether a key is pressed, from its travel and its previous state.
+ *
+ * Keys press at their actuation point, and release `hysteresis` short of it. With rapid trigger, a pressed key also
+ * releases as soon as it comes back up by `rapid_trigger_release` from the deepest point it reached, and then presses
+ * again as soon as it goes down by `rapid_trigger_press` from the shallowest, until it comes back up past the release point.
+ */
+static bool actuate(uint16_t key, uint8_t depth, bool was_pressed, bool *rapid) {
+    uint8_t point         = actuation[key] ? actuation[key] : config.actuation_point;
+    uint8_t release_point = point > config.hysteresis ? point - config.hysteresis : 0;
+
+    if (depth <= release_point) {
+        *rapid       = false;
+        extreme[key] = depth;
+        return false;
+    }
+
+    if (was_pressed) {
+        if (depth > extreme[key]) {
+            extreme[key] = depth;
+        }
+        if (config.rapid_trigger_release && depth + config.rapid_trigger_release <= extreme[key]) {
+            *rapid       = true;
+            extreme[key] = depth;
+            return false;
+        }
+        return true;
+    }
+
+    if (!*rapid) {
+        if (depth >= point) {
+            extreme[key] = depth;
+            return true;
+        }
+        return false;
+    }
+
+    if (depth < extreme[key]) {
+        extreme[key] = depth;
+    }
+    if (depth > extreme[key] && depth >= extreme[key] + config.rapid_trigger_press) {
+        *rapid       = false;
+        extreme[key] = depth;
+        return true;
+    }
+    return false;
+}
+
+void matrix_init_custom(void) {
+    analog_matrix_recalibrate();
+    analog_matrix_driver_init();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    const uint16_t *readings = analog_matrix_driver_sweep();
+    if (!readings) {
+        return false;
+    }
+
+    if (calibration_sweeps < ANALOG_MATRIX_CALIBRATION_SWEEPS) {
+        calibrate(readings);
+        return false;
+    }
+
+    bool     changed = false;
+    uint16_t key     = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t row_pressed = 0;
+        matrix_row_t row_rapid   = 0;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, key++) {
+            matrix_row_t mask  = MATRIX_ROW_SHIFTER << col;
+            bool         rapid = rapid_released[row] & mask;
+
+            travel[key] = measure(key, readings[key]);
+            if (actuate(key, travel[key], pressed[row] & mask, &rapid)) {
+                row_pressed |= mask;
+            }
+            if (rapid) {
+                row_rapid |= mask;
+            }
+        }
+
+        pressed[row]        = row_pressed;
+        rapid_released[row] = row_rapid;
+        if (current_matrix[row] != row_pressed) {
+            current_matrix[row] = row_pressed;
+            changed             = true;
+        }
+    }
+
+    return changed;
+}
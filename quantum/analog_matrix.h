@@ -0,0 +1,111 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Scans a matrix of analog (Hall-effect) switches.
+ *
+ * The driver delivers sweeps of raw readings, one per key, and the matrix turns them into key travel and then into
+ * presses and releases. It plugs into the common matrix code as a `CUSTOM_MATRIX = lite` implementation, so debouncing
+ * and everything after it works unchanged.
+ *
+ * Travel is measured from 0 at rest to 255 at bottom-out, on a scale each key calibrates for itself: its rest reading
+ * is learned at boot and follows the key whenever it reads further out, and its bottom-out reading grows to the
+ * deepest press seen.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "matrix.h"
+
+// Bits per reading from the driver
+#ifndef ANALOG_MATRIX_RESOLUTION
+#    define ANALOG_MATRIX_RESOLUTION 12
+#endif
+
+// Readings that fall as the key is pressed, such as from sensors facing the magnet's south pole
+// #define ANALOG_MATRIX_PRESSED_LOW
+
+// Readings between rest and bottom-out assumed for keys that haven't been bottomed out yet
+#ifndef ANALOG_MATRIX_RANGE
+#    define ANALOG_MATRIX_RANGE 500
+#endif
+
+// Sweeps averaged at boot to find each key's rest reading
+#ifndef ANALOG_MATRIX_CALIBRATION_SWEEPS
+#    define ANALOG_MATRIX_CALIBRATION_SWEEPS 16
+#endif
+
+// Weight of each new reading in the filtered one, as a power of two: 0 disables filtering
+#ifndef ANALOG_MATRIX_FILTER_SHIFT
+#    define ANALOG_MATRIX_FILTER_SHIFT 1
+#endif
+
+// Travel below which a key reads as fully released, to hide sensor noise
+#ifndef ANALOG_MATRIX_DEADZONE
+#    define ANALOG_MATRIX_DEADZONE 8
+#endif
+
+// Travel at which keys press
+#ifndef ANALOG_MATRIX_ACTUATION_POINT
+#    define ANALOG_MATRIX_ACTUATION_POINT 128
+#endif
+
+// How much shallower than the actuation point keys release
+#ifndef ANALOG_MATRIX_HYSTERESIS
+#    define ANALOG_MATRIX_HYSTERESIS 16
+#endif
+
+// Travel back up that releases a pressed key, wherever it is, or 0 to disable rapid trigger
+#ifndef ANALOG_MATRIX_RAPID_TRIGGER_RELEASE
+#    define ANALOG_MATRIX_RAPID_TRIGGER_RELEASE 0
+#endif
+
+// Travel down again that presses a key released by rapid trigger
+#ifndef ANALOG_MATRIX_RAPID_TRIGGER_PRESS
+#    define ANALOG_MATRIX_RAPID_TRIGGER_PRESS ANALOG_MATRIX_RAPID_TRIGGER_RELEASE
+#endif
+
+typedef struct analog_matrix_config_t {
+    uint8_t actuation_point;       // travel at which keys without their own actuation point press
+    uint8_t hysteresis;            // how much shallower than the actuation point keys release
+    uint8_t rapid_trigger_release; // travel back up that releases a pressed key, or 0 to disable rapid trigger
+    uint8_t rapid_trigger_press;   // travel down again that presses a key released by rapid trigger
+} analog_matrix_config_t;
+
+void analog_matrix_get_config(analog_matrix_config_t *config);
+void analog_matrix_set_config(const analog_matrix_config_t *config);
+
+/**
+ * \brief Gives a single key its own actuation point, or 0 to use the configured one.
+ */
+void analog_matrix_set_actuation_point(uint8_t row, uint8_t col, uint8_t actuation_point);
+
+uint8_t analog_matrix_get_actuation_point(uint8_t row, uint8_t col);
+
+/**
+ * \brief Returns how far a key is pressed, from 0 at rest to 255 at bottom-out.
+ */
+uint8_t analog_matrix_get_travel(uint8_t row, uint8_t col);
+
+/**
+ * \brief Forgets every key's calibration, and learns their rest readings again from the next sweeps.
+ */
+void analog_matrix_recalibrate(void);
+
+// Driver API
+
+/**
+ * \brief Starts sampling the keys.
+ */
+void analog_matrix_driver_init(void);
+
+/**
+ * \brief Returns the newest complete sweep of readings, `MATRIX_COLS` per row, or NULL when there hasn't been a new
+ * one since the last call. The readings stay valid until the next call.
+ */
+const uint16_t *analog_matrix_driver_sweep(void);
@@ -0,0 +1,84 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "audio_synth.h"
+
+static const uint16_t *synth_wavetable   = 0;
+static uint8_t         synth_phase_shift = 32; // shifts a phase down to an index into the wavetable
+static uint32_t        synth_sample_rate = 1;
+
+static uint32_t synth_phase[AUDIO_SYNTH_MAX_TONES]     = {0};
+static uint32_t synth_increment[AUDIO_SYNTH_MAX_TONES] = {0};
+static uint8_t  synth_tone_count                       = 0;
+static uint16_t synth_mix_scale                        = 0; // 1/synth_tone_count, as a 0.16 fraction
+
+void audio_synth_init(const uint16_t *wavetable, uint16_t length, uint32_t sample_rate) {
+    synth_wavetable   = wavetable;
+    synth_sample_rate = sample_rate;
+
+    synth_phase_shift = 32;
+    while (length > 1) {
+        length >>= 1;
+        synth_phase_shift--;
+    }
+
+    audio_synth_reset();
+}
+
+void audio_synth_set_tones(const float *frequencies, uint8_t count) {
+    if (count > AUDIO_SYNTH_MAX_TONES) {
+        count = AUDIO_SYNTH_MAX_TONES;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        // one full period of the waveform per 2^32 of phase; frequencies above the
+        // sample rate wrap around, just as they would alias when sampled
+        synth_increment[i] = (uint32_t)(((uint64_t)(frequencies[i] * 256.0f) << 24) / synth_sample_rate);
+    }
+
+    synth_tone_count = count;
+    synth_mix_scale  = count > 1 ? 0x10000 / count : 0;
+}
+
+void audio_synth_reset(void) {
+    for (uint8_t i = 0; i < AUDIO_SYNTH_MAX_TONES; i++) {
+        synth_phase[i] = 0;
+    }
+}
+
+uint8_t audio_synth_get_tone_count(void) {
+    return synth_tone_count;
+}
+
+uint16_t audio_synth_sample(void) {
+    uint32_t sum = 0;
+
+    for (uint8_t i = 0; i < synth_tone_count; i++) {
+        synth_phase[i] += synth_increment[i];
+        sum += synth_wavetable[synth_phase[i] >> synth_phase_shift];
+    }
+
+    // a single tone passes through unscaled, which also avoids needing 1.0 as a 0.16 fraction
+    if (synth_tone_count > 1) {
+        sum = (sum * synth_mix_scale) >> 16;
+    }
+    return sum;
+}
+
+void audio_synth_render(uint16_t *samples, uint16_t count) {
+    for (uint16_t s = 0; s < count; s++) {
+        samples[s] = audio_synth_sample();
+    }
+}
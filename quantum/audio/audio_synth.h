@@ -0,0 +1,75 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/* fixed-point additive wavetable synthesis
+ *
+ * each tone is a 32bit phase accumulator stepping through one shared wavetable,
+ * whose length has to be a power of two: the top bits of the phase index the
+ * table, and its overflow wraps the waveform around for free.
+ * frequencies are only converted into phase increments when the tones change,
+ * so generating a sample takes no floating point math nor division.
+ */
+
+#ifndef AUDIO_SYNTH_MAX_TONES
+#    ifdef AUDIO_MAX_SIMULTANEOUS_TONES
+#        define AUDIO_SYNTH_MAX_TONES AUDIO_MAX_SIMULTANEOUS_TONES
+#    else
+#        define AUDIO_SYNTH_MAX_TONES 8
+#    endif
+#endif
+
+/**
+ * @brief set the waveform and the rate at which samples are generated
+ *
+ * @param[in] wavetable one period of the waveform, which has to outlive the synthesizer
+ * @param[in] length number of samples in the wavetable, a power of two and at least 2
+ * @param[in] sample_rate samples generated per second
+ */
+void audio_synth_init(const uint16_t *wavetable, uint16_t length, uint32_t sample_rate);
+
+/**
+ * @brief set the frequencies to play
+ *
+ * @details each tone keeps its phase across changes, so a tone whose
+ *          frequency stays the same continues without a discontinuity
+ *
+ * @param[in] frequencies in Hz, of which only the first AUDIO_SYNTH_MAX_TONES are played
+ * @param[in] count number of frequencies, 0 to play silence
+ */
+void audio_synth_set_tones(const float *frequencies, uint8_t count);
+
+/**
+ * @brief restart every tone at the beginning of the waveform
+ */
+void audio_synth_reset(void);
+
+/**
+ * @brief number of tones currently being played
+ */
+uint8_t audio_synth_get_tone_count(void);
+
+/**
+ * @brief generate the next sample: the average of all tones, 0 when there are none
+ */
+uint16_t audio_synth_sample(void);
+
+/**
+ * @brief fill a block of samples, for example one half of a DMA buffer
+ */
+void audio_synth_render(uint16_t *samples, uint16_t count);
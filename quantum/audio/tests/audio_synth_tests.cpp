@@ -0,0 +1,190 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "audio_synth.h"
+}
+
+// The additive DAC driver's defaults: AUDIO_DAC_QUALITY_SANE_MINIMUM, with the 3/2 of its timer setup
+#define SAMPLE_RATE (16384 * 3 / 2)
+#define BLOCK_SIZE 32
+#define SAMPLE_MAX 4095
+
+static uint16_t sine[256];
+
+// A mono 16 bit WAV file in memory, filled a DMA half-buffer at a time
+struct WavBuffer {
+    std::vector<uint8_t>  header;
+    std::vector<uint16_t> samples;
+
+    explicit WavBuffer(float seconds) {
+        uint32_t count = (uint32_t)(seconds * SAMPLE_RATE) / BLOCK_SIZE * BLOCK_SIZE;
+        samples.resize(count);
+        for (uint32_t block = 0; block < count; block += BLOCK_SIZE) {
+            audio_synth_render(&samples[block], BLOCK_SIZE);
+        }
+
+        uint32_t data_size = count * 2;
+        auto     put32     = [this](uint32_t v) {
+            for (int i = 0; i < 4; i++) header.push_back(v >> (8 * i));
+        };
+        auto put16 = [this](uint16_t v) {
+            header.push_back(v & 0xFF);
+            header.push_back(v >> 8);
+        };
+        header.insert(header.end(), {'R', 'I', 'F', 'F'});
+        put32(36 + data_size);
+        header.insert(header.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+        put32(16);
+        put16(1); // PCM
+        put16(1); // mono
+        put32(SAMPLE_RATE);
+        put32(SAMPLE_RATE * 2);
+        put16(2);
+        put16(16);
+        header.insert(header.end(), {'d', 'a', 't', 'a'});
+        put32(data_size);
+    }
+
+    // Counts upward crossings of the midpoint, interpolated between samples
+    double Frequency() const {
+        const double mid   = SAMPLE_MAX / 2.0;
+        double       first = -1, last = -1;
+        uint32_t     crossings = 0;
+        for (size_t i = 1; i < samples.size(); i++) {
+            if (samples[i - 1] < mid && samples[i] >= mid) {
+                double at = i - 1 + (mid - samples[i - 1]) / (samples[i] - samples[i - 1]);
+                if (first < 0) {
+                    first = at;
+                } else {
+                    crossings++;
+                }
+                last = at;
+            }
+        }
+        return crossings * SAMPLE_RATE / (last - first);
+    }
+};
+
+// The floating point synthesis the additive DAC driver did before
+static float reference_index[8];
+
+static uint16_t reference_sample(const float *frequencies, uint8_t count) {
+    uint_fast16_t value = 0;
+    for (size_t i = 0; i < count; i++) {
+        float new_index = reference_index[i];
+        new_index += frequencies[i] * ((float)256 / SAMPLE_RATE);
+        while (new_index >= 256)
+            new_index -= 256;
+        reference_index[i] = new_index;
+        value += sine[(size_t)new_index] / count;
+    }
+    return value;
+}
+
+class AudioSynth : public testing::Test {
+   protected:
+    void SetUp() override {
+        for (int i = 0; i < 256; i++) {
+            sine[i] = std::lround(SAMPLE_MAX / 2.0 * (1 - std::cos(2 * M_PI * i / 256)));
+        }
+        audio_synth_init(sine, 256, SAMPLE_RATE);
+    }
+};
+
+TEST_F(AudioSynth, RendersAWavFile) {
+    const float a4 = 440.0f;
+    audio_synth_set_tones(&a4, 1);
+    WavBuffer wav(0.5f);
+
+    EXPECT_EQ(wav.header.size(), 44);
+    EXPECT_EQ(memcmp(wav.header.data(), "RIFF", 4), 0);
+    EXPECT_EQ(memcmp(wav.header.data() + 8, "WAVE", 4), 0);
+    EXPECT_EQ(wav.samples.size(), SAMPLE_RATE / 2 / BLOCK_SIZE * BLOCK_SIZE);
+}
+
+TEST_F(AudioSynth, PlaysInTune) {
+    // A2, A4, C6 and B8, the highest note in musical_notes.h
+    for (float frequency : {110.0f, 440.0f, 1046.5f, 7902.13f}) {
+        audio_synth_set_tones(&frequency, 1);
+        WavBuffer wav(1.0f);
+        EXPECT_NEAR(wav.Frequency(), frequency, frequency * 0.0005) << frequency << "Hz";
+    }
+}
+
+TEST_F(AudioSynth, MixesTonesWithinRange) {
+    const float chord[] = {261.63f, 329.63f, 392.0f, 523.25f};
+    audio_synth_set_tones(chord, 4);
+    EXPECT_EQ(audio_synth_get_tone_count(), 4);
+
+    WavBuffer wav(0.5f);
+    uint16_t  lowest = SAMPLE_MAX, highest = 0;
+    for (uint16_t sample : wav.samples) {
+        lowest  = std::min(lowest, sample);
+        highest = std::max(highest, sample);
+    }
+    EXPECT_LE(highest, SAMPLE_MAX);
+    EXPECT_GT(highest - lowest, SAMPLE_MAX / 2);
+
+    audio_synth_set_tones(chord, 0);
+    EXPECT_EQ(audio_synth_sample(), 0);
+}
+
+TEST_F(AudioSynth, TonesKeepTheirPhaseAcrossChanges) {
+    const float one[] = {440.0f};
+    const float two[] = {440.0f, 660.0f};
+
+    audio_synth_set_tones(one, 1);
+    WavBuffer uninterrupted(0.2f);
+
+    // A second tone coming and going, as the DAC driver updates its snapshot, doesn't disturb the first
+    audio_synth_reset();
+    audio_synth_set_tones(one, 1);
+    WavBuffer first(0.1f);
+    audio_synth_set_tones(two, 2);
+    audio_synth_set_tones(one, 1);
+    WavBuffer second(0.1f);
+
+    ASSERT_LE(first.samples.size() + second.samples.size(), uninterrupted.samples.size());
+    EXPECT_TRUE(std::equal(second.samples.begin(), second.samples.end(), uninterrupted.samples.begin() + first.samples.size()));
+}
+
+TEST_F(AudioSynth, Benchmark) {
+    const float notes[] = {261.63f, 329.63f, 392.0f, 523.25f, 659.25f, 783.99f, 1046.5f, 1318.51f};
+    const int   samples = SAMPLE_RATE;
+    using clock         = std::chrono::steady_clock;
+    uint16_t block[BLOCK_SIZE];
+    uint32_t sink = 0;
+
+    for (uint8_t count : {1, 2, 4, 8}) {
+        memset(reference_index, 0, sizeof(reference_index));
+        auto start = clock::now();
+        for (int s = 0; s < samples; s += BLOCK_SIZE) {
+            for (int i = 0; i < BLOCK_SIZE; i++) {
+                block[i] = reference_sample(notes, count);
+            }
+            sink += block[0];
+        }
+        double reference_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / samples;
+
+        audio_synth_set_tones(notes, count);
+        start = clock::now();
+        for (int s = 0; s < samples; s += BLOCK_SIZE) {
+            audio_synth_render(block, BLOCK_SIZE);
+            sink += block[0];
+        }
+        double synth_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / samples;
+
+        printf("Host time per sample with %u tones: floating point %.1fns, fixed point %.1fns\n", count, reference_ns, synth_ns);
+    }
+    EXPECT_NE(sink, 0);
+}
@@ -0,0 +1,6 @@
+audio_synth_DEFS := -DNO_PRINT -DNO_DEBUG -DAUDIO_SYNTH_MAX_TONES=8
+audio_synth_INC := $(QUANTUM_PATH)/audio
+
+audio_synth_SRC := \
+	$(QUANTUM_PATH)/audio/tests/audio_synth_tests.cpp \
+	$(QUANTUM_PATH)/audio/audio_synth.c
@@ -17,14 +17,18 @@
 #include "voices.h"
 #include "audio.h"
 #include "timer.h"
+#include "util.h"
 #include <stdlib.h>
 #include <math.h>
 
-uint8_t note_timbre      = TIMBRE_DEFAULT;
-bool    glissando        = false;
-bool    vibrato          = false;
-float   vibrato_strength = 0.5;
-float   vibrato_rate     = 0.125;
+uint8_t note_timbre = TIMBRE_DEFAULT;
+bool    glissando   = false;
+bool    vibrato     = false;
+
+// Only changed through the voice_*_vibrato_*() functions, which mark the cached factors as out of date
+static float vibrato_strength = 0.5;
+static float vibrato_rate     = 0.125;
+static bool  vibrato_dirty    = true; // vibrato_strength or vibrato_rate changed since voice_add_vibrato last used them
 
 uint16_t voices_timer = 0;
 
@@ -47,16 +51,27 @@ void voice_deiterate(void) {
 }
 
 #ifdef AUDIO_VOICES
-float mod(float a, int b) {
-    float r = fmod(a, b);
-    return r < 0 ? r + b : r;
+// vibrato_lut raised to vibrato_strength, and how long each entry lasts in 1/256ms;
+// recomputed only when either setting changes, instead of on every update
+static float    vibrato_factors[VIBRATO_LUT_LENGTH];
+static uint32_t vibrato_step = 0;
+
+static void vibrato_update(void) {
+    for (uint8_t i = 0; i < VIBRATO_LUT_LENGTH; i++) {
+        vibrato_factors[i] = pow(vibrato_lut[i], vibrato_strength);
+    }
+    vibrato_step  = MAX(1, (uint32_t)(100 * vibrato_rate * 256));
+    vibrato_dirty = false;
 }
 
 // Effect: 'vibrate' a given target frequency slightly above/below its initial value
 float voice_add_vibrato(float average_freq) {
-    float vibrato_counter = mod(timer_read() / (100 * vibrato_rate), VIBRATO_LUT_LENGTH);
+    if (vibrato_dirty) {
+        vibrato_update();
+    }
+    uint8_t vibrato_counter = ((uint32_t)timer_read() * 256 / vibrato_step) % VIBRATO_LUT_LENGTH;
 
-    return average_freq * pow(vibrato_lut[(int)vibrato_counter], vibrato_strength);
+    return average_freq * vibrato_factors[vibrato_counter];
 }
 
 // Effect: 'slides' the 'frequency' from the starting-point, to the target frequency
@@ -266,7 +281,7 @@ float voice_envelope(float frequency) {
                     break;
                 default:
                     // TODO: merge/replace with voice_add_vibrato above
-                    frequency = frequency * vibrato_lut[(int)fmod((((float)compensated_index - (VOICE_VIBRATO_DELAY + 1)) / 1000 * VOICE_VIBRATO_SPEED), VIBRATO_LUT_LENGTH)];
+                    frequency = frequency * vibrato_lut[((compensated_index - (VOICE_VIBRATO_DELAY + 1)) * VOICE_VIBRATO_SPEED / 1000) % VIBRATO_LUT_LENGTH];
                     break;
             }
             break;
@@ -334,22 +349,28 @@ float voice_envelope(float frequency) {
 // Vibrato functions
 
 void voice_set_vibrato_rate(float rate) {
-    vibrato_rate = rate;
+    vibrato_rate  = rate;
+    vibrato_dirty = true;
 }
 void voice_increase_vibrato_rate(float change) {
     vibrato_rate *= change;
+    vibrato_dirty = true;
 }
 void voice_decrease_vibrato_rate(float change) {
     vibrato_rate /= change;
+    vibrato_dirty = true;
 }
 void voice_set_vibrato_strength(float strength) {
     vibrato_strength = strength;
+    vibrato_dirty    = true;
 }
 void voice_increase_vibrato_strength(float change) {
     vibrato_strength *= change;
+    vibrato_dirty = true;
 }
 void voice_decrease_vibrato_strength(float change) {
     vibrato_strength /= change;
+    vibrato_dirty = true;
 }
 
 // Timbre functions
@@ -21,6 +21,7 @@
 #include "send_string.h"
 #include "keycodes.h"
 #include "nvm_dynamic_keymap.h"
+#include "nvm_transaction.h"
 
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
@@ -28,6 +29,10 @@
 #    define NUM_ENCODERS 0
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
+
 #ifndef DYNAMIC_KEYMAP_MACRO_DELAY
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
@@ -55,6 +60,9 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
+    // Stage every key, rather than writing them one at a time.
+    nvm_transaction_begin();
+
     // Erase the keymaps, if necessary.
     nvm_dynamic_keymap_erase();
 
@@ -72,6 +80,8 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+
+    nvm_transaction_commit();
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
@@ -79,7 +89,9 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    nvm_transaction_begin();
     nvm_dynamic_keymap_update_buffer(offset, size, data);
+    nvm_transaction_commit();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -111,7 +123,9 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    nvm_transaction_begin();
     nvm_dynamic_keymap_macro_update_buffer(offset, size, data);
+    nvm_transaction_commit();
 }
 
 static uint8_t dynamic_keymap_read_byte(uint32_t offset) {
@@ -133,8 +147,10 @@ char send_string_get_next_nvm(void *arg) {
 
 void dynamic_keymap_macro_reset(void) {
     // Erase the macros, if necessary.
+    nvm_transaction_begin();
     nvm_dynamic_keymap_macro_erase();
     nvm_dynamic_keymap_macro_reset();
+    nvm_transaction_commit();
 }
 
 void dynamic_keymap_macro_send(uint8_t id) {
@@ -167,5 +183,11 @@ void dynamic_keymap_macro_send(uint8_t id) {
     }
 
     send_string_nvm_state_t state = {.offset = offset};
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Fall back to typing it out immediately if the queue is full
+    if (send_string_async_with_delay_impl(send_string_get_next_nvm, &state, sizeof(state), DYNAMIC_KEYMAP_MACRO_DELAY, NULL, NULL) != INVALID_SEND_STRING_ASYNC_TOKEN) {
+        return;
+    }
+#endif
     send_string_with_delay_impl(send_string_get_next_nvm, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
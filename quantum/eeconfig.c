@@ -5,6 +5,7 @@
 #include "eeconfig.h"
 #include "action_layer.h"
 #include "nvm_eeconfig.h"
+#include "nvm_transaction.h"
 #include "keycode_config.h"
 
 #ifdef BACKLIGHT_ENABLE
@@ -39,6 +40,14 @@
 #    include "connection.h"
 #endif // CONNECTION_ENABLE
 
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "nvm_dynamic_macro.h"
+#endif // DYNAMIC_MACRO_ENABLE
+
+#ifdef AUTOCORRECT_ENABLE
+#    include "nvm_autocorrect.h"
+#endif // AUTOCORRECT_ENABLE
+
 #ifdef VIA_ENABLE
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -68,6 +77,9 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 }
 
 void eeconfig_init_quantum(void) {
+    // Stage the defaults, rather than writing each field as it is set
+    nvm_transaction_begin();
+
     nvm_eeconfig_erase();
 
     eeconfig_enable();
@@ -157,6 +169,17 @@ void eeconfig_init_quantum(void) {
     dynamic_keymap_reset();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    nvm_dynamic_macro_erase();
+#endif // DYNAMIC_MACRO_ENABLE
+
+#ifdef AUTOCORRECT_ENABLE
+    nvm_autocorrect_erase();
+#endif // AUTOCORRECT_ENABLE
+
+    // Keyboards may write to EEPROM directly, so everything must be in place beforehand
+    nvm_transaction_commit();
+
     eeconfig_init_kb();
 
 #ifdef RGB_MATRIX_ENABLE
@@ -36,6 +36,16 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EECONFIG_USER_DATA_VERSION (EECONFIG_USER_DATA_SIZE)
 #endif
 
+// Size of EEPROM dedicated to recorded dynamic macros, which are only kept across reboots if nonzero
+#ifndef DYNAMIC_MACRO_EEPROM_SIZE
+#    define DYNAMIC_MACRO_EEPROM_SIZE 0
+#endif
+
+// Size of EEPROM dedicated to an autocorrection dictionary loaded at runtime, which is only possible if nonzero
+#ifndef AUTOCORRECT_EEPROM_SIZE
+#    define AUTOCORRECT_EEPROM_SIZE 0
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
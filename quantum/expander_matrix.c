@@ -0,0 +1,260 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "expander_matrix.h"
+
+#include <string.h>
+
+#include "gpio.h"
+#include "timer.h"
+#include "util.h"
+#include "debug.h"
+
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+#    include "mcp23018.h"
+#elif defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+#    include "pca9555.h"
+#endif
+
+#if !defined(EXPANDER_MATRIX_ROW_PINS) || !defined(EXPANDER_MATRIX_COL_PINS)
+#    error "EXPANDER_MATRIX_ROW_PINS and EXPANDER_MATRIX_COL_PINS need to be defined for the expander matrix."
+#endif
+
+#ifdef MATRIX_ROW_PINS
+static const pin_t local_row_pins[] = MATRIX_ROW_PINS;
+static const pin_t local_col_pins[] = MATRIX_COL_PINS;
+#    define LOCAL_ROWS ARRAY_SIZE(local_row_pins)
+#    define LOCAL_COLS ARRAY_SIZE(local_col_pins)
+#else
+#    define LOCAL_ROWS 0
+#    define LOCAL_COLS 0
+#endif
+
+static const uint8_t expander_row_pins[] = EXPANDER_MATRIX_ROW_PINS;
+static const uint8_t expander_col_pins[] = EXPANDER_MATRIX_COL_PINS;
+#define EXPANDER_ROWS ARRAY_SIZE(expander_row_pins)
+#define EXPANDER_COLS ARRAY_SIZE(expander_col_pins)
+
+_Static_assert(LOCAL_ROWS + EXPANDER_ROWS == MATRIX_ROWS, "The MCU's rows and the expander's rows need to add up to MATRIX_ROWS");
+_Static_assert(LOCAL_COLS <= MATRIX_COLS && EXPANDER_COLS <= MATRIX_COLS, "More columns than MATRIX_COLS");
+
+static uint16_t expander_row_mask    = 0;
+static uint16_t expander_col_mask    = 0;
+static bool     expander_connected   = false;
+static bool     expander_busy        = false; // a key was down at the last look, so the rows need scanning one by one
+static uint32_t expander_retry_timer = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Expanders
+
+#if defined(EXPANDER_MATRIX_DRIVER_MCP23018)
+
+static void expander_init(void) {
+    mcp23018_init(EXPANDER_MATRIX_ADDRESS);
+}
+
+// Row pins are open-drain outputs, selected by driving them low
+static bool expander_setup(void) {
+    uint16_t inputs = ~expander_row_mask;
+    return mcp23018_set_config(EXPANDER_MATRIX_ADDRESS, mcp23018_PORTA, inputs & 0xFF) && mcp23018_set_config(EXPANDER_MATRIX_ADDRESS, mcp23018_PORTB, inputs >> 8)
+#    ifdef EXPANDER_MATRIX_INT_PIN
+           && mcp23018_set_interrupt_on_change(EXPANDER_MATRIX_ADDRESS, expander_col_mask)
+#    endif
+        ;
+}
+
+static bool expander_select(uint16_t rows) {
+    uint16_t levels = ~rows;
+    return mcp23018_set_output_all(EXPANDER_MATRIX_ADDRESS, levels & 0xFF, levels >> 8);
+}
+
+static bool expander_read(uint16_t *pins) {
+    return mcp23018_read_pins_all(EXPANDER_MATRIX_ADDRESS, pins);
+}
+
+#elif defined(EXPANDER_MATRIX_DRIVER_PCA9555)
+
+static void expander_init(void) {
+    pca9555_init(EXPANDER_MATRIX_ADDRESS);
+}
+
+// Outputs are latched low, and rows are selected by turning their pins into outputs
+static bool expander_setup(void) {
+    return pca9555_set_output_all(EXPANDER_MATRIX_ADDRESS, ALL_LOW, ALL_LOW) && pca9555_set_config_all(EXPANDER_MATRIX_ADDRESS, ALL_INPUT, ALL_INPUT);
+}
+
+static bool expander_select(uint16_t rows) {
+    uint16_t inputs = ~rows;
+    return pca9555_set_config_all(EXPANDER_MATRIX_ADDRESS, inputs & 0xFF, inputs >> 8);
+}
+
+static bool expander_read(uint16_t *pins) {
+    return pca9555_read_pins_all(EXPANDER_MATRIX_ADDRESS, pins);
+}
+
+#endif
+
+static matrix_row_t expander_pins_to_row(uint16_t pins) {
+    matrix_row_t row = 0;
+    for (uint8_t col = 0; col < EXPANDER_COLS; col++) {
+        if (!(pins & (1 << expander_col_pins[col]))) {
+            row |= MATRIX_ROW_SHIFTER << col;
+        }
+    }
+    return row;
+}
+
+/**
+ * \brief Reads the columns with every row selected, which shows whether any key is down and clears INT.
+ */
+static bool expander_probe(bool *any_down) {
+    uint16_t pins;
+    if (!expander_read(&pins)) {
+        return false;
+    }
+    *any_down = (~pins & expander_col_mask) != 0;
+    return true;
+}
+
+static bool expander_read_row(uint8_t row, matrix_row_t *out) {
+    uint16_t pins;
+    if (!expander_select(1 << expander_row_pins[row]) || !expander_read(&pins)) {
+        return false;
+    }
+    *out = expander_pins_to_row(pins);
+    return true;
+}
+
+static void expander_connect(void) {
+    expander_connected   = expander_setup() && expander_select(expander_row_mask);
+    expander_busy        = expander_connected; // look at every row once, which also clears INT
+    expander_retry_timer = timer_read32();
+}
+
+static void expander_disconnect(matrix_row_t current_matrix[]) {
+    dprintf("expander_matrix: the expander stopped answering\n");
+    expander_connected   = false;
+    expander_busy        = false;
+    expander_retry_timer = timer_read32();
+    memset(&current_matrix[LOCAL_ROWS], 0, sizeof(matrix_row_t) * EXPANDER_ROWS);
+}
+
+bool expander_matrix_is_connected(void) {
+    return expander_connected;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MCU pins
+
+#ifdef MATRIX_ROW_PINS
+
+static void local_init_pins(void) {
+    for (uint8_t row = 0; row < LOCAL_ROWS; row++) {
+        gpio_set_pin_input_high(local_row_pins[row]);
+    }
+    for (uint8_t col = 0; col < LOCAL_COLS; col++) {
+        gpio_set_pin_input_high(local_col_pins[col]);
+    }
+}
+
+/**
+ * \brief Reads one of the MCU's rows, and leaves it unselected but not yet settled.
+ */
+static matrix_row_t local_read_row(uint8_t row) {
+    matrix_row_t value = 0;
+
+    gpio_set_pin_output(local_row_pins[row]);
+    gpio_write_pin_low(local_row_pins[row]);
+    matrix_output_select_delay();
+
+    for (uint8_t col = 0; col < LOCAL_COLS; col++) {
+        if (gpio_read_pin(local_col_pins[col]) == 0) {
+            value |= MATRIX_ROW_SHIFTER << col;
+        }
+    }
+
+    gpio_set_pin_input_high(local_row_pins[row]);
+    return value;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Matrix
+
+void matrix_init_custom(void) {
+#ifdef MATRIX_ROW_PINS
+    local_init_pins();
+#endif
+#ifdef EXPANDER_MATRIX_INT_PIN
+    gpio_set_pin_input_high(EXPANDER_MATRIX_INT_PIN);
+#endif
+
+    for (uint8_t row = 0; row < EXPANDER_ROWS; row++) {
+        expander_row_mask |= 1 << expander_row_pins[row];
+    }
+    for (uint8_t col = 0; col < EXPANDER_COLS; col++) {
+        expander_col_mask |= 1 << expander_col_pins[col];
+    }
+
+    expander_init();
+    expander_connect();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    matrix_row_t previous[MATRIX_ROWS];
+    memcpy(previous, current_matrix, sizeof(previous));
+
+    if (!expander_connected && timer_elapsed32(expander_retry_timer) >= EXPANDER_MATRIX_RETRY_INTERVAL) {
+        expander_connect();
+    }
+
+    // With nothing down at the last look, the rows only need scanning once INT goes low, or without INT, once a read
+    // with every row selected shows a key down
+    bool scan_expander = expander_connected && expander_busy;
+    if (expander_connected && !expander_busy) {
+#ifdef EXPANDER_MATRIX_INT_PIN
+        scan_expander = gpio_read_pin(EXPANDER_MATRIX_INT_PIN) == 0;
+#else
+        if (!expander_probe(&scan_expander)) {
+            expander_disconnect(current_matrix);
+        }
+#endif
+    }
+
+    // Each expander row's transfers stand in for the settling time of the MCU's row of the same index
+    bool expander_ok = true;
+    for (uint8_t row = 0; row < MAX(LOCAL_ROWS, EXPANDER_ROWS); row++) {
+#ifdef MATRIX_ROW_PINS
+        if (row < LOCAL_ROWS) {
+            current_matrix[row] = local_read_row(row);
+        }
+#endif
+        if (scan_expander && expander_ok && row < EXPANDER_ROWS) {
+            expander_ok = expander_read_row(row, &current_matrix[LOCAL_ROWS + row]);
+        } else if (row < LOCAL_ROWS) {
+            matrix_output_unselect_delay(row, current_matrix[row] != 0);
+        }
+    }
+
+    if (scan_expander) {
+        expander_busy = false;
+        for (uint8_t row = 0; row < EXPANDER_ROWS; row++) {
+            expander_busy |= current_matrix[LOCAL_ROWS + row] != 0;
+        }
+
+        // Once everything is up, select every row again for the next look
+        if (expander_ok && !expander_busy) {
+            expander_ok = expander_select(expander_row_mask);
+#ifdef EXPANDER_MATRIX_INT_PIN
+            expander_ok = expander_ok && expander_probe(&expander_busy);
+#endif
+        }
+
+        if (!expander_ok) {
+            expander_disconnect(current_matrix);
+        }
+    }
+
+    return memcmp(previous, current_matrix, sizeof(previous)) != 0;
+}
@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Scans a matrix whose rows are split between the MCU's own pins and an I2C I/O expander.
+ *
+ * The MCU's rows come first, wired COL2ROW to `MATRIX_ROW_PINS` and `MATRIX_COL_PINS` as in the standard matrix, and
+ * are followed by the expander's rows. The expander's rows and columns are given as its pin numbers, 0 to 7 for the
+ * first port and 8 to 15 for the second.
+ *
+ * Between scans, every expander row is left selected, so that a single read of the expander shows whether any of its
+ * keys are down, and any key going down trips the expander's INT line. The expander's rows are only scanned one by one
+ * while something is down; otherwise the scan costs one read, or nothing at all if INT is wired and hasn't tripped.
+ * Each row's I2C transfers run while the MCU's row of the same index settles, in place of the usual delay.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "matrix.h"
+
+// 7-bit I2C address of the expander
+#ifndef EXPANDER_MATRIX_ADDRESS
+#    define EXPANDER_MATRIX_ADDRESS 0x20
+#endif
+
+// The expander's row and column pins
+// #define EXPANDER_MATRIX_ROW_PINS { 0, 1, 2, 3, 4, 5 }
+// #define EXPANDER_MATRIX_COL_PINS { 8, 9, 10, 11, 12, 13, 14 }
+
+// The MCU pin wired to the expander's INT output, which goes low when a key changes
+// #define EXPANDER_MATRIX_INT_PIN B2
+
+// How long to wait before trying to bring back an expander that stopped answering
+#ifndef EXPANDER_MATRIX_RETRY_INTERVAL
+#    define EXPANDER_MATRIX_RETRY_INTERVAL 1000
+#endif
+
+/**
+ * \brief Returns whether the expander is answering.
+ */
+bool expander_matrix_is_connected(void);
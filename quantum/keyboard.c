@@ -80,6 +80,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef KEY_OVERRIDE_ENABLE
 #    include "process_key_override.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
+#ifdef AUTOCORRECT_ENABLE
+#    include "process_autocorrect.h"
+#endif
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
@@ -125,6 +131,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef BATTERY_ENABLE
 #    include "battery.h"
 #endif
+#ifdef POWER_STATE_ENABLE
+#    include "power_state.h"
+#endif
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 #endif
@@ -149,6 +158,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string_async.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -225,6 +237,12 @@ uint32_t get_matrix_scan_rate(void) {
 #    define matrix_scan_perf_task()
 #endif
 
+#ifdef POWER_STATE_ENABLE
+#    define matrix_scan_due() power_state_scan_due()
+#else
+#    define matrix_scan_due() true
+#endif
+
 #ifdef MATRIX_HAS_GHOST
 static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
     matrix_row_t out = 0;
@@ -508,6 +526,12 @@ void keyboard_init(void) {
 #ifdef STENO_ENABLE_ALL
     steno_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
+#if defined(AUTOCORRECT_ENABLE) && AUTOCORRECT_EEPROM_SIZE > 0
+    autocorrect_dictionary_init();
+#endif
 #if defined(NKRO_ENABLE) && defined(FORCE_NKRO)
 #    pragma message "FORCE_NKRO option is now deprecated - Please migrate to NKRO_DEFAULT_ON instead."
     keymap_config.nkro = 1;
@@ -535,6 +559,9 @@ void keyboard_init(void) {
 #ifdef BATTERY_ENABLE
     battery_init();
 #endif
+#ifdef POWER_STATE_ENABLE
+    power_state_init();
+#endif
 #ifdef BLUETOOTH_ENABLE
     bluetooth_init();
 #endif
@@ -584,7 +611,7 @@ static inline void generate_tick_event(void) {
  * @return false Matrix didn't change
  */
 static bool matrix_task(void) {
-    if (!matrix_can_read()) {
+    if (!matrix_can_read() || !matrix_scan_due()) {
         generate_tick_event();
         return false;
     }
@@ -699,6 +726,10 @@ void quantum_task(void) {
 #ifdef LAYER_LOCK_ENABLE
     layer_lock_task();
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -746,6 +777,10 @@ void keyboard_task(void) {
     }
 #endif
 
+#ifdef POWER_STATE_ENABLE
+    power_state_task();
+#endif
+
 #ifdef OLED_ENABLE
     oled_task();
 #    if OLED_TIMEOUT > 0
@@ -796,4 +831,8 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef EEPROM_DRIVER
+    eeprom_driver_task();
+#endif
 }
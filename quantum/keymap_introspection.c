@@ -17,6 +17,10 @@
 #include "keymap_introspection.h"
 #include "util.h"
 
+#ifdef KEYMAP_PACKED_ENABLE
+#    include "keymap_packed.h"
+#endif // KEYMAP_PACKED_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Key mapping
 
@@ -38,7 +42,12 @@ STATIC_ASSERT(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers excee
 
 uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
+#ifdef KEYMAP_PACKED_ENABLE
+        // Only the size of keymaps is used, so the dense copy is left out of the firmware
+        return keymap_packed_keycode(layer_num, row * MATRIX_COLS + column);
+#else
         return pgm_read_word(&keymaps[layer_num][row][column]);
+#endif // KEYMAP_PACKED_ENABLE
     }
     return KC_TRNS;
 }
@@ -149,6 +158,55 @@ __attribute__((weak)) tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx)
 
 #endif // defined(TAP_DANCE_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Key mapping
+
+#if defined(LEADER_ENABLE) && defined(LEADER_MAP_ENABLE)
+
+uint16_t leader_map_count_raw(void) {
+    return ARRAY_SIZE(leader_map);
+}
+
+__attribute__((weak)) uint16_t leader_map_count(void) {
+    return leader_map_count_raw();
+}
+
+STATIC_ASSERT(ARRAY_SIZE(leader_map) <= 256, "Number of leader sequences exceeds maximum of 256.");
+
+uint16_t leader_map_sequence_key_raw(uint16_t sequence_idx, uint8_t key_idx) {
+    if (sequence_idx < leader_map_count_raw() && key_idx < ARRAY_SIZE(leader_map[0].keys)) {
+        return pgm_read_word(&leader_map[sequence_idx].keys[key_idx]);
+    }
+    return KC_NO;
+}
+
+__attribute__((weak)) uint16_t leader_map_sequence_key(uint16_t sequence_idx, uint8_t key_idx) {
+    return leader_map_sequence_key_raw(sequence_idx, key_idx);
+}
+
+uint16_t leader_map_keycode_raw(uint16_t sequence_idx) {
+    if (sequence_idx < leader_map_count_raw()) {
+        return pgm_read_word(&leader_map[sequence_idx].keycode);
+    }
+    return KC_NO;
+}
+
+__attribute__((weak)) uint16_t leader_map_keycode(uint16_t sequence_idx) {
+    return leader_map_keycode_raw(sequence_idx);
+}
+
+static uint8_t leader_map_sorted_order[ARRAY_SIZE(leader_map)];
+
+uint8_t* leader_map_order(void) {
+    return leader_map_sorted_order;
+}
+
+uint16_t leader_map_order_size(void) {
+    return ARRAY_SIZE(leader_map_sorted_order);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_MAP_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Key Overrides
 
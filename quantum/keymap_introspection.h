@@ -89,6 +89,33 @@ tap_dance_action_t* tap_dance_get(uint16_t tap_dance_idx);
 
 #endif // defined(TAP_DANCE_ENABLE)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Key mapping
+
+#if defined(LEADER_ENABLE) && defined(LEADER_MAP_ENABLE)
+
+// Get the number of sequences defined in the leader map, stored in firmware rather than any other persistent storage
+uint16_t leader_map_count_raw(void);
+// Get the number of sequences defined in the leader map, potentially stored dynamically
+uint16_t leader_map_count(void);
+
+// Get a key of a leader map sequence, stored in firmware rather than any other persistent storage
+uint16_t leader_map_sequence_key_raw(uint16_t sequence_idx, uint8_t key_idx);
+// Get a key of a leader map sequence, potentially stored dynamically
+uint16_t leader_map_sequence_key(uint16_t sequence_idx, uint8_t key_idx);
+
+// Get the keycode tapped by a leader map sequence, stored in firmware rather than any other persistent storage
+uint16_t leader_map_keycode_raw(uint16_t sequence_idx);
+// Get the keycode tapped by a leader map sequence, potentially stored dynamically
+uint16_t leader_map_keycode(uint16_t sequence_idx);
+
+// Get the scratch space, with one byte per sequence, that the Leader Key feature sorts the sequences into
+uint8_t* leader_map_order(void);
+// Get the number of sequences the scratch space has room for, beyond which sequences are ignored
+uint16_t leader_map_order_size(void);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_MAP_ENABLE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Key Overrides
 
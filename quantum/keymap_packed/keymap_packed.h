@@ -0,0 +1,35 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "progmem.h"
+#include "keycodes.h"
+
+/* The keymap, generated at build time from the compiled keymaps array.
+ *
+ * Each layer stores a bitmap of the matrix positions it has an entry for, with the entries themselves packed into
+ * keymap_packed_values. Positions left out read back as KC_TRNS, or as KC_NO where keymap_packed_fill_no says so,
+ * which covers matrix positions without a key. keymap_packed_rank holds the index of the first value of each bitmap
+ * byte, so a lookup is a popcount of one byte rather than a walk through the layer.
+ */
+
+#define KEYMAP_PACKED_BITMAP_BYTES (((MATRIX_ROWS) * (MATRIX_COLS) + 7) / 8)
+
+extern const uint8_t  keymap_packed_fill_no[KEYMAP_PACKED_BITMAP_BYTES];
+extern const uint8_t  keymap_packed_stored[][KEYMAP_PACKED_BITMAP_BYTES];
+extern const uint16_t keymap_packed_rank[][KEYMAP_PACKED_BITMAP_BYTES];
+extern const uint16_t keymap_packed_values[];
+
+// Get the keycode at position (row * MATRIX_COLS + column) of a layer, which the caller has checked is in range
+static inline uint16_t keymap_packed_keycode(uint8_t layer, uint16_t position) {
+    uint16_t index  = position / 8;
+    uint8_t  mask   = 1 << (position % 8);
+    uint8_t  stored = pgm_read_byte(&keymap_packed_stored[layer][index]);
+
+    if (stored & mask) {
+        uint16_t rank = pgm_read_word(&keymap_packed_rank[layer][index]) + __builtin_popcount(stored & (mask - 1));
+        return pgm_read_word(&keymap_packed_values[rank]);
+    }
+    return (pgm_read_byte(&keymap_packed_fill_no[index]) & mask) ? KC_NO : KC_TRNS;
+}
@@ -0,0 +1,282 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A 16 layer keymap for a full size board, both the way keymap.c lays it out and packed by generate-keymap-packed-c
+
+#include "keymap_packed.h"
+#include "compiler_support.h"
+
+const uint16_t PROGMEM keymap_packed_test_dense[16][MATRIX_ROWS][MATRIX_COLS] = {
+    {
+        {0x0029, 0x0000, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F, 0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0035, 0x001E, 0x001F, 0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027, 0x002D, 0x002E, 0x002A, 0x0049, 0x004A, 0x004B, 0x0053, 0x0054, 0x0055, 0x0056},
+        {0x002B, 0x0014, 0x001A, 0x0008, 0x0015, 0x0017, 0x001C, 0x0018, 0x000C, 0x0012, 0x0013, 0x002F, 0x0030, 0x0031, 0x004C, 0x004D, 0x004E, 0x005F, 0x0060, 0x0061, 0x0057},
+        {0x2039, 0x0004, 0x0016, 0x0007, 0x0009, 0x000A, 0x000B, 0x000D, 0x000E, 0x000F, 0x0033, 0x0034, 0x0000, 0x0028, 0x0000, 0x0000, 0x0000, 0x005C, 0x005D, 0x005E, 0x0000},
+        {0x00E1, 0x0000, 0x001D, 0x001B, 0x0006, 0x0019, 0x0005, 0x0011, 0x0010, 0x0036, 0x0037, 0x0038, 0x0000, 0x00E5, 0x0000, 0x0052, 0x0000, 0x0059, 0x005A, 0x005B, 0x0058},
+        {0x00E0, 0x00E3, 0x00E2, 0x0000, 0x0000, 0x0000, 0x412C, 0x0000, 0x0000, 0x0000, 0x00E6, 0x5221, 0x0065, 0x00E4, 0x0050, 0x0051, 0x004F, 0x0062, 0x0000, 0x0063, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x00A5, 0x0001, 0x782F, 0x782A, 0x0001, 0x00AD, 0x0001, 0x0001, 0x0001, 0x00AA, 0x0001, 0x00B3, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x783E, 0x0001, 0x7822, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x782F, 0x0001, 0x782F, 0x0001, 0x0001, 0x00B1, 0x782F, 0x0001, 0x00B8, 0x782F, 0x00A6},
+        {0x0001, 0x0001, 0x0001, 0x782D, 0x00B9, 0x0001, 0x0001, 0x7822, 0x7838, 0x0001, 0x783D, 0x783F, 0x0001, 0x0001, 0x00AE, 0x783F, 0x0001, 0x7839, 0x0001, 0x0001, 0x0001},
+        {0x7833, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7834, 0x00C0, 0x0001, 0x0001, 0x0001, 0x783D, 0x0000, 0x7828, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x7825, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x7826, 0x0001, 0x0001, 0x00B6, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x7822, 0x00A9, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x00BD, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x00A8, 0x00B5, 0x0001, 0x0001, 0x783F, 0x0001, 0x782F, 0x0001, 0x0000, 0x00BC, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x00DF, 0x0001, 0x0234, 0x0001, 0x022E, 0x0001, 0x00D8, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x020D, 0x0001, 0x0001, 0x0001, 0x00D0, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x00DB, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0216, 0x0001, 0x0001, 0x021F, 0x0001, 0x0216, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x00D9, 0x0001, 0x0201, 0x021D, 0x020E, 0x0001},
+        {0x020A, 0x0001, 0x022B, 0x022E, 0x0001, 0x0236, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x00CF, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0220, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0221, 0x0001, 0x0001},
+        {0x022F, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x00D5, 0x0001, 0x0001, 0x0211, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x005E, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0060, 0x005C, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x001E, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x005D, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x001E, 0x0001, 0x0001, 0x0001, 0x0001, 0x0059, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0061, 0x0060, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0026, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x005F, 0x0025, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x005C, 0x0001, 0x0020, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x001F, 0x0000, 0x0059, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0025, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x005F, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x770A, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7709, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7719, 0x0001, 0x0001, 0x0001, 0x0001, 0x0009, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7710, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x771E, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x001C, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7713, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x770E, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x001A, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x000A, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0010, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7707, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7702, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7705, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0004, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x770C, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x001B, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0012, 0x0001},
+        {0x000E, 0x0001, 0x0001, 0x770C, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7713, 0x0001},
+        {0x0001, 0x0001, 0x7700, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x000F, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0015, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x771A, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x7706, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x000B, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7706, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0012, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0000, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x7715, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0015, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x000F, 0x7705, 0x0001, 0x0001, 0x0001, 0x0001, 0x0007, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7715, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x001A, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x7708, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7704, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7706, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x771F, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7716, 0x7714, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0011, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x771D},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x7712, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x770B, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x771F, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x000D, 0x0001, 0x0001, 0x770F, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0011},
+        {0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x771A, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+    {
+        {0x0001, 0x0000, 0x0001, 0x0013, 0x0001, 0x770A, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0000},
+        {0x0001, 0x7700, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0001, 0x0001, 0x0000},
+        {0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0011, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0000, 0x0001, 0x0001, 0x0001, 0x0001},
+        {0x7712, 0x0001, 0x0001, 0x0000, 0x0000, 0x0000, 0x0001, 0x0000, 0x0000, 0x0000, 0x0015, 0x0001, 0x0001, 0x0004, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0001, 0x0000},
+    },
+};
+
+// Packed keymap: 16 layers, 247 of 2016 keycodes stored, 1278 bytes instead of 4032 (saves 2754 bytes)
+
+STATIC_ASSERT(KEYMAP_PACKED_BITMAP_BYTES == 16, "The packed keymap was generated for a different matrix size");
+
+const uint8_t PROGMEM keymap_packed_fill_no[KEYMAP_PACKED_BITMAP_BYTES] = {
+    0x02, 0x00, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE8, 0x28, 0x00, 0x15, 0x70, 0x07, 0x28,
+};
+
+const uint8_t PROGMEM keymap_packed_stored[][KEYMAP_PACKED_BITMAP_BYTES] = {
+    {
+        0xFD, 0xFF, 0xE1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x17, 0xD7, 0xFF, 0xEA, 0x8F, 0xF8, 0x17,
+    },
+    {
+        0xD0, 0xA2, 0x40, 0x81, 0xB2, 0x63, 0x36, 0x8B, 0x60, 0x14, 0x04, 0x09, 0x60, 0x08, 0x98, 0x12,
+    },
+    {
+        0x00, 0x55, 0x00, 0x22, 0x40, 0x48, 0x01, 0xBA, 0x16, 0x00, 0x00, 0x41, 0x40, 0x02, 0x20, 0x01,
+    },
+    {
+        0x10, 0x80, 0x21, 0x00, 0x20, 0x00, 0x21, 0x80, 0x41, 0x00, 0x86, 0x82, 0x02, 0x80, 0x40, 0x00,
+    },
+    {
+        0x10, 0x80, 0x00, 0x00, 0x42, 0x00, 0x00, 0x20, 0x80, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+    },
+    {
+        0x40, 0x80, 0x00, 0x00, 0x01, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x00, 0x00, 0x20, 0x00, 0x25, 0x00, 0x20, 0x02, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00,
+    },
+    {
+        0x20, 0x80, 0x20, 0x00, 0x04, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x02, 0x10, 0x00,
+    },
+    {
+        0x80, 0x00, 0x00, 0x00, 0x0C, 0x01, 0x04, 0x00, 0x00, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x08, 0x00, 0x00, 0x18, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    },
+    {
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    {
+        0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x02,
+    },
+    {
+        0x28, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x02, 0x48, 0x00,
+    },
+};
+
+const uint16_t PROGMEM keymap_packed_rank[][KEYMAP_PACKED_BITMAP_BYTES] = {
+    {
+        0, 7, 15, 19, 27, 35, 43, 51, 59, 67, 71, 77, 85, 90, 95, 100,
+    },
+    {
+        104, 107, 110, 111, 113, 117, 121, 125, 129, 131, 133, 134, 136, 138, 139, 142,
+    },
+    {
+        144, 144, 148, 148, 150, 151, 153, 154, 159, 162, 162, 162, 164, 165, 166, 167,
+    },
+    {
+        168, 169, 170, 172, 172, 173, 173, 175, 176, 178, 178, 181, 183, 184, 185, 186,
+    },
+    {
+        186, 187, 188, 188, 188, 190, 190, 190, 191, 192, 192, 192, 192, 193, 193, 193,
+    },
+    {
+        193, 193, 193, 193, 194, 195, 195, 195, 195, 195, 195, 196, 196, 196, 196, 197,
+    },
+    {
+        197, 198, 199, 199, 199, 200, 200, 200, 201, 201, 201, 201, 201, 201, 201, 201,
+    },
+    {
+        201, 201, 201, 201, 201, 201, 201, 201, 202, 203, 203, 203, 203, 203, 203, 203,
+    },
+    {
+        203, 203, 203, 203, 204, 204, 207, 207, 208, 209, 209, 209, 210, 210, 210, 210,
+    },
+    {
+        210, 211, 212, 213, 213, 214, 215, 215, 215, 215, 215, 215, 216, 216, 217, 218,
+    },
+    {
+        218, 219, 219, 219, 219, 221, 222, 223, 223, 223, 224, 224, 224, 225, 225, 225,
+    },
+    {
+        225, 225, 226, 226, 226, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227, 227,
+    },
+    {
+        227, 227, 228, 228, 228, 230, 231, 231, 231, 231, 231, 231, 231, 231, 232, 232,
+    },
+    {
+        232, 232, 233, 233, 233, 233, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235,
+    },
+    {
+        235, 235, 237, 237, 237, 237, 237, 237, 238, 238, 238, 238, 238, 238, 239, 239,
+    },
+    {
+        240, 242, 242, 243, 243, 243, 243, 243, 243, 243, 243, 243, 244, 244, 245, 247,
+    },
+};
+
+const uint16_t PROGMEM keymap_packed_values[] = {
+    0x0029, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F, 0x0040,
+    0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, 0x0048,
+    0x0035, 0x001E, 0x001F, 0x0020, 0x0021, 0x0022, 0x0023, 0x0024,
+    0x0025, 0x0026, 0x0027, 0x002D, 0x002E, 0x002A, 0x0049, 0x004A,
+    0x004B, 0x0053, 0x0054, 0x0055, 0x0056, 0x002B, 0x0014, 0x001A,
+    0x0008, 0x0015, 0x0017, 0x001C, 0x0018, 0x000C, 0x0012, 0x0013,
+    0x002F, 0x0030, 0x0031, 0x004C, 0x004D, 0x004E, 0x005F, 0x0060,
+    0x0061, 0x0057, 0x2039, 0x0004, 0x0016, 0x0007, 0x0009, 0x000A,
+    0x000B, 0x000D, 0x000E, 0x000F, 0x0033, 0x0034, 0x0028, 0x005C,
+    0x005D, 0x005E, 0x00E1, 0x001D, 0x001B, 0x0006, 0x0019, 0x0005,
+    0x0011, 0x0010, 0x0036, 0x0037, 0x0038, 0x00E5, 0x0052, 0x0059,
+    0x005A, 0x005B, 0x0058, 0x00E0, 0x00E3, 0x00E2, 0x412C, 0x00E6,
+    0x5221, 0x0065, 0x00E4, 0x0050, 0x0051, 0x004F, 0x0062, 0x0063,
+    0x00A5, 0x782F, 0x782A, 0x00AD, 0x00AA, 0x00B3, 0x783E, 0x7822,
+    0x782F, 0x782F, 0x00B1, 0x782F, 0x00B8, 0x782F, 0x00A6, 0x782D,
+    0x00B9, 0x7822, 0x7838, 0x783D, 0x783F, 0x00AE, 0x783F, 0x7839,
+    0x7833, 0x7834, 0x00C0, 0x783D, 0x7828, 0x7825, 0x7826, 0x00B6,
+    0x7822, 0x00A9, 0x00BD, 0x00A8, 0x00B5, 0x783F, 0x782F, 0x00BC,
+    0x00DF, 0x0234, 0x022E, 0x00D8, 0x020D, 0x00D0, 0x00DB, 0x0216,
+    0x021F, 0x0216, 0x00D9, 0x0201, 0x021D, 0x020E, 0x020A, 0x022B,
+    0x022E, 0x0236, 0x00CF, 0x0220, 0x0221, 0x022F, 0x00D5, 0x0211,
+    0x005E, 0x0060, 0x005C, 0x001E, 0x005D, 0x001E, 0x0059, 0x0061,
+    0x0060, 0x0026, 0x005F, 0x0025, 0x005C, 0x0020, 0x001F, 0x0059,
+    0x0025, 0x005F, 0x770A, 0x7709, 0x7719, 0x0009, 0x7710, 0x771E,
+    0x001C, 0x7713, 0x770E, 0x001A, 0x000A, 0x0010, 0x7707, 0x7702,
+    0x7705, 0x0004, 0x770C, 0x001B, 0x0012, 0x000E, 0x770C, 0x7713,
+    0x7700, 0x000F, 0x0015, 0x771A, 0x7706, 0x000B, 0x7706, 0x0012,
+    0x0000, 0x7715, 0x0015, 0x000F, 0x7705, 0x0007, 0x7715, 0x001A,
+    0x7708, 0x7704, 0x7706, 0x771F, 0x7716, 0x7714, 0x0011, 0x771D,
+    0x7712, 0x770B, 0x771F, 0x000D, 0x770F, 0x0000, 0x0011, 0x771A,
+    0x0013, 0x770A, 0x7700, 0x0011, 0x7712, 0x0015, 0x0004,
+};
@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keymap_packed.h"
+
+extern const uint16_t keymap_packed_test_dense[][MATRIX_ROWS][MATRIX_COLS];
+}
+
+#define LAYERS 16
+#define POSITIONS ((MATRIX_ROWS) * (MATRIX_COLS))
+#define VALUE_COUNT (keymap_packed_rank[LAYERS - 1][KEYMAP_PACKED_BITMAP_BYTES - 1] + __builtin_popcount(keymap_packed_stored[LAYERS - 1][KEYMAP_PACKED_BITMAP_BYTES - 1]))
+
+static uint64_t cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+TEST(KeymapPacked, MatchesTheDenseKeymap) {
+    for (uint8_t layer = 0; layer < LAYERS; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(keymap_packed_keycode(layer, row * MATRIX_COLS + column), keymap_packed_test_dense[layer][row][column]) << "layer " << (int)layer << " row " << (int)row << " column " << (int)column;
+            }
+        }
+    }
+}
+
+TEST(KeymapPacked, RanksCountTheValuesBeforeThem) {
+    uint16_t count = 0;
+    for (uint8_t layer = 0; layer < LAYERS; layer++) {
+        for (uint16_t i = 0; i < KEYMAP_PACKED_BITMAP_BYTES; i++) {
+            EXPECT_EQ(keymap_packed_rank[layer][i], count);
+            count += __builtin_popcount(keymap_packed_stored[layer][i]);
+        }
+    }
+    EXPECT_EQ(count, VALUE_COUNT);
+}
+
+TEST(KeymapPacked, SmallerThanTheDenseKeymap) {
+    using clock          = std::chrono::steady_clock;
+    const int     rounds = 2000;
+    volatile bool sink   = false;
+
+    size_t dense_size  = LAYERS * POSITIONS * sizeof(uint16_t);
+    size_t packed_size = sizeof(keymap_packed_fill_no) + LAYERS * (KEYMAP_PACKED_BITMAP_BYTES * 3) + VALUE_COUNT * sizeof(uint16_t);
+    printf("Flash for a %d layer keymap: dense %zu bytes, packed %zu bytes (saves %zu bytes)\n", LAYERS, dense_size, packed_size, dense_size - packed_size);
+    EXPECT_LT(packed_size, dense_size / 2);
+
+    // Keymap lookups go through a function, the same as keycode_at_keymap_location_raw
+    auto dense  = [](uint8_t layer, uint16_t position) __attribute__((noinline)) { return keymap_packed_test_dense[layer][position / MATRIX_COLS][position % MATRIX_COLS]; };
+    auto packed = [](uint8_t layer, uint16_t position) __attribute__((noinline)) { return keymap_packed_keycode(layer, position); };
+
+    auto     start       = clock::now();
+    uint64_t start_cycle = cycles();
+    for (int round = 0; round < rounds; round++) {
+        for (uint8_t layer = 0; layer < LAYERS; layer++) {
+            for (uint16_t position = 0; position < POSITIONS; position++) {
+                sink = dense(layer, position) == KC_TRNS;
+            }
+        }
+    }
+    double dense_cycles = (double)(cycles() - start_cycle) / (rounds * LAYERS * POSITIONS);
+    double dense_ns     = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * LAYERS * POSITIONS);
+
+    start       = clock::now();
+    start_cycle = cycles();
+    for (int round = 0; round < rounds; round++) {
+        for (uint8_t layer = 0; layer < LAYERS; layer++) {
+            for (uint16_t position = 0; position < POSITIONS; position++) {
+                sink = packed(layer, position) == KC_TRNS;
+            }
+        }
+    }
+    double packed_cycles = (double)(cycles() - start_cycle) / (rounds * LAYERS * POSITIONS);
+    double packed_ns     = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * LAYERS * POSITIONS);
+
+    printf("Host time per keymap lookup: dense %.1fns (%.1f cycles), packed %.1fns (%.1f cycles)\n", dense_ns, dense_cycles, packed_ns, packed_cycles);
+    (void)sink;
+}
@@ -0,0 +1,6 @@
+keymap_packed_DEFS := -DNO_PRINT -DNO_DEBUG -DMATRIX_ROWS=6 -DMATRIX_COLS=21
+keymap_packed_INC := $(QUANTUM_PATH)/keymap_packed
+
+keymap_packed_SRC := \
+	$(QUANTUM_PATH)/keymap_packed/tests/keymap_packed_tests.cpp \
+	$(QUANTUM_PATH)/keymap_packed/tests/keymap_packed_test_keymap.c
@@ -0,0 +1 @@
+TEST_LIST += keymap_packed
@@ -7,6 +7,11 @@
 
 #include <string.h>
 
+#ifdef LEADER_MAP_ENABLE
+#    include "keymap_introspection.h"
+#    include "quantum.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -25,6 +30,190 @@ __attribute__((weak)) bool leader_add_user(uint16_t keycode) {
     return false;
 }
 
+#ifdef LEADER_MAP_ENABLE
+__attribute__((weak)) bool leader_map_matched_user(uint16_t sequence_idx, uint16_t keycode) {
+    return true;
+}
+
+/* The sequences of leader_map are sorted key by key, with each sequence
+ * ahead of the longer ones it is a prefix of. That makes the sorted
+ * order a flattened trie: the sequences starting with whatever has been
+ * typed so far are always a single range of it, which each new key
+ * narrows down with a binary search. The first sequence of the range is
+ * the one matching exactly, if there is one.
+ *
+ * The order is worked out here, each time the leader key is pressed,
+ * rather than generated at build time, as leader_map_count() and
+ * leader_map_sequence_key() can be overridden to supply sequences that
+ * aren't in the compiled leader_map, and that may change at any time.
+ * If they supply more than the order has room for, every sequence is
+ * checked in turn instead.
+ */
+static bool     leader_map_linear = false;
+static uint16_t leader_map_lower  = 0;
+static uint16_t leader_map_upper  = 0;
+
+static int8_t leader_map_compare(uint16_t a, uint16_t b) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(leader_sequence); i++) {
+        uint16_t key_a = leader_map_sequence_key(a, i);
+        uint16_t key_b = leader_map_sequence_key(b, i);
+        if (key_a != key_b) {
+            return key_a < key_b ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static void leader_map_sort(void) {
+    uint8_t *order = leader_map_order();
+    uint16_t count = leader_map_count();
+
+    // Binary insertion, which keeps duplicates in their declared order
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t lower = 0;
+        uint16_t upper = i;
+        while (lower < upper) {
+            uint16_t middle = (lower + upper) / 2;
+            if (leader_map_compare(order[middle], i) <= 0) {
+                lower = middle + 1;
+            } else {
+                upper = middle;
+            }
+        }
+        memmove(&order[lower + 1], &order[lower], i - lower);
+        order[lower] = i;
+    }
+}
+
+static void leader_map_reset(void) {
+    leader_map_linear = leader_map_count() > leader_map_order_size();
+    if (!leader_map_linear) {
+        leader_map_sort();
+    }
+    leader_map_lower = 0;
+    leader_map_upper = leader_map_linear ? 0 : leader_map_count();
+}
+
+static void leader_map_advance(uint8_t position, uint16_t keycode) {
+    if (leader_map_linear) {
+        return;
+    }
+
+    const uint8_t *order = leader_map_order();
+    uint16_t       lower = leader_map_lower;
+    uint16_t       upper = leader_map_upper;
+
+    while (lower < upper) {
+        uint16_t middle = (lower + upper) / 2;
+        if (leader_map_sequence_key(order[middle], position) < keycode) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    leader_map_lower = lower;
+
+    upper = leader_map_upper;
+    while (lower < upper) {
+        uint16_t middle = (lower + upper) / 2;
+        if (leader_map_sequence_key(order[middle], position) <= keycode) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    leader_map_upper = lower;
+}
+
+/**
+ * \brief Whether a sequence has no more keys than have been typed.
+ */
+static bool leader_map_ends_here(uint16_t sequence_idx) {
+    return leader_sequence_size == ARRAY_SIZE(leader_sequence) || leader_map_sequence_key(sequence_idx, leader_sequence_size) == KC_NO;
+}
+
+/**
+ * \brief Checks every sequence against what has been typed, for when there are too many to sort.
+ *
+ * \param resolved Set when no sequence is left that is longer than the match.
+ * \return The index of the sequence that has been typed, or -1 if there is none.
+ */
+static int16_t leader_map_match_linear(bool *resolved) {
+    int16_t  match    = -1;
+    int16_t  longer   = -1;
+    uint16_t prefixed = 0;
+
+    for (uint16_t i = 0; i < leader_map_count(); i++) {
+        uint8_t key_idx = 0;
+        while (key_idx < leader_sequence_size && leader_map_sequence_key(i, key_idx) == leader_sequence[key_idx]) {
+            key_idx++;
+        }
+        if (key_idx < leader_sequence_size) {
+            continue;
+        }
+
+        prefixed++;
+        if (!leader_map_ends_here(i)) {
+            longer = i;
+        } else if (match < 0) {
+            match = i;
+        }
+    }
+
+    *resolved = prefixed == 1 || longer < 0;
+#    ifdef LEADER_MAP_RESOLVE_UNIQUE_PREFIX
+    if (prefixed == 1 && match < 0) {
+        return longer;
+    }
+#    endif
+    return match;
+}
+
+/**
+ * \brief The index of the sequence that has been typed, or -1 if there is none.
+ */
+static int16_t leader_map_match(void) {
+    if (leader_sequence_size == 0) {
+        return -1;
+    }
+    if (leader_map_linear) {
+        bool resolved;
+        return leader_map_match_linear(&resolved);
+    }
+    if (leader_map_lower == leader_map_upper) {
+        return -1;
+    }
+
+    uint8_t sequence_idx = leader_map_order()[leader_map_lower];
+    if (leader_map_ends_here(sequence_idx)) {
+        return sequence_idx;
+    }
+#    ifdef LEADER_MAP_RESOLVE_UNIQUE_PREFIX
+    if (leader_map_upper - leader_map_lower == 1) {
+        return sequence_idx;
+    }
+#    endif
+    return -1;
+}
+
+/**
+ * \brief Whether the sequence has matched, with no longer sequence left to type.
+ */
+static bool leader_map_resolved(void) {
+    if (leader_map_linear) {
+        bool resolved;
+        return leader_sequence_size > 0 && leader_map_match_linear(&resolved) >= 0 && resolved;
+    }
+    if (leader_map_match() < 0) {
+        return false;
+    }
+
+    // The last sequence of the range is the longest
+    uint8_t sequence_idx = leader_map_order()[leader_map_upper - 1];
+    return leader_map_upper - leader_map_lower == 1 || leader_map_ends_here(sequence_idx);
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -34,10 +223,22 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_MAP_ENABLE
+    leader_map_reset();
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_MAP_ENABLE
+    int16_t sequence_idx = leader_map_match();
+    if (sequence_idx >= 0) {
+        uint16_t keycode = leader_map_keycode(sequence_idx);
+        if (leader_map_matched_user(sequence_idx, keycode)) {
+            tap_code16(keycode);
+        }
+    }
+#endif
     leader_end_user();
 }
 
@@ -63,10 +264,18 @@ bool leader_sequence_add(uint16_t keycode) {
 #endif
 
     leader_sequence[leader_sequence_size] = keycode;
+#ifdef LEADER_MAP_ENABLE
+    leader_map_advance(leader_sequence_size, keycode);
+#endif
     leader_sequence_size++;
 
     if (leader_add_user(keycode)) {
         leader_end();
+#ifdef LEADER_MAP_ENABLE
+    } else if (leader_map_resolved()) {
+        // No need to wait for the timeout when no other sequence can match
+        leader_end();
+#endif
     }
     return true;
 }
@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,21 @@
  * \{
  */
 
+#ifdef LEADER_MAP_ENABLE
+/**
+ * \brief A leader sequence, and the keycode it taps.
+ */
+typedef struct leader_sequence_t {
+    uint16_t keys[5];
+    uint16_t keycode;
+} leader_sequence_t;
+
+/**
+ * \brief Declare an entry of `leader_map`, tapping `kc` once the sequence of up to five keys has been typed.
+ */
+#    define LEADER_SEQUENCE(kc, ...) {.keys = {__VA_ARGS__}, .keycode = (kc)}
+#endif
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -30,6 +47,18 @@ void leader_end_user(void);
  */
 bool leader_add_user(uint16_t keycode);
 
+#ifdef LEADER_MAP_ENABLE
+/**
+ * \brief User callback, invoked when the leader sequence ends on a sequence from `leader_map`.
+ *
+ * \param sequence_idx The index of the sequence in `leader_map`.
+ * \param keycode The keycode the sequence taps.
+ *
+ * \return `true` to tap the keycode, `false` if it has been handled.
+ */
+bool leader_map_matched_user(uint16_t sequence_idx, uint16_t keycode);
+#endif
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
@@ -30,6 +30,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef POWER_STATE_ENABLE
+#    include "power_state.h"
+#endif
+
 #ifndef LED_MATRIX_CENTER
 const led_point_t k_led_matrix_center = {112, 32};
 #else
@@ -154,7 +158,19 @@ __attribute__((weak)) int led_matrix_led_index(int index) {
     return index;
 }
 
+// Dim the output while idle, leaving the configured brightness alone
+static inline uint8_t led_matrix_power_state_dim(uint8_t value) {
+#ifdef POWER_STATE_ENABLE
+    uint8_t scale = power_state_brightness();
+    if (scale < UINT8_MAX) {
+        value = scale8_video(value, scale);
+    }
+#endif
+    return value;
+}
+
 void led_matrix_set_value(int index, uint8_t value) {
+    value = led_matrix_power_state_dim(value);
 #ifdef USE_CIE1931_CURVE
     value = pgm_read_byte(&CIE1931_CURVE[value]);
 #endif
@@ -166,6 +182,7 @@ void led_matrix_set_value_all(uint8_t value) {
     for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++)
         led_matrix_set_value(i, value);
 #else
+    value = led_matrix_power_state_dim(value);
 #    ifdef USE_CIE1931_CURVE
     led_matrix_driver.set_value_all(pgm_read_byte(&CIE1931_CURVE[value]));
 #    else
@@ -348,6 +365,9 @@ void led_matrix_task(void) {
 #if LED_MATRIX_TIMEOUT > 0
                              (last_input_activity_elapsed() > (uint32_t)LED_MATRIX_TIMEOUT) ||
 #endif // LED_MATRIX_TIMEOUT > 0
+#ifdef POWER_STATE_ENABLE
+                             (power_state_get() == POWER_STATE_SLEEP) ||
+#endif // POWER_STATE_ENABLE
                              false;
 
     uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
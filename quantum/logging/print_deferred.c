@@ -0,0 +1,215 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "print_deferred.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+_Static_assert((PRINT_DEFERRED_BUFFER_SIZE & (PRINT_DEFERRED_BUFFER_SIZE - 1)) == 0, "PRINT_DEFERRED_BUFFER_SIZE needs to be a power of two");
+_Static_assert(PRINT_DEFERRED_RECORD_SIZE < 254, "PRINT_DEFERRED_RECORD_SIZE needs to fit in a COBS block");
+
+// Where the linker put the format strings, which their IDs are counted from
+#if defined(__APPLE__)
+extern const char formats_start[] __asm("section$start$__TEXT$qmk_print_fmt");
+#else
+extern const char __start_qmk_print_formats[];
+#    define formats_start __start_qmk_print_formats
+#endif
+
+// Each record is stored as its length, followed by the bytes that are sent
+static uint8_t  buffer[PRINT_DEFERRED_BUFFER_SIZE];
+static uint16_t head    = 0;
+static uint16_t tail    = 0;
+static uint16_t dropped = 0;
+
+#define BUFFER_AT(index) buffer[(index) & (PRINT_DEFERRED_BUFFER_SIZE - 1)]
+
+// A record being written straight into the buffer after the length byte at `start`, until it is complete
+typedef struct record_t {
+    uint16_t start;
+    uint16_t end;
+    bool     overflow;
+} record_t;
+
+static bool record_reserve(record_t *record, uint8_t size) {
+    uint16_t length = record->end + size - record->start - 1;
+    if (length > PRINT_DEFERRED_RECORD_SIZE || (uint16_t)(record->end + size - tail) > PRINT_DEFERRED_BUFFER_SIZE) {
+        record->overflow = true;
+    }
+    return !record->overflow;
+}
+
+static void record_put(record_t *record, uint32_t value, uint8_t size) {
+    if (!record_reserve(record, size)) {
+        return;
+    }
+    for (uint8_t i = 0; i < size; i++) {
+        BUFFER_AT(record->end++) = value >> (8 * i);
+    }
+}
+
+static void record_put_string(record_t *record, const char *str) {
+    uint8_t length = 0;
+    while (length < PRINT_DEFERRED_STRING_LENGTH && str && str[length]) {
+        length++;
+    }
+    if (!record_reserve(record, 1 + length)) {
+        return;
+    }
+    BUFFER_AT(record->end++) = length;
+    for (uint8_t i = 0; i < length; i++) {
+        BUFFER_AT(record->end++) = str[i];
+    }
+}
+
+/**
+ * \brief Copies the arguments that each conversion in the format string takes, without formatting them.
+ */
+static void record_put_args(record_t *record, const char *format, va_list args) {
+    for (const char *c = format; *c; c++) {
+        if (*c != '%') {
+            continue;
+        }
+        if (*++c == '%') {
+            continue;
+        }
+
+        while (*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '0') {
+            c++;
+        }
+        if (*c == '*') {
+            record_put(record, va_arg(args, int), 4);
+            c++;
+        }
+        while (*c >= '0' && *c <= '9') {
+            c++;
+        }
+        if (*c == '.') {
+            if (*++c == '*') {
+                record_put(record, va_arg(args, int), 4);
+                c++;
+            }
+            while (*c >= '0' && *c <= '9') {
+                c++;
+            }
+        }
+
+        uint8_t size   = 4;
+        char    length = 0;
+        if (*c == 'h') {
+            size = 2;
+            if (*++c == 'h') {
+                size = 1;
+                c++;
+            }
+        } else if (*c == 'l' || *c == 'z' || *c == 'j' || *c == 't') {
+            length = *c++;
+            if (length == 'l' && *c == 'l') {
+                length = 'L';
+                c++;
+            }
+        }
+
+        switch (*c) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'b':
+                switch (length) {
+                    case 'l':
+                        record_put(record, va_arg(args, long), size);
+                        break;
+                    case 'L':
+                        record_put(record, va_arg(args, long long), size);
+                        break;
+                    case 'z':
+                        record_put(record, va_arg(args, size_t), size);
+                        break;
+                    case 'j':
+                    case 't':
+                        record_put(record, va_arg(args, ptrdiff_t), size);
+                        break;
+                    default:
+                        record_put(record, va_arg(args, int), size);
+                        break;
+                }
+                break;
+            case 'c':
+                record_put(record, va_arg(args, int), 1);
+                break;
+            case 'p':
+                record_put(record, (uintptr_t)va_arg(args, void *), 4);
+                break;
+            case 's':
+                record_put_string(record, va_arg(args, const char *));
+                break;
+            case '\0':
+                return;
+        }
+    }
+}
+
+void print_deferred(const char *format, ...) {
+    record_t record = {.start = head, .end = head + 1, .overflow = false};
+    record_put(&record, format - formats_start, 2);
+
+    va_list args;
+    va_start(args, format);
+    record_put_args(&record, format, args);
+    va_end(args);
+
+    if (record.overflow) {
+        if (dropped < UINT16_MAX) {
+            dropped++;
+        }
+        return;
+    }
+
+    BUFFER_AT(record.start) = record.end - record.start - 1;
+    head                    = record.end;
+}
+
+/**
+ * \brief Sends a record COBS encoded, so that the only zero byte is the one ending it.
+ */
+static void send_encoded(sendchar_func_t send, const uint8_t *data, uint8_t length) {
+    uint8_t start = 0;
+    for (uint8_t i = 0; i <= length; i++) {
+        if (i == length || data[i] == 0) {
+            send(i - start + 1);
+            for (uint8_t j = start; j < i; j++) {
+                send(data[j]);
+            }
+            start = i + 1;
+        }
+    }
+    send(0);
+}
+
+void print_deferred_drain(sendchar_func_t send) {
+    uint8_t data[PRINT_DEFERRED_RECORD_SIZE];
+
+    while (tail != head) {
+        uint8_t length = BUFFER_AT(tail++);
+        for (uint8_t i = 0; i < length; i++) {
+            data[i] = BUFFER_AT(tail++);
+        }
+        send_encoded(send, data, length);
+    }
+
+    // Anything dropped came after everything that was buffered
+    if (dropped) {
+        uint8_t notice[] = {PRINT_DEFERRED_DROPPED_ID & 0xFF, PRINT_DEFERRED_DROPPED_ID >> 8, dropped & 0xFF, dropped >> 8};
+        send_encoded(send, notice, sizeof(notice));
+        dropped = 0;
+    }
+}
+
+void print_deferred_task(void) {
+    print_deferred_drain(sendchar);
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \brief Defers formatting of `xprintf()` and everything built on it, such as `dprintf()` and `uprintf()`, to the host.
+ *
+ * Each call only stores an ID for its format string and its raw arguments in a ring buffer, which
+ * `print_deferred_task()` drains through `sendchar()` from the main loop. Format strings are collected into their own
+ * section when linking, which the build extracts into `<target>.fmt` for `qmk console-decode` to turn the console
+ * output back into text.
+ *
+ * Each record on the console is COBS encoded and ends with a zero byte. It starts with the offset of its format string
+ * in the section, as two bytes, followed by an argument for each conversion in the format string, including any `*`
+ * width or precision:
+ *
+ *  - `hh` integers and `%c` take one byte, `h` integers two, and every other integer and `%p` four, little-endian
+ *  - `%s` takes a length byte followed by up to `PRINT_DEFERRED_STRING_LENGTH` characters
+ *
+ * A record with the ID `0xFFFF` carries, in two bytes, the number of records dropped because the buffer was full.
+ */
+
+#include <stdint.h>
+
+#include "compiler_support.h"
+#include "sendchar.h"
+
+// Bytes buffered between drains, which needs to be a power of two
+#ifndef PRINT_DEFERRED_BUFFER_SIZE
+#    define PRINT_DEFERRED_BUFFER_SIZE 512
+#endif
+
+// Longest record, above which a call is dropped
+#ifndef PRINT_DEFERRED_RECORD_SIZE
+#    define PRINT_DEFERRED_RECORD_SIZE 64
+#endif
+
+// Characters kept from each `%s` argument
+#ifndef PRINT_DEFERRED_STRING_LENGTH
+#    define PRINT_DEFERRED_STRING_LENGTH 32
+#endif
+
+#define PRINT_DEFERRED_DROPPED_ID 0xFFFF
+
+#if defined(__APPLE__)
+#    define PRINT_DEFERRED_SECTION "__TEXT,qmk_print_fmt"
+#else
+#    define PRINT_DEFERRED_SECTION "qmk_print_formats"
+#endif
+
+/**
+ * \brief Places a format string in the section that the host reads them back from, and returns it.
+ *
+ * Only a string literal can be placed there, so any other format fails to compile. Text that is only known at run time
+ * needs printing through `%s` instead.
+ */
+#define PRINT_DEFERRED_FORMAT(fmt)                                                                   \
+    ({                                                                                               \
+        STATIC_ASSERT(__builtin_constant_p(fmt), "Deferred printing needs a string literal format"); \
+        static const char __attribute__((section(PRINT_DEFERRED_SECTION))) _format[] = "" fmt;       \
+        _format;                                                                                     \
+    })
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Buffers a record of the format string and its arguments. The format string needs to come from
+ * `PRINT_DEFERRED_FORMAT()`.
+ */
+void print_deferred(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * \brief Sends every buffered record through the given function.
+ */
+void print_deferred_drain(sendchar_func_t send);
+
+/**
+ * \brief Sends every buffered record through `sendchar()`, from the main loop.
+ */
+void print_deferred_task(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,187 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "print.h"
+#include "print_deferred.h"
+#include "printf.h"
+
+extern const char __start_qmk_print_formats[];
+}
+
+typedef std::vector<uint8_t> record;
+
+static std::vector<uint8_t> sent;
+
+static int8_t capture(uint8_t c) {
+    sent.push_back(c);
+    return 0;
+}
+
+static int8_t discard(uint8_t c) {
+    return 0;
+}
+
+static uint32_t counted = 0;
+
+static int8_t count(uint8_t c) {
+    counted++;
+    return 0;
+}
+
+// Undoes the COBS encoding of each record
+static std::vector<record> drain_records(void) {
+    sent.clear();
+    print_deferred_drain(capture);
+
+    std::vector<record> records;
+    record              current;
+    size_t              i = 0;
+    while (i < sent.size()) {
+        uint8_t code = sent[i++];
+        if (code == 0) {
+            records.push_back(current);
+            current.clear();
+            continue;
+        }
+        for (uint8_t j = 1; j < code; j++) {
+            EXPECT_NE(sent[i], 0);
+            current.push_back(sent[i++]);
+        }
+        if (code != 0xFF && sent[i] != 0) {
+            current.push_back(0);
+        }
+    }
+    EXPECT_TRUE(current.empty()) << "The last record isn't terminated";
+    return records;
+}
+
+static record id_of(const char *format) {
+    uint16_t id = format - __start_qmk_print_formats;
+    return {(uint8_t)(id & 0xFF), (uint8_t)(id >> 8)};
+}
+
+static record concat(record a, const record &b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
+class PrintDeferred : public testing::Test {
+   protected:
+    void SetUp() override {
+        print_deferred_drain(discard);
+    }
+};
+
+TEST_F(PrintDeferred, RecordsArgumentsWithoutFormatting) {
+    const char *format = PRINT_DEFERRED_FORMAT("key %u at %02X:%c %s\n");
+    print_deferred(format, 300, 0x1F, 'k', "down");
+
+    auto records = drain_records();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0], concat(id_of(format), {0x2C, 0x01, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 'k', 4, 'd', 'o', 'w', 'n'}));
+    EXPECT_STREQ(format, "key %u at %02X:%c %s\n");
+}
+
+TEST_F(PrintDeferred, ArgumentsTakeTheSizeOfTheirConversion) {
+    const char *format = PRINT_DEFERRED_FORMAT("%hhu %hd %ld %*d %.*s %% %p");
+    print_deferred(format, 0x1FF, -2, 0x12345678L, 5, -1, 3, "abcdef", (void *)0x40);
+
+    auto records = drain_records();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0], concat(id_of(format), {
+                                                    0xFF,                            // %hhu
+                                                    0xFE, 0xFF,                      // %hd
+                                                    0x78, 0x56, 0x34, 0x12,          // %ld
+                                                    5, 0, 0, 0,                      // *
+                                                    0xFF, 0xFF, 0xFF, 0xFF,          // %d
+                                                    3, 0, 0, 0,                      // .*
+                                                    6, 'a', 'b', 'c', 'd', 'e', 'f', // %s, which the precision doesn't shorten
+                                                    0x40, 0, 0, 0,                   // %p
+                                                }));
+}
+
+TEST_F(PrintDeferred, MacrosStoreTheirFormatStrings) {
+    xprintf("layer %d\n", 2);
+    print("hello\n");
+
+    auto records = drain_records();
+    ASSERT_EQ(records.size(), 2);
+    uint16_t layer_id = records[0][0] | records[0][1] << 8;
+    uint16_t hello_id = records[1][0] | records[1][1] << 8;
+    EXPECT_STREQ(__start_qmk_print_formats + layer_id, "layer %d\n");
+    EXPECT_STREQ(__start_qmk_print_formats + hello_id, "hello\n");
+    EXPECT_EQ(records[0].size(), 2 + 4);
+    EXPECT_EQ(records[1].size(), 2);
+}
+
+TEST_F(PrintDeferred, TruncatesLongStrings) {
+    const char *format = PRINT_DEFERRED_FORMAT("%s");
+    print_deferred(format, "0123456789012345678901234567890123456789");
+
+    auto records = drain_records();
+    ASSERT_EQ(records.size(), 1);
+    ASSERT_EQ(records[0].size(), 2 + 1 + PRINT_DEFERRED_STRING_LENGTH);
+    EXPECT_EQ(records[0][2], PRINT_DEFERRED_STRING_LENGTH);
+}
+
+TEST_F(PrintDeferred, CountsRecordsDroppedWhenFull) {
+    const char *format = PRINT_DEFERRED_FORMAT("scan %lu\n");
+    for (uint32_t i = 0; i < 100; i++) {
+        print_deferred(format, i);
+    }
+
+    // Each record takes a length byte, two for the ID and four for the argument
+    const uint32_t fits    = PRINT_DEFERRED_BUFFER_SIZE / 7;
+    auto           records = drain_records();
+    ASSERT_EQ(records.size(), fits + 1);
+    EXPECT_EQ(records[fits - 1], concat(id_of(format), {(uint8_t)(fits - 1), 0, 0, 0}));
+    EXPECT_EQ(records[fits], record({0xFF, 0xFF, (uint8_t)(100 - fits), 0}));
+
+    print_deferred(format, 7);
+    records = drain_records();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0], concat(id_of(format), {7, 0, 0, 0}));
+}
+
+TEST_F(PrintDeferred, CheaperThanFormatting) {
+    const int calls = 100000;
+    using clock     = std::chrono::steady_clock;
+
+    counted = 0;
+    print_set_sendchar(count);
+    auto start = clock::now();
+    for (int i = 0; i < calls; i++) {
+        printf_("%s: col %u row %u %s, layer %02X\n", "process_record", i % 16, i % 6, (i & 1) ? "down" : "up", i & 0xFF);
+    }
+    double   formatted_ns    = std::chrono::duration<double, std::nano>(clock::now() - start).count() / calls;
+    uint32_t formatted_bytes = counted;
+    print_set_sendchar([](uint8_t c) -> int8_t { return (int8_t)fputc(c, stdout); });
+
+    counted            = 0;
+    double deferred_ns = 0;
+    double drain_ns    = 0;
+    for (int i = 0; i < calls;) {
+        start = clock::now();
+        // A few records at a time, as the main loop would drain them
+        for (int j = 0; j < 8; j++, i++) {
+            xprintf("%s: col %u row %u %s, layer %02X\n", "process_record", i % 16, i % 6, (i & 1) ? "down" : "up", i & 0xFF);
+        }
+        auto logged = clock::now();
+        print_deferred_drain(count);
+        deferred_ns += std::chrono::duration<double, std::nano>(logged - start).count();
+        drain_ns += std::chrono::duration<double, std::nano>(clock::now() - logged).count();
+    }
+    deferred_ns /= calls;
+    drain_ns /= calls;
+
+    printf("Host time per log call: formatted %.0fns, deferred %.0fns plus %.0fns draining\n", formatted_ns, deferred_ns, drain_ns);
+    printf("Console bytes per log call: formatted %u, deferred %u\n", formatted_bytes / calls, counted / calls);
+    EXPECT_LT(counted, formatted_bytes);
+}
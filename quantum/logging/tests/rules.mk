@@ -0,0 +1,6 @@
+print_deferred_DEFS := -DDEFERRED_PRINT_ENABLE -DPRINT_DEFERRED_BUFFER_SIZE=256
+
+print_deferred_SRC := \
+	$(QUANTUM_PATH)/logging/tests/print_deferred_tests.cpp \
+	$(QUANTUM_PATH)/logging/print_deferred.c \
+	$(LIB_PATH)/printf/src/printf/printf.c
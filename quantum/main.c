@@ -16,6 +16,10 @@
 
 #include "keyboard.h"
 
+#ifdef POWER_STATE_ENABLE
+#    include "power_state.h"
+#endif
+
 void platform_setup(void);
 
 void protocol_setup(void);
@@ -55,6 +59,11 @@ int main(void) {
         raw_hid_task();
 #endif
 
+#ifdef DEFERRED_PRINT_ENABLE
+        void print_deferred_task(void);
+        print_deferred_task();
+#endif
+
 #ifdef CONSOLE_ENABLE
         void console_task(void);
         console_task();
@@ -73,5 +82,10 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef POWER_STATE_ENABLE
+        // Sleep until the next matrix scan while dozing or asleep
+        power_state_wait();
+#endif
     }
 }
@@ -1,4 +1,4 @@
-// this is a single reader [maybe multiple writer?] byte queue
+// this is a single reader, single writer byte queue
 // Copyright 2008 Alex Norman
 // writen by Alex Norman
 //
@@ -18,7 +18,21 @@
 // along with avr-bytequeue.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "bytequeue.h"
-#include "interrupt_setting.h"
+
+// The queue needs no locking as long as there is a single producer calling
+// bytequeue_enqueue and a single consumer calling the other functions, for
+// example a USB interrupt and the main loop: only the producer writes end and
+// only the consumer writes start. Each side publishes its index with release
+// semantics, after the data it covers, and reads the other side's with acquire.
+#define BYTEQUEUE_LOAD(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+#define BYTEQUEUE_STORE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+// Advance an index by up to the length of the queue, wrapping without a division
+static inline byteQueueIndex_t bytequeue_advance(byteQueue_t* queue, byteQueueIndex_t index, byteQueueIndex_t count) {
+    uint16_t next = (uint16_t)index + count;
+    if (next >= queue->length) next -= queue->length;
+    return next;
+}
 
 void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arrayLen) {
     queue->length = arrayLen;
@@ -27,38 +41,30 @@ void bytequeue_init(byteQueue_t* queue, uint8_t* dataArray, byteQueueIndex_t arr
 }
 
 bool bytequeue_enqueue(byteQueue_t* queue, uint8_t item) {
-    interrupt_setting_t setting = store_and_clear_interrupt();
+    byteQueueIndex_t end  = queue->end;
+    byteQueueIndex_t next = bytequeue_advance(queue, end, 1);
     // full
-    if (((queue->end + 1) % queue->length) == queue->start) {
-        restore_interrupt_setting(setting);
+    if (next == BYTEQUEUE_LOAD(queue->start)) {
         return false;
-    } else {
-        queue->data[queue->end] = item;
-        queue->end              = (queue->end + 1) % queue->length;
-        restore_interrupt_setting(setting);
-        return true;
     }
+    queue->data[end] = item;
+    BYTEQUEUE_STORE(queue->end, next);
+    return true;
 }
 
 byteQueueIndex_t bytequeue_length(byteQueue_t* queue) {
-    byteQueueIndex_t    len;
-    interrupt_setting_t setting = store_and_clear_interrupt();
-    if (queue->end >= queue->start)
-        len = queue->end - queue->start;
+    byteQueueIndex_t start = queue->start;
+    byteQueueIndex_t end   = BYTEQUEUE_LOAD(queue->end);
+    if (end >= start)
+        return end - start;
     else
-        len = (queue->length - queue->start) + queue->end;
-    restore_interrupt_setting(setting);
-    return len;
+        return (queue->length - start) + end;
 }
 
-// we don't need to avoid interrupts if there is only one reader
 uint8_t bytequeue_get(byteQueue_t* queue, byteQueueIndex_t index) {
-    return queue->data[(queue->start + index) % queue->length];
+    return queue->data[bytequeue_advance(queue, queue->start, index)];
 }
 
-// we just update the start index to remove elements
 void bytequeue_remove(byteQueue_t* queue, byteQueueIndex_t numToRemove) {
-    interrupt_setting_t setting = store_and_clear_interrupt();
-    queue->start                = (queue->start + numToRemove) % queue->length;
-    restore_interrupt_setting(setting);
+    BYTEQUEUE_STORE(queue->start, bytequeue_advance(queue, queue->start, numToRemove));
 }
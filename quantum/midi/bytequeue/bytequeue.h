@@ -1,4 +1,4 @@
-// this is a single reader [maybe multiple writer?] byte queue
+// this is a single reader, single writer byte queue
 // Copyright 2008 Alex Norman
 // writen by Alex Norman
 //
@@ -4,6 +4,7 @@
 #include "midi.h"
 #include "usb_descriptor.h"
 #include "process_midi.h"
+#include "util.h"
 
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
@@ -16,6 +17,17 @@
 
 MidiDevice midi_device;
 
+#ifndef MIDI_OUTPUT_QUEUE_LENGTH
+// two endpoint transfers worth of events, plus the byte a full queue leaves unused
+#    define MIDI_OUTPUT_QUEUE_LENGTH (MIDI_STREAM_EPSIZE * 2 + 1)
+#endif
+
+_Static_assert(MIDI_OUTPUT_QUEUE_LENGTH > sizeof(MIDI_EventPacket_t) && MIDI_OUTPUT_QUEUE_LENGTH <= 255, "MIDI_OUTPUT_QUEUE_LENGTH must fit at least one event, and at most 255 bytes");
+
+// events are collected here and sent several to a transfer by flush_midi_packets()
+static uint8_t     midi_output_queue_data[MIDI_OUTPUT_QUEUE_LENGTH];
+static byteQueue_t midi_output_queue;
+
 #define SYSEX_START_OR_CONT 0x40
 #define SYSEX_ENDS_IN_1 0x50
 #define SYSEX_ENDS_IN_2 0x60
@@ -74,7 +86,26 @@ static void usb_send_func(MidiDevice* device, uint16_t cnt, uint8_t byte0, uint8
         }
     }
 
-    send_midi_packet(&event);
+    if (bytequeue_length(&midi_output_queue) + sizeof(event) >= MIDI_OUTPUT_QUEUE_LENGTH) {
+        flush_midi_packets();
+    }
+    for (uint8_t i = 0; i < sizeof(event); i++) {
+        bytequeue_enqueue(&midi_output_queue, ((uint8_t*)&event)[i]);
+    }
+}
+
+void flush_midi_packets(void) {
+    MIDI_EventPacket_t events[MIDI_STREAM_EPSIZE / sizeof(MIDI_EventPacket_t)];
+    uint8_t            count;
+
+    while ((count = MIN(bytequeue_length(&midi_output_queue) / sizeof(MIDI_EventPacket_t), ARRAY_SIZE(events))) > 0) {
+        uint8_t* data = (uint8_t*)events;
+        for (uint8_t i = 0; i < count * sizeof(MIDI_EventPacket_t); i++) {
+            data[i] = bytequeue_get(&midi_output_queue, i);
+        }
+        bytequeue_remove(&midi_output_queue, count * sizeof(MIDI_EventPacket_t));
+        send_midi_packets(events, count);
+    }
 }
 
 static void usb_get_midi(MidiDevice* device) {
@@ -132,6 +163,7 @@ void setup_midi(void) {
 #ifdef MIDI_ADVANCED
     midi_init();
 #endif
+    bytequeue_init(&midi_output_queue, midi_output_queue_data, MIDI_OUTPUT_QUEUE_LENGTH);
     midi_device_init(&midi_device);
     midi_device_set_send_func(&midi_device, usb_send_func);
     midi_device_set_pre_input_process_func(&midi_device, usb_get_midi);
@@ -0,0 +1,173 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "bytequeue.h"
+}
+
+// MIDI_INPUT_QUEUE_LENGTH
+#define QUEUE_LENGTH 192
+
+// The queue as it was before, with the interrupt lock stood in for by a mutex
+struct LockedQueue {
+    std::mutex lock;
+    uint8_t    start = 0, end = 0, length;
+    uint8_t   *data;
+
+    LockedQueue(uint8_t *data, uint8_t length) : length(length), data(data) {}
+
+    bool enqueue(uint8_t item) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (((end + 1) % length) == start) return false;
+        data[end] = item;
+        end       = (end + 1) % length;
+        return true;
+    }
+
+    uint8_t count() {
+        std::lock_guard<std::mutex> guard(lock);
+        return end >= start ? end - start : (length - start) + end;
+    }
+
+    uint8_t get(uint8_t index) {
+        return data[(start + index) % length];
+    }
+
+    void remove(uint8_t n) {
+        std::lock_guard<std::mutex> guard(lock);
+        start = (start + n) % length;
+    }
+};
+
+class ByteQueue : public testing::Test {
+   protected:
+    uint8_t     data[QUEUE_LENGTH];
+    byteQueue_t queue;
+
+    void SetUp() override {
+        bytequeue_init(&queue, data, QUEUE_LENGTH);
+    }
+};
+
+TEST_F(ByteQueue, KeepsOrderAcrossWrapAround) {
+    uint8_t next_in = 0, next_out = 0;
+
+    // Uneven batches, so the ends wrap at every position of the buffer
+    for (int round = 0; round < 1000; round++) {
+        uint8_t batch = round % 37 + 1;
+        for (uint8_t i = 0; i < batch; i++) {
+            EXPECT_TRUE(bytequeue_enqueue(&queue, next_in++));
+        }
+        ASSERT_EQ(bytequeue_length(&queue), batch);
+        for (uint8_t i = 0; i < batch; i++) {
+            EXPECT_EQ(bytequeue_get(&queue, i), (uint8_t)(next_out + i));
+        }
+        bytequeue_remove(&queue, batch);
+        next_out += batch;
+        EXPECT_EQ(bytequeue_length(&queue), 0);
+    }
+}
+
+TEST_F(ByteQueue, RejectsBytesWhenFull) {
+    for (int i = 0; i < QUEUE_LENGTH - 1; i++) {
+        EXPECT_TRUE(bytequeue_enqueue(&queue, i));
+    }
+    EXPECT_EQ(bytequeue_length(&queue), QUEUE_LENGTH - 1);
+    EXPECT_FALSE(bytequeue_enqueue(&queue, 0xFF));
+
+    bytequeue_remove(&queue, 1);
+    EXPECT_TRUE(bytequeue_enqueue(&queue, 0xFF));
+    EXPECT_EQ(bytequeue_get(&queue, 0), 1);
+    EXPECT_EQ(bytequeue_get(&queue, QUEUE_LENGTH - 2), 0xFF);
+}
+
+TEST_F(ByteQueue, WrapsAtTheLargestLength) {
+    uint8_t largest[255];
+    bytequeue_init(&queue, largest, sizeof(largest));
+
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(bytequeue_enqueue(&queue, i));
+        ASSERT_TRUE(bytequeue_enqueue(&queue, i + 1));
+        EXPECT_EQ(bytequeue_get(&queue, 1), (uint8_t)(i + 1));
+        bytequeue_remove(&queue, 2);
+    }
+    EXPECT_EQ(bytequeue_length(&queue), 0);
+}
+
+TEST_F(ByteQueue, ProducerAndConsumerNeedNoLock) {
+    const uint32_t total = 1000000;
+    uint32_t       received = 0, misordered = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([this, total] {
+        for (uint32_t i = 0; i < total; i++) {
+            while (!bytequeue_enqueue(&queue, i * 7)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    while (received < total) {
+        byteQueueIndex_t length = bytequeue_length(&queue);
+        if (length == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (byteQueueIndex_t i = 0; i < length; i++) {
+            misordered += bytequeue_get(&queue, i) != (uint8_t)((received + i) * 7);
+        }
+        bytequeue_remove(&queue, length);
+        received += length;
+    }
+    producer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Passed %u bytes between threads at %.1f MB/s\n", total, total / seconds / 1e6);
+    EXPECT_EQ(received, total);
+    EXPECT_EQ(misordered, 0);
+    EXPECT_EQ(bytequeue_length(&queue), 0);
+}
+
+TEST_F(ByteQueue, Benchmark) {
+    const int   rounds = 20000;
+    uint8_t     locked_data[QUEUE_LENGTH];
+    LockedQueue locked(locked_data, QUEUE_LENGTH);
+    using clock = std::chrono::steady_clock;
+    uint32_t sink = 0;
+
+    // A burst of USB-MIDI events in, then handled one byte at a time like midi_device_process()
+    auto start = clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < 64; i++) {
+            locked.enqueue(i);
+        }
+        for (uint8_t length = locked.count(); length > 0; length--) {
+            sink += locked.get(0);
+            locked.remove(1);
+        }
+    }
+    double locked_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * 64);
+
+    start = clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < 64; i++) {
+            bytequeue_enqueue(&queue, i);
+        }
+        for (byteQueueIndex_t length = bytequeue_length(&queue); length > 0; length--) {
+            sink += bytequeue_get(&queue, 0);
+            bytequeue_remove(&queue, 1);
+        }
+    }
+    double lock_free_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * 64);
+
+    printf("Host time per byte: locked %.1fns, lock-free %.1fns\n", locked_ns, lock_free_ns);
+    EXPECT_EQ(sink, 2 * rounds * (63 * 64 / 2));
+}
@@ -0,0 +1,6 @@
+bytequeue_DEFS := -DNO_PRINT -DNO_DEBUG
+bytequeue_INC := $(QUANTUM_PATH)/midi/bytequeue
+
+bytequeue_SRC := \
+	$(QUANTUM_PATH)/midi/tests/bytequeue_tests.cpp \
+	$(QUANTUM_PATH)/midi/bytequeue/bytequeue.c
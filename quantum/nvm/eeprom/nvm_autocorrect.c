@@ -0,0 +1,80 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "eeprom.h"
+#include "util.h"
+#include "nvm_autocorrect.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+#include "nvm_eeprom_transaction_internal.h"
+
+#if (AUTOCORRECT_EEPROM_SIZE) > 0
+
+STATIC_ASSERT((intptr_t)EECONFIG_AUTOCORRECT_DATABLOCK + EECONFIG_AUTOCORRECT_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "AUTOCORRECT_EEPROM_SIZE is configured to use more space than what is available for the selected EEPROM driver");
+
+// Bump when the dictionary format changes, so that old dictionaries are dropped
+#    define AUTOCORRECT_EEPROM_VERSION 1
+
+#    define AUTOCORRECT_EEPROM_VERSION_ADDR (EECONFIG_AUTOCORRECT_DATABLOCK)
+#    define AUTOCORRECT_EEPROM_MIN_LENGTH_ADDR (EECONFIG_AUTOCORRECT_DATABLOCK + 1)
+#    define AUTOCORRECT_EEPROM_MAX_LENGTH_ADDR (EECONFIG_AUTOCORRECT_DATABLOCK + 2)
+#    define AUTOCORRECT_EEPROM_DATA_SIZE_ADDR ((uint16_t *)(EECONFIG_AUTOCORRECT_DATABLOCK + 3))
+#    define AUTOCORRECT_EEPROM_BUFFER_ADDR (EECONFIG_AUTOCORRECT_DATABLOCK + 5)
+
+bool nvm_autocorrect_is_valid(void) {
+    return nvm_eeprom_read_byte(AUTOCORRECT_EEPROM_VERSION_ADDR) == (AUTOCORRECT_EEPROM_VERSION);
+}
+
+void nvm_autocorrect_erase(void) {
+    nvm_eeprom_update_byte(AUTOCORRECT_EEPROM_VERSION_ADDR, 0);
+}
+
+void nvm_autocorrect_read_info(uint8_t *min_length, uint8_t *max_length, uint16_t *size) {
+    *min_length = nvm_eeprom_read_byte(AUTOCORRECT_EEPROM_MIN_LENGTH_ADDR);
+    *max_length = nvm_eeprom_read_byte(AUTOCORRECT_EEPROM_MAX_LENGTH_ADDR);
+    *size       = MIN(nvm_eeprom_read_word(AUTOCORRECT_EEPROM_DATA_SIZE_ADDR), AUTOCORRECT_EEPROM_SIZE);
+}
+
+void nvm_autocorrect_update_info(uint8_t min_length, uint8_t max_length, uint16_t size) {
+    nvm_eeprom_update_byte(AUTOCORRECT_EEPROM_MIN_LENGTH_ADDR, min_length);
+    nvm_eeprom_update_byte(AUTOCORRECT_EEPROM_MAX_LENGTH_ADDR, max_length);
+    nvm_eeprom_update_word(AUTOCORRECT_EEPROM_DATA_SIZE_ADDR, size);
+    // Only marked as valid once everything else is in place, in case power is lost halfway
+    nvm_eeprom_update_byte(AUTOCORRECT_EEPROM_VERSION_ADDR, AUTOCORRECT_EEPROM_VERSION);
+}
+
+uint8_t nvm_autocorrect_read_byte(uint16_t offset) {
+    return offset < AUTOCORRECT_EEPROM_SIZE ? nvm_eeprom_read_byte(AUTOCORRECT_EEPROM_BUFFER_ADDR + offset) : 0;
+}
+
+uint32_t nvm_autocorrect_update_buffer(const void *data, uint32_t offset, uint32_t length) {
+    void *ee_start = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_BUFFER_ADDR + MIN(AUTOCORRECT_EEPROM_SIZE, offset));
+    void *ee_end   = (void *)(uintptr_t)(AUTOCORRECT_EEPROM_BUFFER_ADDR + MIN(AUTOCORRECT_EEPROM_SIZE, offset + length));
+    nvm_eeprom_update_block(data, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+}
+
+#else // (AUTOCORRECT_EEPROM_SIZE) > 0
+
+void nvm_autocorrect_erase(void) {}
+
+bool nvm_autocorrect_is_valid(void) {
+    return false;
+}
+
+void nvm_autocorrect_read_info(uint8_t *min_length, uint8_t *max_length, uint16_t *size) {
+    *min_length = 0;
+    *max_length = 0;
+    *size       = 0;
+}
+
+void nvm_autocorrect_update_info(uint8_t min_length, uint8_t max_length, uint16_t size) {}
+
+uint8_t nvm_autocorrect_read_byte(uint16_t offset) {
+    return 0;
+}
+
+uint32_t nvm_autocorrect_update_buffer(const void *data, uint32_t offset, uint32_t length) {
+    return 0;
+}
+
+#endif // (AUTOCORRECT_EEPROM_SIZE) > 0
@@ -7,6 +7,7 @@
 #include "dynamic_keymap.h"
 #include "nvm_dynamic_keymap.h"
 #include "nvm_eeprom_eeconfig_internal.h"
+#include "nvm_eeprom_transaction_internal.h"
 #include "nvm_eeprom_via_internal.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,8 +87,8 @@ uint16_t nvm_dynamic_keymap_read_keycode(uint8_t layer, uint8_t row, uint8_t col
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = nvm_eeprom_read_byte(address) << 8;
+    keycode |= nvm_eeprom_read_byte(address + 1);
     return keycode;
 }
 
@@ -95,8 +96,8 @@ void nvm_dynamic_keymap_update_keycode(uint8_t layer, uint8_t row, uint8_t colum
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    nvm_eeprom_update_byte(address, (uint8_t)(keycode >> 8));
+    nvm_eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -108,8 +109,8 @@ uint16_t nvm_dynamic_keymap_read_encoder(uint8_t layer, uint8_t encoder_id, bool
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)nvm_eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= nvm_eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -117,8 +118,8 @@ void nvm_dynamic_keymap_update_encoder(uint8_t layer, uint8_t encoder_id, bool c
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    nvm_eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    nvm_eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -128,7 +129,7 @@ void nvm_dynamic_keymap_read_buffer(uint32_t offset, uint32_t size, uint8_t *dat
     uint8_t *target                     = data;
     for (uint32_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = nvm_eeprom_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -143,7 +144,7 @@ void nvm_dynamic_keymap_update_buffer(uint32_t offset, uint32_t size, uint8_t *d
     uint8_t *source                     = data;
     for (uint32_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            nvm_eeprom_update_byte(target, *source);
         }
         source++;
         target++;
@@ -159,7 +160,7 @@ void nvm_dynamic_keymap_macro_read_buffer(uint32_t offset, uint32_t size, uint8_
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = nvm_eeprom_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -173,7 +174,7 @@ void nvm_dynamic_keymap_macro_update_buffer(uint32_t offset, uint32_t size, uint
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            nvm_eeprom_update_byte(target, *source);
         }
         source++;
         target++;
@@ -187,7 +188,7 @@ void nvm_dynamic_keymap_macro_reset(void) {
     uint8_t dummy[16] = {0};
     for (int i = 0; i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; i += sizeof(dummy)) {
         int this_loop = remaining < sizeof(dummy) ? remaining : sizeof(dummy);
-        eeprom_update_block(dummy, start, this_loop);
+        nvm_eeprom_update_block(dummy, start, this_loop);
         start += this_loop;
         remaining -= this_loop;
     }
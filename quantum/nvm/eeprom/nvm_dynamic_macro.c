@@ -0,0 +1,81 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "eeprom.h"
+#include "util.h"
+#include "nvm_dynamic_macro.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+#include "nvm_eeprom_transaction_internal.h"
+
+#if (DYNAMIC_MACRO_EEPROM_SIZE) > 0
+
+STATIC_ASSERT((intptr_t)EECONFIG_DYNAMIC_MACRO_DATABLOCK + EECONFIG_DYNAMIC_MACRO_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "DYNAMIC_MACRO_EEPROM_SIZE is configured to use more space than what is available for the selected EEPROM driver");
+
+// Bump when the packed event format changes, so that old recordings are dropped
+#    define DYNAMIC_MACRO_EEPROM_VERSION 1
+
+#    define DYNAMIC_MACRO_EEPROM_VERSION_ADDR (EECONFIG_DYNAMIC_MACRO_DATABLOCK)
+#    define DYNAMIC_MACRO_EEPROM_LENGTH_ADDR(slot) ((uint16_t *)(EECONFIG_DYNAMIC_MACRO_DATABLOCK + 1 + (slot) * sizeof(uint16_t)))
+#    define DYNAMIC_MACRO_EEPROM_BUFFER_ADDR (EECONFIG_DYNAMIC_MACRO_DATABLOCK + 5)
+
+bool nvm_dynamic_macro_is_valid(void) {
+    return nvm_eeprom_read_byte(DYNAMIC_MACRO_EEPROM_VERSION_ADDR) == (DYNAMIC_MACRO_EEPROM_VERSION);
+}
+
+uint16_t nvm_dynamic_macro_read_length(uint8_t slot) {
+    return nvm_dynamic_macro_is_valid() ? nvm_eeprom_read_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR(slot)) : 0;
+}
+
+void nvm_dynamic_macro_update_length(uint8_t slot, uint16_t length) {
+    // Writing either length claims the whole block, so the other one must not be left over from an older format
+    if (!nvm_dynamic_macro_is_valid()) {
+        nvm_eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR(0), 0);
+        nvm_eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR(1), 0);
+        nvm_eeprom_update_byte(DYNAMIC_MACRO_EEPROM_VERSION_ADDR, DYNAMIC_MACRO_EEPROM_VERSION);
+    }
+    nvm_eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTH_ADDR(slot), length);
+}
+
+void nvm_dynamic_macro_erase(void) {
+    // nvm_eeconfig_erase() doesn't necessarily clear EEPROM, so forget both macros
+    nvm_dynamic_macro_update_length(0, 0);
+    nvm_dynamic_macro_update_length(1, 0);
+}
+
+uint32_t nvm_dynamic_macro_read_buffer(void *data, uint32_t offset, uint32_t length) {
+    void *ee_start = (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + offset);
+    void *ee_end   = (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + MIN(DYNAMIC_MACRO_EEPROM_SIZE, offset + length));
+    nvm_eeprom_read_block(data, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+}
+
+uint32_t nvm_dynamic_macro_update_buffer(const void *data, uint32_t offset, uint32_t length) {
+    void *ee_start = (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + offset);
+    void *ee_end   = (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_BUFFER_ADDR + MIN(DYNAMIC_MACRO_EEPROM_SIZE, offset + length));
+    nvm_eeprom_update_block(data, ee_start, ee_end - ee_start);
+    return ee_end - ee_start;
+}
+
+#else // (DYNAMIC_MACRO_EEPROM_SIZE) > 0
+
+void nvm_dynamic_macro_erase(void) {}
+
+bool nvm_dynamic_macro_is_valid(void) {
+    return false;
+}
+
+uint16_t nvm_dynamic_macro_read_length(uint8_t slot) {
+    return 0;
+}
+
+void nvm_dynamic_macro_update_length(uint8_t slot, uint16_t length) {}
+
+uint32_t nvm_dynamic_macro_read_buffer(void *data, uint32_t offset, uint32_t length) {
+    return 0;
+}
+
+uint32_t nvm_dynamic_macro_update_buffer(const void *data, uint32_t offset, uint32_t length) {
+    return 0;
+}
+
+#endif // (DYNAMIC_MACRO_EEPROM_SIZE) > 0
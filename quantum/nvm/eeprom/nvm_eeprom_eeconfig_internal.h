@@ -57,7 +57,23 @@ typedef struct PACKED {
 #define EECONFIG_KB_DATABLOCK ((uint8_t *)(EECONFIG_BASE_SIZE))
 #define EECONFIG_USER_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE)))
 
+// Recorded dynamic macros: a version byte and the length of each macro, then the macro buffer itself
+#if defined(DYNAMIC_MACRO_ENABLE) && (DYNAMIC_MACRO_EEPROM_SIZE) > 0
+#    define EECONFIG_DYNAMIC_MACRO_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE)))
+#    define EECONFIG_DYNAMIC_MACRO_SIZE (5 + (DYNAMIC_MACRO_EEPROM_SIZE))
+#else
+#    define EECONFIG_DYNAMIC_MACRO_SIZE 0
+#endif
+
+// Loaded autocorrection dictionary: a version byte, the typo lengths and the data size, then the data itself
+#if defined(AUTOCORRECT_ENABLE) && (AUTOCORRECT_EEPROM_SIZE) > 0
+#    define EECONFIG_AUTOCORRECT_DATABLOCK ((uint8_t *)((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE) + (EECONFIG_DYNAMIC_MACRO_SIZE)))
+#    define EECONFIG_AUTOCORRECT_SIZE (5 + (AUTOCORRECT_EEPROM_SIZE))
+#else
+#    define EECONFIG_AUTOCORRECT_SIZE 0
+#endif
+
 // Size of EEPROM being used, other code can refer to this for available EEPROM
-#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE))
+#define EECONFIG_SIZE ((EECONFIG_BASE_SIZE) + (EECONFIG_KB_DATA_SIZE) + (EECONFIG_USER_DATA_SIZE) + (EECONFIG_DYNAMIC_MACRO_SIZE) + (EECONFIG_AUTOCORRECT_SIZE))
 
 STATIC_ASSERT((intptr_t)EECONFIG_HANDEDNESS == 14, "EEPROM handedness offset is incorrect");
@@ -0,0 +1,64 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "eeprom.h"
+
+// Size of each page staged by a transaction, which is written back with a single write
+#ifndef NVM_TRANSACTION_PAGE_SIZE
+#    ifdef EXTERNAL_EEPROM_PAGE_SIZE
+#        define NVM_TRANSACTION_PAGE_SIZE (EXTERNAL_EEPROM_PAGE_SIZE)
+#    else
+#        define NVM_TRANSACTION_PAGE_SIZE 32
+#    endif
+#endif
+
+// Number of pages a transaction may stage at once, before the oldest one is written back early
+#ifndef NVM_TRANSACTION_PAGE_COUNT
+#    if defined(__AVR__) && !defined(EEPROM_DRIVER)
+// The internal EEPROM is written a byte at a time no matter what, so there is nothing to gain
+#        define NVM_TRANSACTION_PAGE_COUNT 0
+#    else
+#        define NVM_TRANSACTION_PAGE_COUNT 8
+#    endif
+#endif
+
+#if (NVM_TRANSACTION_PAGE_COUNT) > 0
+
+// Accessors for the eeprom provider, which go through the pages staged by a transaction while there is one
+
+void nvm_eeprom_format(bool erase);
+
+uint8_t  nvm_eeprom_read_byte(const uint8_t *addr);
+uint16_t nvm_eeprom_read_word(const uint16_t *addr);
+uint32_t nvm_eeprom_read_dword(const uint32_t *addr);
+void     nvm_eeprom_read_block(void *buf, const void *addr, size_t len);
+
+void nvm_eeprom_update_byte(uint8_t *addr, uint8_t value);
+void nvm_eeprom_update_word(uint16_t *addr, uint16_t value);
+void nvm_eeprom_update_dword(uint32_t *addr, uint32_t value);
+void nvm_eeprom_update_block(const void *buf, void *addr, size_t len);
+
+#else // (NVM_TRANSACTION_PAGE_COUNT) > 0
+
+#    ifdef EEPROM_DRIVER
+#        include "eeprom_driver.h"
+#        define nvm_eeprom_format(erase) eeprom_driver_format(erase)
+#    else
+#        define nvm_eeprom_format(erase)
+#    endif
+
+#    define nvm_eeprom_read_byte eeprom_read_byte
+#    define nvm_eeprom_read_word eeprom_read_word
+#    define nvm_eeprom_read_dword eeprom_read_dword
+#    define nvm_eeprom_read_block eeprom_read_block
+
+#    define nvm_eeprom_update_byte eeprom_update_byte
+#    define nvm_eeprom_update_word eeprom_update_word
+#    define nvm_eeprom_update_dword eeprom_update_dword
+#    define nvm_eeprom_update_block eeprom_update_block
+
+#endif // (NVM_TRANSACTION_PAGE_COUNT) > 0
@@ -0,0 +1,242 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "eeprom.h"
+#include "util.h"
+#include "nvm_transaction.h"
+#include "nvm_eeprom_transaction_internal.h"
+
+#ifdef EEPROM_DRIVER
+#    include "eeprom_driver.h"
+#endif
+
+static uint8_t transaction_depth = 0;
+
+bool nvm_transaction_is_active(void) {
+    return transaction_depth > 0;
+}
+
+#if (NVM_TRANSACTION_PAGE_COUNT) > 0
+
+#    define PAGE_ADDRESS(index) ((uintptr_t)(index) * (NVM_TRANSACTION_PAGE_SIZE))
+
+typedef struct nvm_transaction_page_t {
+    uint16_t index;       // address of the page, divided by its size
+    uint16_t dirty_start; // changed bytes, when dirty_end is past dirty_start
+    uint16_t dirty_end;
+    bool     loaded;
+    uint8_t  data[NVM_TRANSACTION_PAGE_SIZE];
+} nvm_transaction_page_t;
+
+static nvm_transaction_page_t pages[NVM_TRANSACTION_PAGE_COUNT];
+static uint8_t                next_eviction = 0;
+
+// Writes the changed part of a page back in one go
+static void page_write_back(nvm_transaction_page_t *page) {
+    if (page->loaded && page->dirty_end > page->dirty_start) {
+        eeprom_write_block(&page->data[page->dirty_start], (void *)(PAGE_ADDRESS(page->index) + page->dirty_start), page->dirty_end - page->dirty_start);
+    }
+    page->dirty_start = 0;
+    page->dirty_end   = 0;
+}
+
+static void pages_write_back(void) {
+    // In address order, so that the result doesn't depend on which pages happened to be evicted
+    for (;;) {
+        nvm_transaction_page_t *lowest = NULL;
+        for (uint8_t i = 0; i < NVM_TRANSACTION_PAGE_COUNT; i++) {
+            if (pages[i].loaded && pages[i].dirty_end > pages[i].dirty_start && (!lowest || pages[i].index < lowest->index)) {
+                lowest = &pages[i];
+            }
+        }
+        if (!lowest) {
+            return;
+        }
+        page_write_back(lowest);
+    }
+}
+
+static void pages_unload(void) {
+    for (uint8_t i = 0; i < NVM_TRANSACTION_PAGE_COUNT; i++) {
+        pages[i].loaded = false;
+    }
+}
+
+// Finds the page at `index`, loading it if needed, or returns NULL if it isn't staged
+static nvm_transaction_page_t *page_get(uint16_t index) {
+    // A partial page at the end of EEPROM is left alone, rather than staged past the end
+    if (transaction_depth == 0 || PAGE_ADDRESS(index) + NVM_TRANSACTION_PAGE_SIZE > TOTAL_EEPROM_BYTE_COUNT) {
+        return NULL;
+    }
+
+    nvm_transaction_page_t *page = NULL;
+    for (uint8_t i = 0; i < NVM_TRANSACTION_PAGE_COUNT; i++) {
+        if (pages[i].loaded && pages[i].index == index) {
+            return &pages[i];
+        }
+        if (!page && !pages[i].loaded) {
+            page = &pages[i];
+        }
+    }
+
+    // Make room by writing back the page that was loaded the longest ago
+    if (!page) {
+        page = &pages[next_eviction];
+        page_write_back(page);
+        next_eviction = (next_eviction + 1) % NVM_TRANSACTION_PAGE_COUNT;
+    }
+
+    page->index       = index;
+    page->dirty_start = 0;
+    page->dirty_end   = 0;
+    page->loaded      = true;
+    eeprom_read_block(page->data, (const void *)PAGE_ADDRESS(index), NVM_TRANSACTION_PAGE_SIZE);
+    return page;
+}
+
+void nvm_transaction_begin(void) {
+    transaction_depth++;
+}
+
+void nvm_transaction_commit(void) {
+    if (transaction_depth == 0) {
+        return;
+    }
+    pages_write_back();
+    if (--transaction_depth == 0) {
+        pages_unload();
+    }
+}
+
+void nvm_eeprom_format(bool erase) {
+    // Keep what was staged before formatting, in case the driver doesn't actually erase anything
+    pages_write_back();
+#    ifdef EEPROM_DRIVER
+    eeprom_driver_format(erase);
+#    endif
+    pages_unload();
+}
+
+void nvm_eeprom_read_block(void *buf, const void *addr, size_t len) {
+    if (transaction_depth == 0) {
+        eeprom_read_block(buf, addr, len);
+        return;
+    }
+
+    uint8_t  *target  = (uint8_t *)buf;
+    uintptr_t address = (uintptr_t)addr;
+    while (len > 0) {
+        uint16_t                offset = address % NVM_TRANSACTION_PAGE_SIZE;
+        size_t                  length = MIN(len, NVM_TRANSACTION_PAGE_SIZE - offset);
+        nvm_transaction_page_t *page   = page_get(address / NVM_TRANSACTION_PAGE_SIZE);
+        if (page) {
+            memcpy(target, &page->data[offset], length);
+        } else {
+            eeprom_read_block(target, (const void *)address, length);
+        }
+        target += length;
+        address += length;
+        len -= length;
+    }
+}
+
+void nvm_eeprom_update_block(const void *buf, void *addr, size_t len) {
+    if (transaction_depth == 0) {
+        eeprom_update_block(buf, addr, len);
+        return;
+    }
+
+    const uint8_t *source  = (const uint8_t *)buf;
+    uintptr_t      address = (uintptr_t)addr;
+    while (len > 0) {
+        uint16_t                offset = address % NVM_TRANSACTION_PAGE_SIZE;
+        size_t                  length = MIN(len, NVM_TRANSACTION_PAGE_SIZE - offset);
+        nvm_transaction_page_t *page   = page_get(address / NVM_TRANSACTION_PAGE_SIZE);
+        if (!page) {
+            eeprom_update_block(source, (void *)address, length);
+        } else {
+            // Only the bytes that actually change need writing back
+            for (uint16_t i = offset; i < offset + length; i++) {
+                if (page->data[i] != source[i - offset]) {
+                    page->data[i] = source[i - offset];
+                    if (page->dirty_end <= page->dirty_start) {
+                        page->dirty_start = i;
+                        page->dirty_end   = i + 1;
+                    } else {
+                        page->dirty_start = MIN(page->dirty_start, i);
+                        page->dirty_end   = MAX(page->dirty_end, i + 1);
+                    }
+                }
+            }
+        }
+        source += length;
+        address += length;
+        len -= length;
+    }
+}
+
+uint8_t nvm_eeprom_read_byte(const uint8_t *addr) {
+    if (transaction_depth == 0) {
+        return eeprom_read_byte(addr);
+    }
+    uint8_t ret = 0;
+    nvm_eeprom_read_block(&ret, addr, 1);
+    return ret;
+}
+
+uint16_t nvm_eeprom_read_word(const uint16_t *addr) {
+    if (transaction_depth == 0) {
+        return eeprom_read_word(addr);
+    }
+    uint16_t ret = 0;
+    nvm_eeprom_read_block(&ret, addr, 2);
+    return ret;
+}
+
+uint32_t nvm_eeprom_read_dword(const uint32_t *addr) {
+    if (transaction_depth == 0) {
+        return eeprom_read_dword(addr);
+    }
+    uint32_t ret = 0;
+    nvm_eeprom_read_block(&ret, addr, 4);
+    return ret;
+}
+
+void nvm_eeprom_update_byte(uint8_t *addr, uint8_t value) {
+    if (transaction_depth == 0) {
+        eeprom_update_byte(addr, value);
+        return;
+    }
+    nvm_eeprom_update_block(&value, addr, 1);
+}
+
+void nvm_eeprom_update_word(uint16_t *addr, uint16_t value) {
+    if (transaction_depth == 0) {
+        eeprom_update_word(addr, value);
+        return;
+    }
+    nvm_eeprom_update_block(&value, addr, 2);
+}
+
+void nvm_eeprom_update_dword(uint32_t *addr, uint32_t value) {
+    if (transaction_depth == 0) {
+        eeprom_update_dword(addr, value);
+        return;
+    }
+    nvm_eeprom_update_block(&value, addr, 4);
+}
+
+#else // (NVM_TRANSACTION_PAGE_COUNT) > 0
+
+void nvm_transaction_begin(void) {
+    transaction_depth++;
+}
+
+void nvm_transaction_commit(void) {
+    if (transaction_depth > 0) {
+        transaction_depth--;
+    }
+}
+
+#endif // (NVM_TRANSACTION_PAGE_COUNT) > 0
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void nvm_autocorrect_erase(void);
+
+bool nvm_autocorrect_is_valid(void);
+
+void nvm_autocorrect_read_info(uint8_t *min_length, uint8_t *max_length, uint16_t *size);
+void nvm_autocorrect_update_info(uint8_t min_length, uint8_t max_length, uint16_t size);
+
+uint8_t  nvm_autocorrect_read_byte(uint16_t offset);
+uint32_t nvm_autocorrect_update_buffer(const void *data, uint32_t offset, uint32_t length);
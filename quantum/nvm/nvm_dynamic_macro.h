@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void nvm_dynamic_macro_erase(void);
+
+bool nvm_dynamic_macro_is_valid(void);
+
+uint16_t nvm_dynamic_macro_read_length(uint8_t slot);
+void     nvm_dynamic_macro_update_length(uint8_t slot, uint16_t length);
+
+uint32_t nvm_dynamic_macro_read_buffer(void *data, uint32_t offset, uint32_t length);
+uint32_t nvm_dynamic_macro_update_buffer(const void *data, uint32_t offset, uint32_t length);
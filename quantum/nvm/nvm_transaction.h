@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Batches the writes made through the other nvm_* APIs.
+ *
+ * Between nvm_transaction_begin() and nvm_transaction_commit(), writes are staged rather than sent to the underlying
+ * storage one at a time, and reads see what was staged. Committing writes everything staged so far, as few and as large
+ * operations as the provider allows. Transactions nest: only the outermost commit ends the transaction, but every
+ * commit writes what was staged before it, so an inner commit can still order writes against later ones.
+ */
+
+void nvm_transaction_begin(void);
+void nvm_transaction_commit(void);
+
+bool nvm_transaction_is_active(void);
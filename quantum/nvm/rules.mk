@@ -26,6 +26,6 @@ else
         COMMON_VPATH += $(QUANTUM_DIR)/nvm/$(NVM_DRIVER_LOWER)
     endif
 
-    QUANTUM_SRC += nvm_eeconfig.c
+    QUANTUM_SRC += nvm_eeconfig.c nvm_transaction.c
 
 endif
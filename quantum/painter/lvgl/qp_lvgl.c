@@ -22,26 +22,42 @@ void *           color_buffer     = NULL;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
+static void qp_lvgl_flush_done(painter_device_t device, void *cb_arg) {
+    qp_flush(device);
+    lv_disp_flush_ready((lv_disp_drv_t *)cb_arg);
+}
+
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
         uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
         qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
-        qp_pixdata(selected_display, (void *)color_p, number_pixels);
-        qp_flush(selected_display);
-        lv_disp_flush_ready(disp);
+        // LVGL renders into the other draw buffer while this one is on its way to the display
+        qp_pixdata_async(selected_display, (void *)color_p, number_pixels, qp_lvgl_flush_done, disp);
     }
 }
 
-static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
-    lvgl_state_t *  state     = (lvgl_state_t *)cb_arg;
+static void qp_lvgl_wait(lv_disp_drv_t *disp) {
+    qp_pixdata_async_poll(selected_display);
+}
+
+static void qp_lvgl_tick(void) {
     static uint32_t last_tick = 0;
+    uint32_t        now       = timer_read32();
+    lv_tick_inc(TIMER_DIFF_32(now, last_tick));
+    last_tick = now;
+}
+
+static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
+    lvgl_state_t *state = (lvgl_state_t *)cb_arg;
     switch (state->fnc_id) {
-        case 0: {
-            uint32_t now = timer_read32();
-            lv_tick_inc(TIMER_DIFF_32(now, last_tick));
-            last_tick = now;
-        } break;
+        case 0:
+            qp_lvgl_tick();
+            break;
         case 1:
+            // Hand back a draw buffer whose transfer has finished, and bring the tick up to date in case a long render
+            // held the tick executor off, before rendering the next frame
+            qp_pixdata_async_poll(selected_display);
+            qp_lvgl_tick();
             lv_task_handler();
             break;
 
@@ -57,16 +73,35 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
 // Quantum Painter LVGL Integration API: qp_lvgl_attach
 
 bool qp_lvgl_attach(painter_device_t device) {
-    qp_dprintf("qp_lvgl_start: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_lvgl_attach: fail (validation_ok == false)\n");
+        qp_lvgl_detach();
+        return false;
+    }
+
+    return qp_lvgl_attach_with_buffers(device, (uint32_t)driver->panel_width * driver->panel_height / (QP_LVGL_BUFFER_DIVISOR), QP_LVGL_BUFFER_COUNT);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration API: qp_lvgl_attach_with_buffers
+
+bool qp_lvgl_attach_with_buffers(painter_device_t device, uint32_t buffer_pixels, uint8_t buffer_count) {
+    qp_dprintf("qp_lvgl_attach_with_buffers: entry\n");
     qp_lvgl_detach();
 
     painter_driver_t *driver = (painter_driver_t *)device;
     if (!driver || !driver->validate_ok) {
-        qp_dprintf("qp_lvgl_attach: fail (validation_ok == false)\n");
+        qp_dprintf("qp_lvgl_attach_with_buffers: fail (validation_ok == false)\n");
         qp_lvgl_detach();
         return false;
     }
 
+    if (buffer_pixels == 0 || buffer_count < 1 || buffer_count > 2) {
+        qp_dprintf("qp_lvgl_attach_with_buffers: fail (invalid buffer configuration)\n");
+        return false;
+    }
+
     // Setting up the tasks
     lvgl_state_t *lv_tick_inc_state = &lvgl_states[0];
     lv_tick_inc_state->fnc_id       = 0;
@@ -74,7 +109,7 @@ bool qp_lvgl_attach(painter_device_t device) {
     lv_tick_inc_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, 1, tick_task_callback, lv_tick_inc_state);
 
     if (lv_tick_inc_state->defer_token == INVALID_DEFERRED_TOKEN) {
-        qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
+        qp_dprintf("qp_lvgl_attach_with_buffers: fail (could not set up qp_lvgl executor)\n");
         qp_lvgl_detach();
         return false;
     }
@@ -85,7 +120,7 @@ bool qp_lvgl_attach(painter_device_t device) {
     lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, QP_LVGL_TASK_PERIOD, tick_task_callback, lv_task_handler_state);
 
     if (lv_task_handler_state->defer_token == INVALID_DEFERRED_TOKEN) {
-        qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
+        qp_dprintf("qp_lvgl_attach_with_buffers: fail (could not set up qp_lvgl executor)\n");
         qp_lvgl_detach();
         return false;
     }
@@ -93,20 +128,19 @@ bool qp_lvgl_attach(painter_device_t device) {
     // Init LVGL
     lv_init();
 
-    // Set up lvgl display buffer
+    // Set up lvgl display buffers, a second one lets LVGL render while the first is being sent
     static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required   = driver->panel_width * driver->panel_height / 10;
-    void *       new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
+    const size_t              count_required   = (size_t)buffer_pixels * buffer_count;
+    void *                    new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
     if (!new_color_buffer) {
-        qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
+        qp_dprintf("qp_lvgl_attach_with_buffers: fail (could not set up memory buffer)\n");
         qp_lvgl_detach();
         return false;
     }
     color_buffer = new_color_buffer;
     memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
     // Initialize the display buffer.
-    lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
+    lv_disp_draw_buf_init(&draw_buf, color_buffer, buffer_count > 1 ? (lv_color_t *)color_buffer + buffer_pixels : NULL, buffer_pixels);
 
     selected_display = device;
 
@@ -117,6 +151,7 @@ bool qp_lvgl_attach(painter_device_t device) {
     static lv_disp_drv_t disp_drv;     /*Descriptor of a display driver*/
     lv_disp_drv_init(&disp_drv);       /*Basic initialization*/
     disp_drv.flush_cb = qp_lvgl_flush; /*Set your driver function*/
+    disp_drv.wait_cb  = qp_lvgl_wait;  /*Poll for the end of a transfer while LVGL waits for a buffer*/
     disp_drv.draw_buf = &draw_buf;     /*Assign the buffer to the display*/
     disp_drv.hor_res  = panel_width;   /*Set the horizontal resolution of the display*/
     disp_drv.ver_res  = panel_height;  /*Set the vertical resolution of the display*/
@@ -132,6 +167,8 @@ void qp_lvgl_detach(void) {
     for (int i = 0; i < 2; ++i) {
         cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
     }
+    // The display may still be reading from a draw buffer
+    qp_pixdata_async_wait(selected_display);
     if (color_buffer) {
         free(color_buffer);
         color_buffer = NULL;
@@ -11,6 +11,16 @@
 #    define QP_LVGL_TASK_PERIOD 5
 #endif
 
+// Each draw buffer allocated by qp_lvgl_attach() holds 1/QP_LVGL_BUFFER_DIVISOR of the screen
+#ifndef QP_LVGL_BUFFER_DIVISOR
+#    define QP_LVGL_BUFFER_DIVISOR 10
+#endif
+
+// 2 lets LVGL render into one draw buffer while the other is sent, 1 halves the memory used
+#ifndef QP_LVGL_BUFFER_COUNT
+#    define QP_LVGL_BUFFER_COUNT 2
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
@@ -23,6 +33,17 @@
  */
 bool qp_lvgl_attach(painter_device_t device);
 
+/**
+ * Sets up LVGL with the supplied display, using draw buffers of the given size.
+ *
+ * @param device[in] the handle of the device to control
+ * @param buffer_pixels[in] the number of pixels each draw buffer holds
+ * @param buffer_count[in] the number of draw buffers, 1 or 2
+ * @return true if init. of LVGL succeeded
+ * @return false if init. of LVGL failed
+ */
+bool qp_lvgl_attach_with_buffers(painter_device_t device, uint32_t buffer_pixels, uint8_t buffer_count);
+
 /**
  * Disconnects LVGL from any attached display
  */
@@ -64,14 +64,24 @@ bool qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette,
     return true;
 }
 
-bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
+bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_multi_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
     // Decode the format
     qgf_parse_format(frame_descriptor->format, bpp, has_palette, is_panel_native);
 
+    // A frame is either a single-rectangle delta or a multi-rectangle delta, never both
+    const uint8_t delta_flags = QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_MULTI_DELTA;
+    if ((frame_descriptor->flags & delta_flags) == delta_flags) {
+        qp_dprintf("Failed to parse frame_descriptor, both delta and multi-delta flags were set\n");
+        return false;
+    }
+
     // Copy out the required info
     if (is_delta) {
         *is_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_DELTA) == QGF_FRAME_FLAG_DELTA;
     }
+    if (is_multi_delta) {
+        *is_multi_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_MULTI_DELTA) == QGF_FRAME_FLAG_MULTI_DELTA;
+    }
     if (compression_scheme) {
         *compression_scheme = frame_descriptor->compression_scheme;
     }
@@ -99,8 +109,8 @@ bool qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, ui
     }
 
     // Make sure the magic and version are correct
-    if (graphics_descriptor.magic != QGF_MAGIC || graphics_descriptor.qgf_version != 0x01) {
-        qp_dprintf("Failed to validate graphics_descriptor, expected magic 0x%06X was 0x%06X, expected version = 0x%02X was 0x%02X\n", (int)QGF_MAGIC, (int)graphics_descriptor.magic, (int)0x01, (int)graphics_descriptor.qgf_version);
+    if (graphics_descriptor.magic != QGF_MAGIC || (graphics_descriptor.qgf_version != QGF_VERSION_1 && graphics_descriptor.qgf_version != QGF_VERSION_2)) {
+        qp_dprintf("Failed to validate graphics_descriptor, expected magic 0x%06X was 0x%06X, expected version <= 0x%02X was 0x%02X\n", (int)QGF_MAGIC, (int)graphics_descriptor.magic, (int)QGF_VERSION_2, (int)graphics_descriptor.qgf_version);
         return false;
     }
 
@@ -177,7 +187,7 @@ void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     qp_stream_setpos(stream, offset);
 }
 
-bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta) {
+bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_multi_delta) {
     // Seek to the correct location
     qgf_seek_to_frame_descriptor(stream, frame_number);
 
@@ -193,7 +203,7 @@ bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, u
         return false;
     }
 
-    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, NULL, NULL);
+    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, is_multi_delta, NULL, NULL);
 }
 
 bool qgf_validate_palette_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t bpp) {
@@ -231,6 +241,41 @@ bool qgf_validate_delta_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     return true;
 }
 
+bool qgf_read_multi_delta_descriptor(qp_stream_t *stream, qgf_delta_rect_v2_t *rects, uint8_t *rect_count) {
+    // Read the multi-delta descriptor
+    qgf_multi_delta_v2_t multi_delta_descriptor;
+    if (qp_stream_read(&multi_delta_descriptor, sizeof(qgf_multi_delta_v2_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read multi_delta_descriptor, expected length was not %d\n", (int)sizeof(qgf_multi_delta_v2_t));
+        return false;
+    }
+
+    // Make sure this block is valid
+    uint8_t count = multi_delta_descriptor.rect_count;
+    if (count == 0 || count > QGF_MAX_DELTA_RECTS) {
+        qp_dprintf("Failed to validate multi_delta_descriptor, rect_count %d out of range\n", (int)count);
+        return false;
+    }
+    if (!qgf_validate_block_header(&multi_delta_descriptor.header, QGF_FRAME_MULTI_DELTA_DESCRIPTOR_TYPEID, (sizeof(qgf_multi_delta_v2_t) - sizeof(qgf_block_header_v1_t)) + count * sizeof(qgf_delta_rect_v2_t))) {
+        return false;
+    }
+
+    // Copy out the rectangles, or skip over them if the caller doesn't need them
+    if (rects) {
+        if (qp_stream_read(rects, sizeof(qgf_delta_rect_v2_t), count, stream) != count) {
+            qp_dprintf("Failed to read multi_delta_descriptor rectangles\n");
+            return false;
+        }
+    } else {
+        qp_stream_seek(stream, count * sizeof(qgf_delta_rect_v2_t), SEEK_CUR);
+    }
+
+    if (rect_count) {
+        *rect_count = count;
+    }
+
+    return true;
+}
+
 bool qgf_validate_frame_data_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     // Read and validate the data block
     qgf_data_v1_t data_descriptor;
@@ -259,7 +304,8 @@ bool qgf_validate_stream(qp_stream_t *stream) {
         bool    has_palette     = false;
         bool    is_panel_native = false;
         bool    has_delta       = false;
-        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta)) {
+        bool    has_multi_delta = false;
+        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta, &has_multi_delta)) {
             return false;
         }
 
@@ -273,6 +319,11 @@ bool qgf_validate_stream(qp_stream_t *stream) {
             return false;
         }
 
+        // If we've got a multi-delta block, check it
+        if (has_multi_delta && !qgf_read_multi_delta_descriptor(stream, NULL, NULL)) {
+            return false;
+        }
+
         // Check the data block
         if (!qgf_validate_frame_data_descriptor(stream, i)) {
             return false;
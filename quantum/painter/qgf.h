@@ -35,7 +35,7 @@ STATIC_ASSERT(sizeof(qgf_block_header_v1_t) == 5, "qgf_block_header_v1_t must be
 typedef struct QP_PACKED qgf_graphics_descriptor_v1_t {
     qgf_block_header_v1_t header;              // = { .type_id = 0x00, .neg_type_id = (~0x00), .length = 18 }
     uint32_t              magic : 24;          // constant, equal to 0x464751 ("QGF")
-    uint8_t               qgf_version;         // constant, equal to 0x01
+    uint8_t               qgf_version;         // 0x01, or 0x02 if any frame uses multi-rectangle deltas
     uint32_t              total_file_size;     // total size of the entire file, starting at offset zero
     uint32_t              neg_total_file_size; // negated value of total_file_size
     uint16_t              image_width;         // in pixels
@@ -46,6 +46,8 @@ typedef struct QP_PACKED qgf_graphics_descriptor_v1_t {
 STATIC_ASSERT(sizeof(qgf_graphics_descriptor_v1_t) == (sizeof(qgf_block_header_v1_t) + 18), "qgf_graphics_descriptor_v1_t must be 23 bytes in v1 of QGF");
 
 #define QGF_MAGIC 0x464751
+#define QGF_VERSION_1 0x01
+#define QGF_VERSION_2 0x02
 
 /////////////////////////////////////////
 // Frame offset descriptor
@@ -75,6 +77,7 @@ typedef struct QP_PACKED qgf_frame_v1_t {
 
 STATIC_ASSERT(sizeof(qgf_frame_v1_t) == (sizeof(qgf_block_header_v1_t) + 6), "qgf_frame_v1_t must be 11 bytes in v1 of QGF");
 
+#define QGF_FRAME_FLAG_MULTI_DELTA 0x04 // QGF v2 only
 #define QGF_FRAME_FLAG_DELTA 0x02
 #define QGF_FRAME_FLAG_TRANSPARENT 0x01
 
@@ -113,6 +116,31 @@ typedef struct QP_PACKED qgf_delta_v1_t {
 
 STATIC_ASSERT(sizeof(qgf_delta_v1_t) == (sizeof(qgf_block_header_v1_t) + 8), "qgf_delta_v1_t must be 13 bytes in v1 of QGF");
 
+/////////////////////////////////////////
+// Frame multi-rectangle delta descriptor (QGF v2)
+
+#define QGF_FRAME_MULTI_DELTA_DESCRIPTOR_TYPEID 0x06
+
+// Maximum number of rectangles in a single multi-rectangle delta frame
+#define QGF_MAX_DELTA_RECTS 8
+
+typedef struct QP_PACKED qgf_delta_rect_v2_t {
+    uint16_t left;   // The left pixel location of this rectangle
+    uint16_t top;    // The top pixel location of this rectangle
+    uint16_t right;  // The right pixel location of this rectangle
+    uint16_t bottom; // The bottom pixel location of this rectangle
+} qgf_delta_rect_v2_t;
+
+STATIC_ASSERT(sizeof(qgf_delta_rect_v2_t) == 8, "qgf_delta_rect_v2_t must be 8 bytes in v2 of QGF");
+
+typedef struct QP_PACKED qgf_multi_delta_v2_t {
+    qgf_block_header_v1_t header;     // = { .type_id = 0x06, .neg_type_id = (~0x06), .length = (1 + N * 8) }
+    uint8_t               rect_count; // N, in the range [1,QGF_MAX_DELTA_RECTS]
+    qgf_delta_rect_v2_t   rects[0];   // N * rectangles, each with its pixel data stored consecutively in the frame data block
+} qgf_multi_delta_v2_t;
+
+STATIC_ASSERT(sizeof(qgf_multi_delta_v2_t) == (sizeof(qgf_block_header_v1_t) + 1), "qgf_multi_delta_v2_t must be 6 bytes in v2 of QGF");
+
 /////////////////////////////////////////
 // Frame data descriptor
 
@@ -134,4 +162,5 @@ bool     qgf_validate_block_header(qgf_block_header_v1_t *desc, uint8_t expected
 bool     qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, uint16_t *image_height, uint16_t *frame_count, uint32_t *total_bytes);
 bool     qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette, bool *is_panel_native);
 void     qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number);
-bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay);
+bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_multi_delta, painter_compression_t *compression_scheme, uint16_t *delay);
+bool     qgf_read_multi_delta_descriptor(qp_stream_t *stream, qgf_delta_rect_v2_t *rects, uint8_t *rect_count);
@@ -318,3 +318,89 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_pixdata_async
+
+bool qp_pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, qp_pixdata_callback_t callback, void *cb_arg) {
+    qp_dprintf("qp_pixdata_async: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_pixdata_async: fail (validation_ok == false)\n");
+        if (callback) {
+            callback(device, cb_arg);
+        }
+        return false;
+    }
+
+    if (!driver->driver_vtable->pixdata_async) {
+        // Framebuffer-backed drivers have nothing to wait for
+        bool ret = qp_pixdata(device, pixel_data, native_pixel_count);
+        if (callback) {
+            callback(device, cb_arg);
+        }
+        return ret;
+    }
+
+    // Also waits for any previous transfer to finish
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_pixdata_async: fail (could not start comms)\n");
+        if (callback) {
+            callback(device, cb_arg);
+        }
+        return false;
+    }
+
+    // Set up before starting, as the comms driver may complete the transfer before returning
+    driver->async.callback = callback;
+    driver->async.cb_arg   = cb_arg;
+    driver->async.busy     = true;
+    driver->async.pending  = true;
+
+    bool ret = driver->driver_vtable->pixdata_async(device, pixel_data, native_pixel_count);
+    if (!ret) {
+        driver->async.busy = false;
+        qp_pixdata_async_poll(device);
+    }
+    qp_dprintf("qp_pixdata_async: %s\n", ret ? "ok" : "fail");
+    return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_pixdata_async_poll
+
+bool qp_pixdata_async_poll(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->async.pending) {
+        return true;
+    }
+
+    if (driver->async.busy) {
+        return false;
+    }
+
+    // Cleared first, so that the callback is free to start the next transfer
+    driver->async.pending = false;
+    qp_comms_stop(device);
+    if (driver->async.callback) {
+        driver->async.callback(device, driver->async.cb_arg);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_pixdata_async_wait
+
+bool qp_pixdata_async_wait(painter_device_t device) {
+    uint32_t start = timer_read32();
+    while (!qp_pixdata_async_poll(device)) {
+        if (timer_elapsed32(start) >= QUANTUM_PAINTER_ASYNC_TIMEOUT) {
+            qp_dprintf("qp_pixdata_async_wait: fail (timed out)\n");
+            painter_driver_t *driver = (painter_driver_t *)device;
+            driver->async.busy       = false;
+            qp_pixdata_async_poll(device);
+            return false;
+        }
+    }
+    return true;
+}
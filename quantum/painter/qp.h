@@ -56,6 +56,24 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of decoded glyphs that Quantum Painter keeps in RAM for reuse when drawing text. Each
+ *      entry holds a glyph's pixels already converted to the display's native format, keyed on the font, code point and
+ *      colors used, so redrawing the same text does not need to re-read or re-decode the font data. Each entry
+ *      requires \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM. Set to 0 to disable the glyph cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the maximum number of bytes of native pixel data that can be held by each glyph cache entry.
+ *      Glyphs which are larger than this are always decoded from the font data.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 256
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +90,14 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_ASYNC_TIMEOUT
+/**
+ * @def This controls how long, in milliseconds, Quantum Painter waits for an asynchronous transfer to finish before it
+ *      gives up on it.
+ */
+#    define QUANTUM_PAINTER_ASYNC_TIMEOUT 100
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -103,6 +129,11 @@ typedef const void *painter_device_t;
  */
 typedef enum { QP_ROTATION_0, QP_ROTATION_90, QP_ROTATION_180, QP_ROTATION_270 } painter_rotation_t;
 
+/**
+ * @typedef The function invoked by \ref qp_pixdata_async once the pixel data has been sent.
+ */
+typedef void (*qp_pixdata_callback_t)(painter_device_t device, void *cb_arg);
+
 /**
  * @typedef A descriptor for a Quantum Painter image.
  */
@@ -341,6 +372,50 @@ bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t
  */
 bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
 
+/**
+ * Starts streaming raw pixel data (in the native panel format) to the area previously set by \ref qp_viewport,
+ * returning while the transfer is still in progress if the display and its comms support it.
+ *
+ * The callback is invoked exactly once, whether or not the transfer succeeded, from \ref qp_pixdata_async_poll or the
+ * next Quantum Painter operation on the same display -- never from an interrupt. Displays without asynchronous
+ * support send the data before returning, and invoke the callback straight away.
+ *
+ * @note This is for advanced uses only, and should not be required for normal Quantum Painter functionality.
+ *
+ * @param device[in] the handle of the device to control
+ * @param pixel_data[in] pointer to buffer data, which must stay valid until the callback has been invoked
+ * @param native_pixel_count[in] the number of pixels to transmit
+ * @param callback[in] the function to invoke once the data has been sent, or NULL
+ * @param cb_arg[in] the argument passed to the callback
+ * @return true if streaming of data succeeded, or was started
+ * @return false if streaming of data failed
+ */
+bool qp_pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, qp_pixdata_callback_t callback, void *cb_arg);
+
+/**
+ * Finishes off an asynchronous transfer started by \ref qp_pixdata_async if its data has been sent, invoking its
+ * callback.
+ *
+ * @note This is for advanced uses only, and should not be required for normal Quantum Painter functionality.
+ *
+ * @param device[in] the handle of the device to check
+ * @return true if no transfer is in progress
+ * @return false if the transfer is still in progress
+ */
+bool qp_pixdata_async_poll(painter_device_t device);
+
+/**
+ * Waits for an asynchronous transfer started by \ref qp_pixdata_async to finish, invoking its callback. A transfer that
+ * takes longer than QUANTUM_PAINTER_ASYNC_TIMEOUT is abandoned: comms are stopped and the callback is invoked anyway.
+ *
+ * @note This is for advanced uses only, and should not be required for normal Quantum Painter functionality.
+ *
+ * @param device[in] the handle of the device to wait for
+ * @return true if no transfer is in progress, or it finished in time
+ * @return false if the transfer was abandoned
+ */
+bool qp_pixdata_async_wait(painter_device_t device);
+
 /**
  * Loads an image into memory.
  *
@@ -353,6 +428,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads an image stored in the external flash asset store.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image. Image data is streamed from flash while drawing.
+ *
+ * @param name[in] the name the image was uploaded with
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if the image could not be found, or loading the image failed
+ */
+painter_image_handle_t qp_load_image_flash(const char *name);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes an image handle when no longer in use.
  *
@@ -440,6 +529,20 @@ void qp_stop_animation(deferred_token anim_token);
  */
 painter_font_handle_t qp_load_font_mem(const void *buffer);
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+/**
+ * Loads a font stored in the external flash asset store.
+ *
+ * @note Fonts can be unloaded by calling \ref qp_close_font. Glyph data is streamed from flash while drawing, unless
+ *       QUANTUM_PAINTER_LOAD_FONTS_TO_RAM is enabled.
+ *
+ * @param name[in] the name the font was uploaded with
+ * @return an image handle usable with \ref qp_textwidth, \ref qp_drawtext, and \ref qp_drawtext_recolor.
+ * @return NULL if the font could not be found, or loading the font failed
+ */
+painter_font_handle_t qp_load_font_flash(const char *name);
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 /**
  * Closes a font handle when no longer in use.
  *
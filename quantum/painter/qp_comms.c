@@ -23,6 +23,9 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
+    // The bus belongs to any asynchronous transfer still in progress
+    qp_pixdata_async_wait(device);
+
     return driver->comms_vtable->comms_start(device);
 }
 
@@ -46,6 +49,27 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+bool qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!driver->comms_vtable->comms_send_async) {
+        bool ret = driver->comms_vtable->comms_send(device, data, byte_count) == byte_count;
+        qp_comms_send_async_complete(device);
+        return ret;
+    }
+
+    return driver->comms_vtable->comms_send_async(device, data, byte_count);
+}
+
+void qp_comms_send_async_complete(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    driver->async.busy       = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -16,6 +16,12 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous comms APIs, used by qp_pixdata_async()
+
+bool qp_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count);
+void qp_comms_send_async_complete(painter_device_t device); // safe to call from an interrupt
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
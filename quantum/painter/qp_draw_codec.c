@@ -2,6 +2,8 @@
 // Copyright 2023 Pablo Martinez (@elpekenin) <elpekenin@elpekenin.dev>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
+
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
@@ -165,12 +167,91 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Direct decode of uncompressed data held in memory-mapped streams
+
+// Number of palette indices unpacked before being handed to the driver in one go
+#define QP_MAPPED_DECODE_BATCH 32
+
+static bool qp_internal_appender_mapped(painter_device_t device, uint8_t bpp, uint32_t pixel_count, const uint8_t* src) {
+    painter_driver_t* driver     = (painter_driver_t*)device;
+    uint32_t          max_pixels = qp_internal_num_pixels_in_buffer(device);
+
+    // Non-native pixel format, unpack palette indices in batches instead of pixel-by-pixel
+    if (bpp <= 8) {
+        const uint8_t pixel_bitmask   = (1 << bpp) - 1;
+        const uint8_t pixels_per_byte = 8 / bpp;
+        uint8_t       indices[QP_MAPPED_DECODE_BATCH];
+        uint8_t       byteval          = 0;
+        uint8_t       pixels_in_byte   = 0;
+        uint32_t      pixel_write_pos  = 0;
+        uint32_t      remaining_pixels = pixel_count;
+        while (remaining_pixels > 0) {
+            uint32_t batch = QP_MIN(QP_MIN(remaining_pixels, QP_MAPPED_DECODE_BATCH), max_pixels - pixel_write_pos);
+            for (uint32_t i = 0; i < batch; ++i) {
+                if (pixels_in_byte == 0) {
+                    byteval        = *src++;
+                    pixels_in_byte = pixels_per_byte;
+                }
+                indices[i] = byteval & pixel_bitmask;
+                byteval >>= bpp;
+                --pixels_in_byte;
+            }
+
+            if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, qp_internal_global_pixel_lookup_table, pixel_write_pos, batch, indices)) {
+                return false;
+            }
+
+            pixel_write_pos += batch;
+            remaining_pixels -= batch;
+
+            // If we've hit the transmit limit, send out the entire buffer and reset the write position
+            if (pixel_write_pos == max_pixels) {
+                if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, pixel_write_pos)) {
+                    return false;
+                }
+                pixel_write_pos = 0;
+            }
+        }
+
+        // Any leftovers need transmission as well.
+        if (pixel_write_pos > 0) {
+            return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, pixel_write_pos);
+        }
+        return true;
+    }
+
+    // Native pixel format, copy whole blocks into the pixdata buffer. The data is deliberately copied rather than handed
+    // to the driver directly, as not all MCUs can DMA out of flash.
+    uint32_t max_bytes       = max_pixels * bpp / 8;
+    uint32_t remaining_bytes = pixel_count * bpp / 8;
+    while (remaining_bytes > 0) {
+        uint32_t block_bytes = QP_MIN(remaining_bytes, max_bytes);
+        memcpy(qp_internal_global_pixdata_buffer, src, block_bytes);
+        if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, block_bytes * 8 / bpp)) {
+            return false;
+        }
+        src += block_bytes;
+        remaining_bytes -= block_bytes;
+    }
+    return true;
+}
+
 // Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
     bool ret = false;
 
+    // Uncompressed data in a memory-mapped stream can be read in bulk, bypassing the per-byte stream callbacks
+    if (input_callback == qp_drawimage_byte_uncompressed_decoder && (bpp <= 8 || bpp == driver->native_bits_per_pixel)) {
+        uint32_t       byte_count = (pixel_count * bpp + 7) / 8;
+        const uint8_t* src        = qp_stream_map(((qp_internal_byte_input_state_t*)input_state)->src_stream, byte_count);
+        if (src) {
+            return qp_internal_appender_mapped(device, bpp, pixel_count, src);
+        }
+    }
+
     // Non-native pixel format
     if (bpp <= 8) {
         // Set up the output state
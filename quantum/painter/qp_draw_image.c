@@ -5,6 +5,10 @@
 #include "qp_draw.h"
 #include "qp_comms.h"
 #include "qgf.h"
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    include "qp_flash_assets.h"
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
 #include "deferred_exec.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -19,6 +23,9 @@ typedef struct qgf_image_handle_t {
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
     };
 } qgf_image_handle_t;
 
@@ -85,6 +92,31 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_flash
+
+static inline bool image_flash_stream_factory(qgf_image_handle_t *image, void *arg) {
+    const char *name = (const char *)arg;
+
+    uint32_t address;
+    uint32_t length;
+    if (!qp_flash_assets_find(name, &address, &length)) {
+        qp_dprintf("qp_load_image_flash: fail (asset not found)\n");
+        return false;
+    }
+
+    image->flash_stream = qp_make_flash_stream(address, length);
+    return true;
+}
+
+painter_image_handle_t qp_load_image_flash(const char *name) {
+    return qp_load_image_internal(image_flash_stream_factory, (void *)name);
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -117,10 +149,9 @@ typedef struct qgf_frame_info_t {
     bool                  has_palette;
     bool                  is_panel_native;
     bool                  is_delta;
-    uint16_t              left;
-    uint16_t              top;
-    uint16_t              right;
-    uint16_t              bottom;
+    bool                  is_multi_delta;
+    uint8_t               rect_count;
+    qgf_delta_rect_v2_t   rects[QGF_MAX_DELTA_RECTS];
     uint16_t              delay;
 } qgf_frame_info_t;
 
@@ -144,7 +175,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Parse out the frame info
-    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->compression_scheme, &info->delay)) {
+    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->is_multi_delta, &info->compression_scheme, &info->delay)) {
         return false;
     }
 
@@ -191,10 +222,21 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
             return false;
         }
 
-        info->left   = delta_descriptor.left;
-        info->top    = delta_descriptor.top;
-        info->right  = delta_descriptor.right;
-        info->bottom = delta_descriptor.bottom;
+        info->rect_count      = 1;
+        info->rects[0].left   = delta_descriptor.left;
+        info->rects[0].top    = delta_descriptor.top;
+        info->rects[0].right  = delta_descriptor.right;
+        info->rects[0].bottom = delta_descriptor.bottom;
+    } else if (info->is_multi_delta) {
+        if (!qgf_read_multi_delta_descriptor(&qgf_image->stream, info->rects, &info->rect_count)) {
+            return false;
+        }
+    } else {
+        info->rect_count      = 1;
+        info->rects[0].left   = 0;
+        info->rects[0].top    = 0;
+        info->rects[0].right  = qgf_image->base.width - 1;
+        info->rects[0].bottom = qgf_image->base.height - 1;
     }
 
     // Read the data block
@@ -233,39 +275,36 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    uint16_t l, t, r, b;
-    if (frame_info->is_delta) {
-        l = x + frame_info->left;
-        t = y + frame_info->top;
-        r = x + frame_info->right;
-        b = y + frame_info->bottom;
-    } else {
-        l = x;
-        t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
-    }
-    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
+    // Each rectangle's pixel data follows on from the previous one's, and is compressed independently
+    bool ret = true;
+    for (uint8_t i = 0; ret && i < frame_info->rect_count; ++i) {
+        const qgf_delta_rect_v2_t *rect        = &frame_info->rects[i];
+        uint16_t                   l           = x + rect->left;
+        uint16_t                   t           = y + rect->top;
+        uint16_t                   r           = x + rect->right;
+        uint16_t                   b           = y + rect->bottom;
+        uint32_t                   pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
+
+        // Configure where we're going to be rendering to
+        if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+            qp_comms_stop(device);
+            return false;
+        }
 
-    // Configure where we're going to be rendering to
-    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
-        return false;
-    }
+        // Set up the input state
+        qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
+        qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
+        if (input_callback == NULL) {
+            qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
+            qp_comms_stop(device);
+            return false;
+        }
 
-    // Set up the input state
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
-    if (input_callback == NULL) {
-        qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
-        qp_comms_stop(device);
-        return false;
+        // Decode and stream pixels
+        ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
     }
 
-    // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
-
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
@@ -9,6 +9,10 @@
 #include "qp_comms.h"
 #include "qff.h"
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+#    include "qp_flash_assets.h"
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QFF font handles
 
@@ -21,12 +25,16 @@ typedef struct qff_font_handle_t {
     bool                  has_palette;
     bool                  is_panel_native;
     painter_compression_t compression_scheme;
+    uint32_t              glyph_data_offset;
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
 #ifdef QP_STREAM_HAS_FILE_IO
         qp_file_stream_t file_stream;
 #endif // QP_STREAM_HAS_FILE_IO
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+        qp_flash_stream_t flash_stream;
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
     };
 #if QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
     bool  owns_buffer;
@@ -36,6 +44,10 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+#if (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+static void qp_glyph_cache_evict_font(qff_font_handle_t *qff_font);
+#endif // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -73,21 +85,25 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     font->owns_buffer = false;
     font->buffer      = NULL;
 
-    void *ram_buffer = malloc(font->mem_stream.length);
+    // Work out the size from the font itself, as the source stream may not be a memory stream
+    qp_stream_setpos(&font->stream, 0);
+    uint32_t font_size  = qff_get_total_size(&font->stream);
+    void *   ram_buffer = malloc(font_size);
     if (ram_buffer == NULL) {
         qp_dprintf("qp_load_font: could not allocate enough RAM for font, falling back to original\n");
     } else {
         do {
             // Copy the data into RAM
-            if (qp_stream_read(ram_buffer, 1, font->mem_stream.length, &font->mem_stream) != font->mem_stream.length) {
+            if (qp_stream_read(ram_buffer, 1, font_size, &font->stream) != font_size) {
                 qp_dprintf("qp_load_font: could not copy from flash to RAM, falling back to original\n");
                 break;
             }
 
             // Create the new stream with the new buffer
+            qp_stream_close(&font->stream);
             font->buffer      = ram_buffer;
             font->owns_buffer = true;
-            font->mem_stream  = qp_make_memory_stream(font->buffer, font->mem_stream.length);
+            font->mem_stream  = qp_make_memory_stream(font->buffer, font_size);
         } while (0);
     }
 
@@ -106,6 +122,13 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
         return NULL;
     }
 
+    // Work out where the glyph data block starts, so that glyph lookups don't need to recalculate it every time
+    font->glyph_data_offset = sizeof(qff_font_descriptor_v1_t)                                                                                                            // Skip the font descriptor
+                              + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                          // Skip the ascii table
+                              + (font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                              + (font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
+                              + sizeof(qgf_block_header_v1_t);                                                                                                            // Skip the data block header
+
     // Validation success, we can return the handle
     font->validate_ok = true;
     qp_dprintf("qp_load_font: ok\n");
@@ -132,6 +155,31 @@ painter_font_handle_t qp_load_font_mem(const void *buffer) {
     return qp_load_font_internal(font_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_font_flash
+
+static inline bool font_flash_stream_factory(qff_font_handle_t *font, void *arg) {
+    const char *name = (const char *)arg;
+
+    uint32_t address;
+    uint32_t length;
+    if (!qp_flash_assets_find(name, &address, &length)) {
+        qp_dprintf("qp_load_font_flash: fail (asset not found)\n");
+        return false;
+    }
+
+    font->flash_stream = qp_make_flash_stream(address, length);
+    return true;
+}
+
+painter_font_handle_t qp_load_font_flash(const char *name) {
+    return qp_load_font_internal(font_flash_stream_factory, (void *)name);
+}
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_font
 
@@ -151,6 +199,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+    // Drop any cached glyphs, as the slot may be reused by a different font
+    qp_glyph_cache_evict_font(qff_font);
+#endif // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -161,39 +214,31 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
-// Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
-static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
+// Helper that sets up the palette (if required)
+static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     painter_driver_t *driver = (painter_driver_t *)device;
 
-    // Drop out if we can't actually place the data we read out anywhere
-    if (!data_offset) {
-        qp_dprintf("Failed to prepare stream for read, output info buffer unavailable\n");
-        return false;
-    }
-
-    // Work out where we're reading from
-    uint32_t offset = sizeof(qff_font_descriptor_v1_t);
-    if (qff_font->has_ascii_table) {
-        offset += sizeof(qff_ascii_glyph_table_v1_t);
-    }
-    if (qff_font->num_unicode_glyphs > 0) {
-        offset += sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * 6);
-    }
-
     // Handle palette if needed
     const uint16_t palette_entries  = 1u << qff_font->bpp;
     bool           needs_pixconvert = false;
     if (qff_font->has_palette) {
+        // Work out where the palette is located
+        uint32_t offset = sizeof(qff_font_descriptor_v1_t);
+        if (qff_font->has_ascii_table) {
+            offset += sizeof(qff_ascii_glyph_table_v1_t);
+        }
+        if (qff_font->num_unicode_glyphs > 0) {
+            offset += sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * 6);
+        }
+
         // If this font has a palette, we need to read it out and set up the pixel lookup table
         qp_stream_setpos(&qff_font->stream, offset);
         if (!qp_internal_load_qgf_palette(&qff_font->stream, qff_font->bpp)) {
             return false;
         }
 
-        // Skip this block, as far as offset calculations go
-        offset += sizeof(qgf_palette_v1_t) + (palette_entries * 3);
         needs_pixconvert = true;
     } else {
         // Interpolate from fg/bg
@@ -205,18 +250,18 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
             qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
-            qp_comms_stop(device);
             return false;
         }
     }
 
-    *data_offset = offset;
     return true;
 }
 
-static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+// Helper that finds the width of the glyph for the supplied code point, as well as the offset in the stream of its pixel data
+static inline bool qp_drawtext_lookup_glyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width, uint32_t *data_offset) {
+    uint32_t glyph_value = 0;
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
-        // Do ascii table
+        // Do ascii table -- glyph info is directly indexed by the code point, so only a single read is required
         qff_ascii_glyph_v1_t glyph_info;
         uint32_t             glyph_info_offset = sizeof(qff_font_descriptor_v1_t)          // Skip the font descriptor
                                      + sizeof(qgf_block_header_v1_t)                       // Skip the ascii table header
@@ -231,22 +276,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        glyph_value = glyph_info.value;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
         uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
@@ -258,6 +288,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
+        bool                   found = false;
         qff_unicode_glyph_v1_t glyph_info;
         for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
             if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
@@ -266,33 +297,24 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             }
 
             if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
+                glyph_value = glyph_info.value;
+                found       = true;
+                break;
             }
         }
 
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
-        return false;
+        if (!found) {
+            qp_dprintf("Failed to find unicode glyph info\n");
+            return false;
+        }
     }
-    return false;
+
+    *width       = (uint8_t)(glyph_value & QFF_GLYPH_WIDTH_MASK);
+    *data_offset = qff_font->glyph_data_offset + ((glyph_value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    return true;
 }
 
-// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
+// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded codepoint
 static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
@@ -302,13 +324,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -316,6 +332,118 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
+// Cache entry metadata -- the decoded native pixels live in the matching slot of glyph_cache_pixdata
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t   device; // NULL if the entry is unused
+    qff_font_handle_t *font;
+    uint32_t           code_point;
+    uint32_t           fg_hsv888;
+    uint32_t           bg_hsv888;
+    uint32_t           last_used;
+    uint8_t            width;
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_counter                              = 0;
+
+// Word-aligned, as drivers write native pixels using their natural width
+static uint32_t glyph_cache_pixdata[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES][((QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) + 3) / 4];
+
+#    define QP_GLYPH_CACHE_PACK_HSV(pixel) ((((uint32_t)(pixel).hsv888.h) << 16) | (((uint32_t)(pixel).hsv888.s) << 8) | ((uint32_t)(pixel).hsv888.v))
+
+static inline uint8_t *qp_glyph_cache_pixdata(qp_glyph_cache_entry_t *entry) {
+    return (uint8_t *)glyph_cache_pixdata[entry - glyph_cache];
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    uint32_t fg = QP_GLYPH_CACHE_PACK_HSV(fg_hsv888);
+    uint32_t bg = QP_GLYPH_CACHE_PACK_HSV(bg_hsv888);
+    for (uint16_t i = 0; i < (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES); ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->device == device && entry->font == qff_font && entry->code_point == code_point && entry->fg_hsv888 == fg && entry->bg_hsv888 == bg) {
+            entry->last_used = ++glyph_cache_counter;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Glyph widths don't depend on the device or colors, so any cached rendering of the glyph will do
+static bool qp_glyph_cache_find_width(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    for (uint16_t i = 0; i < (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES); ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->device != NULL && entry->font == qff_font && entry->code_point == code_point) {
+            *width = entry->width;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Claims an unused entry, or evicts the least-recently-used one
+static qp_glyph_cache_entry_t *qp_glyph_cache_alloc(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint8_t width) {
+    qp_glyph_cache_entry_t *entry = &glyph_cache[0];
+    for (uint16_t i = 0; i < (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES); ++i) {
+        if (glyph_cache[i].device == NULL) {
+            entry = &glyph_cache[i];
+            break;
+        }
+        if (glyph_cache[i].last_used < entry->last_used) {
+            entry = &glyph_cache[i];
+        }
+    }
+
+    entry->device     = device;
+    entry->font       = qff_font;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = QP_GLYPH_CACHE_PACK_HSV(fg_hsv888);
+    entry->bg_hsv888  = QP_GLYPH_CACHE_PACK_HSV(bg_hsv888);
+    entry->last_used  = ++glyph_cache_counter;
+    entry->width      = width;
+    return entry;
+}
+
+static void qp_glyph_cache_evict_font(qff_font_handle_t *qff_font) {
+    for (uint16_t i = 0; i < (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES); ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].device = NULL;
+            glyph_cache[i].font   = NULL;
+        }
+    }
+}
+
+// Output state used when decoding a glyph into a cache entry instead of the global pixdata buffer
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t *        buffer;
+    uint32_t         write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->buffer, palette, state->write_pos++, 1, &index);
+}
+
+static bool qp_glyph_cache_byte_appender(uint8_t byteval, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t *             driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixdata(state->device, state->buffer, state->write_pos++, byteval);
+}
+
+#else // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
+static inline bool qp_glyph_cache_find_width(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    return false;
+}
+
+#endif // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // String width calculation
 
@@ -325,9 +453,17 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    // Only the glyph info is needed, the pixel data can be left alone
+    uint8_t  width;
+    uint32_t data_offset;
+    if (!qp_glyph_cache_find_width(qff_font, code_point, &width) && !qp_drawtext_lookup_glyph(qff_font, code_point, &width, &data_offset)) {
+        qp_dprintf("Failed to look up glyph width.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -339,24 +475,55 @@ static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_f
 
 // Callback state
 typedef struct code_point_iter_drawglyph_state_t {
-    painter_device_t                  device;
-    int16_t                           xpos;
-    int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
-    qp_internal_byte_input_state_t *  input_state;
-    qp_internal_pixel_output_state_t *output_state;
+    painter_device_t                device;
+    int16_t                         xpos;
+    int16_t                         ypos;
+    qp_internal_byte_input_callback input_callback;
+    qp_internal_byte_input_state_t *input_state;
+    qp_pixel_t                      fg_hsv888;
+    qp_pixel_t                      bg_hsv888;
+    bool                            palette_ready;
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+
+#if (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+    // If we've already decoded this glyph, send the native pixels straight out without touching the font data
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (entry) {
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + entry->width - 1, state->ypos + height - 1);
+        state->xpos += entry->width;
+        return driver->driver_vtable->pixdata(state->device, qp_glyph_cache_pixdata(entry), ((uint32_t)entry->width) * height);
+    }
+#endif // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
-    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+    // Set up the palette the first time we actually need to decode a glyph
+    if (!state->palette_ready) {
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888)) {
+            qp_dprintf("Failed to prepare font for rendering.\n");
+            return false;
+        }
+        state->palette_ready = true;
+    }
+
+    uint8_t  width;
+    uint32_t data_offset;
+    if (!qp_drawtext_lookup_glyph(qff_font, code_point, &width, &data_offset)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
+    if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        return false;
+    }
 
-    // Reset the output state
-    state->output_state->pixel_write_pos = 0;
+    // Reset the input state's RLE mode -- the stream is now positioned at the start of the glyph's pixel data
+    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
     // Configure where we're going to be rendering to
     driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
@@ -366,6 +533,31 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+    // If the decoded glyph fits in a cache entry, decode it there and send it from the cache
+    uint32_t native_bytes = (pixel_count * driver->native_bits_per_pixel + 7) / 8;
+    if (native_bytes <= (QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) && (qff_font->bpp <= 8 || qff_font->bpp == driver->native_bits_per_pixel)) {
+        entry                                      = qp_glyph_cache_alloc(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888, width);
+        qp_glyph_cache_output_state_t output_state = {.device = state->device, .buffer = qp_glyph_cache_pixdata(entry), .write_pos = 0};
+
+        bool ret;
+        if (qff_font->bpp <= 8) {
+            ret = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &output_state);
+        } else {
+            ret = qp_internal_send_bytes(state->device, pixel_count * qff_font->bpp / 8, state->input_callback, state->input_state, qp_glyph_cache_byte_appender, &output_state);
+        }
+
+        if (!ret) {
+            // Don't leave a partially-decoded glyph lying around
+            entry->device = NULL;
+            return false;
+        }
+
+        return driver->driver_vtable->pixdata(state->device, output_state.buffer, pixel_count);
+    }
+#endif // (QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES) > 0
+
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -425,10 +617,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return false;
     }
 
-    // Set up the pixel output state
-    qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
-
-    // Set up the codepoint iteration state
+    // Set up the codepoint iteration state -- the palette is prepared lazily, as cached glyphs don't need it
     code_point_iter_drawglyph_state_t state = {// Common
                                                .device = device,
                                                .xpos   = x,
@@ -436,17 +625,10 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                // Input
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
-                                               // Output
-                                               .output_state = &output_state};
-
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
+                                               // Colors
+                                               .fg_hsv888     = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888     = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .palette_ready = false};
 
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
@@ -0,0 +1,497 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+
+#include "flash.h"
+#include "qp_flash_assets.h"
+
+// The index occupies a whole number of sectors at the start of the store, with asset data following on from it
+#define QP_FLASH_ASSETS_INDEX_BYTES (sizeof(qp_flash_assets_header_t) + ((QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES) * sizeof(qp_flash_asset_entry_t)))
+#define QP_FLASH_ASSETS_SECTOR_ROUND_UP(n) ((((n) + (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE)-1) / (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE)) * (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE))
+#define QP_FLASH_ASSETS_INDEX_SIZE QP_FLASH_ASSETS_SECTOR_ROUND_UP(QP_FLASH_ASSETS_INDEX_BYTES)
+#define QP_FLASH_ASSETS_ENTRY_ADDRESS(i) ((QUANTUM_PAINTER_FLASH_ASSETS_OFFSET) + sizeof(qp_flash_assets_header_t) + ((i) * sizeof(qp_flash_asset_entry_t)))
+#define QP_FLASH_ASSETS_DATA_ADDRESS ((QUANTUM_PAINTER_FLASH_ASSETS_OFFSET) + QP_FLASH_ASSETS_INDEX_SIZE)
+#define QP_FLASH_ASSETS_DATA_CAPACITY ((uint32_t)(QUANTUM_PAINTER_FLASH_ASSETS_SIZE) - QP_FLASH_ASSETS_INDEX_SIZE)
+
+STATIC_ASSERT((QUANTUM_PAINTER_FLASH_ASSETS_OFFSET) % (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE) == 0, "QUANTUM_PAINTER_FLASH_ASSETS_OFFSET must be sector-aligned");
+STATIC_ASSERT((QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES) > 0 && (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES) <= 255, "QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES must be between 1 and 255");
+STATIC_ASSERT((QUANTUM_PAINTER_FLASH_ASSETS_SIZE) > QP_FLASH_ASSETS_INDEX_SIZE, "QUANTUM_PAINTER_FLASH_ASSETS_SIZE is too small to hold the asset index");
+STATIC_ASSERT((QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE) > 0, "QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE must be non-zero");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Read-ahead cache, shared by all flash streams
+
+static struct {
+    uint32_t address;
+    uint32_t length; // 0 if the cache holds nothing
+    uint8_t  data[QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE];
+} flash_cache;
+
+static inline void qp_flash_cache_invalidate(void) {
+    flash_cache.length = 0;
+}
+
+static inline bool qp_flash_cache_contains(uint32_t address, uint32_t length) {
+    return address >= flash_cache.address && (address + length) <= (flash_cache.address + flash_cache.length);
+}
+
+static bool qp_flash_cache_fill(uint32_t address, uint32_t length) {
+    if (length > sizeof(flash_cache.data)) {
+        length = sizeof(flash_cache.data);
+    }
+
+    if (flash_read_range(address, flash_cache.data, length) != FLASH_STATUS_SUCCESS) {
+        qp_flash_cache_invalidate();
+        return false;
+    }
+
+    flash_cache.address = address;
+    flash_cache.length  = length;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flash streams
+
+static int16_t flash_get(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    if (s->position >= s->length) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    uint32_t address = s->address + s->position;
+    if (!qp_flash_cache_contains(address, 1) && !qp_flash_cache_fill(address, s->length - s->position)) {
+        s->is_eof = true;
+        return STREAM_EOF;
+    }
+
+    s->position++;
+    return flash_cache.data[address - flash_cache.address];
+}
+
+static bool flash_put(qp_stream_t *stream, uint8_t c) {
+    // Flash streams are read-only, assets are written through qp_flash_assets_write()
+    return false;
+}
+
+static int flash_seek(qp_stream_t *stream, int32_t offset, int origin) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Handle as per fseek
+    int32_t position = s->position;
+    switch (origin) {
+        case SEEK_SET:
+            position = offset;
+            break;
+        case SEEK_CUR:
+            position += offset;
+            break;
+        case SEEK_END:
+            position = s->length + offset;
+            break;
+        default:
+            return -1;
+    }
+
+    // Same bounds handling as memory streams
+    if (position < 0 || position > s->length) {
+        return -1;
+    }
+
+    s->position = position;
+    s->is_eof   = false;
+    return 0;
+}
+
+static int32_t flash_tell(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->position;
+}
+
+static bool flash_is_eof(qp_stream_t *stream) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+    return s->is_eof;
+}
+
+static void flash_close(qp_stream_t *stream) {
+    // No-op.
+}
+
+static const uint8_t *flash_map(qp_stream_t *stream, uint32_t length) {
+    qp_flash_stream_t *s = (qp_flash_stream_t *)stream;
+
+    // Only requests that fit within the cache can be served directly
+    if (s->position < 0 || length > sizeof(flash_cache.data) || length > (uint32_t)(s->length - s->position)) {
+        return NULL;
+    }
+
+    uint32_t address = s->address + s->position;
+    if (!qp_flash_cache_contains(address, length) && !qp_flash_cache_fill(address, s->length - s->position)) {
+        return NULL;
+    }
+
+    s->position += length;
+    return &flash_cache.data[address - flash_cache.address];
+}
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, uint32_t length) {
+    qp_flash_stream_t stream = {
+        .base     = {.get = flash_get, .put = flash_put, .seek = flash_seek, .tell = flash_tell, .is_eof = flash_is_eof, .close = flash_close, .map = flash_map},
+        .address  = address,
+        .length   = (int32_t)length,
+        .position = 0,
+        .is_eof   = false,
+    };
+    return stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Index helpers
+
+static bool    flash_initialised = false;
+static int16_t upload_entry      = -1; // index of the entry currently being uploaded, -1 if none
+
+static void qp_flash_assets_init(void) {
+    if (!flash_initialised) {
+        flash_init();
+        flash_initialised = true;
+    }
+}
+
+static bool qp_flash_assets_is_formatted(void) {
+    qp_flash_assets_header_t header;
+    if (flash_read_range(QUANTUM_PAINTER_FLASH_ASSETS_OFFSET, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    return header.magic == QP_FLASH_ASSETS_MAGIC && header.version == QP_FLASH_ASSETS_VERSION && header.max_entries == (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES);
+}
+
+static bool qp_flash_assets_read_entry(uint8_t index, qp_flash_asset_entry_t *entry) {
+    return flash_read_range(QP_FLASH_ASSETS_ENTRY_ADDRESS(index), entry, sizeof(qp_flash_asset_entry_t)) == FLASH_STATUS_SUCCESS;
+}
+
+static bool qp_flash_assets_set_state(uint8_t index, qp_flash_asset_state_t state) {
+    uint8_t value = (uint8_t)state;
+    qp_flash_cache_invalidate();
+    return flash_write_range(QP_FLASH_ASSETS_ENTRY_ADDRESS(index) + offsetof(qp_flash_asset_entry_t, state), &value, sizeof(value)) == FLASH_STATUS_SUCCESS;
+}
+
+// Names are stored NUL-padded without a terminator, so anything longer could only match on its prefix
+static bool qp_flash_assets_name_is_valid(const char *name) {
+    size_t len = strlen(name);
+    return len > 0 && len <= QP_FLASH_ASSET_NAME_LENGTH;
+}
+
+static bool qp_flash_assets_name_matches(const qp_flash_asset_entry_t *entry, const char *name) {
+    return strncmp(entry->name, name, QP_FLASH_ASSET_NAME_LENGTH) == 0;
+}
+
+// Scans the index, returning the number of entries in use and the offset of the first unused byte of the data area
+static bool qp_flash_assets_scan(uint8_t *used_entries, uint32_t *data_end) {
+    if (!qp_flash_assets_is_formatted()) {
+        return false;
+    }
+
+    uint8_t  used = 0;
+    uint32_t end  = 0;
+    for (uint8_t i = 0; i < (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES); ++i) {
+        qp_flash_asset_entry_t entry;
+        if (!qp_flash_assets_read_entry(i, &entry)) {
+            return false;
+        }
+
+        // Entries are allocated in order, so the first free one marks the end of the index
+        if (entry.state == QP_FLASH_ASSET_FREE) {
+            break;
+        }
+
+        // Deleted and abandoned entries still consume data space until the store is reformatted
+        ++used;
+        uint32_t entry_end = QP_FLASH_ASSETS_SECTOR_ROUND_UP(entry.offset + entry.length);
+        if (entry_end > end) {
+            end = entry_end;
+        }
+    }
+
+    if (used_entries) *used_entries = used;
+    if (data_end) *data_end = end;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset store API
+
+bool qp_flash_assets_format(void) {
+    qp_flash_assets_init();
+    qp_flash_cache_invalidate();
+    upload_entry = -1;
+
+    for (uint32_t addr = 0; addr < QP_FLASH_ASSETS_INDEX_SIZE; addr += (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE)) {
+        if (flash_erase_sector((QUANTUM_PAINTER_FLASH_ASSETS_OFFSET) + addr) != FLASH_STATUS_SUCCESS) {
+            qp_dprintf("qp_flash_assets_format: fail (could not erase index)\n");
+            return false;
+        }
+    }
+
+    qp_flash_assets_header_t header = {
+        .magic       = QP_FLASH_ASSETS_MAGIC,
+        .version     = QP_FLASH_ASSETS_VERSION,
+        .max_entries = (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES),
+        .reserved    = 0xFFFF,
+    };
+    if (flash_write_range(QUANTUM_PAINTER_FLASH_ASSETS_OFFSET, &header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_assets_format: fail (could not write header)\n");
+        return false;
+    }
+
+    qp_dprintf("qp_flash_assets_format: ok\n");
+    return true;
+}
+
+bool qp_flash_assets_find(const char *name, uint32_t *address, uint32_t *length) {
+    qp_flash_assets_init();
+    if (!qp_flash_assets_name_is_valid(name)) {
+        qp_dprintf("qp_flash_assets_find: fail (invalid name)\n");
+        return false;
+    }
+
+    if (!qp_flash_assets_is_formatted()) {
+        qp_dprintf("qp_flash_assets_find: fail (store not formatted)\n");
+        return false;
+    }
+
+    // Walk the whole index, later entries supersede earlier ones with the same name
+    bool found = false;
+    for (uint8_t i = 0; i < (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES); ++i) {
+        qp_flash_asset_entry_t entry;
+        if (!qp_flash_assets_read_entry(i, &entry) || entry.state == QP_FLASH_ASSET_FREE) {
+            break;
+        }
+
+        if (entry.state == QP_FLASH_ASSET_VALID && qp_flash_assets_name_matches(&entry, name)) {
+            if (address) *address = QP_FLASH_ASSETS_DATA_ADDRESS + entry.offset;
+            if (length) *length = entry.length;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+bool qp_flash_assets_begin(const char *name, uint32_t length) {
+    qp_flash_assets_init();
+
+    if (length == 0 || !qp_flash_assets_name_is_valid(name)) {
+        qp_dprintf("qp_flash_assets_begin: fail (invalid name or length)\n");
+        return false;
+    }
+
+    // Abandon any upload that was never committed
+    if (upload_entry >= 0) {
+        qp_flash_assets_set_state((uint8_t)upload_entry, QP_FLASH_ASSET_DELETED);
+        upload_entry = -1;
+    }
+
+    uint8_t  used;
+    uint32_t data_end;
+    if (!qp_flash_assets_scan(&used, &data_end)) {
+        qp_dprintf("qp_flash_assets_begin: fail (store not formatted)\n");
+        return false;
+    }
+
+    if (used >= (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES)) {
+        qp_dprintf("qp_flash_assets_begin: fail (index full)\n");
+        return false;
+    }
+
+    if (length > QP_FLASH_ASSETS_DATA_CAPACITY - data_end) {
+        qp_dprintf("qp_flash_assets_begin: fail (not enough space)\n");
+        return false;
+    }
+
+    // Erase the sectors the asset will occupy
+    qp_flash_cache_invalidate();
+    for (uint32_t addr = 0; addr < length; addr += (QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE)) {
+        if (flash_erase_sector(QP_FLASH_ASSETS_DATA_ADDRESS + data_end + addr) != FLASH_STATUS_SUCCESS) {
+            qp_dprintf("qp_flash_assets_begin: fail (could not erase data)\n");
+            return false;
+        }
+    }
+
+    // Allocate the entry -- it won't be visible to lookups until it's committed
+    qp_flash_asset_entry_t entry = {
+        .offset = data_end,
+        .length = length,
+        .state  = QP_FLASH_ASSET_UPLOADING,
+    };
+    strncpy(entry.name, name, QP_FLASH_ASSET_NAME_LENGTH);
+    if (flash_write_range(QP_FLASH_ASSETS_ENTRY_ADDRESS(used), &entry, sizeof(entry)) != FLASH_STATUS_SUCCESS) {
+        qp_dprintf("qp_flash_assets_begin: fail (could not write index entry)\n");
+        return false;
+    }
+
+    upload_entry = used;
+    qp_dprintf("qp_flash_assets_begin: ok\n");
+    return true;
+}
+
+bool qp_flash_assets_write(uint32_t offset, const void *data, uint32_t length) {
+    if (upload_entry < 0) {
+        qp_dprintf("qp_flash_assets_write: fail (no upload in progress)\n");
+        return false;
+    }
+
+    qp_flash_asset_entry_t entry;
+    if (!qp_flash_assets_read_entry((uint8_t)upload_entry, &entry)) {
+        return false;
+    }
+
+    if (offset > entry.length || length > entry.length - offset) {
+        qp_dprintf("qp_flash_assets_write: fail (out of bounds)\n");
+        return false;
+    }
+
+    qp_flash_cache_invalidate();
+    return flash_write_range(QP_FLASH_ASSETS_DATA_ADDRESS + entry.offset + offset, data, length) == FLASH_STATUS_SUCCESS;
+}
+
+bool qp_flash_assets_commit(void) {
+    if (upload_entry < 0) {
+        qp_dprintf("qp_flash_assets_commit: fail (no upload in progress)\n");
+        return false;
+    }
+
+    qp_flash_asset_entry_t entry;
+    if (!qp_flash_assets_read_entry((uint8_t)upload_entry, &entry)) {
+        return false;
+    }
+
+    // Mark the new entry valid before deleting any older copies, so there's never a window with no valid asset
+    if (!qp_flash_assets_set_state((uint8_t)upload_entry, QP_FLASH_ASSET_VALID)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < (uint8_t)upload_entry; ++i) {
+        qp_flash_asset_entry_t other;
+        if (qp_flash_assets_read_entry(i, &other) && other.state == QP_FLASH_ASSET_VALID && strncmp(other.name, entry.name, QP_FLASH_ASSET_NAME_LENGTH) == 0) {
+            qp_flash_assets_set_state(i, QP_FLASH_ASSET_DELETED);
+        }
+    }
+
+    upload_entry = -1;
+    qp_dprintf("qp_flash_assets_commit: ok\n");
+    return true;
+}
+
+bool qp_flash_assets_delete(const char *name) {
+    qp_flash_assets_init();
+    if (!qp_flash_assets_name_is_valid(name)) {
+        qp_dprintf("qp_flash_assets_delete: fail (invalid name)\n");
+        return false;
+    }
+
+    if (!qp_flash_assets_is_formatted()) {
+        return false;
+    }
+
+    bool deleted = false;
+    for (uint8_t i = 0; i < (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES); ++i) {
+        qp_flash_asset_entry_t entry;
+        if (!qp_flash_assets_read_entry(i, &entry) || entry.state == QP_FLASH_ASSET_FREE) {
+            break;
+        }
+
+        if (entry.state == QP_FLASH_ASSET_VALID && qp_flash_assets_name_matches(&entry, name)) {
+            deleted |= qp_flash_assets_set_state(i, QP_FLASH_ASSET_DELETED);
+        }
+    }
+
+    return deleted;
+}
+
+uint32_t qp_flash_assets_free_space(void) {
+    qp_flash_assets_init();
+
+    uint8_t  used;
+    uint32_t data_end;
+    if (!qp_flash_assets_scan(&used, &data_end) || used >= (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES)) {
+        return 0;
+    }
+
+    return QP_FLASH_ASSETS_DATA_CAPACITY - data_end;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Raw HID upload protocol
+
+static inline uint32_t qp_flash_assets_get_u32(const uint8_t *p) {
+    return ((uint32_t)p[0]) | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void qp_flash_assets_put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void qp_flash_assets_get_name(char *name, const uint8_t *p, uint8_t available) {
+    uint8_t len = available < QP_FLASH_ASSET_NAME_LENGTH ? available : QP_FLASH_ASSET_NAME_LENGTH;
+    memcpy(name, p, len);
+    name[len] = 0;
+}
+
+bool qp_flash_assets_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 3 || data[0] != (QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID)) {
+        return false;
+    }
+
+    uint8_t *payload        = &data[3];
+    uint8_t  payload_length = length - 3;
+    bool     ok             = false;
+    char     name[QP_FLASH_ASSET_NAME_LENGTH + 1];
+
+    switch (data[1]) {
+        case QP_FLASH_ASSETS_CMD_INFO: {
+            uint8_t  used     = 0;
+            uint32_t data_end = 0;
+            ok                = payload_length >= 10 && qp_flash_assets_scan(&used, &data_end);
+            if (ok) {
+                qp_flash_assets_put_u32(&payload[0], QP_FLASH_ASSETS_DATA_CAPACITY);
+                qp_flash_assets_put_u32(&payload[4], used >= (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES) ? 0 : QP_FLASH_ASSETS_DATA_CAPACITY - data_end);
+                payload[8] = used;
+                payload[9] = (QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES);
+            }
+            break;
+        }
+        case QP_FLASH_ASSETS_CMD_FORMAT:
+            ok = qp_flash_assets_format();
+            break;
+        case QP_FLASH_ASSETS_CMD_BEGIN:
+            if (payload_length > 4) {
+                qp_flash_assets_get_name(name, &payload[4], payload_length - 4);
+                ok = qp_flash_assets_begin(name, qp_flash_assets_get_u32(&payload[0]));
+            }
+            break;
+        case QP_FLASH_ASSETS_CMD_WRITE:
+            if (payload_length >= 5 && payload[4] <= payload_length - 5) {
+                ok = qp_flash_assets_write(qp_flash_assets_get_u32(&payload[0]), &payload[5], payload[4]);
+            }
+            break;
+        case QP_FLASH_ASSETS_CMD_COMMIT:
+            ok = qp_flash_assets_commit();
+            break;
+        case QP_FLASH_ASSETS_CMD_DELETE:
+            qp_flash_assets_get_name(name, payload, payload_length);
+            ok = qp_flash_assets_delete(name);
+            break;
+        default:
+            break;
+    }
+
+    data[2] = ok ? QP_FLASH_ASSETS_STATUS_OK : QP_FLASH_ASSETS_STATUS_ERROR;
+    return true;
+}
@@ -0,0 +1,168 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Quantum Painter asset store on external flash.
+//
+// Layout, starting at QUANTUM_PAINTER_FLASH_ASSETS_OFFSET:
+//     - index area: header + fixed array of entries, padded to a whole number of sectors
+//     - data area: asset data, each asset starting on a sector boundary, appended in upload order
+//
+// Entries only ever have bits cleared after the index has been formatted, so an asset can be added or deleted without
+// erasing the index. Space used by deleted assets is only reclaimed by reformatting the store.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qp_internal.h"
+#include "qp_stream.h"
+
+#ifdef FLASH_DRIVER_SPI
+#    include "flash_spi.h"
+#endif // FLASH_DRIVER_SPI
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter flash asset store configurables (add to your keyboard's config.h)
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_OFFSET
+/**
+ * @def The address in external flash at which the asset store starts. Must be sector-aligned.
+ */
+#    define QUANTUM_PAINTER_FLASH_ASSETS_OFFSET 0
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_OFFSET
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE
+/**
+ * @def The erase sector size of the external flash.
+ */
+#    ifdef EXTERNAL_FLASH_SECTOR_SIZE
+#        define QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE (EXTERNAL_FLASH_SECTOR_SIZE)
+#    else
+#        define QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE (4 * 1024L)
+#    endif
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_SECTOR_SIZE
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_SIZE
+/**
+ * @def The number of bytes of external flash available to the asset store, including the index.
+ */
+#    ifdef EXTERNAL_FLASH_SIZE
+#        define QUANTUM_PAINTER_FLASH_ASSETS_SIZE ((EXTERNAL_FLASH_SIZE) - (QUANTUM_PAINTER_FLASH_ASSETS_OFFSET))
+#    else
+#        define QUANTUM_PAINTER_FLASH_ASSETS_SIZE ((512 * 1024L) - (QUANTUM_PAINTER_FLASH_ASSETS_OFFSET))
+#    endif
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_SIZE
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES
+/**
+ * @def The maximum number of assets the index can hold, including deleted assets until the store is reformatted.
+ */
+#    define QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES 32
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE
+/**
+ * @def The size of the read-ahead cache shared by all flash asset streams. Larger values mean fewer flash transactions
+ *      while drawing, at the cost of RAM.
+ */
+#    define QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE 256
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID
+/**
+ * @def The first byte of raw HID packets handled by \ref qp_flash_assets_raw_hid_receive.
+ */
+#    define QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID 0x51
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID
+
+// Maximum length of an asset name, including the NUL terminator if the name is shorter
+#define QP_FLASH_ASSET_NAME_LENGTH 16
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Index format
+
+#define QP_FLASH_ASSETS_MAGIC 0x41465051 // "QPFA"
+#define QP_FLASH_ASSETS_VERSION 0x01
+
+typedef struct QP_PACKED qp_flash_assets_header_t {
+    uint32_t magic;       // = QP_FLASH_ASSETS_MAGIC
+    uint8_t  version;     // = QP_FLASH_ASSETS_VERSION
+    uint8_t  max_entries; // = QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES at the time of formatting
+    uint16_t reserved;
+} qp_flash_assets_header_t;
+
+STATIC_ASSERT(sizeof(qp_flash_assets_header_t) == 8, "qp_flash_assets_header_t must be 8 bytes");
+
+// Entry states -- each transition only clears bits, so it can be programmed without an erase
+typedef enum qp_flash_asset_state_t {
+    QP_FLASH_ASSET_FREE      = 0xFF,
+    QP_FLASH_ASSET_UPLOADING = 0x7F,
+    QP_FLASH_ASSET_VALID     = 0x3F,
+    QP_FLASH_ASSET_DELETED   = 0x00,
+} qp_flash_asset_state_t;
+
+typedef struct QP_PACKED qp_flash_asset_entry_t {
+    char     name[QP_FLASH_ASSET_NAME_LENGTH]; // NUL-padded
+    uint32_t offset;                           // relative to the start of the data area
+    uint32_t length;                           // in bytes
+    uint8_t  state;                            // see qp_flash_asset_state_t
+} qp_flash_asset_entry_t;
+
+STATIC_ASSERT(sizeof(qp_flash_asset_entry_t) == 25, "qp_flash_asset_entry_t must be 25 bytes");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Raw HID upload protocol
+//
+// Request:  [QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID] [command] [ignored] [payload...]
+// Response: [QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID] [command] [status]  [payload...]
+//
+// All multi-byte values are little-endian.
+
+typedef enum qp_flash_assets_raw_hid_command_t {
+    QP_FLASH_ASSETS_CMD_INFO   = 0x01, // response: u32 capacity, u32 bytes free, u8 entries used, u8 max entries
+    QP_FLASH_ASSETS_CMD_FORMAT = 0x02, // erases the index, removing all assets
+    QP_FLASH_ASSETS_CMD_BEGIN  = 0x03, // request: u32 length, name -- starts an upload, replacing any asset of the same name
+    QP_FLASH_ASSETS_CMD_WRITE  = 0x04, // request: u32 offset, u8 count, data[count] -- writes into the asset being uploaded
+    QP_FLASH_ASSETS_CMD_COMMIT = 0x05, // marks the asset being uploaded as valid
+    QP_FLASH_ASSETS_CMD_DELETE = 0x06, // request: name
+} qp_flash_assets_raw_hid_command_t;
+
+typedef enum qp_flash_assets_raw_hid_status_t {
+    QP_FLASH_ASSETS_STATUS_OK    = 0x00,
+    QP_FLASH_ASSETS_STATUS_ERROR = 0x01,
+} qp_flash_assets_raw_hid_status_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asset store API
+
+// Erases the index, discarding all assets
+bool qp_flash_assets_format(void);
+
+// Looks up a committed asset by name, returning its absolute flash address and length
+bool qp_flash_assets_find(const char *name, uint32_t *address, uint32_t *length);
+
+// Starts uploading an asset of the given length, erasing the space required. Only one upload can be active at a time.
+bool qp_flash_assets_begin(const char *name, uint32_t length);
+
+// Writes data at the given offset of the asset being uploaded
+bool qp_flash_assets_write(uint32_t offset, const void *data, uint32_t length);
+
+// Marks the asset being uploaded as valid, deleting any older asset with the same name
+bool qp_flash_assets_commit(void);
+
+// Deletes a committed asset by name
+bool qp_flash_assets_delete(const char *name);
+
+// Number of bytes still available for new assets
+uint32_t qp_flash_assets_free_space(void);
+
+// Handles an asset store raw HID packet, writing the response back into `data` -- returns false if the packet was not
+// addressed to the asset store. Invoke from raw_hid_receive() and send `data` back with raw_hid_send() if handled, or if
+// VIA is enabled, from via_command_kb() and send the response there instead.
+bool qp_flash_assets_raw_hid_receive(uint8_t *data, uint8_t length);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Flash streams
+
+qp_flash_stream_t qp_make_flash_stream(uint32_t address, uint32_t length);
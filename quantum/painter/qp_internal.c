@@ -72,6 +72,13 @@ static void qp_internal_display_timeout_task(void) {
 STATIC_ASSERT((QUANTUM_PAINTER_TASK_THROTTLE) > 0 && (QUANTUM_PAINTER_TASK_THROTTLE) < 1000, "QUANTUM_PAINTER_TASK_THROTTLE must be between 1 and 999");
 
 void qp_internal_task(void) {
+    // Hand finished asynchronous transfers back to their owners as soon as possible, so they can queue up the next one
+    for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
+        if (qp_devices[i] != NULL) {
+            qp_pixdata_async_poll(qp_devices[i]);
+        }
+    }
+
     // Perform throttling of the internal processing of Quantum Painter
     static uint32_t last_tick = 0;
     uint32_t        now       = timer_read32();
@@ -100,7 +107,8 @@ void qp_internal_task(void) {
     debug_enable         = false;
 #endif // defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
-        if (qp_devices[i] != NULL) {
+        // Skip displays still busy with an asynchronous transfer, rather than waiting on them
+        if (qp_devices[i] != NULL && qp_pixdata_async_poll(qp_devices[i])) {
             qp_flush(qp_devices[i]);
         }
     }
@@ -14,6 +14,7 @@ typedef bool (*painter_driver_clear_func)(painter_device_t device);
 typedef bool (*painter_driver_flush_func)(painter_device_t device);
 typedef bool (*painter_driver_viewport_func)(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
 typedef bool (*painter_driver_pixdata_func)(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+typedef bool (*painter_driver_pixdata_async_func)(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
 typedef bool (*painter_driver_convert_palette_func)(painter_device_t device, int16_t palette_size, qp_pixel_t *palette);
 typedef bool (*painter_driver_append_pixels)(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices);
 typedef bool (*painter_driver_append_pixdata)(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
@@ -26,6 +27,7 @@ typedef struct painter_driver_vtable_t {
     painter_driver_flush_func           flush;
     painter_driver_viewport_func        viewport;
     painter_driver_pixdata_func         pixdata;
+    painter_driver_pixdata_async_func   pixdata_async; // optional, see qp_pixdata_async()
     painter_driver_convert_palette_func palette_convert;
     painter_driver_append_pixels        append_pixels;
     painter_driver_append_pixdata       append_pixdata;
@@ -38,12 +40,14 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef bool (*painter_driver_comms_send_async_func)(painter_device_t device, const void *data, uint32_t byte_count);
 
 typedef struct painter_comms_vtable_t {
-    painter_driver_comms_init_func  comms_init;
-    painter_driver_comms_start_func comms_start;
-    painter_driver_comms_stop_func  comms_stop;
-    painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_init_func       comms_init;
+    painter_driver_comms_start_func      comms_start;
+    painter_driver_comms_stop_func       comms_stop;
+    painter_driver_comms_send_func       comms_send;
+    painter_driver_comms_send_async_func comms_send_async; // optional, must call qp_comms_send_async_complete() when done
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -81,6 +85,14 @@ typedef struct painter_driver_t {
 
     // Comms config pointer -- needs to point to an appropriate comms config if the comms driver requires it.
     void *comms_config;
+
+    // Asynchronous pixel data transfer state, see qp_pixdata_async()
+    struct {
+        volatile bool         busy;    // cleared by the comms driver, possibly from an interrupt, once the data is sent
+        bool                  pending; // comms are still started and the callback has not been invoked yet
+        qp_pixdata_callback_t callback;
+        void *                cb_arg;
+    } async;
 } painter_driver_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
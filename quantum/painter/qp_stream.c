@@ -1,6 +1,8 @@
 // Copyright 2021 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
+
 #include "qp_stream.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +11,14 @@
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
+    // If the stream is directly addressable, copy the whole block in one go
+    const uint8_t *mapped = qp_stream_map(stream, num_members * member_size);
+    if (mapped) {
+        memcpy(output_ptr, mapped, num_members * member_size);
+        return num_members;
+    }
+
+    // Otherwise fall back to reading byte-by-byte, which also handles partial reads at the end of the stream
     uint32_t i;
     for (i = 0; i < (num_members * member_size); ++i) {
         int16_t c = qp_stream_get(stream);
@@ -109,9 +119,19 @@ static inline void mem_close(qp_stream_t *stream) {
     // No-op.
 }
 
+static inline const uint8_t *mem_map(qp_stream_t *stream, uint32_t length) {
+    qp_memory_stream_t *s = (qp_memory_stream_t *)stream;
+    if (s->position < 0 || length > (uint32_t)(s->length - s->position)) {
+        return NULL;
+    }
+    const uint8_t *ptr = &s->buffer[s->position];
+    s->position += length;
+    return ptr;
+}
+
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     qp_memory_stream_t stream = {
-        .base     = {.get = mem_get, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
+        .base     = {.get = mem_get, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close, .map = mem_map},
         .buffer   = (uint8_t *)buffer,
         .length   = length,
         .position = 0,
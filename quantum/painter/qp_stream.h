@@ -43,6 +43,10 @@ uint32_t qp_stream_write_impl(const void *input_buf, uint32_t member_size, uint3
 
 #define qp_stream_close(stream_ptr) (((qp_stream_t *)(stream_ptr))->close((qp_stream_t *)(stream_ptr)))
 
+// Returns a pointer to the next `length` bytes of the stream and advances past them, or NULL if the stream cannot provide
+// them directly (not memory-mapped, or not enough data remaining) -- in which case the stream position is unchanged.
+#define qp_stream_map(stream_ptr, length) (((qp_stream_t *)(stream_ptr))->map ? ((qp_stream_t *)(stream_ptr))->map((qp_stream_t *)(stream_ptr), (length)) : NULL)
+
 #define STREAM_EOF ((int16_t)(-1))
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -55,6 +59,7 @@ typedef struct qp_stream_t {
     int32_t (*tell)(qp_stream_t *stream);
     bool (*is_eof)(qp_stream_t *stream);
     void (*close)(qp_stream_t *stream);
+    const uint8_t *(*map)(qp_stream_t *stream, uint32_t length); // optional, NULL if the stream is not directly addressable
 } qp_stream_t;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -83,3 +88,20 @@ typedef struct qp_file_stream_t {
 qp_file_stream_t qp_make_file_stream(FILE *f);
 
 #endif // QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// External flash streams
+
+#ifdef QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
+
+typedef struct qp_flash_stream_t {
+    qp_stream_t base;
+    uint32_t    address;
+    int32_t     length;
+    int32_t     position;
+    bool        is_eof;
+} qp_flash_stream_t;
+
+// See qp_flash_assets.h for qp_make_flash_stream()
+
+#endif // QUANTUM_PAINTER_FLASH_ASSETS_ENABLE
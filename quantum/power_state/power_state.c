@@ -0,0 +1,220 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "power_state.h"
+#include "keyboard.h"
+#include "timer.h"
+#include "compiler_support.h"
+#include "util.h"
+#include <lib/lib8tion/lib8tion.h>
+
+#ifdef BACKLIGHT_ENABLE
+#    include "backlight.h"
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
+#ifdef RGBLIGHT_ENABLE
+#    include "rgblight.h"
+#endif
+
+STATIC_ASSERT(POWER_STATE_IDLE_TIMEOUT < POWER_STATE_DOZE_TIMEOUT && POWER_STATE_DOZE_TIMEOUT < POWER_STATE_SLEEP_TIMEOUT, "Power state timeouts must go up from idle to doze to sleep");
+
+static const uint8_t scan_intervals[] = {
+    [POWER_STATE_ACTIVE] = 0,
+    [POWER_STATE_IDLE]   = POWER_STATE_IDLE_SCAN_INTERVAL,
+    [POWER_STATE_DOZE]   = POWER_STATE_DOZE_SCAN_INTERVAL,
+    [POWER_STATE_SLEEP]  = POWER_STATE_SLEEP_SCAN_INTERVAL,
+};
+
+static const uint8_t brightness_scales[] = {
+    [POWER_STATE_ACTIVE] = UINT8_MAX,
+    [POWER_STATE_IDLE]   = POWER_STATE_IDLE_BRIGHTNESS,
+    [POWER_STATE_DOZE]   = POWER_STATE_DOZE_BRIGHTNESS,
+    [POWER_STATE_SLEEP]  = 0,
+};
+
+static power_state_t current_state  = POWER_STATE_ACTIVE;
+static bool          suspended      = false;
+static uint32_t      wakeup_time    = 0;
+static uint16_t      last_scan_time = 0;
+
+// The levels the user had while active, which dimming scales down from and goes back to
+#ifdef BACKLIGHT_ENABLE
+static uint8_t backlight_active_level = 0;
+static bool    backlight_dimmed       = false;
+#endif
+#ifdef RGBLIGHT_ENABLE
+static uint8_t rgblight_active_val = 0;
+static bool    rgblight_dimmed     = false;
+#endif
+#ifdef OLED_ENABLE
+static uint8_t oled_active_brightness = 0;
+static bool    oled_dimmed            = false;
+static bool    oled_turned_off        = false;
+#endif
+
+__attribute__((weak)) bool power_state_changed_user(power_state_t state) {
+    return true;
+}
+
+__attribute__((weak)) bool power_state_changed_kb(power_state_t state) {
+    return power_state_changed_user(state);
+}
+
+#if defined(BACKLIGHT_ENABLE) || defined(RGBLIGHT_ENABLE) || defined(OLED_ENABLE)
+static uint8_t dim(uint8_t level, uint8_t scale) {
+    // scale8_video keeps a dimmed level from rounding down to off
+    return scale == UINT8_MAX ? level : scale8_video(level, scale);
+}
+#endif
+
+static void power_state_save_levels(void) {
+#ifdef BACKLIGHT_ENABLE
+    backlight_dimmed = is_backlight_enabled();
+    if (backlight_dimmed) {
+        backlight_active_level = get_backlight_level();
+    }
+#endif
+#ifdef RGBLIGHT_ENABLE
+    rgblight_dimmed = rgblight_is_enabled();
+    if (rgblight_dimmed) {
+        rgblight_active_val = rgblight_get_val();
+    }
+#endif
+#ifdef OLED_ENABLE
+    oled_dimmed = is_oled_on();
+    if (oled_dimmed) {
+        oled_active_brightness = oled_get_brightness();
+    }
+#endif
+}
+
+static void power_state_apply(power_state_t state) {
+    __attribute__((unused)) uint8_t scale = brightness_scales[state];
+
+#ifdef BACKLIGHT_ENABLE
+    if (backlight_dimmed) {
+        backlight_level_noeeprom(dim(backlight_active_level, scale));
+    }
+#endif
+
+#ifdef RGBLIGHT_ENABLE
+    if (rgblight_dimmed) {
+        rgblight_sethsv_noeeprom(rgblight_get_hue(), rgblight_get_sat(), dim(rgblight_active_val, scale));
+    }
+#endif
+
+#ifdef OLED_ENABLE
+    if (scale == 0) {
+        if (is_oled_on()) {
+            oled_off();
+            oled_turned_off = true;
+        }
+    } else {
+        if (oled_dimmed) {
+            oled_set_brightness(dim(oled_active_brightness, scale));
+        }
+        if (oled_turned_off) {
+            oled_on();
+            oled_turned_off = false;
+        }
+    }
+#endif
+
+    // LED Matrix and RGB Matrix scale their output by power_state_brightness() as they render
+}
+
+static void power_state_set(power_state_t state) {
+    if (current_state == POWER_STATE_ACTIVE) {
+        power_state_save_levels();
+    }
+
+    current_state  = state;
+    last_scan_time = timer_read();
+
+    if (power_state_changed_kb(state)) {
+        power_state_apply(state);
+    }
+}
+
+void power_state_init(void) {
+    wakeup_time = timer_read32();
+}
+
+void power_state_task(void) {
+    if (suspended) {
+        return;
+    }
+
+    // Waking up along with the host counts as activity, so the keyboard doesn't go straight back to sleep
+    uint32_t idle_time = MIN(last_input_activity_elapsed(), timer_elapsed32(wakeup_time));
+
+    power_state_t state = POWER_STATE_ACTIVE;
+    if (idle_time >= POWER_STATE_SLEEP_TIMEOUT) {
+        state = POWER_STATE_SLEEP;
+    } else if (idle_time >= POWER_STATE_DOZE_TIMEOUT) {
+        state = POWER_STATE_DOZE;
+    } else if (idle_time >= POWER_STATE_IDLE_TIMEOUT) {
+        state = POWER_STATE_IDLE;
+    }
+
+    if (state != current_state) {
+        power_state_set(state);
+    }
+}
+
+void preprocess_power_state(void) {
+    // Come back to the user's levels before the key acts on them, so that a dimmed level is never what gets changed or
+    // saved
+    if (!suspended && current_state != POWER_STATE_ACTIVE) {
+        power_state_set(POWER_STATE_ACTIVE);
+    }
+}
+
+power_state_t power_state_get(void) {
+    return current_state;
+}
+
+bool power_state_scan_due(void) {
+    uint8_t interval = scan_intervals[current_state];
+    if (interval == 0) {
+        return true;
+    }
+    if (timer_elapsed(last_scan_time) < interval) {
+        return false;
+    }
+    last_scan_time = timer_read();
+    return true;
+}
+
+uint8_t power_state_brightness(void) {
+    return brightness_scales[current_state];
+}
+
+void power_state_wait(void) {
+    // Idle stays awake for other tasks, and only scans less often
+    if (current_state < POWER_STATE_DOZE) {
+        return;
+    }
+
+    uint16_t elapsed = timer_elapsed(last_scan_time);
+    if (elapsed < scan_intervals[current_state]) {
+        platform_low_power_wait_ms(scan_intervals[current_state] - elapsed);
+    }
+}
+
+void power_state_suspend(void) {
+    suspended = true;
+    if (current_state != POWER_STATE_SLEEP) {
+        power_state_set(POWER_STATE_SLEEP);
+    }
+}
+
+void power_state_wakeup(void) {
+    suspended   = false;
+    wakeup_time = timer_read32();
+    if (current_state != POWER_STATE_ACTIVE) {
+        power_state_set(POWER_STATE_ACTIVE);
+    }
+}
@@ -0,0 +1,121 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * \defgroup power_state Power State API
+ *
+ * \brief Steps the keyboard down through lower power states while there is no input.
+ * \{
+ */
+
+// Time without input before each state, in milliseconds
+#ifndef POWER_STATE_IDLE_TIMEOUT
+#    define POWER_STATE_IDLE_TIMEOUT 5000
+#endif
+#ifndef POWER_STATE_DOZE_TIMEOUT
+#    define POWER_STATE_DOZE_TIMEOUT 60000
+#endif
+#ifndef POWER_STATE_SLEEP_TIMEOUT
+#    define POWER_STATE_SLEEP_TIMEOUT 600000
+#endif
+
+// Time between matrix scans in each state, in milliseconds, which bounds how long a key press takes to wake the keyboard
+#ifndef POWER_STATE_IDLE_SCAN_INTERVAL
+#    define POWER_STATE_IDLE_SCAN_INTERVAL 1
+#endif
+#ifndef POWER_STATE_DOZE_SCAN_INTERVAL
+#    define POWER_STATE_DOZE_SCAN_INTERVAL 8
+#endif
+#ifndef POWER_STATE_SLEEP_SCAN_INTERVAL
+#    define POWER_STATE_SLEEP_SCAN_INTERVAL 25
+#endif
+
+// Lighting and display brightness in each state, scaled from the user's setting, where 255 leaves it unchanged
+#ifndef POWER_STATE_IDLE_BRIGHTNESS
+#    define POWER_STATE_IDLE_BRIGHTNESS 255
+#endif
+#ifndef POWER_STATE_DOZE_BRIGHTNESS
+#    define POWER_STATE_DOZE_BRIGHTNESS 64
+#endif
+
+typedef enum power_state_t {
+    POWER_STATE_ACTIVE,
+    POWER_STATE_IDLE,
+    POWER_STATE_DOZE,
+    POWER_STATE_SLEEP,
+} power_state_t;
+
+/**
+ * \brief Initialize the power state, starting out active.
+ */
+void power_state_init(void);
+
+/**
+ * \brief Move to the state for the time since the last input.
+ */
+void power_state_task(void);
+
+/**
+ * \brief Become active for a key event, before it is processed.
+ */
+void preprocess_power_state(void);
+
+/**
+ * \brief Get the current power state.
+ */
+power_state_t power_state_get(void);
+
+/**
+ * \brief Check whether the matrix is due a scan, counting it as scanned if so.
+ */
+bool power_state_scan_due(void);
+
+/**
+ * \brief Get the brightness for the current state.
+ *
+ * \return The scale to apply to the user's brightness, where 255 leaves it unchanged and 0 turns it off.
+ */
+uint8_t power_state_brightness(void);
+
+/**
+ * \brief Wait in a low power mode until the next matrix scan is due, if the current state allows for it.
+ */
+void power_state_wait(void);
+
+/**
+ * \brief Go to sleep while the host has suspended USB.
+ */
+void power_state_suspend(void);
+
+/**
+ * \brief Wake up along with the host, counting it as activity.
+ */
+void power_state_wakeup(void);
+
+/**
+ * \brief Wait for up to the given time in the platform's low power mode, waking for interrupts.
+ */
+void platform_low_power_wait_ms(uint16_t ms);
+
+/**
+ * \brief user hook called when the power state changed.
+ *
+ * \return false to stop the keyboard hook and the default dimming from running.
+ */
+bool power_state_changed_user(power_state_t state);
+
+/**
+ * \brief keyboard hook called when the power state changed.
+ *
+ * \return false to stop the default dimming from running.
+ */
+bool power_state_changed_kb(power_state_t state);
+
+/** \} */
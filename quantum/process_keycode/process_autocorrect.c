@@ -11,6 +11,9 @@
 #include "keycode_config.h"
 #include "send_string.h"
 #include "action_util.h"
+#include "util.h"
+#include "compiler_support.h"
+#include "nvm_autocorrect.h"
 
 #if __has_include("autocorrect_data.h")
 #    include "autocorrect_data.h"
@@ -19,8 +22,38 @@
 #    include "autocorrect_data_default.h"
 #endif
 
-static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
-static uint8_t typo_buffer_size                    = 1;
+// Ends a chain node whose child is elsewhere, and is followed by a link to it.
+#define AUTOCORRECT_CHAIN_LINK 1
+
+#if AUTOCORRECT_EEPROM_SIZE > 0
+#    define TYPO_BUFFER_SIZE MAX(AUTOCORRECT_MAX_LENGTH, AUTOCORRECT_EEPROM_MAX_LENGTH)
+
+// Parameters of the dictionary loaded into EEPROM, which replaces the built-in one while it is valid
+static bool     dictionary_in_eeprom = false;
+static uint8_t  dictionary_min_length;
+static uint8_t  dictionary_max_length;
+static uint16_t dictionary_size;
+static uint16_t dictionary_received;
+
+static uint8_t dictionary_read_byte(uint16_t offset) {
+    return dictionary_in_eeprom ? nvm_autocorrect_read_byte(offset) : pgm_read_byte(autocorrect_data + offset);
+}
+
+#    define DICTIONARY_MIN_LENGTH (dictionary_in_eeprom ? dictionary_min_length : AUTOCORRECT_MIN_LENGTH)
+#    define DICTIONARY_MAX_LENGTH (dictionary_in_eeprom ? dictionary_max_length : AUTOCORRECT_MAX_LENGTH)
+#    define DICTIONARY_BYTES (dictionary_in_eeprom ? dictionary_size : DICTIONARY_SIZE)
+#else
+#    define TYPO_BUFFER_SIZE AUTOCORRECT_MAX_LENGTH
+#    define DICTIONARY_MIN_LENGTH AUTOCORRECT_MIN_LENGTH
+#    define DICTIONARY_MAX_LENGTH AUTOCORRECT_MAX_LENGTH
+#    define DICTIONARY_BYTES DICTIONARY_SIZE
+#    define dictionary_read_byte(offset) pgm_read_byte(autocorrect_data + (offset))
+#endif
+
+STATIC_ASSERT(TYPO_BUFFER_SIZE + 10 <= UINT8_MAX, "Typos are too long for the correction buffers");
+
+static uint8_t typo_buffer[TYPO_BUFFER_SIZE] = {KC_SPC};
+static uint8_t typo_buffer_size              = 1;
 
 /**
  * @brief function for querying the enabled state of autocorrect
@@ -175,6 +208,125 @@ bool process_autocorrect_default_handler(uint16_t *keycode, keyrecord_t *record,
     return true;
 }
 
+#if AUTOCORRECT_EEPROM_SIZE > 0
+/**
+ * @brief Picks the dictionary loaded into EEPROM, if there is a valid one, or the built-in one
+ *
+ */
+void autocorrect_dictionary_init(void) {
+    dictionary_in_eeprom = false;
+    if (nvm_autocorrect_is_valid()) {
+        nvm_autocorrect_read_info(&dictionary_min_length, &dictionary_max_length, &dictionary_size);
+        dictionary_in_eeprom = dictionary_size > 0 && dictionary_min_length > 0 && dictionary_max_length <= TYPO_BUFFER_SIZE;
+    }
+    // Start as if after a space, so that typos marked as beginning a word are found in the first one
+    typo_buffer[0]   = KC_SPC;
+    typo_buffer_size = 1;
+}
+
+/**
+ * @brief Starts loading a dictionary into EEPROM, which replaces the one in use once complete
+ *
+ * @param min_length length of the shortest typo
+ * @param max_length length of the longest typo
+ * @param size number of bytes of dictionary data to follow
+ * @return false if the dictionary doesn't fit
+ */
+bool autocorrect_dictionary_begin(uint8_t min_length, uint8_t max_length, uint16_t size) {
+    // The built-in dictionary is used while the new one is incomplete
+    nvm_autocorrect_erase();
+    autocorrect_dictionary_init();
+    if (size == 0 || size > AUTOCORRECT_EEPROM_SIZE || min_length == 0 || min_length > max_length || max_length > TYPO_BUFFER_SIZE) {
+        dictionary_size = 0;
+        return false;
+    }
+    dictionary_min_length = min_length;
+    dictionary_max_length = max_length;
+    dictionary_size       = size;
+    dictionary_received   = 0;
+    return true;
+}
+
+/**
+ * @brief Writes the next chunk of the dictionary being loaded. Chunks must be written in order.
+ *
+ * @param offset where the chunk starts in the dictionary data
+ * @param data the chunk
+ * @param length size of the chunk
+ * @return false if no dictionary is being loaded, or the chunk is out of place
+ */
+bool autocorrect_dictionary_write(uint16_t offset, const uint8_t *data, uint8_t length) {
+    if (dictionary_in_eeprom || offset != dictionary_received || length > dictionary_size - dictionary_received) {
+        return false;
+    }
+    nvm_autocorrect_update_buffer(data, offset, length);
+    dictionary_received += length;
+    return true;
+}
+
+/**
+ * @brief Finishes loading a dictionary, and starts using it
+ *
+ * @return false if the dictionary is incomplete
+ */
+bool autocorrect_dictionary_end(void) {
+    if (dictionary_in_eeprom || dictionary_size == 0 || dictionary_received != dictionary_size) {
+        return false;
+    }
+    nvm_autocorrect_update_info(dictionary_min_length, dictionary_max_length, dictionary_size);
+    autocorrect_dictionary_init();
+    return dictionary_in_eeprom;
+}
+
+/**
+ * @brief Drops the dictionary loaded into EEPROM, going back to the built-in one
+ *
+ */
+void autocorrect_dictionary_reset(void) {
+    nvm_autocorrect_erase();
+    autocorrect_dictionary_init();
+}
+
+/**
+ * @brief Handles a raw HID packet for loading a dictionary. Packets start with a command:
+ *
+ *   AUTOCORRECT_HID_BEGIN, min length, max length, size (little endian)
+ *   AUTOCORRECT_HID_WRITE, offset (little endian), length, data...
+ *   AUTOCORRECT_HID_END
+ *   AUTOCORRECT_HID_RESET
+ *
+ * NOTE: The command is replaced with AUTOCORRECT_HID_ERROR if it fails, so the packet can be sent back as the reply
+ *
+ * @param data the packet
+ * @param length size of the packet
+ * @return false if the packet wasn't a dictionary command
+ */
+bool autocorrect_dictionary_receive(uint8_t *data, uint8_t length) {
+    bool okay;
+    switch (data[0]) {
+        case AUTOCORRECT_HID_BEGIN:
+            okay = length >= 5 && autocorrect_dictionary_begin(data[1], data[2], data[3] | data[4] << 8);
+            break;
+        case AUTOCORRECT_HID_WRITE:
+            okay = length >= 4 && data[3] <= length - 4 && autocorrect_dictionary_write(data[1] | data[2] << 8, &data[4], data[3]);
+            break;
+        case AUTOCORRECT_HID_END:
+            okay = autocorrect_dictionary_end();
+            break;
+        case AUTOCORRECT_HID_RESET:
+            autocorrect_dictionary_reset();
+            okay = true;
+            break;
+        default:
+            return false;
+    }
+    if (!okay) {
+        data[0] = AUTOCORRECT_HID_ERROR;
+    }
+    return true;
+}
+#endif // AUTOCORRECT_EEPROM_SIZE > 0
+
 /**
  * @brief handling for when autocorrection has been triggered
  *
@@ -189,6 +341,27 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+#if AUTOCORRECT_EEPROM_SIZE > 0
+/**
+ * @brief user function to apply a correction from a dictionary loaded into EEPROM
+ *
+ * @param backspaces number of characters to remove
+ * @param str pointer to the replacement string, in RAM
+ * @param typo the wrong string
+ * @param correct the correct string
+ * @return true apply correction
+ * @return false user handled replacement
+ */
+__attribute__((weak)) bool apply_autocorrect_ram(uint8_t backspaces, const char *str, char *typo, char *correct) {
+#    if defined(__AVR__)
+    return true;
+#    else
+    // PROGMEM is ordinary memory here, so apply_autocorrect() can be handed a RAM string as well
+    return apply_autocorrect(backspaces, str, typo, correct);
+#    endif
+}
+#endif
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -267,56 +440,79 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
     }
 
     // Rotate oldest character if buffer is full.
-    if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
-        memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
-        typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
+    if (typo_buffer_size >= DICTIONARY_MAX_LENGTH) {
+        memmove(typo_buffer, typo_buffer + 1, DICTIONARY_MAX_LENGTH - 1);
+        typo_buffer_size = DICTIONARY_MAX_LENGTH - 1;
     }
 
     // Append `keycode` to buffer.
     typo_buffer[typo_buffer_size++] = keycode;
     // Return if buffer is smaller than the shortest word.
-    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
+    if (typo_buffer_size < DICTIONARY_MIN_LENGTH) {
         return true;
     }
 
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
     uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    uint8_t  code  = dictionary_read_byte(state);
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
         uint8_t const key_i = typo_buffer[i];
 
         if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+            for (; code != key_i; code = dictionary_read_byte(state += 3)) {
                 if (!code) return true;
             }
             // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            state = (dictionary_read_byte(state + 1) | dictionary_read_byte(state + 2) << 8);
             // Check for match in node with single child.
         } else if (code != key_i) {
             return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+        } else if (!(code = dictionary_read_byte(++state))) {
             ++state;
+        } else if (code == AUTOCORRECT_CHAIN_LINK) {
+            // Follow link to a child node shared with other parts of the dictionary.
+            state = (dictionary_read_byte(state + 1) | dictionary_read_byte(state + 2) << 8);
         }
 
         // Stop if `state` becomes an invalid index. This should not normally
         // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
+        if (state >= DICTIONARY_BYTES) {
             return true;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
+        code = dictionary_read_byte(state);
 
         if (code & 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
             const char *  changes    = (const char *)(autocorrect_data + state + 1);
+            uint8_t       changes_len;
+#if AUTOCORRECT_EEPROM_SIZE > 0
+            // Corrections from EEPROM are copied to RAM, as they can't be passed around as PROGMEM strings
+            char changes_ram[TYPO_BUFFER_SIZE + 10];
+            if (dictionary_in_eeprom) {
+                for (changes_len = 0; changes_len < sizeof(changes_ram) && state + 1 + changes_len < DICTIONARY_BYTES; ++changes_len) {
+                    if (!(changes_ram[changes_len] = dictionary_read_byte(state + 1 + changes_len))) {
+                        break;
+                    }
+                }
+                // Skip a correction that is too long or runs off the end of the dictionary
+                if (changes_len == sizeof(changes_ram) || state + 1 + changes_len >= DICTIONARY_BYTES) {
+                    return true;
+                }
+                changes = changes_ram;
+            } else
+#endif
+            {
+                changes_len = strlen_P(changes);
+            }
 
             /* Gather info about the typo'd word
              *
              * Since buffer may contain several words, delimited by spaces, we
              * iterate from the end to find the start and length of the typo
              */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+            char typo[TYPO_BUFFER_SIZE + 1] = {0}; // extra char for null terminator
 
             uint8_t typo_len   = 0;
             uint8_t typo_start = 0;
@@ -349,17 +545,45 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
              *
              * B) When correcting 'typo' -- Need extra offset for terminator
              */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
+            char correct[TYPO_BUFFER_SIZE + 10] = {0};
 
             uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
+            // Skip a correction that doesn't fit, rather than overrun the buffer
+            if (offset > typo_len || typo_len - offset + changes_len >= sizeof(correct)) {
+                return true;
+            }
+            memcpy(correct, typo, typo_len - offset);
+#if AUTOCORRECT_EEPROM_SIZE > 0
+            if (dictionary_in_eeprom) {
+                memcpy(correct + typo_len - offset, changes, changes_len);
+            } else
+#endif
+            {
+                memcpy_P(correct + typo_len - offset, changes, changes_len);
+            }
 
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
+            bool apply;
+#if AUTOCORRECT_EEPROM_SIZE > 0
+            if (dictionary_in_eeprom) {
+                apply = apply_autocorrect_ram(backspaces, changes, typo, correct);
+            } else
+#endif
+            {
+                apply = apply_autocorrect(backspaces, changes, typo, correct);
+            }
+
+            if (apply) {
                 for (uint8_t i = 0; i < backspaces; ++i) {
                     tap_code(KC_BSPC);
                 }
-                send_string_P(changes);
+#if AUTOCORRECT_EEPROM_SIZE > 0
+                if (dictionary_in_eeprom) {
+                    send_string(changes);
+                } else
+#endif
+                {
+                    send_string_P(changes);
+                }
             }
 
             if (keycode == KC_SPC) {
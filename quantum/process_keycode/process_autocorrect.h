@@ -9,6 +9,21 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "action.h"
+#include "eeconfig.h"
+
+#if AUTOCORRECT_EEPROM_SIZE > 0
+// Length of the longest typo a dictionary loaded into EEPROM may have
+#    ifndef AUTOCORRECT_EEPROM_MAX_LENGTH
+#        define AUTOCORRECT_EEPROM_MAX_LENGTH 32
+#    endif
+
+// Raw HID commands for loading a dictionary, see autocorrect_dictionary_receive()
+#    define AUTOCORRECT_HID_BEGIN 0x01
+#    define AUTOCORRECT_HID_WRITE 0x02
+#    define AUTOCORRECT_HID_END 0x03
+#    define AUTOCORRECT_HID_RESET 0x04
+#    define AUTOCORRECT_HID_ERROR 0xFF
+#endif
 
 bool process_autocorrect(uint16_t keycode, keyrecord_t *record);
 bool process_autocorrect_user(uint16_t *keycode, keyrecord_t *record, uint8_t *typo_buffer_size, uint8_t *mods);
@@ -19,3 +34,13 @@ bool autocorrect_is_enabled(void);
 void autocorrect_enable(void);
 void autocorrect_disable(void);
 void autocorrect_toggle(void);
+
+#if AUTOCORRECT_EEPROM_SIZE > 0
+void autocorrect_dictionary_init(void);
+bool apply_autocorrect_ram(uint8_t backspaces, const char *str, char *typo, char *correct);
+bool autocorrect_dictionary_begin(uint8_t min_length, uint8_t max_length, uint16_t size);
+bool autocorrect_dictionary_write(uint16_t offset, const uint8_t *data, uint8_t length);
+bool autocorrect_dictionary_end(void);
+void autocorrect_dictionary_reset(void);
+bool autocorrect_dictionary_receive(uint8_t *data, uint8_t length);
+#endif
@@ -21,7 +21,10 @@
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
+#include "compiler_support.h"
+#include "nvm_dynamic_macro.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -82,6 +85,46 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
+/* Recorded events are packed into a byte stream rather than stored
+ * as whole keyrecord_t structs. Each event starts with a flags byte,
+ * which says which of the optional fields follow it:
+ *
+ *   flags | [key] | [type] | [tap] | [keycode] | [time]
+ *
+ * key     - the key position, as one byte (row << 4 | col) if both
+ *           fit into a nibble, otherwise as two (row, col). Left out
+ *           if it is the same key as the previous event, which is
+ *           usually the case for the release following a press.
+ * type    - the event type, left out for KEY_EVENT.
+ * tap     - the tap state, left out if all zeroes.
+ * keycode - the 16-bit keycode override used by combos and Repeat Key,
+ *           left out if zero.
+ * time    - the time since the previous event (or the start of the
+ *           recording), in units of DYNAMIC_MACRO_TIME_RESOLUTION
+ *           milliseconds, as a little-endian base-128 varint. Left out
+ *           if zero.
+ *
+ * On playback the timestamps are rebuilt relative to the start of the
+ * playback, so the events keep their spacing.
+ */
+#define DM_PRESSED 0x01
+#define DM_SAME_KEY 0x02
+#define DM_SHORT_KEY 0x04
+#define DM_TYPE 0x08
+#define DM_TAP 0x10
+#define DM_KEYCODE 0x20
+#define DM_TIME 0x40
+
+/* flags, key, type, tap, keycode and a 16-bit varint */
+#define DM_MAX_EVENT_SIZE 10
+
+/* The state carried from one event to the next, for both encoding and
+ * decoding. */
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+} dynamic_macro_cursor_t;
+
 /* Convenience macros used for retrieving the debug info. All of them
  * need a `direction` variable accessible at the call site.
  */
@@ -89,13 +132,146 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
 #define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
 #define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
 
+/**
+ * Pack a single event.
+ *
+ * @param[out]    buffer The packed event, DM_MAX_EVENT_SIZE bytes at most.
+ * @param[in,out] cursor The previous event.
+ * @param[in]     record The event to pack.
+ * @return The packed length.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *buffer, dynamic_macro_cursor_t *cursor, const keyrecord_t *record) {
+    uint8_t flags  = record->event.pressed ? DM_PRESSED : 0;
+    uint8_t length = 1;
+
+    if (KEYEQ(record->event.key, cursor->key)) {
+        flags |= DM_SAME_KEY;
+    } else if (record->event.key.row < 16 && record->event.key.col < 16) {
+        flags |= DM_SHORT_KEY;
+        buffer[length++] = record->event.key.row << 4 | record->event.key.col;
+    } else {
+        buffer[length++] = record->event.key.row;
+        buffer[length++] = record->event.key.col;
+    }
+    cursor->key = record->event.key;
+
+    if (record->event.type != KEY_EVENT) {
+        flags |= DM_TYPE;
+        buffer[length++] = record->event.type;
+    }
+
+#ifndef NO_ACTION_TAPPING
+    uint8_t tap = record->tap.count << 4 | record->tap.interrupted;
+    if (tap) {
+        flags |= DM_TAP;
+        buffer[length++] = tap;
+    }
+#endif
+
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DM_KEYCODE;
+        buffer[length++] = record->keycode & 0xFF;
+        buffer[length++] = record->keycode >> 8;
+    }
+#endif
+
+#if DYNAMIC_MACRO_TIME_RESOLUTION > 0
+    uint16_t units = (uint16_t)(record->event.time - cursor->time) / DYNAMIC_MACRO_TIME_RESOLUTION;
+    /* Step by whole units, so that rounding doesn't add up over a long macro. */
+    cursor->time += units * DYNAMIC_MACRO_TIME_RESOLUTION;
+    if (units) {
+        flags |= DM_TIME;
+        while (units >= 0x80) {
+            buffer[length++] = (units & 0x7F) | 0x80;
+            units >>= 7;
+        }
+        buffer[length++] = units;
+    }
+#endif
+
+    buffer[0] = flags;
+    return length;
+}
+
+/**
+ * Unpack a single event.
+ *
+ * @param[in,out] macro_pointer The position of the event, advanced past it.
+ * @param[in]     direction     Either +1 or -1, which way to iterate the buffer.
+ * @param[in,out] cursor        The previous event.
+ * @param[out]    record        The unpacked event.
+ */
+static void dynamic_macro_decode(uint8_t **macro_pointer, int8_t direction, dynamic_macro_cursor_t *cursor, keyrecord_t *record) {
+    uint8_t *p     = *macro_pointer;
+    uint8_t  flags = *p;
+    p += direction;
+
+    *record = (keyrecord_t){
+        .event.pressed = flags & DM_PRESSED,
+        .event.type    = KEY_EVENT,
+    };
+
+    if (flags & DM_SHORT_KEY) {
+        cursor->key = MAKE_KEYPOS(*p >> 4, *p & 0x0F);
+        p += direction;
+    } else if (!(flags & DM_SAME_KEY)) {
+        cursor->key.row = *p;
+        p += direction;
+        cursor->key.col = *p;
+        p += direction;
+    }
+    record->event.key = cursor->key;
+
+    if (flags & DM_TYPE) {
+        record->event.type = *p;
+        p += direction;
+    }
+
+    if (flags & DM_TAP) {
+#ifndef NO_ACTION_TAPPING
+        record->tap.count       = *p >> 4;
+        record->tap.interrupted = *p & 0x01;
+#endif
+        p += direction;
+    }
+
+    if (flags & DM_KEYCODE) {
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = *p;
+#endif
+        p += direction;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode |= *p << 8;
+#endif
+        p += direction;
+    }
+
+    if (flags & DM_TIME) {
+        uint16_t units = 0;
+        uint8_t  shift = 0;
+        do {
+            units |= (uint16_t)(*p & 0x7F) << shift;
+            shift += 7;
+            p += direction;
+        } while (*(p - direction) & 0x80);
+        cursor->time += units * DYNAMIC_MACRO_TIME_RESOLUTION;
+    }
+    record->event.time = cursor->time;
+
+    *macro_pointer = p;
+}
+
+/* The previous event while recording. */
+static dynamic_macro_cursor_t record_cursor;
+
 /**
  * Start recording of the dynamic macro.
  *
  * @param[out] macro_pointer The new macro buffer iterator.
  * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(uint8_t **macro_pointer, uint8_t *macro_buffer, int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
@@ -103,6 +279,7 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     clear_keyboard();
     layer_clear();
     *macro_pointer = macro_buffer;
+    record_cursor  = (dynamic_macro_cursor_t){.key = MAKE_KEYPOS(UINT8_MAX, UINT8_MAX), .time = timer_read()};
 }
 
 /**
@@ -112,17 +289,19 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(uint8_t *macro_buffer, uint8_t *macro_end, int8_t direction) {
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    layer_state_t          saved_layer_state = layer_state;
+    dynamic_macro_cursor_t cursor            = {.key = MAKE_KEYPOS(UINT8_MAX, UINT8_MAX), .time = timer_read()};
+    keyrecord_t            record;
 
     clear_keyboard();
     layer_clear();
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+    while (direction * (macro_end - macro_buffer) > 0) {
+        dynamic_macro_decode(&macro_buffer, direction, &cursor, &record);
+        process_record(&record);
 #ifdef DYNAMIC_MACRO_DELAY
         wait_ms(DYNAMIC_MACRO_DELAY);
 #endif
@@ -144,7 +323,7 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
  * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(uint8_t *macro_buffer, uint8_t **macro_pointer, uint8_t *macro2_end, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
     if (!record->event.pressed && *macro_pointer == macro_buffer) {
         dprintln("dynamic macro: ignoring a leading key-up event");
@@ -152,33 +331,50 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
     }
 
     /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
+     * is safe to use before overwriting the other macro, and an event
+     * is only stored if all of it fits.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    dynamic_macro_cursor_t cursor = record_cursor;
+    uint8_t                event[DM_MAX_EVENT_SIZE];
+    uint8_t                length = dynamic_macro_encode(event, &cursor, record);
+    if (length <= DYNAMIC_MACRO_CURRENT_CAPACITY(*macro_pointer, macro2_end)) {
+        for (uint8_t i = 0; i < length; i++) {
+            **macro_pointer = event[i];
+            *macro_pointer += direction;
+        }
+        record_cursor = cursor;
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
  * pointer to the end of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(uint8_t *macro_buffer, uint8_t *macro_pointer, int8_t direction, uint8_t **macro_end) {
     dynamic_macro_record_end_kb(direction);
 
     /* Do not save the keys being held when stopping the recording,
-     * i.e. the keys used to access the layer DM_RSTP is on.
+     * i.e. the keys used to access the layer DM_RSTP is on. Events
+     * can only be read forwards, so find the end of the last key-up.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    dynamic_macro_cursor_t cursor = {0};
+    keyrecord_t            record;
+    uint8_t               *last_release = macro_buffer;
+    for (uint8_t *p = macro_buffer; direction * (macro_pointer - p) > 0;) {
+        dynamic_macro_decode(&p, direction, &cursor, &record);
+        if (!record.event.pressed) {
+            last_release = p;
+        }
+    }
+    if (last_release != macro_pointer) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+        macro_pointer = last_release;
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
 
     *macro_end = macro_pointer;
 }
@@ -190,7 +386,7 @@ void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_poin
  * the buffer.
  *
  * Macro2 is written right-to-left starting from the end of the
- * buffer.
+ * buffer, so its packed events are read backwards.
  *
  * &macro_buffer   macro_end
  *  v                   v
@@ -207,28 +403,76 @@ void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_poin
  * macros or one long macro and one short macro. Or even one empty
  * and one using the whole buffer.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
 
 /* Pointer to the first buffer element after the first macro.
  * Initially points to the very beginning of the buffer since the
  * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+static uint8_t *macro_end = macro_buffer;
 
 /* The other end of the macro buffer. Serves as the beginning of
  * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+static uint8_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1;
 
 /* A persistent pointer to the current macro position (iterator)
  * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+static uint8_t *macro_pointer = NULL;
 
 /* 0   - no macro is being recorded right now
  * 1,2 - either macro 1 or 2 is being recorded */
 static uint8_t macro_id = 0;
 
+#if DYNAMIC_MACRO_EEPROM_SIZE > 0
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= DYNAMIC_MACRO_EEPROM_SIZE, "DYNAMIC_MACRO_BUFFER_SIZE must fit into DYNAMIC_MACRO_EEPROM_SIZE");
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+
+/* The EEPROM block mirrors the buffer, so that saving one macro
+ * leaves the other one alone. Its length is cleared while its bytes
+ * are rewritten, so an interrupted save loses the macro rather than
+ * replaying a mix of the old and new ones.
+ */
+static void dynamic_macro_save(int8_t direction) {
+    uint8_t  slot   = DYNAMIC_MACRO_CURRENT_SLOT() - 1;
+    uint16_t length = direction > 0 ? macro_end - macro_buffer : r_macro_buffer - r_macro_end;
+    uint16_t offset = direction > 0 ? 0 : DYNAMIC_MACRO_BUFFER_SIZE - length;
+
+    nvm_dynamic_macro_update_length(slot, 0);
+    nvm_dynamic_macro_update_buffer(macro_buffer + offset, offset, length);
+    nvm_dynamic_macro_update_length(slot, length);
+}
+
+static void dynamic_macro_load(void) {
+    uint16_t length1 = nvm_dynamic_macro_read_length(0);
+    uint16_t length2 = nvm_dynamic_macro_read_length(1);
+
+    if ((uint32_t)length1 + length2 > DYNAMIC_MACRO_BUFFER_SIZE) {
+        dprintln("dynamic macro: ignoring saved macros that don't fit");
+        return;
+    }
+
+    nvm_dynamic_macro_read_buffer(macro_buffer, 0, length1);
+    nvm_dynamic_macro_read_buffer(macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - length2, DYNAMIC_MACRO_BUFFER_SIZE - length2, length2);
+    macro_end   = macro_buffer + length1;
+    r_macro_end = r_macro_buffer - length2;
+}
+#endif // DYNAMIC_MACRO_EEPROM_SIZE > 0
+
+/**
+ * Forget the recorded macros, then restore the saved ones if they are
+ * kept in EEPROM.
+ */
+void dynamic_macro_init(void) {
+    macro_id    = 0;
+    macro_end   = macro_buffer;
+    r_macro_end = r_macro_buffer;
+#if DYNAMIC_MACRO_EEPROM_SIZE > 0
+    dynamic_macro_load();
+#endif
+}
+
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
@@ -236,9 +480,15 @@ void dynamic_macro_stop_recording(void) {
     switch (macro_id) {
         case 1:
             dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
+#if DYNAMIC_MACRO_EEPROM_SIZE > 0
+            dynamic_macro_save(+1);
+#endif
             break;
         case 2:
             dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
+#if DYNAMIC_MACRO_EEPROM_SIZE > 0
+            dynamic_macro_save(-1);
+#endif
             break;
     }
     macro_id = 0;
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "action.h"
+#include "eeconfig.h"
 
 /* May be overridden with a custom value. Be aware that the effective
  * macro length is half of this value: each keypress is recorded twice
@@ -30,11 +31,36 @@
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
  * so 128 is considered a safe default.
+ *
+ * Events are packed, so this only sets how much memory the macros get:
+ * as much as this many keyrecord_t structs would take. Most events
+ * pack into two or three bytes, which fits several times as many.
  */
 #ifndef DYNAMIC_MACRO_SIZE
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* The size of the buffer shared by both macros, in bytes. When the
+ * macros are kept in EEPROM, the buffer is saved as it is, so it is
+ * the size of the EEPROM block instead.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    if DYNAMIC_MACRO_EEPROM_SIZE > 0
+#        define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_EEPROM_SIZE)
+#    else
+#        define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#    endif
+#endif
+
+/* The timing of the recorded events is kept in steps of this many
+ * milliseconds. Coarser steps take fewer bytes per event; 0 drops the
+ * timing altogether, and the events are replayed with the same time.
+ */
+#ifndef DYNAMIC_MACRO_TIME_RESOLUTION
+#    define DYNAMIC_MACRO_TIME_RESOLUTION 1
+#endif
+
+void dynamic_macro_init(void);
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -405,7 +405,7 @@ void key_override_task(void) {
     }
 }
 
-bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+bool process_key_override(const uint16_t keycode, keyrecord_t *const record) {
 #ifdef BENCH_KEY_OVERRIDE
     uint16_t start = timer_read();
 #endif
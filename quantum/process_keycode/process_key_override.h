@@ -100,7 +100,7 @@ void key_override_toggle(void);
 bool key_override_is_enabled(void);
 
 /** Handling of key overrides and its implemented keycodes */
-bool process_key_override(const uint16_t keycode, const keyrecord_t *const record);
+bool process_key_override(const uint16_t keycode, keyrecord_t *const record);
 
 /** Perform any deferred keys */
 void key_override_task(void);
@@ -243,11 +243,7 @@ bool process_midi(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
-#endif // MIDI_ADVANCED
-
-void midi_task(void) {
-    midi_device_process(&midi_device);
-#ifdef MIDI_ADVANCED
+static void midi_modulation_task(void) {
     if (timer_elapsed(midi_modulation_timer) < midi_config.modulation_interval) return;
     midi_modulation_timer = timer_read();
 
@@ -265,5 +261,15 @@ void midi_task(void) {
 
         if (midi_modulation > 127) midi_modulation = 127;
     }
+}
+
+#endif // MIDI_ADVANCED
+
+void midi_task(void) {
+    midi_device_process(&midi_device);
+#ifdef MIDI_ADVANCED
+    midi_modulation_task();
 #endif
+    // send everything queued since the last pass, several events to a USB transfer
+    flush_midi_packets();
 }
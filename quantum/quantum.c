@@ -93,6 +93,10 @@
 #    include "process_oneshot.h"
 #endif
 
+#ifdef EEPROM_DRIVER
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -235,6 +239,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -312,6 +319,10 @@ bool process_record_quantum(keyrecord_t *record) {
     //   return false;
     // }
 
+#ifdef POWER_STATE_ENABLE
+    preprocess_power_state();
+#endif
+
 #if defined(SECURE_ENABLE)
     if (!preprocess_secure(keycode, record)) {
         return false;
@@ -338,120 +349,148 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
-    if (!(
 #if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
 #endif
+
+    return process_record_handlers_dispatch(keycode, record);
+}
+
+// clang-format off
+#define PROCESS_ALL_KEYCODES(func) {.first = 0x0000, .last = 0xFFFF, .handler = func}
+#define PROCESS_KEYCODES(first_keycode, last_keycode, func) {.first = first_keycode, .last = last_keycode, .handler = func}
+
+/** \brief Keycode handlers, in the order process_record_quantum runs them
+ *
+ * Handlers that look at every key event claim the whole keycode space, the
+ * ones that only act on their feature's own keycodes are skipped for any other.
+ */
+const process_record_handler_t process_record_handlers[] PROGMEM = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_ALL_KEYCODES(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_last_key),
+    PROCESS_ALL_KEYCODES(process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_haptic),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_auto_mouse),
 #endif
-            process_record_modules(keycode, record) && // modules must run before kb
-            process_record_kb(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_record_modules), // modules must run before kb
+    PROCESS_ALL_KEYCODES(process_record_kb),
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_KEYCODES(QK_MACRO, QK_MACRO_MAX, process_record_via),
 #endif
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_KEYCODES(QK_SEQUENCER, QK_SEQUENCER_MAX, process_sequencer),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_KEYCODES(QK_MIDI, QK_MIDI_MAX, process_midi),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_KEYCODES(QK_AUDIO, QK_AUDIO_MAX, process_audio),
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_KEYCODES(QK_LIGHTING, QK_LIGHTING_MAX, process_backlight),
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+    PROCESS_KEYCODES(QK_LIGHTING, QK_LIGHTING_MAX, process_led_matrix),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_KEYCODES(QK_STENO, QK_STENO_MAX, process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_key_override),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_tap_dance),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_unicode_common),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_KEYCODES(QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN, process_dynamic_tapping_term),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_KEYCODES(QK_MAGIC, QK_MAGIC_MAX, process_magic),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_KEYCODES(QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, process_grave_esc),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+    PROCESS_KEYCODES(QK_LIGHTING, QK_LIGHTING_MAX, process_underglow),
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+    PROCESS_KEYCODES(QK_LIGHTING, QK_LIGHTING_MAX, process_rgb_matrix),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_KEYCODES(QK_JOYSTICK, QK_JOYSTICK_MAX, process_joystick),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_KEYCODES(QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX, process_programmable_button),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_KEYCODES(QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER, process_tri_layer),
 #endif
 #if !defined(NO_ACTION_LAYER)
-            process_default_layer(keycode, record) &&
+    PROCESS_KEYCODES(QK_PERSISTENT_DEF_LAYER, QK_PERSISTENT_DEF_LAYER_MAX, process_default_layer),
 #endif
 #ifdef LAYER_LOCK_ENABLE
-            process_layer_lock(keycode, record) &&
+    PROCESS_ALL_KEYCODES(process_layer_lock),
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+    PROCESS_KEYCODES(QK_CONNECTION, QK_CONNECTION_MAX, process_connection),
 #endif
 #ifndef NO_ACTION_ONESHOT
-            process_oneshot(keycode, record) &&
+    PROCESS_KEYCODES(QK_ONE_SHOT_ON, QK_ONE_SHOT_TOGGLE, process_oneshot),
 #endif
-            process_quantum(keycode, record))) {
-        return false;
-    }
+    PROCESS_ALL_KEYCODES(process_quantum),
+};
+// clang-format on
+
+const uint8_t process_record_handler_count = ARRAY_SIZE(process_record_handlers);
 
+bool process_record_handlers_dispatch(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handlers); i++) {
+        if (keycode < pgm_read_word(&process_record_handlers[i].first) || keycode > pgm_read_word(&process_record_handlers[i].last)) {
+            continue;
+        }
+        process_record_func_t handler = (process_record_func_t)pgm_read_ptr(&process_record_handlers[i].handler);
+        if (!handler(keycode, record)) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -485,6 +524,13 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 void suspend_power_down_quantum(void) {
     suspend_power_down_modules();
     suspend_power_down_kb();
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
+#ifdef POWER_STATE_ENABLE
+    // before the backlight goes off, so that it comes back at the same level
+    power_state_suspend();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -558,6 +604,9 @@ __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
 #endif
 #if defined(RGB_MATRIX_ENABLE)
     rgb_matrix_set_suspend_state(false);
+#endif
+#ifdef POWER_STATE_ENABLE
+    power_state_wakeup();
 #endif
     suspend_wakeup_init_modules();
     suspend_wakeup_init_kb();
@@ -245,6 +245,10 @@ extern layer_state_t layer_state;
 #    include "os_detection.h"
 #endif
 
+#ifdef POWER_STATE_ENABLE
+#    include "power_state.h"
+#endif
+
 #ifdef LAYER_LOCK_ENABLE
 #    include "layer_lock.h"
 #endif
@@ -272,6 +276,20 @@ bool     process_record_user(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_kb(uint16_t keycode, keyrecord_t *record);
 void     post_process_record_user(uint16_t keycode, keyrecord_t *record);
 
+typedef bool (*process_record_func_t)(uint16_t keycode, keyrecord_t *record);
+
+/* A keycode handler, only called for keycodes from first to last */
+typedef struct {
+    uint16_t              first;
+    uint16_t              last;
+    process_record_func_t handler;
+} process_record_handler_t;
+
+extern const process_record_handler_t process_record_handlers[];
+extern const uint8_t                  process_record_handler_count;
+
+bool process_record_handlers_dispatch(uint16_t keycode, keyrecord_t *record);
+
 void reset_keyboard(void);
 void soft_reset_keyboard(void);
 
@@ -28,6 +28,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef POWER_STATE_ENABLE
+#    include "power_state.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -158,7 +162,20 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
     return index;
 }
 
+// Dim the output while idle, leaving the configured brightness alone
+static inline void rgb_matrix_power_state_dim(uint8_t *red, uint8_t *green, uint8_t *blue) {
+#ifdef POWER_STATE_ENABLE
+    uint8_t scale = power_state_brightness();
+    if (scale < UINT8_MAX) {
+        *red   = scale8_video(*red, scale);
+        *green = scale8_video(*green, scale);
+        *blue  = scale8_video(*blue, scale);
+    }
+#endif
+}
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    rgb_matrix_power_state_dim(&red, &green, &blue);
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
@@ -167,6 +184,7 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+    rgb_matrix_power_state_dim(&red, &green, &blue);
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
@@ -383,6 +401,9 @@ void rgb_matrix_task(void) {
 #if RGB_MATRIX_TIMEOUT > 0
                              (last_input_activity_elapsed() > (uint32_t)RGB_MATRIX_TIMEOUT) ||
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef POWER_STATE_ENABLE
+                             (power_state_get() == POWER_STATE_SLEEP) ||
+#endif // POWER_STATE_ENABLE
                              false;
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
@@ -24,6 +24,13 @@
 #include "action.h"
 #include "wait.h"
 
+#ifdef SEND_STRING_PACK_REPORTS
+#    include "action_util.h"
+#    include "report.h"
+#    include "host.h"
+#    include "keycode_config.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -143,16 +150,134 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
-
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
+#ifdef SEND_STRING_PACK_REPORTS
+/* A run of characters that share a single press report and a single
+ * release report: same modifiers, no repeated keys, and no more keys than
+ * the report has room for.
+ */
+typedef struct send_string_packed_run_t {
+    uint8_t keycodes[KEYBOARD_REPORT_KEYS];
+    uint8_t count;
+    uint8_t capacity;
+    uint8_t mods;
+} send_string_packed_run_t;
+
+static inline bool send_string_nkro_active(void) {
+#    ifdef NKRO_ENABLE
+    return host_can_send_nkro() && keymap_config.nkro;
+#    else
+    return false;
+#    endif
+}
+
+static uint8_t send_string_free_report_keys(void) {
+    if (send_string_nkro_active()) {
+        return KEYBOARD_REPORT_KEYS;
+    }
+
+    uint8_t free_keys = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (keyboard_report->keys[i] == KC_NO) {
+            free_keys++;
+        }
+    }
+    return free_keys;
+}
+
+static bool send_string_packed_run_add(send_string_packed_run_t *run, char ascii_code) {
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+
+    // Dead keys need a space tapped afterwards, and BEL and control codes aren't keys at all
+    if (keycode == KC_NO || PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+        return false;
+    }
+
+    // A key that is already held would not register as a new press
+    if (is_key_pressed(keycode)) {
+        return false;
+    }
+
+    uint8_t mods = (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+
+    if (run->count == 0) {
+        run->capacity = send_string_free_report_keys();
+        run->mods     = mods;
+    } else {
+        if (mods != run->mods || run->count >= run->capacity) {
+            return false;
+        }
+        for (uint8_t i = 0; i < run->count; i++) {
+            if (run->keycodes[i] == keycode) {
+                return false;
+            }
+        }
+        // The host reads an NKRO bitmap in keycode order, so that must match the order of the characters
+        if (send_string_nkro_active() && keycode < run->keycodes[run->count - 1]) {
+            return false;
+        }
+    }
+
+    if (run->count >= run->capacity) {
+        return false;
+    }
+
+    run->keycodes[run->count++] = keycode;
+    return true;
+}
+
+// Types out a run with the same timing as send_char_with_delay(), but only one press and one release report
+static void send_string_packed_run_send(send_string_packed_run_t *run, uint8_t interval) {
+    if (run->count == 0) {
+        return;
+    }
+
+    if (run->mods) {
+        register_mods(run->mods);
+        wait_ms(interval);
+    }
+
+    for (uint8_t i = 0; i < run->count; i++) {
+        add_key(run->keycodes[i]);
+    }
+    send_keyboard_report();
+    wait_ms(interval);
+
+    for (uint8_t i = 0; i < run->count; i++) {
+        del_key(run->keycodes[i]);
+    }
+    send_keyboard_report();
+    wait_ms(interval);
+
+    if (run->mods) {
+        unregister_mods(run->mods);
+        wait_ms(interval);
+    }
+
+    run->count = 0;
+}
+#endif
+
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+#ifdef SEND_STRING_PACK_REPORTS
+    send_string_packed_run_t run = {0};
+#endif
+
     while (1) {
         char ascii_code = getter(arg);
+#ifdef SEND_STRING_PACK_REPORTS
+        // Hold characters back until one arrives that can't share their report
+        if (send_string_packed_run_add(&run, ascii_code)) {
+            continue;
+        }
+        send_string_packed_run_send(&run, interval);
+        if (send_string_packed_run_add(&run, ascii_code)) {
+            continue;
+        }
+#endif
         if (!ascii_code) break;
         if (ascii_code == SS_QMK_PREFIX) {
             ascii_code = getter(arg);
@@ -193,10 +318,6 @@ void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t inte
     }
 }
 
-typedef struct send_string_memory_state_t {
-    const char *string;
-} send_string_memory_state_t;
-
 char send_string_get_next_ram(void *arg) {
     send_string_memory_state_t *state = (send_string_memory_state_t *)arg;
     char                        ret   = *state->string;
@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#pragma once
+
 /**
  * \file
  *
@@ -46,6 +48,9 @@ extern const uint8_t ascii_to_keycode_lut[128];
     | ((h) ? 1 : 0) << 7 )
 // clang-format on
 
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
 /**
  * \brief Type out a string of ASCII characters.
  *
@@ -169,4 +174,25 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 
+/**
+ * \brief Getter state for strings in RAM or PROGMEM, pointing at the next character to be sent.
+ */
+typedef struct send_string_memory_state_t {
+    const char *string;
+} send_string_memory_state_t;
+
+/**
+ * \brief Getter for strings in RAM, for use with `send_string_with_delay_impl()`.
+ */
+char send_string_get_next_ram(void *arg);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Getter for strings in PROGMEM, for use with `send_string_with_delay_impl()`.
+ */
+char send_string_get_next_progmem(void *arg);
+#else
+#    define send_string_get_next_progmem send_string_get_next_ram
+#endif
+
 /** \} */
@@ -0,0 +1,308 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string_async.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "quantum_keycodes.h"
+#include "keycode.h"
+#include "action.h"
+#include "timer.h"
+#include "debug.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Steps
+//
+// Each character (or SS_* sequence) is decoded into a short list of key events, each followed by the delay the blocking
+// send_string() implementation would wait after it.
+
+typedef enum send_string_async_step_type_t {
+    SEND_STRING_ASYNC_STEP_DOWN,
+    SEND_STRING_ASYNC_STEP_UP,
+    SEND_STRING_ASYNC_STEP_WAIT,
+} send_string_async_step_type_t;
+
+typedef struct send_string_async_step_t {
+    uint8_t  type;    // see send_string_async_step_type_t
+    uint8_t  keycode; // basic keycode, unused for waits
+    uint32_t delay;   // milliseconds to wait before the next step
+} send_string_async_step_t;
+
+// Worst case is a shifted, AltGr'd dead key: both modifiers pressed and released, plus the key and space taps
+#define SEND_STRING_ASYNC_MAX_STEPS 8
+
+static send_string_async_step_t steps[SEND_STRING_ASYNC_MAX_STEPS];
+static uint8_t                  step_count = 0;
+static uint8_t                  step_pos   = 0;
+static uint32_t                 next_step_time;
+static bool                     step_delay_pending = false;
+static bool                     string_terminated  = false;
+
+static void add_step(send_string_async_step_type_t type, uint8_t keycode, uint32_t delay) {
+    if (step_count < SEND_STRING_ASYNC_MAX_STEPS) {
+        steps[step_count++] = (send_string_async_step_t){.type = type, .keycode = keycode, .delay = delay};
+    }
+}
+
+static void add_tap_steps(uint8_t keycode, uint16_t hold_delay, uint8_t interval) {
+    add_step(SEND_STRING_ASYNC_STEP_DOWN, keycode, hold_delay);
+    add_step(SEND_STRING_ASYNC_STEP_UP, keycode, interval);
+}
+
+static inline uint16_t tap_hold_delay(uint8_t keycode) {
+    return keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Queue
+
+typedef struct send_string_async_item_t {
+    send_string_async_token_t token;
+    uint8_t                   interval;
+    char (*getter)(void *);
+    union {
+        uint8_t  bytes[SEND_STRING_ASYNC_ARG_SIZE];
+        uint32_t align32;
+        void    *align_ptr;
+    } arg;
+    send_string_async_callback_t callback;
+    void                        *cb_arg;
+} send_string_async_item_t;
+
+// Entry 0 is the string currently being typed
+static send_string_async_item_t  queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t                   queue_count = 0;
+static send_string_async_token_t last_token  = INVALID_SEND_STRING_ASYNC_TOKEN;
+
+static int8_t find_item(send_string_async_token_t token) {
+    for (uint8_t i = 0; i < queue_count; ++i) {
+        if (queue[i].token == token) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static send_string_async_token_t next_token(void) {
+    do {
+        ++last_token;
+    } while (last_token == INVALID_SEND_STRING_ASYNC_TOKEN || find_item(last_token) >= 0);
+    return last_token;
+}
+
+static void reset_steps(void) {
+    step_count         = 0;
+    step_pos           = 0;
+    step_delay_pending = false;
+    string_terminated  = false;
+}
+
+// Removes a string from the queue, then lets its owner know
+static void finish_item(uint8_t index, bool completed) {
+    send_string_async_item_t item = queue[index];
+    memmove(&queue[index], &queue[index + 1], (queue_count - index - 1) * sizeof(send_string_async_item_t));
+    --queue_count;
+
+    if (index == 0) {
+        reset_steps();
+    }
+
+    if (item.callback) {
+        item.callback(item.token, completed, item.cb_arg);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Decoding -- mirrors send_string_with_delay_impl() and send_char_with_delay()
+
+static void decode_char(char ascii_code, uint8_t interval) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        // Doesn't wait, so can be left to the blocking implementation
+        send_char_with_delay(ascii_code, 0);
+        return;
+    }
+#endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        add_step(SEND_STRING_ASYNC_STEP_DOWN, KC_LEFT_SHIFT, interval);
+    }
+    if (is_altgred) {
+        add_step(SEND_STRING_ASYNC_STEP_DOWN, KC_RIGHT_ALT, interval);
+    }
+    add_tap_steps(keycode, interval, interval);
+    if (is_altgred) {
+        add_step(SEND_STRING_ASYNC_STEP_UP, KC_RIGHT_ALT, interval);
+    }
+    if (is_shifted) {
+        add_step(SEND_STRING_ASYNC_STEP_UP, KC_LEFT_SHIFT, interval);
+    }
+    if (is_dead) {
+        add_tap_steps(KC_SPACE, tap_hold_delay(KC_SPACE), interval);
+    }
+}
+
+// Fills in the steps for the next character of the current string, returning false once the string has ended
+static bool decode_next(send_string_async_item_t *item) {
+    if (string_terminated) {
+        return false;
+    }
+
+    char ascii_code = item->getter(item->arg.bytes);
+    if (!ascii_code) {
+        return false;
+    }
+
+    if (ascii_code != SS_QMK_PREFIX) {
+        decode_char(ascii_code, item->interval);
+        return true;
+    }
+
+    ascii_code = item->getter(item->arg.bytes);
+    if (ascii_code == SS_TAP_CODE) {
+        uint8_t keycode = item->getter(item->arg.bytes);
+        add_tap_steps(keycode, tap_hold_delay(keycode), item->interval);
+    } else if (ascii_code == SS_DOWN_CODE) {
+        add_step(SEND_STRING_ASYNC_STEP_DOWN, item->getter(item->arg.bytes), item->interval);
+    } else if (ascii_code == SS_UP_CODE) {
+        add_step(SEND_STRING_ASYNC_STEP_UP, item->getter(item->arg.bytes), item->interval);
+    } else if (ascii_code == SS_DELAY_CODE) {
+        uint32_t ms = 0;
+        ascii_code  = item->getter(item->arg.bytes);
+        while (isdigit(ascii_code)) {
+            ms *= 10;
+            ms += ascii_code - '0';
+            ascii_code = item->getter(item->arg.bytes);
+        }
+        add_step(SEND_STRING_ASYNC_STEP_WAIT, 0, ms + item->interval);
+    } else {
+        add_step(SEND_STRING_ASYNC_STEP_WAIT, 0, item->interval);
+    }
+
+    // If we had a delay that terminated with a null, the string is done once these steps are
+    string_terminated = (ascii_code == 0);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// API
+
+send_string_async_token_t send_string_async_with_delay_impl(char (*getter)(void *), const void *arg, uint8_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    if (queue_count >= SEND_STRING_ASYNC_QUEUE_SIZE || arg_size > SEND_STRING_ASYNC_ARG_SIZE) {
+        dprintf("send_string_async: could not queue string\n");
+        return INVALID_SEND_STRING_ASYNC_TOKEN;
+    }
+
+    send_string_async_item_t *item = &queue[queue_count];
+    memset(item, 0, sizeof(send_string_async_item_t));
+    item->token    = next_token();
+    item->interval = interval;
+    item->getter   = getter;
+    item->callback = callback;
+    item->cb_arg   = cb_arg;
+    memcpy(item->arg.bytes, arg, arg_size);
+
+    // Start typing straight away if nothing else is queued
+    if (queue_count++ == 0) {
+        reset_steps();
+    }
+    return item->token;
+}
+
+send_string_async_token_t send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+send_string_async_token_t send_string_async_with_delay(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_with_delay_impl(send_string_get_next_ram, &state, sizeof(state), interval, NULL, NULL);
+}
+
+#if defined(__AVR__)
+send_string_async_token_t send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_with_delay_impl(send_string_get_next_progmem, &state, sizeof(state), interval, NULL, NULL);
+}
+#endif
+
+bool send_string_async_cancel(send_string_async_token_t token) {
+    int8_t index = find_item(token);
+    if (index < 0) {
+        return false;
+    }
+
+    // Don't leave anything held that the current character pressed
+    if (index == 0) {
+        for (; step_pos < step_count; ++step_pos) {
+            if (steps[step_pos].type == SEND_STRING_ASYNC_STEP_UP) {
+                unregister_code(steps[step_pos].keycode);
+            }
+        }
+    }
+
+    finish_item(index, false);
+    return true;
+}
+
+void send_string_async_cancel_all(void) {
+    while (queue_count > 0) {
+        send_string_async_cancel(queue[queue_count - 1].token);
+    }
+}
+
+bool send_string_async_is_pending(send_string_async_token_t token) {
+    return token != INVALID_SEND_STRING_ASYNC_TOKEN && find_item(token) >= 0;
+}
+
+bool send_string_async_is_active(void) {
+    return queue_count > 0;
+}
+
+void send_string_async_task(void) {
+    uint8_t keys_sent = 0;
+    while (queue_count > 0 && keys_sent < SEND_STRING_ASYNC_MAX_KEYS_PER_TASK) {
+        // Wait out the delay after the previous step
+        if (step_delay_pending) {
+            if (!timer_expired32(timer_read32(), next_step_time)) {
+                return;
+            }
+            step_delay_pending = false;
+        }
+
+        // Move on to the next character once the current one has been typed
+        if (step_pos == step_count) {
+            step_count = 0;
+            step_pos   = 0;
+            if (!decode_next(&queue[0])) {
+                finish_item(0, true);
+            }
+            continue;
+        }
+
+        send_string_async_step_t *step = &steps[step_pos++];
+        switch (step->type) {
+            case SEND_STRING_ASYNC_STEP_DOWN:
+                register_code(step->keycode);
+                ++keys_sent;
+                break;
+            case SEND_STRING_ASYNC_STEP_UP:
+                unregister_code(step->keycode);
+                ++keys_sent;
+                break;
+            default:
+                break;
+        }
+
+        if (step->delay > 0) {
+            next_step_time     = timer_read32() + step->delay;
+            step_delay_pending = true;
+        }
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * \file
+ *
+ * \defgroup send_string_async Asynchronous Send String API
+ *
+ * \brief These functions queue strings to be typed out from the main loop, instead of blocking until they're done.
+ *
+ * Each keystroke is emitted from `send_string_async_task()`, and any intervals or `SS_DELAY()` are waited out by
+ * scheduling the next keystroke rather than sleeping, so matrix scanning, lighting and split syncing carry on while a
+ * string is being typed. Strings are typed one at a time, in the order they were queued.
+ * \{
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "send_string.h"
+
+#ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+/**
+ * \brief The maximum number of strings that can be queued at once, including the one being typed.
+ */
+#    define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#endif
+
+#ifndef SEND_STRING_ASYNC_ARG_SIZE
+/**
+ * \brief The maximum size of the getter state copied into the queue for each string.
+ */
+#    define SEND_STRING_ASYNC_ARG_SIZE 8
+#endif
+
+#ifndef SEND_STRING_ASYNC_MAX_KEYS_PER_TASK
+/**
+ * \brief The maximum number of key events sent by a single `send_string_async_task()` call when there is no delay between them.
+ */
+#    define SEND_STRING_ASYNC_MAX_KEYS_PER_TASK 4
+#endif
+
+/**
+ * \brief A token identifying a queued string, usable for cancellation.
+ */
+typedef uint8_t send_string_async_token_t;
+
+/**
+ * \brief The token value denoting a string which could not be queued.
+ */
+#define INVALID_SEND_STRING_ASYNC_TOKEN 0
+
+/**
+ * \brief Callback invoked once a queued string has finished, or has been cancelled.
+ *
+ * \param token The token returned when the string was queued.
+ * \param completed `true` if the whole string was typed, `false` if it was cancelled.
+ * \param cb_arg The callback argument supplied when the string was queued.
+ */
+typedef void (*send_string_async_callback_t)(send_string_async_token_t token, bool completed, void *cb_arg);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out. It must remain valid until the string has finished typing.
+ * \return A token for the queued string, or `INVALID_SEND_STRING_ASYNC_TOKEN` if the queue is full.
+ */
+send_string_async_token_t send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out, with a delay between each character.
+ *
+ * \param string The string to type out. It must remain valid until the string has finished typing.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \return A token for the queued string, or `INVALID_SEND_STRING_ASYNC_TOKEN` if the queue is full.
+ */
+send_string_async_token_t send_string_async_with_delay(const char *string, uint8_t interval);
+
+#if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \return A token for the queued string, or `INVALID_SEND_STRING_ASYNC_TOKEN` if the queue is full.
+ */
+send_string_async_token_t send_string_async_with_delay_P(const char *string, uint8_t interval);
+#else
+#    define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), interval).
+ */
+#define SEND_STRING_ASYNC_DELAY(string, interval) send_string_async_with_delay_P(PSTR(string), interval)
+
+/**
+ * \brief Queue a string produced by a getter function, as per `send_string_with_delay_impl()`.
+ *
+ * The getter's state is copied into the queue, so `arg` does not need to outlive this call.
+ *
+ * \param getter Returns the next character of the string each time it is invoked.
+ * \param arg The getter's initial state.
+ * \param arg_size The size of the getter's state, at most `SEND_STRING_ASYNC_ARG_SIZE`.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \param callback Invoked once the string has finished or been cancelled, may be NULL.
+ * \param cb_arg Passed to `callback`.
+ * \return A token for the queued string, or `INVALID_SEND_STRING_ASYNC_TOKEN` if the queue is full.
+ */
+send_string_async_token_t send_string_async_with_delay_impl(char (*getter)(void *), const void *arg, uint8_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+
+/**
+ * \brief Cancel a queued string.
+ *
+ * If the string is being typed, any modifiers or keys it is partway through tapping are released. Keys held down by
+ * `SS_DOWN()` are left held.
+ *
+ * \param token The token returned when the string was queued.
+ * \return `true` if the string was cancelled, `false` if it had already finished.
+ */
+bool send_string_async_cancel(send_string_async_token_t token);
+
+/**
+ * \brief Cancel all queued strings.
+ */
+void send_string_async_cancel_all(void);
+
+/**
+ * \brief Check whether a string is still queued or being typed.
+ *
+ * \param token The token returned when the string was queued.
+ */
+bool send_string_async_is_pending(send_string_async_token_t token);
+
+/**
+ * \brief Check whether any string is queued or being typed.
+ */
+bool send_string_async_is_active(void);
+
+/**
+ * \brief Types out the next part of the current string, when due. Called from the main loop; should not be invoked by
+ * keyboard/user code.
+ */
+void send_string_async_task(void);
+
+/** \} */
@@ -30,6 +30,7 @@
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "util.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -113,10 +114,11 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     return false;
 }
 
-#define TRANSACTION_HANDLER_MASTER(prefix)                                                                              \
+#define TRANSACTION_HANDLER_MASTER_CALL(prefix)                                                                         \
     do {                                                                                                                \
         if (!transaction_handler_master(master_matrix, slave_matrix, #prefix, &prefix##_handlers_master)) return false; \
     } while (0)
+#define TRANSACTION_HANDLER_MASTER(prefix) TRANSACTION_HANDLER_MASTER_CALL(prefix)
 
 /**
  * @brief Constructs a transaction handler that doesn't acquire a lock to the
@@ -954,6 +956,150 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#ifdef SPLIT_TRANSACTION_BUDGET_US
+
+////////////////////////////////////////////////////
+// Scheduler
+//
+// Input transactions run first on every pass. The remaining groups then run in order of how long they have been waiting,
+// for as long as the pass stays within SPLIT_TRANSACTION_BUDGET_US. A group left waiting longer than
+// SPLIT_TRANSACTION_MAX_DEFER_MS is run regardless of the budget, one per pass, so nothing is starved.
+
+#    ifndef SPLIT_TRANSACTION_MAX_DEFER_MS
+#        define SPLIT_TRANSACTION_MAX_DEFER_MS 10
+#    endif // SPLIT_TRANSACTION_MAX_DEFER_MS
+
+#    if defined(PROTOCOL_CHIBIOS)
+#        include <ch.h>
+typedef systime_t split_budget_time_t;
+#        define split_budget_now() chVTGetSystemTimeX()
+#        define split_budget_elapsed_us(start) ((uint32_t)TIME_I2US(chVTTimeElapsedSinceX(start)))
+#    else
+typedef uint32_t split_budget_time_t;
+#        define split_budget_now() timer_read32()
+#        define split_budget_elapsed_us(start) (timer_elapsed32(start) * 1000UL)
+#    endif
+
+typedef struct split_scheduled_group_t {
+    const char *name;
+    bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+} split_scheduled_group_t;
+
+// Expand the lower priority groups into a table instead of calling them inline
+#    undef TRANSACTION_HANDLER_MASTER
+#    define TRANSACTION_HANDLER_MASTER(prefix) {#prefix, &prefix##_handlers_master},
+
+static const split_scheduled_group_t split_scheduled_groups[] = {
+    // clang-format off
+    TRANSACTIONS_SYNC_TIMER_MASTER()
+    TRANSACTIONS_LAYER_STATE_MASTER()
+    TRANSACTIONS_LED_STATE_MASTER()
+    TRANSACTIONS_MODS_MASTER()
+    TRANSACTIONS_BACKLIGHT_MASTER()
+    TRANSACTIONS_RGBLIGHT_MASTER()
+    TRANSACTIONS_LED_MATRIX_MASTER()
+    TRANSACTIONS_RGB_MATRIX_MASTER()
+    TRANSACTIONS_WPM_MASTER()
+    TRANSACTIONS_OLED_MASTER()
+    TRANSACTIONS_ST7565_MASTER()
+    TRANSACTIONS_WATCHDOG_MASTER()
+    TRANSACTIONS_HAPTIC_MASTER()
+    TRANSACTIONS_ACTIVITY_MASTER()
+    TRANSACTIONS_DETECTED_OS_MASTER()
+    // clang-format on
+    {NULL, NULL},
+};
+
+#    undef TRANSACTION_HANDLER_MASTER
+#    define TRANSACTION_HANDLER_MASTER(prefix) TRANSACTION_HANDLER_MASTER_CALL(prefix)
+
+#    define SPLIT_SCHEDULED_GROUP_COUNT (ARRAY_SIZE(split_scheduled_groups) - 1)
+
+static uint32_t                   split_scheduled_last_run[ARRAY_SIZE(split_scheduled_groups)];
+static split_transactions_stats_t split_stats;
+
+void split_transactions_get_stats(split_transactions_stats_t *stats) {
+    memcpy(stats, &split_stats, sizeof(split_transactions_stats_t));
+}
+
+void split_transactions_reset_stats(void) {
+    memset(&split_stats, 0, sizeof(split_transactions_stats_t));
+}
+
+// Returns the group that has been waiting the longest and has not yet run this pass, or -1 if there are none
+static int8_t split_scheduler_next_group(uint32_t now, const bool *ran) {
+    int8_t   next    = -1;
+    uint32_t longest = 0;
+    for (uint8_t i = 0; i < SPLIT_SCHEDULED_GROUP_COUNT; ++i) {
+        uint32_t waited = TIMER_DIFF_32(now, split_scheduled_last_run[i]);
+        if (!ran[i] && (next < 0 || waited > longest)) {
+            next    = i;
+            longest = waited;
+        }
+    }
+    return next;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool         scheduler_started = false;
+    split_budget_time_t start             = split_budget_now();
+
+    if (!scheduler_started) {
+        for (uint8_t i = 0; i < SPLIT_SCHEDULED_GROUP_COUNT; ++i) {
+            split_scheduled_last_run[i] = timer_read32();
+        }
+        scheduler_started = true;
+    }
+
+    ++split_stats.passes;
+
+    // Input first
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+
+    if (split_budget_elapsed_us(start) >= SPLIT_TRANSACTION_BUDGET_US) {
+        ++split_stats.over_budget;
+    }
+
+    bool    ran[ARRAY_SIZE(split_scheduled_groups)] = {false};
+    bool    forced                                  = false;
+    uint8_t skipped                                 = SPLIT_SCHEDULED_GROUP_COUNT;
+    int8_t  next;
+    while ((next = split_scheduler_next_group(timer_read32(), ran)) >= 0) {
+        uint32_t now  = timer_read32();
+        bool     late = TIMER_DIFF_32(now, split_scheduled_last_run[next]) > SPLIT_TRANSACTION_MAX_DEFER_MS;
+        if (split_budget_elapsed_us(start) >= SPLIT_TRANSACTION_BUDGET_US) {
+            // Out of time, but don't leave an overdue group waiting any longer
+            if (!late || forced) {
+                break;
+            }
+            forced = true;
+        }
+
+        if (late) {
+            ++split_stats.late;
+        }
+
+        ran[next] = true;
+        --skipped;
+        if (!transaction_handler_master(master_matrix, slave_matrix, split_scheduled_groups[next].name, split_scheduled_groups[next].handler)) {
+            return false;
+        }
+        split_scheduled_last_run[next] = now;
+    }
+    split_stats.skipped += skipped;
+
+    uint32_t elapsed = split_budget_elapsed_us(start);
+    if (elapsed > split_stats.max_pass_us) {
+        split_stats.max_pass_us = elapsed;
+    }
+    return true;
+}
+
+#else // SPLIT_TRANSACTION_BUDGET_US
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
@@ -977,6 +1123,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+#endif // SPLIT_TRANSACTION_BUDGET_US
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
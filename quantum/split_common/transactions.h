@@ -45,6 +45,20 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_TRANSACTION_BUDGET_US
+// Statistics from the split transaction scheduler
+typedef struct split_transactions_stats_t {
+    uint32_t passes;      // number of times the master has run its transactions
+    uint32_t over_budget; // passes where the input transactions alone used up the budget
+    uint32_t skipped;     // lower priority group runs deferred to a later pass for lack of time
+    uint32_t late;        // lower priority group runs that happened more than SPLIT_TRANSACTION_MAX_DEFER_MS after the last
+    uint32_t max_pass_us; // longest pass seen, in microseconds
+} split_transactions_stats_t;
+
+void split_transactions_get_stats(split_transactions_stats_t *stats);
+void split_transactions_reset_stats(void);
+#endif // SPLIT_TRANSACTION_BUDGET_US
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
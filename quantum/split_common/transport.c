@@ -123,7 +123,12 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if !defined(USE_I2C) && defined(SERIAL_USART_FRAMED)
+    // Writes wait for a read to carry them, so send what is left before the scan ends, rather than with the next one
+    return transactions_master(master_matrix, slave_matrix) && soft_serial_flush();
+#else
     return transactions_master(master_matrix, slave_matrix);
+#endif
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
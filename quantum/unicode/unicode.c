@@ -324,16 +324,36 @@ static void send_nibble_wrapper(uint8_t digit) {
 
 // clang-format on
 
+// Sends the digits as a single string where possible, so they can share reports if SEND_STRING_PACK_REPORTS is enabled
+static void send_nibbles(const uint8_t *digits, uint8_t count) {
+    if (unicode_config.input_mode == UNICODE_MODE_WINDOWS) {
+        for (uint8_t i = 0; i < count; i++) {
+            send_nibble_wrapper(digits[i]);
+        }
+        return;
+    }
+
+    char str[10];
+    for (uint8_t i = 0; i < count; i++) {
+        str[i] = digits[i] < 10 ? '0' + digits[i] : 'a' + (digits[i] - 10);
+    }
+    str[count] = '\0';
+    send_string(str);
+}
+
 void register_hex(uint16_t hex) {
+    uint8_t digits[4];
     for (int i = 3; i >= 0; i--) {
-        uint8_t digit = ((hex >> (i * 4)) & 0xF);
-        send_nibble_wrapper(digit);
+        digits[3 - i] = ((hex >> (i * 4)) & 0xF);
     }
+    send_nibbles(digits, 4);
 }
 
 void register_hex32(uint32_t hex) {
-    bool first_digit        = true;
-    bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
+    uint8_t digits[9];
+    uint8_t count              = 0;
+    bool    first_digit        = true;
+    bool    needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
     for (int i = 7; i >= 0; i--) {
         // Work out the digit we're going to transmit
         uint8_t digit = ((hex >> (i * 4)) & 0xF);
@@ -341,7 +361,7 @@ void register_hex32(uint32_t hex) {
         // If we're still searching for the first digit, and found one
         // that needs a leading zero sent out, send the zero.
         if (first_digit && needs_leading_zero && digit > 9) {
-            send_nibble_wrapper(0);
+            digits[count++] = 0;
         }
 
         // Always send digits (including zero) if we're down to the last
@@ -350,10 +370,11 @@ void register_hex32(uint32_t hex) {
 
         // If we've found a digit worth transmitting, do so.
         if (digit != 0 || !first_digit || must_send) {
-            send_nibble_wrapper(digit);
-            first_digit = false;
+            digits[count++] = digit;
+            first_digit     = false;
         }
     }
+    send_nibbles(digits, count);
 }
 
 void register_unicode(uint32_t code_point) {
@@ -36,6 +36,7 @@
 #include "wait.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "nvm_via.h"
+#include "nvm_transaction.h"
 
 #if defined(AUDIO_ENABLE)
 #    include "audio.h"
@@ -118,12 +119,15 @@ void eeconfig_init_via(void) {
     nvm_via_erase();
     // set the magic number to false, in case this gets interrupted
     via_eeprom_set_valid(false);
+    // Stage the reset, and commit all of it before the magic number
+    nvm_transaction_begin();
     // This resets the layout options
     via_set_layout_options(VIA_EEPROM_LAYOUT_OPTIONS_DEFAULT);
     // This resets the keymaps in EEPROM to what is in flash.
     dynamic_keymap_reset();
     // This resets the macros in EEPROM to nothing.
     dynamic_keymap_macro_reset();
+    nvm_transaction_commit();
     // Save the magic number last, in case saving was interrupted
     via_eeprom_set_valid(true);
 }
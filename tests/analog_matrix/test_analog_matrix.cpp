@@ -0,0 +1,295 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "analog_matrix.h"
+#include "analog_matrix_mock.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class AnalogMatrix : public TestFixture {
+   public:
+    void SetUp() override {
+        analog_matrix_mock_reset();
+        analog_matrix_config_t config = {
+            .actuation_point       = ANALOG_MATRIX_ACTUATION_POINT,
+            .hysteresis            = ANALOG_MATRIX_HYSTERESIS,
+            .rapid_trigger_release = 0,
+            .rapid_trigger_press   = 0,
+        };
+        analog_matrix_set_config(&config);
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                analog_matrix_set_actuation_point(row, col, 0);
+            }
+        }
+        Calibrate();
+    }
+
+    // Sweeps the keys at rest until they have learned their rest readings
+    void Calibrate(void) {
+        analog_matrix_recalibrate();
+        for (int i = 0; i < ANALOG_MATRIX_CALIBRATION_SWEEPS; i++) {
+            matrix_scan();
+        }
+    }
+
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        report_times.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) {
+            reports.push_back(report);
+            report_times.push_back(timer_read32());
+        }));
+    }
+
+    // Bottoms a key out and lets it go, so that it learns its full range
+    void BottomOut(TestDriver &driver, KeymapKey &key) {
+        EXPECT_REPORT(driver, (key.code));
+        key.press();
+        idle_for(10);
+        EXPECT_EMPTY_REPORT(driver);
+        key.release();
+        idle_for(10);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    // The travel a key's sensor reads without noise, on the scale of a key that has been bottomed out
+    static uint8_t IdealTravel(uint8_t row, uint8_t col) {
+        return (uint32_t)(analog_matrix_mock_get_reading(row, col) - ANALOG_MATRIX_MOCK_REST) * 255 / ANALOG_MATRIX_MOCK_SWING;
+    }
+
+    // How far down a key has to be for its sensor to read a given travel
+    static uint16_t DepthFor(uint8_t travel) {
+        const uint32_t full = ANALOG_MATRIX_MOCK_FULL_TRAVEL_UM;
+        for (uint32_t depth = 0; depth < full; depth++) {
+            if ((uint64_t)ANALOG_MATRIX_MOCK_SWING * depth * (full + depth) / (2 * full * full) * 255 / ANALOG_MATRIX_MOCK_SWING >= travel) {
+                return depth;
+            }
+        }
+        return full;
+    }
+
+    // Plays a press on a key, and returns how many milliseconds the report came after the key passed its actuation point
+    uint32_t ActuationLatency(TestDriver &driver, KeymapKey &key, const analog_matrix_mock_point_t *curve, uint8_t length) {
+        uint8_t  point       = analog_matrix_get_actuation_point(key.position.row, key.position.col);
+        uint32_t crossed_at  = 0;
+        uint32_t reported_at = 0;
+        EXPECT_REPORT(driver, (key.code)).WillOnce(Invoke([&reported_at](report_keyboard_t &) { reported_at = timer_read32(); }));
+
+        analog_matrix_mock_play(key.position.row, key.position.col, curve, length);
+        for (int i = 0; i < 1000 && !reported_at; i++) {
+            if (!crossed_at && IdealTravel(key.position.row, key.position.col) >= point) {
+                crossed_at = timer_read32();
+            }
+            run_one_scan_loop();
+        }
+        VERIFY_AND_CLEAR(driver);
+        EXPECT_NE(crossed_at, 0);
+        return reported_at - crossed_at;
+    }
+
+    std::vector<report_keyboard_t> reports;
+    std::vector<uint32_t>          report_times;
+};
+
+TEST_F(AnalogMatrix, PressesAndReleasesAtActuationPoint) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    BottomOut(driver, key_a);
+
+    // Just past the actuation point, the key presses once however the noise falls
+    static const analog_matrix_mock_point_t press[] = {
+        {0, 0},
+        {20, DepthFor(ANALOG_MATRIX_ACTUATION_POINT + 4)},
+    };
+    EXPECT_REPORT(driver, (KC_A));
+    analog_matrix_mock_play(0, 0, press, 2);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+
+    // Coming back up short of the release point keeps it pressed
+    static const analog_matrix_mock_point_t hover[] = {
+        {0, DepthFor(ANALOG_MATRIX_ACTUATION_POINT + 4)},
+        {20, DepthFor(ANALOG_MATRIX_ACTUATION_POINT - ANALOG_MATRIX_HYSTERESIS + 4)},
+    };
+    EXPECT_NO_REPORT(driver);
+    analog_matrix_mock_play(0, 0, hover, 2);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+
+    // Past it, the key releases
+    static const analog_matrix_mock_point_t release[] = {
+        {0, DepthFor(ANALOG_MATRIX_ACTUATION_POINT - ANALOG_MATRIX_HYSTERESIS + 4)},
+        {20, DepthFor(ANALOG_MATRIX_ACTUATION_POINT - ANALOG_MATRIX_HYSTERESIS - 4)},
+    };
+    EXPECT_EMPTY_REPORT(driver);
+    analog_matrix_mock_play(0, 0, release, 2);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AnalogMatrix, ActuationLatency) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    BottomOut(driver, key_a);
+
+    // Recorded travel: a fast stroke bottoms out in 8ms, a gentle one in 40ms
+    static const analog_matrix_mock_point_t fast[] = {
+        {0, 0}, {2, 300}, {4, 1300}, {6, 2900}, {8, 4000},
+    };
+    static const analog_matrix_mock_point_t gentle[] = {
+        {0, 0}, {10, 500}, {20, 1500}, {30, 2800}, {40, 4000},
+    };
+    static const analog_matrix_mock_point_t lift[] = {
+        {0, 4000},
+        {10, 0},
+    };
+
+    uint32_t fast_latency = ActuationLatency(driver, key_a, fast, sizeof(fast) / sizeof(fast[0]));
+    EXPECT_EMPTY_REPORT(driver);
+    analog_matrix_mock_play(0, 0, lift, 2);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    uint32_t gentle_latency = ActuationLatency(driver, key_a, gentle, sizeof(gentle) / sizeof(gentle[0]));
+    EXPECT_EMPTY_REPORT(driver);
+    analog_matrix_mock_play(0, 0, lift, 2);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    printf("actuation latency: %ums on a fast stroke, %ums on a gentle one\n", fast_latency, gentle_latency);
+    EXPECT_LE(fast_latency, 2);
+    EXPECT_LE(gentle_latency, 2);
+}
+
+TEST_F(AnalogMatrix, RapidTrigger) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    BottomOut(driver, key_a);
+
+    // Press deep, come up a little without passing the release point, go back down, then let go
+    static const analog_matrix_mock_point_t strokes[] = {
+        {0, 0}, {10, 3600}, {20, 3600}, {30, 3000}, {40, 3000}, {50, 3600}, {60, 3600}, {70, 0},
+    };
+
+    RecordReports(driver);
+    analog_matrix_mock_play(0, 0, strokes, sizeof(strokes) / sizeof(strokes[0]));
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(reports.size(), 2);
+
+    analog_matrix_config_t config;
+    analog_matrix_get_config(&config);
+    config.rapid_trigger_release = 16;
+    config.rapid_trigger_press   = 16;
+    analog_matrix_set_config(&config);
+
+    RecordReports(driver);
+    analog_matrix_mock_play(0, 0, strokes, sizeof(strokes) / sizeof(strokes[0]));
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+    ASSERT_EQ(reports.size(), 4);
+    EXPECT_EQ(reports[0].keys[0], KC_A);
+    EXPECT_EQ(reports[1].keys[0], KC_NO);
+    EXPECT_EQ(reports[2].keys[0], KC_A);
+    EXPECT_EQ(reports[3].keys[0], KC_NO);
+
+    // The key lets go on the way up, long before it gets back to the release point
+    EXPECT_LT(report_times[1] - report_times[0], 25);
+}
+
+TEST_F(AnalogMatrix, PerKeyActuationPoint) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    BottomOut(driver, key_a);
+    BottomOut(driver, key_b);
+    analog_matrix_set_actuation_point(0, 0, 40);
+    EXPECT_EQ(analog_matrix_get_actuation_point(0, 0), 40);
+    EXPECT_EQ(analog_matrix_get_actuation_point(0, 1), ANALOG_MATRIX_ACTUATION_POINT);
+
+    // A shallow press on both keys only presses the one with the shallow actuation point
+    static const analog_matrix_mock_point_t shallow[] = {
+        {0, 0},
+        {10, DepthFor(80)},
+    };
+    EXPECT_REPORT(driver, (KC_A));
+    analog_matrix_mock_play(0, 0, shallow, 2);
+    analog_matrix_mock_play(0, 1, shallow, 2);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_NEAR(analog_matrix_get_travel(0, 1), 80, 4);
+
+    static const analog_matrix_mock_point_t lift[] = {
+        {0, DepthFor(80)},
+        {10, 0},
+    };
+    EXPECT_EMPTY_REPORT(driver);
+    analog_matrix_mock_play(0, 0, lift, 2);
+    analog_matrix_mock_play(0, 1, lift, 2);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AnalogMatrix, IgnoresNoiseAndEmptyChannels) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    // Channels without a switch stay quiet, as do switches at rest
+    analog_matrix_mock_disconnect(1, 1);
+    analog_matrix_mock_disconnect(3, 9);
+    Calibrate();
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            EXPECT_EQ(analog_matrix_get_travel(row, col), 0);
+        }
+    }
+
+    // A key that was held through calibration learns its rest reading when it comes up
+    press_key(0, 0);
+    analog_matrix_recalibrate();
+    EXPECT_NO_REPORT(driver);
+    idle_for(ANALOG_MATRIX_CALIBRATION_SWEEPS + 10);
+    release_key(0, 0);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    BottomOut(driver, key_a);
+}
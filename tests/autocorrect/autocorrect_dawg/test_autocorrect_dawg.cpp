@@ -0,0 +1,76 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+
+// autocorrect_data.h in this folder was made with `qmk generate-autocorrect-data --dawg`
+class AutoCorrectDawg : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        for (uint8_t i = 0; i < 26; i++) {
+            add_key(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        }
+        add_key(KeymapKey(0, 26 % MATRIX_COLS, 26 / MATRIX_COLS, KC_SPC));
+    }
+
+    // Types `text`, which holds only a-z and spaces, and returns what the host ends up with
+    std::string Type(TestDriver &driver, const std::string &text) {
+        std::string       typed;
+        report_keyboard_t previous = {};
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            if (report.keys[0] && report.keys[0] != previous.keys[0]) {
+                if (report.keys[0] == KC_BSPC) {
+                    typed.pop_back();
+                } else {
+                    typed += report.keys[0] == KC_SPC ? ' ' : (char)('a' + report.keys[0] - KC_A);
+                }
+            }
+            previous = report;
+        }));
+        for (char c : text) {
+            uint8_t index = c == ' ' ? 26 : c - 'a';
+            tap_key(KeymapKey(0, index % MATRIX_COLS, index / MATRIX_COLS, c == ' ' ? KC_SPC : KC_A + index));
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return typed;
+    }
+};
+
+TEST_F(AutoCorrectDawg, LinksToSharedNodesAreFollowed) {
+    TestDriver driver;
+
+    // These share the leaf that types "ion", reached through chain links
+    EXPECT_EQ(Type(driver, " natoin "), " nation ");
+    EXPECT_EQ(Type(driver, " statoin "), " station ");
+    EXPECT_EQ(Type(driver, " motoin "), " motion ");
+    EXPECT_EQ(Type(driver, " notoin "), " notion ");
+    EXPECT_EQ(Type(driver, " potoin "), " potion ");
+    EXPECT_EQ(Type(driver, " rotatoin "), " rotation ");
+}
+
+TEST_F(AutoCorrectDawg, UnsharedTyposAreCorrected) {
+    TestDriver driver;
+
+    EXPECT_EQ(Type(driver, " fales "), " false ");
+    EXPECT_EQ(Type(driver, " flase "), " false ");
+    EXPECT_EQ(Type(driver, " fasle "), " false ");
+    EXPECT_EQ(Type(driver, " thier "), " their ");
+    EXPECT_EQ(Type(driver, " lenght "), " length ");
+}
+
+TEST_F(AutoCorrectDawg, NearMissesAreLeftAlone) {
+    TestDriver driver;
+
+    // Each of these runs into a link and then stops matching
+    EXPECT_EQ(Type(driver, " datoin "), " datoin ");
+    EXPECT_EQ(Type(driver, " rotoin "), " rotoin ");
+    EXPECT_EQ(Type(driver, " xstatoin "), " xstatoin ");
+    EXPECT_EQ(Type(driver, " nation "), " nation ");
+}
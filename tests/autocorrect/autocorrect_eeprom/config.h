@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define AUTOCORRECT_EEPROM_SIZE 256
+#define AUTOCORRECT_EEPROM_MAX_LENGTH 16
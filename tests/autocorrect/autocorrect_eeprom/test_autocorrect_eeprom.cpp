@@ -0,0 +1,167 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+
+// The dictionary of tests/autocorrect/autocorrect_dawg, as written by `qmk generate-autocorrect-data --dawg --binary`
+static const uint8_t dictionary[] = {
+    0x05, 0x09, 0x76, 0x00, 0x48, 0x10, 0x00, 0x11, 0x2A, 0x00, 0x15, 0x58, 0x00, 0x16, 0x63, 0x00, 0x17, 0x6C, 0x00,
+    0x00, 0x4F, 0x17, 0x00, 0x16, 0x20, 0x00, 0x00, 0x16, 0x04, 0x09, 0x00, 0x82, 0x6C, 0x73, 0x65, 0x00, 0x04, 0x0F,
+    0x09, 0x00, 0x83, 0x61, 0x6C, 0x73, 0x65, 0x00, 0x0C, 0x12, 0x17, 0x00, 0x44, 0x35, 0x00, 0x12, 0x4E, 0x00, 0x00,
+    0x51, 0x3C, 0x00, 0x17, 0x43, 0x00, 0x00, 0x2C, 0x00, 0x82, 0x69, 0x6F, 0x6E, 0x00, 0x52, 0x4A, 0x00, 0x16, 0x3C,
+    0x00, 0x00, 0x15, 0x01, 0x3C, 0x00, 0x50, 0x3C, 0x00, 0x11, 0x3C, 0x00, 0x13, 0x3C, 0x00, 0x00, 0x08, 0x0C, 0x0B,
+    0x17, 0x2C, 0x00, 0x82, 0x65, 0x69, 0x72, 0x00, 0x08, 0x0F, 0x04, 0x09, 0x00, 0x81, 0x73, 0x65, 0x00, 0x0B, 0x0A,
+    0x11, 0x08, 0x0F, 0x00, 0x81, 0x74, 0x68, 0x00
+};
+
+// A single typo, "xab", with a replacement of 30 letters, which is too long for the correction buffer
+static const uint8_t long_correction[] = {
+    0x03, 0x03, 0x24, 0x00, 0x05, 0x04, 0x1B, 0x00, 0x82, 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z',
+    'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 'z', 0x00
+};
+
+static std::string applied;
+
+extern "C" bool apply_autocorrect_ram(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    applied = std::string(typo) + " " + correct;
+    return true;
+}
+
+class AutoCorrectEeprom : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        autocorrect_dictionary_reset();
+        applied.clear();
+        for (uint8_t i = 0; i < 26; i++) {
+            add_key(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, KC_A + i));
+        }
+        add_key(KeymapKey(0, 26 % MATRIX_COLS, 26 / MATRIX_COLS, KC_SPC));
+    }
+
+    // Sends a raw HID packet, and returns the command of the reply
+    uint8_t Send(std::vector<uint8_t> packet) {
+        packet.resize(32);
+        EXPECT_TRUE(autocorrect_dictionary_receive(packet.data(), packet.size()));
+        return packet[0];
+    }
+
+    // Loads a dictionary the way a host would, in packets of up to 28 bytes
+    void Load(const uint8_t *data = dictionary, uint16_t size = sizeof(dictionary)) {
+        EXPECT_EQ(Send({AUTOCORRECT_HID_BEGIN, data[0], data[1], data[2], data[3]}), AUTOCORRECT_HID_BEGIN);
+        for (uint16_t offset = 0; offset < size - 4; offset += 28) {
+            uint8_t              length = MIN(28, size - 4 - offset);
+            std::vector<uint8_t> packet = {AUTOCORRECT_HID_WRITE, (uint8_t)offset, (uint8_t)(offset >> 8), length};
+            packet.insert(packet.end(), &data[4 + offset], &data[4 + offset + length]);
+            EXPECT_EQ(Send(packet), AUTOCORRECT_HID_WRITE);
+        }
+        EXPECT_EQ(Send({AUTOCORRECT_HID_END}), AUTOCORRECT_HID_END);
+    }
+
+    // Types `text`, which holds only a-z and spaces, and returns what the host ends up with
+    std::string Type(TestDriver &driver, const std::string &text) {
+        std::string       typed;
+        report_keyboard_t previous = {};
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&](report_keyboard_t &report) {
+            if (report.keys[0] && report.keys[0] != previous.keys[0]) {
+                if (report.keys[0] == KC_BSPC) {
+                    typed.pop_back();
+                } else {
+                    typed += report.keys[0] == KC_SPC ? ' ' : (char)('a' + report.keys[0] - KC_A);
+                }
+            }
+            previous = report;
+        }));
+        for (char c : text) {
+            uint8_t index = c == ' ' ? 26 : c - 'a';
+            tap_key(KeymapKey(0, index % MATRIX_COLS, index / MATRIX_COLS, c == ' ' ? KC_SPC : KC_A + index));
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return typed;
+    }
+};
+
+TEST_F(AutoCorrectEeprom, BuiltInDictionaryIsUsedByDefault) {
+    TestDriver driver;
+
+    EXPECT_EQ(Type(driver, " fitler "), " filter ");
+    EXPECT_EQ(Type(driver, " natoin "), " natoin ");
+}
+
+TEST_F(AutoCorrectEeprom, LoadedDictionaryReplacesBuiltInOne) {
+    TestDriver driver;
+
+    Load();
+    EXPECT_EQ(Type(driver, " natoin "), " nation ");
+    EXPECT_EQ(Type(driver, " rotatoin "), " rotation ");
+    EXPECT_EQ(Type(driver, " fales "), " false ");
+    EXPECT_EQ(Type(driver, " fitler "), " fitler ");
+    EXPECT_EQ(applied, "fales false");
+
+    EXPECT_EQ(Send({AUTOCORRECT_HID_RESET}), AUTOCORRECT_HID_RESET);
+    EXPECT_EQ(Type(driver, " natoin "), " natoin ");
+    EXPECT_EQ(Type(driver, " fitler "), " filter ");
+}
+
+TEST_F(AutoCorrectEeprom, LoadedDictionaryIsKeptAcrossReboots) {
+    TestDriver driver;
+
+    Load();
+    autocorrect_dictionary_init();
+    EXPECT_EQ(Type(driver, " statoin "), " station ");
+
+    // Clearing EEPROM drops it
+    eeconfig_init_quantum();
+    autocorrect_dictionary_init();
+    EXPECT_EQ(Type(driver, " statoin "), " statoin ");
+    autocorrect_enable();
+}
+
+TEST_F(AutoCorrectEeprom, BadTransfersAreRejected) {
+    TestDriver driver;
+
+    // Too large to fit, or with typos longer than it can buffer
+    EXPECT_EQ(Send({AUTOCORRECT_HID_BEGIN, 5, 9, 0x01, 0x01}), AUTOCORRECT_HID_ERROR);
+    EXPECT_EQ(Send({AUTOCORRECT_HID_BEGIN, 5, 17, 0x10, 0x00}), AUTOCORRECT_HID_ERROR);
+    EXPECT_EQ(Send({AUTOCORRECT_HID_WRITE, 0, 0, 1, 0x48}), AUTOCORRECT_HID_ERROR);
+
+    // Chunks out of order, and an incomplete dictionary
+    EXPECT_EQ(Send({AUTOCORRECT_HID_BEGIN, 5, 9, 0x10, 0x00}), AUTOCORRECT_HID_BEGIN);
+    EXPECT_EQ(Send({AUTOCORRECT_HID_WRITE, 1, 0, 1, 0x48}), AUTOCORRECT_HID_ERROR);
+    EXPECT_EQ(Send({AUTOCORRECT_HID_WRITE, 0, 0, 1, 0x48}), AUTOCORRECT_HID_WRITE);
+    EXPECT_EQ(Send({AUTOCORRECT_HID_END}), AUTOCORRECT_HID_ERROR);
+
+    // The built-in dictionary stays in use
+    EXPECT_EQ(Type(driver, " fitler "), " filter ");
+
+    // Other packets are left to the keymap
+    std::vector<uint8_t> packet = {0x42};
+    packet.resize(32);
+    EXPECT_FALSE(autocorrect_dictionary_receive(packet.data(), packet.size()));
+    EXPECT_EQ(packet[0], 0x42);
+}
+
+TEST_F(AutoCorrectEeprom, FirstWordIsMatchedAfterBoot) {
+    TestDriver driver;
+
+    autocorrect_dictionary_init();
+    EXPECT_EQ(Type(driver, "thier "), "their ");
+
+    Load();
+    EXPECT_EQ(Type(driver, "natoin "), "nation ");
+}
+
+TEST_F(AutoCorrectEeprom, CorrectionsTooLongToBufferAreSkipped) {
+    TestDriver driver;
+
+    Load(long_correction, sizeof(long_correction));
+    EXPECT_EQ(Type(driver, " xab "), " xab ");
+    EXPECT_EQ(applied, "");
+}
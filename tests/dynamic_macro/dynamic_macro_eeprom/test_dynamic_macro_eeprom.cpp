@@ -0,0 +1,176 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class DynamicMacroEeprom : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_macro_init();
+    }
+
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    // The recorded reports, without repeats or the empty reports sent when recording and playback start
+    std::vector<report_keyboard_t> Changes(void) const {
+        std::vector<report_keyboard_t> changes;
+        report_keyboard_t              previous = {};
+        for (const auto &report : reports) {
+            if (!(report == previous)) {
+                changes.push_back(report);
+                previous = report;
+            }
+        }
+        return changes;
+    }
+
+    std::vector<report_keyboard_t> Play(TestDriver &driver, KeymapKey &key_play) {
+        RecordReports(driver);
+        tap_key(key_play);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return Changes();
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(DynamicMacroEeprom, MacrosSurviveReboot) {
+    TestDriver driver;
+    KeymapKey  key_record_1(0, 0, 0, DM_REC1);
+    KeymapKey  key_record_2(0, 1, 0, DM_REC2);
+    KeymapKey  key_stop(0, 2, 0, DM_RSTP);
+    KeymapKey  key_play_1(0, 3, 0, DM_PLY1);
+    KeymapKey  key_play_2(0, 4, 0, DM_PLY2);
+    KeymapKey  key_shift(0, 5, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 6, 0, KC_A);
+    KeymapKey  key_b(0, 7, 0, KC_B);
+    set_keymap({key_record_1, key_record_2, key_stop, key_play_1, key_play_2, key_shift, key_a, key_b});
+
+    RecordReports(driver);
+    tap_key(key_record_1);
+    key_shift.press();
+    run_one_scan_loop();
+    tap_keys(key_a, key_b);
+    key_shift.release();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    tap_key(key_record_2);
+    tap_keys(key_b, key_b, key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    std::vector<report_keyboard_t> played_1 = Play(driver, key_play_1);
+    std::vector<report_keyboard_t> played_2 = Play(driver, key_play_2);
+    EXPECT_EQ(played_1.size(), 6);
+    EXPECT_EQ(played_2.size(), 6);
+
+    dynamic_macro_init();
+
+    EXPECT_EQ(Play(driver, key_play_1), played_1);
+    EXPECT_EQ(Play(driver, key_play_2), played_2);
+}
+
+TEST_F(DynamicMacroEeprom, RerecordingKeepsTheOtherMacro) {
+    TestDriver driver;
+    KeymapKey  key_record_1(0, 0, 0, DM_REC1);
+    KeymapKey  key_record_2(0, 1, 0, DM_REC2);
+    KeymapKey  key_stop(0, 2, 0, DM_RSTP);
+    KeymapKey  key_play_1(0, 3, 0, DM_PLY1);
+    KeymapKey  key_play_2(0, 4, 0, DM_PLY2);
+    KeymapKey  key_a(0, 6, 0, KC_A);
+    KeymapKey  key_b(0, 7, 0, KC_B);
+    set_keymap({key_record_1, key_record_2, key_stop, key_play_1, key_play_2, key_a, key_b});
+
+    RecordReports(driver);
+    tap_key(key_record_2);
+    tap_keys(key_b, key_a);
+    tap_key(key_stop);
+    tap_key(key_record_1);
+    tap_keys(key_a, key_a, key_a);
+    tap_key(key_stop);
+    tap_key(key_record_1);
+    tap_key(key_b);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_macro_init();
+
+    std::vector<report_keyboard_t> played_1 = Play(driver, key_play_1);
+    ASSERT_EQ(played_1.size(), 2);
+    EXPECT_EQ(played_1[0].keys[0], KC_B);
+
+    std::vector<report_keyboard_t> played_2 = Play(driver, key_play_2);
+    ASSERT_EQ(played_2.size(), 4);
+    EXPECT_EQ(played_2[0].keys[0], KC_B);
+    EXPECT_EQ(played_2[2].keys[0], KC_A);
+}
+
+TEST_F(DynamicMacroEeprom, FullBufferSurvivesReboot) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_record, key_stop, key_play, key_a, key_b});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    for (int i = 0; i < 100; i++) {
+        tap_key(key_a, i % 3);
+        tap_key(key_b, 1);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    std::vector<report_keyboard_t> played = Play(driver, key_play);
+    EXPECT_GT(played.size(), 40);
+
+    dynamic_macro_init();
+
+    EXPECT_EQ(Play(driver, key_play), played);
+}
+
+TEST_F(DynamicMacroEeprom, ErasedEepromHasNoMacros) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    set_keymap({key_record, key_stop, key_play, key_a});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    tap_key(key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    eeconfig_init_quantum();
+    dynamic_macro_init();
+
+    EXPECT_TRUE(Play(driver, key_play).empty());
+}
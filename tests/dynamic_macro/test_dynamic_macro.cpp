@@ -0,0 +1,237 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class DynamicMacro : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_macro_init();
+    }
+
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    // The recorded reports, without repeats or the empty reports sent when recording and playback start
+    std::vector<report_keyboard_t> Changes(void) const {
+        std::vector<report_keyboard_t> changes;
+        report_keyboard_t              previous = {};
+        for (const auto &report : reports) {
+            if (!(report == previous)) {
+                changes.push_back(report);
+                previous = report;
+            }
+        }
+        return changes;
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(DynamicMacro, TapsAreReplayed) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    KeymapKey  key_c(0, 5, 0, KC_C);
+    set_keymap({key_record, key_stop, key_play, key_a, key_b, key_c});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    tap_keys(key_a, key_b, key_c);
+    tap_key(key_stop);
+    std::vector<report_keyboard_t> recorded = Changes();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(recorded.size(), 6);
+
+    RecordReports(driver);
+    tap_key(key_play);
+    EXPECT_EQ(Changes(), recorded);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, LongSequenceIsReplayedIdentically) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_shift(0, 3, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 4, 0, KC_A);
+    KeymapKey  key_b(0, 5, 0, KC_B);
+    KeymapKey  key_c(0, 6, 0, KC_C);
+    KeymapKey  key_mod_tap(0, 7, 0, RCTL_T(KC_D));
+    KeymapKey  key_far(0, 0, 3, KC_E);
+    set_keymap({key_record, key_stop, key_play, key_shift, key_a, key_b, key_c, key_mod_tap, key_far});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    for (int i = 0; i < 3; i++) {
+        // Shifted key
+        key_shift.press();
+        run_one_scan_loop();
+        tap_key(key_a);
+        key_shift.release();
+        run_one_scan_loop();
+
+        // Overlapping keys
+        key_b.press();
+        run_one_scan_loop();
+        key_c.press();
+        run_one_scan_loop();
+        key_b.release();
+        run_one_scan_loop();
+        key_c.release();
+        run_one_scan_loop();
+
+        // A mod-tap, tapped and then held, which is replayed from its tap state
+        tap_key(key_mod_tap);
+        idle_for(TAPPING_TERM + 1);
+        key_mod_tap.press();
+        idle_for(TAPPING_TERM + 1);
+        tap_key(key_far, 1 + i * 40);
+        key_mod_tap.release();
+        run_one_scan_loop();
+    }
+    tap_key(key_stop);
+    std::vector<report_keyboard_t> recorded = Changes();
+    VERIFY_AND_CLEAR(driver);
+
+    // Many more events than DYNAMIC_MACRO_SIZE, which is all the unpacked buffer held
+    EXPECT_EQ(recorded.size(), 3 * 14);
+
+    RecordReports(driver);
+    tap_key(key_play);
+    EXPECT_EQ(Changes(), recorded);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PackedEventsMultiplyCapacity) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_record, key_stop, key_play, key_a, key_b});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    for (int i = 0; i < 100; i++) {
+        tap_keys(key_a, key_b);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    RecordReports(driver);
+    tap_key(key_play);
+    VERIFY_AND_CLEAR(driver);
+
+    // The macro is cut short once the buffer is full, but never in the middle of a key
+    int taps = 0;
+    for (const auto &report : Changes()) {
+        EXPECT_TRUE(report == (report_keyboard_t){} || report.keys[0] == KC_A || report.keys[0] == KC_B);
+        if (report.keys[0] != KC_NO) {
+            taps++;
+        }
+    }
+    EXPECT_LT(taps, 200);
+
+    // Unpacked, there was room for DYNAMIC_MACRO_SIZE events, or half as many taps
+    EXPECT_GE(taps, 3 * DYNAMIC_MACRO_SIZE / 2);
+}
+
+TEST_F(DynamicMacro, BothMacrosShareTheBuffer) {
+    TestDriver driver;
+    KeymapKey  key_record_1(0, 0, 0, DM_REC1);
+    KeymapKey  key_record_2(0, 1, 0, DM_REC2);
+    KeymapKey  key_stop(0, 2, 0, DM_RSTP);
+    KeymapKey  key_play_1(0, 3, 0, DM_PLY1);
+    KeymapKey  key_play_2(0, 4, 0, DM_PLY2);
+    KeymapKey  key_a(0, 5, 0, KC_A);
+    KeymapKey  key_b(0, 6, 0, KC_B);
+    KeymapKey  key_far(0, 0, 3, KC_E);
+    set_keymap({key_record_1, key_record_2, key_stop, key_play_1, key_play_2, key_a, key_b, key_far});
+
+    RecordReports(driver);
+    tap_key(key_record_2);
+    tap_keys(key_far, key_b, key_far);
+    tap_key(key_stop);
+    tap_key(key_record_1);
+    tap_keys(key_a, key_a);
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    RecordReports(driver);
+    tap_key(key_play_2);
+    std::vector<report_keyboard_t> played_2 = Changes();
+    VERIFY_AND_CLEAR(driver);
+
+    RecordReports(driver);
+    tap_key(key_play_1);
+    std::vector<report_keyboard_t> played_1 = Changes();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(played_2.size(), 6);
+    EXPECT_EQ(played_2[0].keys[0], KC_E);
+    EXPECT_EQ(played_2[2].keys[0], KC_B);
+    EXPECT_EQ(played_2[4].keys[0], KC_E);
+
+    ASSERT_EQ(played_1.size(), 4);
+    EXPECT_EQ(played_1[0].keys[0], KC_A);
+    EXPECT_EQ(played_1[2].keys[0], KC_A);
+}
+
+TEST_F(DynamicMacro, HeldKeysAreTrimmed) {
+    TestDriver driver;
+    KeymapKey  key_record(0, 0, 0, DM_REC1);
+    KeymapKey  key_layer(0, 1, 0, MO(1));
+    KeymapKey  key_stop(1, 2, 0, DM_RSTP);
+    KeymapKey  key_play(0, 3, 0, DM_PLY1);
+    KeymapKey  key_a(0, 4, 0, KC_A);
+    set_keymap({key_record, key_layer, key_stop, key_play, key_a});
+
+    RecordReports(driver);
+    tap_key(key_record);
+    tap_key(key_a);
+    key_layer.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The layer key used to reach DM_RSTP is not part of the macro
+    RecordReports(driver);
+    tap_key(key_play);
+    VERIFY_AND_CLEAR(driver);
+    std::vector<report_keyboard_t> played = Changes();
+    ASSERT_EQ(played.size(), 2);
+    EXPECT_EQ(played[0].keys[0], KC_A);
+    EXPECT_EQ(layer_state, 0);
+}
@@ -0,0 +1,51 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Three-key sequences, declared in descending order
+#define LEADER_MAP_X_ROW(k1) LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_O), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_N), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_M), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_L), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_K), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_J), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_I), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_H), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_G), LEADER_SEQUENCE(KC_NO, KC_X, k1, KC_F)
+
+// Four-key sequences, each following the two-key sequence it extends
+#define LEADER_MAP_Y_ROW(k1) LEADER_SEQUENCE(KC_NO, KC_Y, k1), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_F, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_H, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_J, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_L, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_N, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_G, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_I, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_K, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_M, KC_Y), LEADER_SEQUENCE(KC_NO, KC_Y, k1, KC_O, KC_Y)
+
+const leader_sequence_t PROGMEM leader_map[] = {
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_3, KC_C, KC_D),
+    LEADER_SEQUENCE(KC_4, KC_A, KC_B, KC_C, KC_D, KC_E),
+    LEADER_SEQUENCE(LSFT(KC_5), KC_E, KC_E, KC_E),
+    LEADER_SEQUENCE(KC_6, KC_C, KC_D),
+    LEADER_MAP_X_ROW(KC_O),
+    LEADER_MAP_X_ROW(KC_N),
+    LEADER_MAP_X_ROW(KC_M),
+    LEADER_MAP_X_ROW(KC_L),
+    LEADER_MAP_X_ROW(KC_K),
+    LEADER_MAP_X_ROW(KC_J),
+    LEADER_MAP_X_ROW(KC_I),
+    LEADER_MAP_X_ROW(KC_H),
+    LEADER_MAP_X_ROW(KC_G),
+    LEADER_MAP_X_ROW(KC_F),
+    LEADER_MAP_Y_ROW(KC_F),
+    LEADER_MAP_Y_ROW(KC_H),
+    LEADER_MAP_Y_ROW(KC_J),
+    LEADER_MAP_Y_ROW(KC_L),
+    LEADER_MAP_Y_ROW(KC_N),
+    LEADER_MAP_Y_ROW(KC_G),
+    LEADER_MAP_Y_ROW(KC_I),
+    LEADER_MAP_Y_ROW(KC_K),
+    LEADER_MAP_Y_ROW(KC_M),
+    LEADER_MAP_Y_ROW(KC_O),
+};
+
+int16_t  leader_map_last_matched = -1;
+uint16_t leader_end_count        = 0;
+
+bool leader_map_matched_user(uint16_t sequence_idx, uint16_t keycode) {
+    leader_map_last_matched = sequence_idx;
+    return keycode != KC_NO;
+}
+
+void leader_end_user(void) {
+    leader_end_count++;
+}
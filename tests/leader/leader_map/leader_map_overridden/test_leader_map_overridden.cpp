@@ -0,0 +1,100 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+
+extern int16_t leader_map_last_matched;
+
+// Claims more sequences than leader_map holds, as a keymap with sequences stored elsewhere might
+uint16_t extra_sequences = 8;
+// Turns one of the compiled sequences into Z Z, as a keymap editing its sequences might
+uint16_t z_z_sequence = UINT16_MAX;
+
+uint16_t leader_map_count(void) {
+    return leader_map_count_raw() + extra_sequences;
+}
+
+uint16_t leader_map_sequence_key(uint16_t sequence_idx, uint8_t key_idx) {
+    if (sequence_idx >= leader_map_count_raw() || sequence_idx == z_z_sequence) {
+        return key_idx < 2 ? KC_Z : KC_NO;
+    }
+    return leader_map_sequence_key_raw(sequence_idx, key_idx);
+}
+
+uint16_t leader_map_keycode(uint16_t sequence_idx) {
+    if (sequence_idx >= leader_map_count_raw() || sequence_idx == z_z_sequence) {
+        return KC_9;
+    }
+    return leader_map_keycode_raw(sequence_idx);
+}
+}
+
+using testing::_;
+
+class LeaderMapOverridden : public TestFixture {
+   public:
+    void SetUp() override {
+        extra_sequences = 8;
+        z_z_sequence    = UINT16_MAX;
+        TestFixture::SetUp();
+    }
+};
+
+TEST_F(LeaderMapOverridden, checks_every_sequence_when_they_do_not_fit_the_sorted_order) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_c      = KeymapKey(0, 1, 0, KC_C);
+    auto       key_d      = KeymapKey(0, 2, 0, KC_D);
+    auto       key_z      = KeymapKey(0, 3, 0, KC_Z);
+
+    set_keymap({key_leader, key_c, key_d, key_z});
+
+    ASSERT_GT(leader_map_count(), leader_map_order_size());
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_leader, key_z, key_z);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, leader_map_count_raw());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_leader, key_c, key_d);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMapOverridden, sorts_again_when_the_sequences_change) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto       key_c      = KeymapKey(0, 1, 0, KC_C);
+    auto       key_d      = KeymapKey(0, 2, 0, KC_D);
+    auto       key_z      = KeymapKey(0, 3, 0, KC_Z);
+
+    set_keymap({key_leader, key_c, key_d, key_z});
+
+    extra_sequences = 0;
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_leader, key_c, key_d);
+    EXPECT_EQ(leader_map_last_matched, 2);
+    VERIFY_AND_CLEAR(driver);
+
+    z_z_sequence = 2;
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_leader, key_z, key_z);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 2);
+    VERIFY_AND_CLEAR(driver);
+}
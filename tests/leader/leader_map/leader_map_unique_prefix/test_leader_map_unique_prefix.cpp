@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+extern int16_t leader_map_last_matched;
+}
+
+using testing::_;
+
+class LeaderMapUniquePrefix : public TestFixture {
+   public:
+    void SetUp() override {
+        leader_map_last_matched = -1;
+    }
+};
+
+TEST_F(LeaderMapUniquePrefix, resolves_unique_prefix) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_e      = KeymapKey(0, 1, 0, KC_E);
+
+    set_keymap({key_leader, key_e});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(2);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_e);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMapUniquePrefix, waits_for_timeout_on_shared_prefix) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_f      = KeymapKey(0, 1, 0, KC_F);
+    auto key_x      = KeymapKey(0, 2, 0, KC_X);
+
+    set_keymap({key_leader, key_f, key_x});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+    tap_key(key_f);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+    idle_for(300);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, -1);
+    VERIFY_AND_CLEAR(driver);
+}
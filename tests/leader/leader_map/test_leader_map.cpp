@@ -0,0 +1,154 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+
+extern int16_t  leader_map_last_matched;
+extern uint16_t leader_end_count;
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class LeaderMap : public TestFixture {
+   public:
+    void SetUp() override {
+        keys.clear();
+        keys.push_back(KeymapKey(0, 0, 0, QK_LEADER));
+        for (uint16_t keycode = KC_A; keycode <= KC_Z; keycode++) {
+            uint8_t position = keys.size();
+            keys.push_back(KeymapKey(0, position % MATRIX_COLS, position / MATRIX_COLS, keycode));
+        }
+        for (const auto &key : keys) {
+            add_key(key);
+        }
+
+        leader_map_last_matched = -1;
+        leader_end_count        = 0;
+    }
+
+    // Taps the leader key, then the given letters
+    void type_sequence(std::vector<uint16_t> keycodes) {
+        tap_key(keys[0]);
+        for (uint16_t keycode : keycodes) {
+            tap_key(keys[1 + keycode - KC_A]);
+        }
+    }
+
+    std::vector<KeymapKey> keys;
+};
+
+TEST_F(LeaderMap, resolves_unique_sequence_without_timeout) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    type_sequence({KC_C, KC_D});
+
+    // Duplicates resolve to the first one declared
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 2);
+    EXPECT_EQ(leader_end_count, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMap, waits_for_timeout_while_sequence_can_continue) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type_sequence({KC_A});
+    EXPECT_EQ(leader_sequence_active(), true);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    type_sequence({KC_A, KC_B});
+    EXPECT_EQ(leader_sequence_active(), true);
+    idle_for(300);
+    EXPECT_EQ(leader_map_last_matched, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMap, resolves_five_key_sequence) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    type_sequence({KC_A, KC_B, KC_C, KC_D, KC_E});
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, 3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMap, taps_modified_keycode) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(2);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    type_sequence({KC_E, KC_E, KC_E});
+    EXPECT_EQ(leader_sequence_active(), false);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMap, unknown_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type_sequence({KC_Z, KC_A});
+    EXPECT_EQ(leader_sequence_active(), true);
+    idle_for(300);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(leader_map_last_matched, -1);
+    EXPECT_EQ(leader_end_count, 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderMap, resolves_every_sequence_of_large_table) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    ASSERT_GT(leader_map_count(), 200);
+    for (uint16_t i = 0; i < leader_map_count(); i++) {
+        std::vector<uint16_t> sequence;
+        for (uint8_t j = 0; j < 5 && leader_map_sequence_key(i, j) != KC_NO; j++) {
+            sequence.push_back(leader_map_sequence_key(i, j));
+        }
+
+        // Sequences that others continue from wait for the timeout
+        bool ambiguous = false;
+        for (uint16_t other = 0; other < leader_map_count(); other++) {
+            bool prefix = leader_map_sequence_key(other, sequence.size()) != KC_NO;
+            for (uint8_t j = 0; j < sequence.size(); j++) {
+                prefix &= leader_map_sequence_key(other, j) == sequence[j];
+            }
+            ambiguous |= prefix;
+        }
+
+        leader_map_last_matched = -1;
+        type_sequence(sequence);
+        EXPECT_EQ(leader_sequence_active(), ambiguous) << "sequence " << i;
+        if (ambiguous) {
+            idle_for(300);
+        }
+
+        EXPECT_EQ(leader_map_last_matched, i == 5 ? 2 : i) << "sequence " << i;
+    }
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 1024
+#define EEPROM_COUNTING_PAGE_SIZE 32
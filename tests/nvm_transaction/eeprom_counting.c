@@ -0,0 +1,51 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "eeprom_driver.h"
+#include "eeprom_counting.h"
+
+eeprom_counting_stats_t eeprom_counting_stats;
+uint8_t                 eeprom_counting_data[EEPROM_SIZE];
+
+void eeprom_counting_reset_stats(void) {
+    memset(&eeprom_counting_stats, 0, sizeof(eeprom_counting_stats));
+}
+
+void eeprom_driver_init(void) {}
+
+void eeprom_driver_erase(void) {
+    // Like flash, erased memory reads back as all ones
+    memset(eeprom_counting_data, 0xFF, EEPROM_SIZE);
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t offset = (uintptr_t)addr;
+    memset(buf, 0, len);
+    if (offset < EEPROM_SIZE) {
+        memcpy(buf, &eeprom_counting_data[offset], offset + len > EEPROM_SIZE ? EEPROM_SIZE - offset : len);
+    }
+    eeprom_counting_stats.reads++;
+    eeprom_counting_stats.elapsed_us += (EEPROM_COUNTING_ADDRESS_BYTES + len) * EEPROM_COUNTING_BYTE_US;
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source = (const uint8_t *)buf;
+    uintptr_t      offset = (uintptr_t)addr;
+    // Page writes wrap around at the end of a page, so the driver splits them
+    while (len > 0) {
+        size_t length = EEPROM_COUNTING_PAGE_SIZE - offset % EEPROM_COUNTING_PAGE_SIZE;
+        if (length > len) {
+            length = len;
+        }
+        if (offset + length <= EEPROM_SIZE) {
+            memcpy(&eeprom_counting_data[offset], source, length);
+        }
+        eeprom_counting_stats.writes++;
+        eeprom_counting_stats.bytes_written += length;
+        eeprom_counting_stats.elapsed_us += (EEPROM_COUNTING_ADDRESS_BYTES + length) * EEPROM_COUNTING_BYTE_US + EEPROM_COUNTING_WRITE_CYCLE_US;
+        source += length;
+        offset += length;
+        len -= length;
+    }
+}
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+// Timing of a 400kHz I2C EEPROM, with 9 bits on the bus per byte and a write cycle per page
+#define EEPROM_COUNTING_BYTE_US 23
+#define EEPROM_COUNTING_ADDRESS_BYTES 3
+#define EEPROM_COUNTING_WRITE_CYCLE_US 5000
+
+typedef struct eeprom_counting_stats_t {
+    uint32_t reads;         // read transactions
+    uint32_t writes;        // write transactions, one per page written to
+    uint32_t bytes_written; //
+    uint32_t elapsed_us;    // time on the bus and waiting for write cycles
+} eeprom_counting_stats_t;
+
+extern eeprom_counting_stats_t eeprom_counting_stats;
+extern uint8_t                 eeprom_counting_data[];
+
+void eeprom_counting_reset_stats(void);
@@ -0,0 +1,12 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+DYNAMIC_KEYMAP_ENABLE = yes
+
+# Counts and times every access, as an external I2C EEPROM would take them
+EEPROM_DRIVER = custom
+SRC += eeprom_counting.c
@@ -0,0 +1,160 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom_counting.h"
+#include "eeprom_driver.h"
+#include "keymap_introspection.h"
+#include "nvm_transaction.h"
+#include "nvm_dynamic_keymap.h"
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+}
+
+class NvmTransaction : public TestFixture {
+   public:
+    void SetUp() override {
+        eeprom_driver_erase();
+        eeprom_counting_reset_stats();
+    }
+
+    std::vector<uint8_t> Contents(void) const {
+        return std::vector<uint8_t>(eeprom_counting_data, eeprom_counting_data + EEPROM_SIZE);
+    }
+};
+
+TEST_F(NvmTransaction, DynamicKeymapResetIsBatched) {
+    // One key at a time, as the reset used to write them
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                nvm_dynamic_keymap_update_keycode(layer, row, column, keycode_at_keymap_location_raw(layer, row, column));
+            }
+        }
+    }
+    eeprom_counting_stats_t unbatched = eeprom_counting_stats;
+    auto                    expected  = Contents();
+
+    eeprom_driver_erase();
+    eeprom_counting_reset_stats();
+    dynamic_keymap_reset();
+    eeprom_counting_stats_t batched = eeprom_counting_stats;
+
+    EXPECT_EQ(Contents(), expected);
+    EXPECT_FALSE(nvm_transaction_is_active());
+
+    // Each page of the keymap is read and programmed once
+    const uint32_t keymap_bytes = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    const uint32_t pages        = keymap_bytes / EEPROM_COUNTING_PAGE_SIZE + 1;
+    EXPECT_GE(unbatched.writes, DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS);
+    EXPECT_LE(batched.writes, pages);
+    EXPECT_LE(batched.reads, pages);
+    EXPECT_LT(batched.elapsed_us * 20, unbatched.elapsed_us);
+    printf("dynamic_keymap_reset(): %u writes in %uus unbatched, %u writes in %uus batched\n", unbatched.writes, unbatched.elapsed_us, batched.writes, batched.elapsed_us);
+}
+
+TEST_F(NvmTransaction, FactoryResetIsBatched) {
+    eeconfig_init_quantum();
+    eeprom_counting_stats_t first = eeprom_counting_stats;
+
+    // Everything written by the reset lies within the first few pages
+    EXPECT_TRUE(eeconfig_is_enabled());
+    EXPECT_LE(first.writes, (uint32_t)EEPROM_SIZE / EEPROM_COUNTING_PAGE_SIZE);
+    printf("eeconfig_init_quantum(): %u writes of %u bytes in %uus\n", first.writes, first.bytes_written, first.elapsed_us);
+
+    // Booting with valid settings only reads them
+    eeprom_counting_reset_stats();
+    keyboard_init();
+    EXPECT_EQ(eeprom_counting_stats.writes, 0);
+    printf("keyboard_init(): %u reads in %uus\n", eeprom_counting_stats.reads, eeprom_counting_stats.elapsed_us);
+}
+
+TEST_F(NvmTransaction, WritesAreDeferredUntilCommit) {
+    nvm_transaction_begin();
+    EXPECT_TRUE(nvm_transaction_is_active());
+
+    nvm_dynamic_keymap_update_keycode(0, 0, 0, KC_A);
+    nvm_dynamic_keymap_update_keycode(0, 0, 1, KC_B);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(eeprom_counting_stats.writes, 0);
+
+    nvm_transaction_commit();
+    EXPECT_FALSE(nvm_transaction_is_active());
+    EXPECT_GE(eeprom_counting_stats.writes, 1);
+    EXPECT_LE(eeprom_counting_stats.writes, 2);
+
+    // Nothing is held back once the transaction is over
+    eeprom_counting_reset_stats();
+    nvm_dynamic_keymap_update_keycode(0, 0, 0, KC_C);
+    EXPECT_EQ(eeprom_counting_stats.writes, 1);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_C);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(NvmTransaction, UnchangedBytesAreNotWritten) {
+    nvm_dynamic_keymap_update_keycode(0, 0, 0, KC_A);
+    eeprom_counting_reset_stats();
+
+    nvm_transaction_begin();
+    nvm_dynamic_keymap_update_keycode(0, 0, 0, KC_A);
+    nvm_transaction_commit();
+    EXPECT_EQ(eeprom_counting_stats.writes, 0);
+}
+
+TEST_F(NvmTransaction, NestedCommitWritesBack) {
+    nvm_transaction_begin();
+    nvm_dynamic_keymap_update_keycode(0, 0, 0, KC_A);
+
+    nvm_transaction_begin();
+    nvm_dynamic_keymap_update_keycode(0, 0, 1, KC_B);
+    nvm_transaction_commit();
+
+    // The inner commit keeps writes in order, but the transaction carries on
+    EXPECT_TRUE(nvm_transaction_is_active());
+    EXPECT_GE(eeprom_counting_stats.writes, 1);
+    std::vector<uint8_t> staged = Contents();
+
+    eeprom_counting_reset_stats();
+    nvm_dynamic_keymap_update_keycode(0, 0, 2, KC_C);
+    EXPECT_EQ(eeprom_counting_stats.writes, 0);
+    nvm_transaction_commit();
+    EXPECT_FALSE(nvm_transaction_is_active());
+
+    EXPECT_NE(Contents(), staged);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 2), KC_C);
+
+    // An unmatched commit does nothing
+    nvm_transaction_commit();
+    EXPECT_FALSE(nvm_transaction_is_active());
+}
+
+TEST_F(NvmTransaction, EvictionKeepsEveryWrite) {
+    // Touch more pages than are staged at once, then come back to the first ones
+    const uint32_t size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t        pattern[size];
+    for (uint32_t i = 0; i < size; i++) {
+        pattern[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    nvm_transaction_begin();
+    nvm_dynamic_keymap_update_buffer(0, size, pattern);
+    nvm_dynamic_keymap_update_buffer(0, 2, pattern + 2);
+    uint8_t readback[size];
+    nvm_dynamic_keymap_read_buffer(0, size, readback);
+    nvm_transaction_commit();
+
+    pattern[0] = pattern[2];
+    pattern[1] = pattern[3];
+    EXPECT_EQ(memcmp(readback, pattern, size), 0);
+    nvm_dynamic_keymap_read_buffer(0, size, readback);
+    EXPECT_EQ(memcmp(readback, pattern, size), 0);
+}
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 16
+#define SURFACE_NUM_DEVICES 5
+
+// Needed by the SH1106 driver, built so that Quantum Painter has a device slot
+#define I2C_TIMEOUT 100
+
+#define EXTERNAL_FLASH_SIZE (256 * 1024L)
+#define EXTERNAL_FLASH_SECTOR_SIZE (4 * 1024L)
+#define EXTERNAL_FLASH_BLOCK_SIZE (64 * 1024L)
@@ -0,0 +1,99 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// File-backed flash driver for host tests, emulating NOR semantics: erase sets bytes to 0xFF, writes can only clear bits.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "flash.h"
+#include "flash_file.h"
+
+static FILE *   flash_file       = NULL;
+static uint32_t flash_read_count = 0;
+
+void flash_init(void) {
+    if (flash_file == NULL) {
+        flash_file = tmpfile();
+        flash_erase_chip();
+    }
+}
+
+flash_status_t flash_is_busy(void) {
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_begin_erase_chip(void) {
+    return flash_erase_chip();
+}
+
+flash_status_t flash_wait_erase_chip(void) {
+    return FLASH_STATUS_SUCCESS;
+}
+
+static flash_status_t flash_fill(uint32_t addr, size_t len) {
+    uint8_t blank[256];
+    memset(blank, 0xFF, sizeof(blank));
+    if (fseek(flash_file, addr, SEEK_SET) != 0) {
+        return FLASH_STATUS_ERROR;
+    }
+    while (len > 0) {
+        size_t n = len < sizeof(blank) ? len : sizeof(blank);
+        if (fwrite(blank, 1, n, flash_file) != n) {
+            return FLASH_STATUS_ERROR;
+        }
+        len -= n;
+    }
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_erase_chip(void) {
+    return flash_fill(0, EXTERNAL_FLASH_SIZE);
+}
+
+flash_status_t flash_erase_block(uint32_t addr) {
+    if (addr % EXTERNAL_FLASH_BLOCK_SIZE != 0 || addr >= EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    return flash_fill(addr, EXTERNAL_FLASH_BLOCK_SIZE);
+}
+
+flash_status_t flash_erase_sector(uint32_t addr) {
+    if (addr % EXTERNAL_FLASH_SECTOR_SIZE != 0 || addr >= EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    return flash_fill(addr, EXTERNAL_FLASH_SECTOR_SIZE);
+}
+
+flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
+    if (addr + len > EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    ++flash_read_count;
+    if (fseek(flash_file, addr, SEEK_SET) != 0 || fread(buf, 1, len, flash_file) != len) {
+        return FLASH_STATUS_ERROR;
+    }
+    return FLASH_STATUS_SUCCESS;
+}
+
+flash_status_t flash_write_range(uint32_t addr, const void *buf, size_t len) {
+    if (addr + len > EXTERNAL_FLASH_SIZE) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    const uint8_t *src = (const uint8_t *)buf;
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t existing;
+        if (fseek(flash_file, addr + i, SEEK_SET) != 0 || fread(&existing, 1, 1, flash_file) != 1) {
+            return FLASH_STATUS_ERROR;
+        }
+        existing &= src[i];
+        if (fseek(flash_file, addr + i, SEEK_SET) != 0 || fwrite(&existing, 1, 1, flash_file) != 1) {
+            return FLASH_STATUS_ERROR;
+        }
+    }
+    return FLASH_STATUS_SUCCESS;
+}
+
+uint32_t flash_file_read_count(void) {
+    return flash_read_count;
+}
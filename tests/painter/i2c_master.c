@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// There is no display on the bus, the SH1106 driver is only built so that Quantum Painter has a device slot
+#include "i2c_master.h"
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    return I2C_STATUS_ERROR;
+}
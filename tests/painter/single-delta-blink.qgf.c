@@ -0,0 +1,63 @@
+// Copyright 2026 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `qmk painter-convert-graphics -i single-delta-blink.gif -f mono4 --no-multi-deltas`
+
+// Image's metadata
+// ----------------
+// Width: 64
+// Height: 32
+//        Frame:    0|   1|   2|   3
+// Duration(ms):  100| 100| 100| 100
+//  Compression:    1|   1|   1|   1 >> See qp.h, painter_compression_t
+//        Delta:    0|   1|   1|   1
+// Areas on delta frames
+// Frame   1: (  6,   6) - ( 57,  25) >>  969/2048 pixels (47.31%)
+// Frame   2: (  6,   6) - ( 15,  11) >>   45/2048 pixels (2.20%)
+// Frame   3: (  6,   2) - ( 57,  25) >> 1173/2048 pixels (57.28%)
+
+#include <qp.h>
+
+const uint32_t gfx_single_delta_blink_length = 590;
+
+// clang-format off
+const uint8_t gfx_single_delta_blink[590] = {
+    0x00, 0xFF, 0x12, 0x00, 0x00, 0x51, 0x47, 0x46, 0x01, 0x4E, 0x02, 0x00, 0x00, 0xB1, 0xFD, 0xFF,
+    0xFF, 0x40, 0x00, 0x20, 0x00, 0x04, 0x00, 0x01, 0xFE, 0x10, 0x00, 0x00, 0x2C, 0x00, 0x00, 0x00,
+    0x2B, 0x01, 0x00, 0x00, 0xA6, 0x01, 0x00, 0x00, 0xC5, 0x01, 0x00, 0x00, 0x02, 0xFD, 0x06, 0x00,
+    0x00, 0x01, 0x00, 0x01, 0xFF, 0x64, 0x00, 0x05, 0xFA, 0xEF, 0x00, 0x00, 0x10, 0xFF, 0x80, 0x03,
+    0x0E, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x81, 0xC0, 0x03, 0x03,
+    0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0,
+    0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00,
+    0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A,
+    0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA,
+    0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03,
+    0x03, 0xAA, 0x80, 0x0A, 0x0A, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00,
+    0x81, 0xC0, 0x03, 0x04, 0x00, 0x06, 0x55, 0x04, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x81, 0xC0,
+    0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA,
+    0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0,
+    0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00,
+    0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03,
+    0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81,
+    0xC0, 0x03, 0x0A, 0x00, 0x80, 0xA0, 0x03, 0xAA, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x81, 0xC0, 0x03,
+    0x0E, 0x00, 0x81, 0xC0, 0x03, 0x0E, 0x00, 0x80, 0xC0, 0x10, 0xFF, 0x02, 0xFD, 0x06, 0x00, 0x00,
+    0x01, 0x02, 0x01, 0xFF, 0x64, 0x00, 0x04, 0xFB, 0x08, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x39,
+    0x00, 0x19, 0x00, 0x05, 0xFA, 0x5E, 0x00, 0x00, 0x02, 0xFF, 0x80, 0xAF, 0x0A, 0x00, 0x02, 0xFF,
+    0x80, 0xAF, 0x0A, 0x00, 0x02, 0xFF, 0x80, 0xAF, 0x0A, 0x00, 0x02, 0xFF, 0x80, 0xAF, 0x0A, 0x00,
+    0x02, 0xFF, 0x80, 0xAF, 0x0A, 0x00, 0x02, 0xFF, 0x80, 0xAF, 0x0A, 0x00, 0x03, 0xAA, 0x0A, 0x00,
+    0x03, 0xAA, 0x27, 0x00, 0x80, 0x50, 0x05, 0x55, 0x80, 0x05, 0x1A, 0x00, 0x03, 0xAA, 0x0A, 0x00,
+    0x03, 0xAA, 0x0A, 0x00, 0x80, 0xFA, 0x02, 0xFF, 0x0A, 0x00, 0x80, 0xFA, 0x02, 0xFF, 0x0A, 0x00,
+    0x80, 0xFA, 0x02, 0xFF, 0x0A, 0x00, 0x80, 0xFA, 0x02, 0xFF, 0x0A, 0x00, 0x80, 0xFA, 0x02, 0xFF,
+    0x0A, 0x00, 0x80, 0xFA, 0x02, 0xFF, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x02, 0x01, 0xFF, 0x64,
+    0x00, 0x04, 0xFB, 0x08, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x0F, 0x00, 0x0B, 0x00, 0x05, 0xFA,
+    0x02, 0x00, 0x00, 0x0F, 0xAA, 0x02, 0xFD, 0x06, 0x00, 0x00, 0x01, 0x02, 0x01, 0xFF, 0x64, 0x00,
+    0x04, 0xFB, 0x08, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x39, 0x00, 0x19, 0x00, 0x05, 0xFA, 0x6C,
+    0x00, 0x00, 0x06, 0x00, 0x80, 0x03, 0x13, 0x00, 0x03, 0xAA, 0x0A, 0x00, 0x03, 0xAA, 0x0A, 0x00,
+    0x02, 0x55, 0x80, 0xA5, 0x0A, 0x00, 0x02, 0x55, 0x80, 0xA5, 0x0A, 0x00, 0x02, 0x55, 0x80, 0xA5,
+    0x0A, 0x00, 0x02, 0x55, 0x80, 0xA5, 0x0A, 0x00, 0x02, 0x55, 0x80, 0xA5, 0x0A, 0x00, 0x02, 0x55,
+    0x80, 0xA5, 0x0A, 0x00, 0x03, 0xAA, 0x0A, 0x00, 0x03, 0xAA, 0x27, 0x00, 0x80, 0x50, 0x05, 0x55,
+    0x80, 0x05, 0x1A, 0x00, 0x03, 0xAA, 0x0A, 0x00, 0x03, 0xAA, 0x0A, 0x00, 0x80, 0x5A, 0x02, 0x55,
+    0x0A, 0x00, 0x80, 0x5A, 0x02, 0x55, 0x0A, 0x00, 0x80, 0x5A, 0x02, 0x55, 0x0A, 0x00, 0x80, 0x5A,
+    0x02, 0x55, 0x0A, 0x00, 0x80, 0x5A, 0x02, 0x55, 0x0A, 0x00, 0x80, 0x5A, 0x02, 0x55,
+};
+// clang-format on
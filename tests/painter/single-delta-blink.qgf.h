@@ -0,0 +1,11 @@
+// Copyright 2026 QMK -- generated source code only, image retains original copyright
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// This file was auto-generated by `qmk painter-convert-graphics -i single-delta-blink.gif -f mono4 --no-multi-deltas`
+
+#pragma once
+
+#include <qp.h>
+
+extern const uint32_t gfx_single_delta_blink_length;
+extern const uint8_t  gfx_single_delta_blink[590];
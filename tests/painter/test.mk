@@ -0,0 +1,13 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface sh1106_i2c
+QUANTUM_PAINTER_FLASH_ASSETS_ENABLE = yes
+FLASH_DRIVER = custom
+
+SRC += thintel15.qff.c lock-caps-ON.qgf.c multi-delta-blink.qgf.c single-delta-blink.qgf.c flash_file.c i2c_master.c
@@ -0,0 +1,328 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qp_surface.h"
+
+void simulate_async_tick(uint32_t t);
+}
+
+using namespace std::chrono;
+
+#define SLOW_BUS_WIDTH 240
+#define SLOW_BUS_HEIGHT 240
+#define SLOW_BUS_BYTES_PER_PIXEL 2
+// LVGL's default draw buffer of 1/10 of the screen
+#define SLOW_BUS_CHUNK_PIXELS (SLOW_BUS_WIDTH * SLOW_BUS_HEIGHT / 10)
+
+// A display on a bus that takes its time, with the completion signalled from another thread like a DMA interrupt
+struct SlowBusDisplay {
+    painter_driver_t         base; // must be first, so the device handle can be cast back
+    painter_driver_vtable_t  driver_vtable;
+    painter_comms_vtable_t   comms_vtable;
+    microseconds             per_chunk;
+    std::thread              transfer;
+    std::vector<std::string> log;
+    uint32_t                 starts = 0, stops = 0;
+    bool                     never_completes = false;
+    // With the gate closed, a transfer only completes once the test has opened it up to that transfer's number
+    bool                  gated = false;
+    uint32_t              sent  = 0;
+    std::atomic<uint32_t> opened{0};
+
+    static SlowBusDisplay *from(painter_device_t device) {
+        return (SlowBusDisplay *)device;
+    }
+
+    static bool ok(painter_device_t device) {
+        return true;
+    }
+
+    static bool init(painter_device_t device, painter_rotation_t rotation) {
+        return true;
+    }
+
+    static bool power(painter_device_t device, bool power_on) {
+        return true;
+    }
+
+    static bool viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+        from(device)->log.push_back("viewport");
+        return true;
+    }
+
+    static bool pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+        return qp_comms_send(device, pixel_data, native_pixel_count * SLOW_BUS_BYTES_PER_PIXEL) > 0;
+    }
+
+    static bool pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+        return qp_comms_send_async(device, pixel_data, native_pixel_count * SLOW_BUS_BYTES_PER_PIXEL);
+    }
+
+    static bool palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+        return true;
+    }
+
+    static bool append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+        return true;
+    }
+
+    static bool append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+        return true;
+    }
+
+    static bool comms_start(painter_device_t device) {
+        from(device)->starts++;
+        from(device)->log.push_back("start");
+        return true;
+    }
+
+    static void comms_stop(painter_device_t device) {
+        from(device)->stops++;
+        from(device)->log.push_back("stop");
+    }
+
+    static uint32_t comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+        from(device)->log.push_back("send");
+        std::this_thread::sleep_for(from(device)->per_chunk * byte_count / (SLOW_BUS_CHUNK_PIXELS * SLOW_BUS_BYTES_PER_PIXEL));
+        return byte_count;
+    }
+
+    static bool comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+        SlowBusDisplay *display = from(device);
+        display->log.push_back("send_async");
+        if (display->never_completes) {
+            return true;
+        }
+        if (display->transfer.joinable()) {
+            display->transfer.join();
+        }
+        microseconds duration = display->per_chunk * byte_count / (SLOW_BUS_CHUNK_PIXELS * SLOW_BUS_BYTES_PER_PIXEL);
+        uint32_t     number   = ++display->sent;
+        display->transfer     = std::thread([display, device, duration, number] {
+            std::this_thread::sleep_for(duration);
+            while (display->gated && display->opened < number) {
+                std::this_thread::yield();
+            }
+            qp_comms_send_async_complete(device);
+        });
+        return true;
+    }
+
+    explicit SlowBusDisplay(microseconds per_chunk, bool async) : per_chunk(per_chunk) {
+        memset(&base, 0, sizeof(base));
+        memset(&driver_vtable, 0, sizeof(driver_vtable));
+        memset(&comms_vtable, 0, sizeof(comms_vtable));
+        driver_vtable.init            = init;
+        driver_vtable.power           = power;
+        driver_vtable.clear           = ok;
+        driver_vtable.flush           = ok;
+        driver_vtable.viewport        = viewport;
+        driver_vtable.pixdata         = pixdata;
+        driver_vtable.pixdata_async   = async ? pixdata_async : NULL;
+        driver_vtable.palette_convert = palette_convert;
+        driver_vtable.append_pixels   = append_pixels;
+        driver_vtable.append_pixdata  = append_pixdata;
+        comms_vtable.comms_init       = ok;
+        comms_vtable.comms_start      = comms_start;
+        comms_vtable.comms_stop       = comms_stop;
+        comms_vtable.comms_send       = comms_send;
+        comms_vtable.comms_send_async = comms_send_async;
+        base.driver_vtable            = &driver_vtable;
+        base.comms_vtable             = &comms_vtable;
+        base.panel_width              = SLOW_BUS_WIDTH;
+        base.panel_height             = SLOW_BUS_HEIGHT;
+        base.native_bits_per_pixel    = SLOW_BUS_BYTES_PER_PIXEL * 8;
+    }
+
+    ~SlowBusDisplay() {
+        if (transfer.joinable()) {
+            transfer.join();
+        }
+    }
+
+    painter_device_t device() {
+        return &base;
+    }
+};
+
+static void count_callback(painter_device_t device, void *cb_arg) {
+    (*(int *)cb_arg)++;
+}
+
+// Stands in for LVGL drawing into a buffer, which keeps the CPU busy
+static void render(uint16_t *buffer, microseconds duration) {
+    auto     until = steady_clock::now() + duration;
+    uint16_t value = 0;
+    while (steady_clock::now() < until) {
+        for (uint32_t i = 0; i < SLOW_BUS_CHUNK_PIXELS; i += 97) {
+            buffer[i] = value++;
+        }
+    }
+}
+
+// Renders frames the way LVGL does, a draw buffer at a time, returning frames per second. Counts the draw buffers that
+// were rendered while another was still on its way to the display.
+static double frames_per_second(SlowBusDisplay &display, uint8_t buffer_count, int frames, microseconds render_time, int *overlapped) {
+    static uint16_t buffers[2][SLOW_BUS_CHUNK_PIXELS];
+    const int       chunks      = SLOW_BUS_WIDTH * SLOW_BUS_HEIGHT / SLOW_BUS_CHUNK_PIXELS;
+    volatile bool   flushing[2] = {false, false};
+    auto            done        = [](painter_device_t device, void *cb_arg) { *(volatile bool *)cb_arg = false; };
+
+    auto start = steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        for (int chunk = 0; chunk < chunks; chunk++) {
+            uint8_t b = chunk % buffer_count;
+            // LVGL's wait_cb
+            while (flushing[b]) {
+                qp_pixdata_async_poll(display.device());
+            }
+            // The transfer in flight can't complete until it is let through below, so this doesn't depend on timing
+            if (display.base.async.busy) {
+                (*overlapped)++;
+            }
+            render(buffers[b], render_time);
+            display.opened = display.sent;
+            flushing[b]    = true;
+            qp_viewport(display.device(), 0, 0, SLOW_BUS_WIDTH - 1, SLOW_BUS_HEIGHT / chunks - 1);
+            qp_pixdata_async(display.device(), buffers[b], SLOW_BUS_CHUNK_PIXELS, done, (void *)&flushing[b]);
+        }
+    }
+    display.opened = UINT32_MAX;
+    while (!qp_pixdata_async_poll(display.device())) {
+    }
+    return frames / duration<double>(steady_clock::now() - start).count();
+}
+
+TEST(PainterAsync, FallsBackToSynchronousPixdata) {
+    static uint8_t   framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(4, 4, 16)];
+    painter_device_t surface = qp_make_rgb565_surface(4, 4, framebuffer);
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+    const uint16_t pixels[4] = {0x1234, 0x5678, 0x9ABC, 0xDEF0};
+    int            calls     = 0;
+    ASSERT_TRUE(qp_viewport(surface, 0, 0, 3, 0));
+    EXPECT_TRUE(qp_pixdata_async(surface, pixels, 4, count_callback, &calls));
+
+    // Framebuffer drivers are done straight away
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(qp_pixdata_async_poll(surface));
+    EXPECT_EQ(memcmp(framebuffer, pixels, sizeof(pixels)), 0);
+}
+
+TEST(PainterAsync, CallbackRunsOnceTheTransferIsDone) {
+    SlowBusDisplay display(milliseconds(20), true);
+    ASSERT_TRUE(qp_init(display.device(), QP_ROTATION_0));
+    display.log.clear();
+
+    static uint16_t pixels[SLOW_BUS_CHUNK_PIXELS];
+    int             calls = 0;
+    EXPECT_TRUE(qp_pixdata_async(display.device(), pixels, SLOW_BUS_CHUNK_PIXELS, count_callback, &calls));
+
+    // Still on the bus, with the comms held open for it
+    EXPECT_FALSE(qp_pixdata_async_poll(display.device()));
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(display.starts, display.stops + 1);
+
+    while (!qp_pixdata_async_poll(display.device())) {
+    }
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(display.starts, display.stops);
+
+    // Nothing more to do
+    EXPECT_TRUE(qp_pixdata_async_poll(display.device()));
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(PainterAsync, NextOperationWaitsForTheTransfer) {
+    SlowBusDisplay display(milliseconds(10), true);
+    ASSERT_TRUE(qp_init(display.device(), QP_ROTATION_0));
+    display.log.clear();
+
+    static uint16_t pixels[SLOW_BUS_CHUNK_PIXELS];
+    int             calls = 0;
+    EXPECT_TRUE(qp_pixdata_async(display.device(), pixels, SLOW_BUS_CHUNK_PIXELS, count_callback, &calls));
+    EXPECT_TRUE(qp_viewport(display.device(), 0, 0, 9, 9));
+
+    EXPECT_EQ(calls, 1);
+    std::vector<std::string> expected = {"start", "send_async", "stop", "start", "viewport", "stop"};
+    EXPECT_EQ(display.log, expected);
+}
+
+TEST(PainterAsync, WaitGivesUpOnATransferThatNeverFinishes) {
+    SlowBusDisplay display(milliseconds(1), true);
+    display.never_completes = true;
+    ASSERT_TRUE(qp_init(display.device(), QP_ROTATION_0));
+    display.log.clear();
+
+    static uint16_t pixels[SLOW_BUS_CHUNK_PIXELS];
+    int             calls = 0;
+    EXPECT_TRUE(qp_pixdata_async(display.device(), pixels, SLOW_BUS_CHUNK_PIXELS, count_callback, &calls));
+
+    // Every read of the timer moves it on, so the wait runs out
+    simulate_async_tick(1);
+    EXPECT_FALSE(qp_pixdata_async_wait(display.device()));
+    simulate_async_tick(0);
+
+    // The buffer is handed back and the comms are stopped, so the display can be used again
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(display.starts, display.stops);
+    EXPECT_TRUE(qp_viewport(display.device(), 0, 0, 9, 9));
+    std::vector<std::string> expected = {"start", "send_async", "stop", "start", "viewport", "stop"};
+    EXPECT_EQ(display.log, expected);
+}
+
+TEST(PainterAsync, CommsWithoutAsyncSendCompleteImmediately) {
+    SlowBusDisplay display(milliseconds(1), true);
+    display.comms_vtable.comms_send_async = NULL;
+    ASSERT_TRUE(qp_init(display.device(), QP_ROTATION_0));
+    display.log.clear();
+
+    static uint16_t pixels[SLOW_BUS_CHUNK_PIXELS];
+    int             calls = 0;
+    EXPECT_TRUE(qp_pixdata_async(display.device(), pixels, SLOW_BUS_CHUNK_PIXELS, count_callback, &calls));
+    EXPECT_TRUE(qp_pixdata_async_poll(display.device()));
+    EXPECT_EQ(calls, 1);
+    std::vector<std::string> expected = {"start", "send", "stop"};
+    EXPECT_EQ(display.log, expected);
+}
+
+TEST(PainterAsync, DoubleBufferingOverlapsRenderingAndTransfer) {
+    // A 240x240 RGB565 screen on an 8MHz SPI bus takes 11.5ms per 1/10 screen draw buffer
+    const microseconds per_chunk(11520);
+    const microseconds render_time(8000);
+    const int          frames = 5;
+    const int          chunks = SLOW_BUS_WIDTH * SLOW_BUS_HEIGHT / SLOW_BUS_CHUNK_PIXELS;
+
+    SlowBusDisplay sync_display(per_chunk, false);
+    ASSERT_TRUE(qp_init(sync_display.device(), QP_ROTATION_0));
+    int    single_overlapped = 0;
+    double single_fps        = frames_per_second(sync_display, 1, frames, render_time, &single_overlapped);
+
+    SlowBusDisplay async_display(per_chunk, true);
+    async_display.gated = true;
+    ASSERT_TRUE(qp_init(async_display.device(), QP_ROTATION_0));
+    int    double_overlapped = 0;
+    double double_fps        = frames_per_second(async_display, 2, frames, render_time, &double_overlapped);
+
+    printf("Frames per second on a slow bus: single buffer %.1f, double buffer %.1f\n", single_fps, double_fps);
+
+    // A single buffer waits for every transfer, while with two, every draw buffer after the first is rendered during
+    // the transfer of the one before it
+    EXPECT_EQ(single_overlapped, 0);
+    EXPECT_EQ(double_overlapped, frames * chunks - 1);
+    EXPECT_EQ(async_display.starts, async_display.stops);
+}
@@ -0,0 +1,211 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "qp_flash_assets.h"
+#include "flash_file.h"
+#include "thintel15.qff.h"
+#include "lock-caps-ON.qgf.h"
+}
+
+#define FLASH_SURFACE_WIDTH 128
+#define FLASH_SURFACE_HEIGHT 32
+
+static uint8_t flash_framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(FLASH_SURFACE_WIDTH, FLASH_SURFACE_HEIGHT, 16)];
+
+class PainterFlashAssets : public ::testing::Test {
+   protected:
+    static void SetUpTestCase() {
+        surface = qp_make_rgb565_surface(FLASH_SURFACE_WIDTH, FLASH_SURFACE_HEIGHT, flash_framebuffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_FORMAT), QP_FLASH_ASSETS_STATUS_OK);
+    }
+
+    // Sends a raw HID packet to the asset store, returning the status byte of the response
+    uint8_t command(uint8_t cmd, const std::vector<uint8_t> &payload = {}) {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID;
+        packet[1] = cmd;
+        memcpy(&packet[3], payload.data(), payload.size());
+        EXPECT_TRUE(qp_flash_assets_raw_hid_receive(packet, sizeof(packet)));
+        EXPECT_EQ(packet[0], QUANTUM_PAINTER_FLASH_ASSETS_RAW_HID_ID);
+        EXPECT_EQ(packet[1], cmd);
+        return packet[2];
+    }
+
+    static std::vector<uint8_t> u32(uint32_t v) {
+        return {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    }
+
+    // Uploads an asset the same way a host tool would, one raw HID packet at a time
+    void upload(const char *name, const uint8_t *data, uint32_t length, bool commit = true) {
+        std::vector<uint8_t> begin = u32(length);
+        begin.insert(begin.end(), name, name + strlen(name));
+        ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_BEGIN, begin), QP_FLASH_ASSETS_STATUS_OK);
+
+        const uint32_t chunk = sizeof(packet) - 8;
+        for (uint32_t offset = 0; offset < length; offset += chunk) {
+            uint32_t             count = (length - offset) < chunk ? (length - offset) : chunk;
+            std::vector<uint8_t> write = u32(offset);
+            write.push_back((uint8_t)count);
+            write.insert(write.end(), data + offset, data + offset + count);
+            ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_WRITE, write), QP_FLASH_ASSETS_STATUS_OK);
+        }
+
+        if (commit) {
+            ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_COMMIT), QP_FLASH_ASSETS_STATUS_OK);
+        }
+    }
+
+    std::vector<uint8_t> render_text(painter_font_handle_t font, const char *str) {
+        memset(flash_framebuffer, 0, sizeof(flash_framebuffer));
+        EXPECT_GT(qp_drawtext(surface, 0, 0, font, str), 0);
+        return std::vector<uint8_t>(flash_framebuffer, flash_framebuffer + sizeof(flash_framebuffer));
+    }
+
+    std::vector<uint8_t> render_image(painter_image_handle_t image) {
+        memset(flash_framebuffer, 0, sizeof(flash_framebuffer));
+        EXPECT_TRUE(qp_drawimage(surface, 0, 0, image));
+        return std::vector<uint8_t>(flash_framebuffer, flash_framebuffer + sizeof(flash_framebuffer));
+    }
+
+    static painter_device_t surface;
+    uint8_t                 packet[32];
+};
+
+painter_device_t PainterFlashAssets::surface = nullptr;
+
+TEST_F(PainterFlashAssets, FontRendersIdenticallyToMemory) {
+    upload("thintel15", font_thintel15, font_thintel15_length);
+
+    painter_font_handle_t mem_font   = qp_load_font_mem(font_thintel15);
+    painter_font_handle_t flash_font = qp_load_font_flash("thintel15");
+    ASSERT_NE(mem_font, nullptr);
+    ASSERT_NE(flash_font, nullptr);
+
+    auto expected = render_text(mem_font, "Hello, World! 0123456789");
+    auto actual   = render_text(flash_font, "Hello, World! 0123456789");
+    EXPECT_NE(expected, std::vector<uint8_t>(sizeof(flash_framebuffer), 0));
+    EXPECT_EQ(expected, actual);
+
+    qp_close_font(flash_font);
+    qp_close_font(mem_font);
+}
+
+TEST_F(PainterFlashAssets, ImageRendersIdenticallyToMemory) {
+    upload("caps", gfx_lock_caps_ON, gfx_lock_caps_ON_length);
+
+    painter_image_handle_t mem_image   = qp_load_image_mem(gfx_lock_caps_ON);
+    painter_image_handle_t flash_image = qp_load_image_flash("caps");
+    ASSERT_NE(mem_image, nullptr);
+    ASSERT_NE(flash_image, nullptr);
+    EXPECT_EQ(flash_image->width, mem_image->width);
+    EXPECT_EQ(flash_image->height, mem_image->height);
+
+    auto expected = render_image(mem_image);
+    auto actual   = render_image(flash_image);
+    EXPECT_NE(expected, std::vector<uint8_t>(sizeof(flash_framebuffer), 0));
+    EXPECT_EQ(expected, actual);
+
+    qp_close_image(flash_image);
+    qp_close_image(mem_image);
+}
+
+TEST_F(PainterFlashAssets, ReadAheadCacheBatchesFlashReads) {
+    upload("thintel15", font_thintel15, font_thintel15_length);
+
+    painter_font_handle_t font = qp_load_font_flash("thintel15");
+    ASSERT_NE(font, nullptr);
+
+    // Drawing reads well over a kilobyte of glyph data and tables -- without the cache that would be one flash
+    // transaction per byte
+    uint32_t reads_before = flash_file_read_count();
+    render_text(font, "The quick brown fox jumps over the lazy dog");
+    uint32_t reads = flash_file_read_count() - reads_before;
+    EXPECT_GT(reads, 0u);
+    EXPECT_LT(reads, 200u);
+
+    qp_close_font(font);
+}
+
+TEST_F(PainterFlashAssets, UncommittedUploadIsNotVisible) {
+    upload("caps", gfx_lock_caps_ON, gfx_lock_caps_ON_length, false);
+    EXPECT_EQ(qp_load_image_flash("caps"), nullptr);
+    ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_COMMIT), QP_FLASH_ASSETS_STATUS_OK);
+
+    painter_image_handle_t image = qp_load_image_flash("caps");
+    EXPECT_NE(image, nullptr);
+    qp_close_image(image);
+}
+
+TEST_F(PainterFlashAssets, ReuploadReplacesAsset) {
+    upload("asset", font_thintel15, font_thintel15_length);
+    upload("asset", gfx_lock_caps_ON, gfx_lock_caps_ON_length);
+
+    uint32_t address, length;
+    ASSERT_TRUE(qp_flash_assets_find("asset", &address, &length));
+    EXPECT_EQ(length, gfx_lock_caps_ON_length);
+
+    painter_image_handle_t image = qp_load_image_flash("asset");
+    EXPECT_NE(image, nullptr);
+    qp_close_image(image);
+
+    // Both uploads still occupy index entries until the store is reformatted
+    ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_INFO), QP_FLASH_ASSETS_STATUS_OK);
+    EXPECT_EQ(packet[3 + 8], 2);
+    EXPECT_EQ(packet[3 + 9], QUANTUM_PAINTER_FLASH_ASSETS_MAX_ENTRIES);
+}
+
+TEST_F(PainterFlashAssets, DeleteRemovesAsset) {
+    upload("caps", gfx_lock_caps_ON, gfx_lock_caps_ON_length);
+    ASSERT_TRUE(qp_flash_assets_find("caps", NULL, NULL));
+
+    ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_DELETE, {'c', 'a', 'p', 's'}), QP_FLASH_ASSETS_STATUS_OK);
+    EXPECT_FALSE(qp_flash_assets_find("caps", NULL, NULL));
+    EXPECT_EQ(qp_load_image_flash("caps"), nullptr);
+
+    // Deleting something that isn't there is reported as an error
+    EXPECT_EQ(command(QP_FLASH_ASSETS_CMD_DELETE, {'c', 'a', 'p', 's'}), QP_FLASH_ASSETS_STATUS_ERROR);
+}
+
+TEST_F(PainterFlashAssets, OverlongNamesDoNotMatchTheirPrefix) {
+    upload("sixteen_chars_ab", gfx_lock_caps_ON, gfx_lock_caps_ON_length);
+    EXPECT_FALSE(qp_flash_assets_find("sixteen_chars_abc", NULL, NULL));
+    EXPECT_FALSE(qp_flash_assets_delete("sixteen_chars_abc"));
+    EXPECT_TRUE(qp_flash_assets_find("sixteen_chars_ab", NULL, NULL));
+}
+
+TEST_F(PainterFlashAssets, FormatReclaimsSpace) {
+    uint32_t empty = qp_flash_assets_free_space();
+    upload("thintel15", font_thintel15, font_thintel15_length);
+    EXPECT_LT(qp_flash_assets_free_space(), empty);
+
+    ASSERT_EQ(command(QP_FLASH_ASSETS_CMD_FORMAT), QP_FLASH_ASSETS_STATUS_OK);
+    EXPECT_EQ(qp_flash_assets_free_space(), empty);
+    EXPECT_FALSE(qp_flash_assets_find("thintel15", NULL, NULL));
+}
+
+TEST_F(PainterFlashAssets, OversizedUploadIsRejected) {
+    std::vector<uint8_t> begin = u32(qp_flash_assets_free_space() + 1);
+    begin.push_back('x');
+    EXPECT_EQ(command(QP_FLASH_ASSETS_CMD_BEGIN, begin), QP_FLASH_ASSETS_STATUS_ERROR);
+
+    // Writes without an active upload are also rejected
+    EXPECT_EQ(command(QP_FLASH_ASSETS_CMD_WRITE, {0, 0, 0, 0, 1, 0xAA}), QP_FLASH_ASSETS_STATUS_ERROR);
+}
+
+TEST_F(PainterFlashAssets, IgnoresOtherRawHidPackets) {
+    uint8_t other[32] = {0x01, QP_FLASH_ASSETS_CMD_FORMAT};
+    EXPECT_FALSE(qp_flash_assets_raw_hid_receive(other, sizeof(other)));
+    EXPECT_EQ(other[2], 0);
+}
@@ -0,0 +1,175 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_surface.h"
+#include "multi-delta-blink.qgf.h"
+#include "single-delta-blink.qgf.h"
+
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+}
+
+#define MULTI_DELTA_SURFACE_WIDTH 64
+#define MULTI_DELTA_SURFACE_HEIGHT 32
+#define MULTI_DELTA_FRAME_COUNT 4
+#define MULTI_DELTA_FRAME_DELAY 100
+
+static uint8_t multi_delta_framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(MULTI_DELTA_SURFACE_WIDTH, MULTI_DELTA_SURFACE_HEIGHT, 16)];
+
+// Counts what gets pushed to the surface, by interposing on its driver vtable
+static const painter_driver_vtable_t *surface_vtable = nullptr;
+static painter_driver_vtable_t        counting_vtable;
+static uint32_t                       viewports_set   = 0;
+static uint32_t                       pixels_streamed = 0;
+
+static bool counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    ++viewports_set;
+    return surface_vtable->viewport(device, left, top, right, bottom);
+}
+
+static bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    pixels_streamed += native_pixel_count;
+    return surface_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+struct FrameStats {
+    uint32_t             viewports;
+    uint32_t             pixels;
+    std::vector<uint8_t> framebuffer;
+};
+
+class PainterMultiDelta : public ::testing::Test {
+   protected:
+    static void SetUpTestCase() {
+        surface = qp_make_rgb565_surface(MULTI_DELTA_SURFACE_WIDTH, MULTI_DELTA_SURFACE_HEIGHT, multi_delta_framebuffer);
+
+        painter_driver_t *driver = (painter_driver_t *)surface;
+        surface_vtable           = driver->driver_vtable;
+        counting_vtable          = *surface_vtable;
+        counting_vtable.viewport = counting_viewport;
+        counting_vtable.pixdata  = counting_pixdata;
+        driver->driver_vtable    = &counting_vtable;
+    }
+
+    static void TearDownTestCase() {
+        ((painter_driver_t *)surface)->driver_vtable = surface_vtable;
+    }
+
+    void SetUp() override {
+        memset(multi_delta_framebuffer, 0, sizeof(multi_delta_framebuffer));
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    }
+
+    static FrameStats capture(void) {
+        FrameStats stats = {viewports_set, pixels_streamed, std::vector<uint8_t>(multi_delta_framebuffer, multi_delta_framebuffer + sizeof(multi_delta_framebuffer))};
+        viewports_set    = 0;
+        pixels_streamed  = 0;
+        return stats;
+    }
+
+    // Plays the animation through once, capturing what was sent to the surface for each frame
+    static std::vector<FrameStats> play(const uint8_t *buffer) {
+        std::vector<FrameStats> frames;
+
+        painter_image_handle_t image = qp_load_image_mem(buffer);
+        EXPECT_NE(image, nullptr);
+        if (!image) {
+            return frames;
+        }
+        EXPECT_EQ(image->frame_count, MULTI_DELTA_FRAME_COUNT);
+
+        viewports_set        = 0;
+        pixels_streamed      = 0;
+        deferred_token token = qp_animate(surface, 0, 0, image);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        frames.push_back(capture());
+
+        for (int i = 1; i < MULTI_DELTA_FRAME_COUNT; ++i) {
+            advance_time(MULTI_DELTA_FRAME_DELAY);
+            qp_internal_animation_tick();
+            frames.push_back(capture());
+        }
+
+        qp_stop_animation(token);
+        qp_close_image(image);
+        return frames;
+    }
+
+    static painter_device_t surface;
+};
+
+painter_device_t PainterMultiDelta::surface = nullptr;
+
+TEST_F(PainterMultiDelta, ImageLoads) {
+    painter_image_handle_t image = qp_load_image_mem(gfx_multi_delta_blink);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->width, MULTI_DELTA_SURFACE_WIDTH);
+    EXPECT_EQ(image->height, MULTI_DELTA_SURFACE_HEIGHT);
+    EXPECT_EQ(image->frame_count, MULTI_DELTA_FRAME_COUNT);
+    EXPECT_TRUE(qp_close_image(image));
+}
+
+TEST_F(PainterMultiDelta, OnlyChangedRectanglesAreStreamed) {
+    auto frames = play(gfx_multi_delta_blink);
+    ASSERT_EQ(frames.size(), MULTI_DELTA_FRAME_COUNT);
+
+    // First frame is drawn in full
+    EXPECT_EQ(frames[0].viewports, 1);
+    EXPECT_EQ(frames[0].pixels, MULTI_DELTA_SURFACE_WIDTH * MULTI_DELTA_SURFACE_HEIGHT);
+
+    // Two separate 10x6 areas change
+    EXPECT_EQ(frames[1].viewports, 2);
+    EXPECT_EQ(frames[1].pixels, 2 * 10 * 6);
+
+    // A single 10x6 area changes, so a single-rectangle delta is used
+    EXPECT_EQ(frames[2].viewports, 1);
+    EXPECT_EQ(frames[2].pixels, 10 * 6);
+
+    // Two 10x6 areas and a lone pixel change
+    EXPECT_EQ(frames[3].viewports, 3);
+    EXPECT_EQ(frames[3].pixels, 2 * 10 * 6 + 1);
+}
+
+TEST_F(PainterMultiDelta, FewerPixelsThanSingleRectangle) {
+    auto multi  = play(gfx_multi_delta_blink);
+    auto single = play(gfx_single_delta_blink);
+    ASSERT_EQ(multi.size(), MULTI_DELTA_FRAME_COUNT);
+    ASSERT_EQ(single.size(), MULTI_DELTA_FRAME_COUNT);
+
+    uint32_t multi_total  = 0;
+    uint32_t single_total = 0;
+    for (int i = 0; i < MULTI_DELTA_FRAME_COUNT; ++i) {
+        EXPECT_LE(multi[i].pixels, single[i].pixels) << "frame " << i;
+        multi_total += multi[i].pixels;
+        single_total += single[i].pixels;
+    }
+    EXPECT_LT(multi_total, single_total);
+}
+
+TEST_F(PainterMultiDelta, RendersSameAsSingleRectangle) {
+    auto multi  = play(gfx_multi_delta_blink);
+    auto single = play(gfx_single_delta_blink);
+    ASSERT_EQ(multi.size(), MULTI_DELTA_FRAME_COUNT);
+    ASSERT_EQ(single.size(), MULTI_DELTA_FRAME_COUNT);
+
+    for (int i = 0; i < MULTI_DELTA_FRAME_COUNT; ++i) {
+        EXPECT_EQ(multi[i].framebuffer, single[i].framebuffer) << "frame " << i;
+    }
+}
+
+TEST_F(PainterMultiDelta, RejectsUnknownVersion) {
+    std::vector<uint8_t> corrupted(gfx_multi_delta_blink, gfx_multi_delta_blink + gfx_multi_delta_blink_length);
+
+    // Byte 8 is the graphics descriptor's version
+    ASSERT_EQ(corrupted[8], 0x02);
+    corrupted[8] = 0x03;
+    EXPECT_EQ(qp_load_image_mem(corrupted.data()), nullptr);
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_draw.h"
+#include "qp_surface.h"
+}
+
+#define STREAM_SURFACE_WIDTH 128
+#define STREAM_SURFACE_HEIGHT 64
+
+static uint8_t stream_framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(STREAM_SURFACE_WIDTH, STREAM_SURFACE_HEIGHT, 16)];
+
+class PainterStream : public ::testing::Test {
+   protected:
+    static void SetUpTestCase() {
+        surface = qp_make_rgb565_surface(STREAM_SURFACE_WIDTH, STREAM_SURFACE_HEIGHT, stream_framebuffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+        // Pseudo-random asset data, so that every palette index and byte value is exercised
+        asset.resize(STREAM_SURFACE_WIDTH * STREAM_SURFACE_HEIGHT * 2);
+        uint32_t lfsr = 0xACE1u;
+        for (auto &b : asset) {
+            lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+            b    = (uint8_t)lfsr;
+        }
+    }
+
+    // Renders the asset through the same path used by image and font drawing
+    std::vector<uint8_t> render(uint8_t bpp, bool mapped) {
+        memset(stream_framebuffer, 0, sizeof(stream_framebuffer));
+
+        // Count the stream's byte and block reads, as the appender makes them
+        qp_memory_stream_t stream = qp_make_memory_stream(asset.data(), asset.size());
+        memory_ops                = stream.base;
+        stream.base.get           = counting_get;
+        stream.base.map           = mapped ? counting_map : NULL;
+        get_calls                 = 0;
+        mapped_bytes              = 0;
+
+        if (bpp <= 8) {
+            qp_pixel_t fg = {.hsv888 = {.h = 0, .s = 255, .v = 255}};
+            qp_pixel_t bg = {.hsv888 = {.h = 128, .s = 255, .v = 64}};
+            qp_internal_invalidate_palette();
+            qp_internal_interpolate_palette(fg, bg, 1 << bpp);
+            painter_driver_t *driver = (painter_driver_t *)surface;
+            driver->driver_vtable->palette_convert(surface, 1 << bpp, qp_internal_global_pixel_lookup_table);
+        }
+
+        qp_internal_byte_input_state_t  input_state    = {.device = surface, .src_stream = &stream.base};
+        qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, IMAGE_UNCOMPRESSED);
+        EXPECT_TRUE(qp_viewport(surface, 0, 0, STREAM_SURFACE_WIDTH - 1, STREAM_SURFACE_HEIGHT - 1));
+        EXPECT_TRUE(qp_internal_appender(surface, bpp, STREAM_SURFACE_WIDTH * STREAM_SURFACE_HEIGHT, input_callback, &input_state));
+        return std::vector<uint8_t>(stream_framebuffer, stream_framebuffer + sizeof(stream_framebuffer));
+    }
+
+    double pixels_per_second(uint8_t bpp, bool mapped, int iterations) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            render(bpp, mapped);
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return (double)iterations * STREAM_SURFACE_WIDTH * STREAM_SURFACE_HEIGHT / elapsed;
+    }
+
+    static int16_t counting_get(qp_stream_t *stream) {
+        ++get_calls;
+        return memory_ops.get(stream);
+    }
+
+    static const uint8_t *counting_map(qp_stream_t *stream, uint32_t length) {
+        const uint8_t *data = memory_ops.map(stream, length);
+        if (data) {
+            mapped_bytes += length;
+        }
+        return data;
+    }
+
+    static painter_device_t surface;
+    static qp_stream_t      memory_ops;
+    static uint32_t         get_calls;
+    static uint32_t         mapped_bytes;
+    std::vector<uint8_t>    asset;
+};
+
+painter_device_t PainterStream::surface      = nullptr;
+qp_stream_t      PainterStream::memory_ops   = {};
+uint32_t         PainterStream::get_calls    = 0;
+uint32_t         PainterStream::mapped_bytes = 0;
+
+TEST_F(PainterStream, BlockReadMatchesByteRead) {
+    uint8_t data[16];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = i;
+    }
+
+    qp_memory_stream_t mapped   = qp_make_memory_stream(data, sizeof(data));
+    qp_memory_stream_t unmapped = qp_make_memory_stream(data, sizeof(data));
+    unmapped.base.map           = NULL;
+
+    uint8_t a[6], b[6];
+    qp_stream_setpos(&mapped, 3);
+    qp_stream_setpos(&unmapped, 3);
+    EXPECT_EQ(qp_stream_read(a, 2, 3, &mapped), 3u);
+    EXPECT_EQ(qp_stream_read(b, 2, 3, &unmapped), 3u);
+    EXPECT_EQ(memcmp(a, b, sizeof(a)), 0);
+    EXPECT_EQ(qp_stream_tell(&mapped), qp_stream_tell(&unmapped));
+
+    // Reads past the end must still return only the complete members available
+    qp_stream_setpos(&mapped, 11);
+    EXPECT_EQ(qp_stream_read(a, 2, 3, &mapped), 2u);
+    EXPECT_TRUE(qp_stream_eof(&mapped));
+}
+
+TEST_F(PainterStream, MappedPathRendersIdentically) {
+    for (uint8_t bpp : {1, 2, 4, 16}) {
+        EXPECT_EQ(render(bpp, true), render(bpp, false)) << "bpp=" << (int)bpp;
+    }
+}
+
+TEST_F(PainterStream, MappedPathSkipsByteReads) {
+    const uint32_t bytes = STREAM_SURFACE_WIDTH * STREAM_SURFACE_HEIGHT * 2;
+
+    render(16, false);
+    EXPECT_EQ(get_calls, bytes);
+    EXPECT_EQ(mapped_bytes, 0u);
+
+    // Native data is a straight block copy when mapped, without reading it a byte at a time
+    render(16, true);
+    EXPECT_EQ(get_calls, 0u);
+    EXPECT_EQ(mapped_bytes, bytes);
+}
+
+TEST_F(PainterStream, Benchmark) {
+    for (uint8_t bpp : {4, 16}) {
+        double mapped   = pixels_per_second(bpp, true, 200);
+        double unmapped = pixels_per_second(bpp, false, 200);
+        printf("qp_internal_appender: %2d bpp, %.1f Mpixel/s byte-by-byte, %.1f Mpixel/s memory-mapped\n", bpp, unmapped / 1e6, mapped / 1e6);
+    }
+}
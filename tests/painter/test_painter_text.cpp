@@ -0,0 +1,149 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_surface.h"
+#include "thintel15.qff.h"
+}
+
+#define SURFACE_WIDTH 128
+#define SURFACE_HEIGHT 16
+
+static uint8_t framebuffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(SURFACE_WIDTH, SURFACE_HEIGHT, 16)];
+
+class PainterText : public ::testing::Test {
+   protected:
+    static void SetUpTestCase() {
+        // Surfaces are allocated from a fixed pool, so only make one for the whole suite
+        surface = qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer);
+    }
+
+    void SetUp() override {
+        memset(framebuffer, 0, sizeof(framebuffer));
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        font = qp_load_font_mem(font_thintel15);
+        ASSERT_NE(font, nullptr);
+    }
+
+    void TearDown() override {
+        qp_close_font(font);
+    }
+
+    std::vector<uint8_t> render(const char *str, uint8_t hue_fg = 0, uint8_t sat_fg = 0, uint8_t val_fg = 255) {
+        memset(framebuffer, 0, sizeof(framebuffer));
+        EXPECT_GT(qp_drawtext_recolor(surface, 0, 0, font, str, hue_fg, sat_fg, val_fg, 0, 0, 0), 0);
+        return std::vector<uint8_t>(framebuffer, framebuffer + sizeof(framebuffer));
+    }
+
+    static painter_device_t surface;
+    painter_font_handle_t   font;
+};
+
+painter_device_t PainterText::surface = nullptr;
+
+// Counts the pixels decoded from font data, and the pixel data sent to the surface
+static const painter_driver_vtable_t *surface_vtable;
+static uint32_t                       pixels_decoded;
+static uint32_t                       pixdata_calls;
+
+static bool counting_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    pixels_decoded += pixel_count;
+    return surface_vtable->append_pixels(device, target_buffer, palette, pixel_offset, pixel_count, palette_indices);
+}
+
+static bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    pixdata_calls++;
+    return surface_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+TEST_F(PainterText, CachedGlyphsRenderIdentically) {
+    auto cold = render("Hello, World!");
+    auto warm = render("Hello, World!");
+
+    // Something must actually have been drawn
+    EXPECT_NE(cold, std::vector<uint8_t>(sizeof(framebuffer), 0));
+    EXPECT_EQ(cold, warm);
+}
+
+TEST_F(PainterText, CachedGlyphsHonourColors) {
+    auto white = render("QMK");
+    auto red   = render("QMK", 0, 255, 255);
+    EXPECT_NE(white, red);
+
+    // Swapping back must produce the original output, not the most recently cached colors
+    EXPECT_EQ(render("QMK"), white);
+    EXPECT_EQ(render("QMK", 0, 255, 255), red);
+}
+
+TEST_F(PainterText, TextWidthMatchesDrawnWidth) {
+    const char *str   = "The quick brown fox";
+    int16_t     width = qp_textwidth(font, str);
+    EXPECT_GT(width, 0);
+    EXPECT_EQ(qp_drawtext(surface, 0, 0, font, str), width);
+
+    // Widths found through cached glyphs must agree with the font data
+    EXPECT_EQ(qp_textwidth(font, str), width);
+}
+
+TEST_F(PainterText, ReloadedFontDoesNotReuseStaleGlyphs) {
+    auto original = render("ABC");
+
+    // Closing the font invalidates its glyphs; the reloaded font may land in the same slot
+    qp_close_font(font);
+    font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+
+    EXPECT_EQ(render("ABC"), original);
+    EXPECT_NE(render("XYZ"), original);
+}
+
+TEST_F(PainterText, Benchmark) {
+    const char *str        = "Layer: 0  WPM: 123";
+    const int   iterations = 2000;
+
+    painter_driver_t *      driver          = (painter_driver_t *)surface;
+    painter_driver_vtable_t counting_vtable = *driver->driver_vtable;
+    surface_vtable                          = driver->driver_vtable;
+    counting_vtable.append_pixels           = counting_append_pixels;
+    counting_vtable.pixdata                 = counting_pixdata;
+    driver->driver_vtable                   = &counting_vtable;
+
+    // Changing the foreground color on every iteration forces every glyph to be decoded from the font data
+    pixels_decoded = 0;
+    pixdata_calls  = 0;
+    auto start     = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        qp_drawtext_recolor(surface, 0, 0, font, str, i & 0xFF, 255, 255, 0, 0, 0);
+    }
+    auto     uncached                = std::chrono::steady_clock::now() - start;
+    uint32_t uncached_pixels_decoded = pixels_decoded;
+    uint32_t uncached_pixdata_calls  = pixdata_calls;
+
+    qp_drawtext(surface, 0, 0, font, str);
+    pixels_decoded = 0;
+    pixdata_calls  = 0;
+    start          = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        qp_drawtext(surface, 0, 0, font, str);
+    }
+    auto cached = std::chrono::steady_clock::now() - start;
+
+    driver->driver_vtable = surface_vtable;
+
+    auto strings_per_second = [&](std::chrono::steady_clock::duration d) { return (double)iterations / std::chrono::duration<double>(d).count(); };
+    printf("qp_drawtext: %.0f strings/s uncached, %.0f strings/s cached\n", strings_per_second(uncached), strings_per_second(cached));
+
+    // Once cached, the glyphs are sent as they are, in one transfer each, without decoding anything
+    EXPECT_GT(uncached_pixels_decoded, 0);
+    EXPECT_EQ(pixels_decoded, 0);
+    EXPECT_EQ(pixdata_calls, uncached_pixdata_calls);
+    EXPECT_EQ(pixdata_calls, iterations * strlen(str));
+}
@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+POWER_STATE_ENABLE = yes
+
+BACKLIGHT_ENABLE = yes
+BACKLIGHT_DRIVER = custom
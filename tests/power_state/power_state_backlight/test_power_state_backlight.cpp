@@ -0,0 +1,93 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "backlight.h"
+#include "eeconfig.h"
+#include "power_state.h"
+}
+
+#define USER_LEVEL 10
+
+class PowerStateBacklight : public TestFixture {
+   public:
+    KeymapKey key_a      = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_bl_up  = KeymapKey(0, 1, 0, BL_UP);
+    KeymapKey key_bl_tog = KeymapKey(0, 2, 0, BL_TOGG);
+
+    void SetUp() override {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+        set_keymap({key_a, key_bl_up, key_bl_tog});
+
+        // Start out active, as the time starts over for every test, then set the user's level
+        tap_key(key_a);
+        backlight_level(USER_LEVEL);
+    }
+
+    static backlight_config_t saved_config(void) {
+        backlight_config_t config;
+        eeconfig_read_backlight(&config);
+        return config;
+    }
+
+    void doze(void) {
+        idle_for(POWER_STATE_DOZE_TIMEOUT);
+        ASSERT_EQ(power_state_get(), POWER_STATE_DOZE);
+        ASSERT_LT(get_backlight_level(), USER_LEVEL);
+        ASSERT_GT(get_backlight_level(), 0);
+    }
+};
+
+TEST_F(PowerStateBacklight, DimmingIsNotSaved) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    doze();
+    EXPECT_EQ(saved_config().level, USER_LEVEL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerStateBacklight, StepsUpFromTheUserLevelWhileDozing) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    doze();
+    key_bl_up.press();
+    idle_for(POWER_STATE_DOZE_SCAN_INTERVAL);
+    key_bl_up.release();
+    run_one_scan_loop();
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    EXPECT_EQ(get_backlight_level(), USER_LEVEL + 1);
+    EXPECT_EQ(saved_config().level, USER_LEVEL + 1);
+
+    // and stays there
+    idle_for(POWER_STATE_IDLE_TIMEOUT - 10);
+    EXPECT_EQ(get_backlight_level(), USER_LEVEL + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerStateBacklight, TogglesOffWhileDozing) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    doze();
+    key_bl_tog.press();
+    idle_for(POWER_STATE_DOZE_SCAN_INTERVAL);
+    key_bl_tog.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(is_backlight_enabled());
+    EXPECT_FALSE(saved_config().enable);
+
+    // Neither becoming active nor dozing off again turns it back on
+    idle_for(POWER_STATE_DOZE_TIMEOUT);
+    EXPECT_EQ(power_state_get(), POWER_STATE_DOZE);
+    EXPECT_FALSE(is_backlight_enabled());
+    EXPECT_FALSE(saved_config().enable);
+    VERIFY_AND_CLEAR(driver);
+}
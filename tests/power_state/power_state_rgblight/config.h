@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POWER_STATE_IDLE_TIMEOUT 1000
+#define POWER_STATE_DOZE_TIMEOUT 5000
+#define POWER_STATE_SLEEP_TIMEOUT 20000
+
+#define RGBLIGHT_LED_COUNT 4
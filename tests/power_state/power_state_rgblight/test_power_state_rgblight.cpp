@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "eeconfig.h"
+#include "power_state.h"
+#include "rgblight.h"
+
+static void rgblight_driver_init(void) {}
+static void rgblight_driver_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {}
+static void rgblight_driver_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {}
+static void rgblight_driver_flush(void) {}
+
+extern const rgblight_driver_t rgblight_driver = {
+    .init          = rgblight_driver_init,
+    .set_color     = rgblight_driver_set_color,
+    .set_color_all = rgblight_driver_set_color_all,
+    .flush         = rgblight_driver_flush,
+};
+}
+
+#define USER_HUE 100
+#define USER_SAT 200
+#define USER_VAL 120
+
+class PowerStateRgblight : public TestFixture {
+   public:
+    KeymapKey key_a      = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_rgb_vu = KeymapKey(0, 1, 0, UG_VALU);
+
+    void SetUp() override {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+        set_keymap({key_a, key_rgb_vu});
+
+        // Start out active, as the time starts over for every test, then set the user's colour
+        tap_key(key_a);
+        rgblight_enable();
+        rgblight_mode(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_sethsv(USER_HUE, USER_SAT, USER_VAL);
+    }
+
+    static rgblight_config_t saved_config(void) {
+        rgblight_config_t config;
+        eeconfig_read_rgblight(&config);
+        return config;
+    }
+};
+
+TEST_F(PowerStateRgblight, DimsWithoutSaving) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    idle_for(POWER_STATE_DOZE_TIMEOUT);
+    ASSERT_EQ(power_state_get(), POWER_STATE_DOZE);
+    EXPECT_LT(rgblight_get_val(), USER_VAL);
+    EXPECT_GT(rgblight_get_val(), 0);
+    EXPECT_EQ(rgblight_get_hue(), USER_HUE);
+    EXPECT_EQ(rgblight_get_sat(), USER_SAT);
+    EXPECT_EQ(saved_config().val, USER_VAL);
+
+    idle_for(POWER_STATE_SLEEP_TIMEOUT - POWER_STATE_DOZE_TIMEOUT);
+    ASSERT_EQ(power_state_get(), POWER_STATE_SLEEP);
+    EXPECT_EQ(rgblight_get_val(), 0);
+    EXPECT_TRUE(rgblight_is_enabled());
+    EXPECT_EQ(saved_config().val, USER_VAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerStateRgblight, StepsUpFromTheUserValueWhileDozing) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    idle_for(POWER_STATE_DOZE_TIMEOUT);
+    ASSERT_EQ(power_state_get(), POWER_STATE_DOZE);
+    key_rgb_vu.press();
+    idle_for(POWER_STATE_DOZE_SCAN_INTERVAL);
+    key_rgb_vu.release();
+    run_one_scan_loop();
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    EXPECT_GT(rgblight_get_val(), USER_VAL);
+    EXPECT_EQ(saved_config().val, rgblight_get_val());
+    VERIFY_AND_CLEAR(driver);
+}
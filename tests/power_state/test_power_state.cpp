@@ -0,0 +1,179 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "power_state.h"
+
+static std::vector<power_state_t> state_changes;
+
+bool power_state_changed_user(power_state_t state) {
+    state_changes.push_back(state);
+    return true;
+}
+}
+
+// A keyboard with per-key lighting: the MCU running flat out or sleeping between scans, and the LEDs at full brightness
+#define MCU_RUN_MA 20.0
+#define MCU_SLEEP_MA 4.0
+#define MCU_SCAN_MS 0.25
+#define LEDS_MA 60.0
+
+class PowerState : public TestFixture {
+   public:
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+
+    void SetUp() override {
+        TestDriver driver;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+        set_keymap({key_a});
+
+        // Start out active, as the time starts over for every test
+        tap_key(key_a);
+        state_changes.clear();
+    }
+
+    static double current_ma(power_state_t state, uint8_t brightness) {
+        double awake = 1.0;
+        switch (state) {
+            case POWER_STATE_DOZE:
+                awake = MCU_SCAN_MS / POWER_STATE_DOZE_SCAN_INTERVAL;
+                break;
+            case POWER_STATE_SLEEP:
+                awake = MCU_SCAN_MS / POWER_STATE_SLEEP_SCAN_INTERVAL;
+                break;
+            default:
+                // Idle keeps the main loop running for everything else
+                break;
+        }
+        return MCU_SLEEP_MA + (MCU_RUN_MA - MCU_SLEEP_MA) * awake + LEDS_MA * brightness / 255;
+    }
+};
+
+TEST_F(PowerState, StepsDownWhileThereIsNoInput) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    idle_for(POWER_STATE_IDLE_TIMEOUT - 10);
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    idle_for(10);
+    EXPECT_EQ(power_state_get(), POWER_STATE_IDLE);
+    idle_for(POWER_STATE_DOZE_TIMEOUT - POWER_STATE_IDLE_TIMEOUT);
+    EXPECT_EQ(power_state_get(), POWER_STATE_DOZE);
+    idle_for(POWER_STATE_SLEEP_TIMEOUT - POWER_STATE_DOZE_TIMEOUT);
+    EXPECT_EQ(power_state_get(), POWER_STATE_SLEEP);
+
+    std::vector<power_state_t> expected = {POWER_STATE_IDLE, POWER_STATE_DOZE, POWER_STATE_SLEEP};
+    EXPECT_EQ(state_changes, expected);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerState, KeyPressWakesWithinTheScanInterval) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    idle_for(POWER_STATE_SLEEP_TIMEOUT);
+    ASSERT_EQ(power_state_get(), POWER_STATE_SLEEP);
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing happens until the next scan comes round
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    idle_for(POWER_STATE_SLEEP_SCAN_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+
+    // Then every scan loop counts again
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    std::vector<power_state_t> expected = {POWER_STATE_IDLE, POWER_STATE_DOZE, POWER_STATE_SLEEP, POWER_STATE_ACTIVE};
+    EXPECT_EQ(state_changes, expected);
+}
+
+TEST_F(PowerState, ScanRateAndBrightnessFollowTheState) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    // Two seconds of typing, so the scan rate is counted over a whole second of it. A scan loop takes 1ms here.
+    for (int i = 0; i < 20; i++) {
+        tap_key(key_a);
+        idle_for(99);
+    }
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    EXPECT_NEAR(get_matrix_scan_rate(), 1000, 1);
+    EXPECT_EQ(power_state_brightness(), 255);
+
+    // Then two seconds into each of the lower states
+    idle_for(POWER_STATE_IDLE_TIMEOUT + 2000);
+    EXPECT_EQ(power_state_get(), POWER_STATE_IDLE);
+    EXPECT_NEAR(get_matrix_scan_rate(), 1000 / POWER_STATE_IDLE_SCAN_INTERVAL, 1);
+    EXPECT_EQ(power_state_brightness(), POWER_STATE_IDLE_BRIGHTNESS);
+
+    idle_for(POWER_STATE_DOZE_TIMEOUT - POWER_STATE_IDLE_TIMEOUT);
+    EXPECT_EQ(power_state_get(), POWER_STATE_DOZE);
+    EXPECT_NEAR(get_matrix_scan_rate(), 1000 / POWER_STATE_DOZE_SCAN_INTERVAL, 1);
+    EXPECT_EQ(power_state_brightness(), POWER_STATE_DOZE_BRIGHTNESS);
+
+    idle_for(POWER_STATE_SLEEP_TIMEOUT - POWER_STATE_DOZE_TIMEOUT);
+    EXPECT_EQ(power_state_get(), POWER_STATE_SLEEP);
+    EXPECT_NEAR(get_matrix_scan_rate(), 1000 / POWER_STATE_SLEEP_SCAN_INTERVAL, 1);
+    EXPECT_EQ(power_state_brightness(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerState, SleepsWhileTheHostIsSuspended) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    suspend_power_down_quantum();
+    EXPECT_EQ(power_state_get(), POWER_STATE_SLEEP);
+    run_one_scan_loop();
+    EXPECT_EQ(power_state_get(), POWER_STATE_SLEEP);
+
+    // Waking up counts as activity, even though the keys haven't been touched
+    idle_for(POWER_STATE_SLEEP_TIMEOUT);
+    suspend_wakeup_init_quantum();
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    idle_for(POWER_STATE_IDLE_TIMEOUT - 10);
+    EXPECT_EQ(power_state_get(), POWER_STATE_ACTIVE);
+    idle_for(20);
+    EXPECT_EQ(power_state_get(), POWER_STATE_IDLE);
+
+    std::vector<power_state_t> expected = {POWER_STATE_SLEEP, POWER_STATE_ACTIVE, POWER_STATE_IDLE};
+    EXPECT_EQ(state_changes, expected);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PowerState, DrawsLessPowerWhenLeftAlone) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    // Half a minute of typing, then a minute and a half left alone, sampled every 100ms
+    double managed_ma = 0, unmanaged_ma = 0;
+    int    ms         = 0;
+    for (; ms < 120000; ms += 100) {
+        if (ms < 30000) {
+            (ms % 200 == 0) ? key_a.press() : key_a.release();
+        }
+        idle_for(100);
+        managed_ma += current_ma(power_state_get(), power_state_brightness()) * 100;
+        unmanaged_ma += current_ma(POWER_STATE_ACTIVE, 255) * 100;
+    }
+    managed_ma /= ms;
+    unmanaged_ma /= ms;
+
+    printf("Average current over two minutes: always active %.1fmA, power states %.1fmA\n", unmanaged_ma, managed_ma);
+    EXPECT_EQ(power_state_get(), POWER_STATE_SLEEP);
+    EXPECT_LT(managed_ma, unmanaged_ma * 0.6);
+    VERIFY_AND_CLEAR(driver);
+}
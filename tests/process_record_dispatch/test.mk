@@ -0,0 +1,35 @@
+# Copyright 2024 QMK
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+# Most of the features that hook into process_record_quantum
+AUTOCORRECT_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+DYNAMIC_MACRO_ENABLE = yes
+DYNAMIC_TAPPING_TERM_ENABLE = yes
+KEY_LOCK_ENABLE = yes
+KEY_OVERRIDE_ENABLE = yes
+LAYER_LOCK_ENABLE = yes
+LEADER_ENABLE = yes
+PROGRAMMABLE_BUTTON_ENABLE = yes
+REPEAT_KEY_ENABLE = yes
+SECURE_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+TRI_LAYER_ENABLE = yes
+UNICODE_ENABLE = yes
+INTROSPECTION_KEYMAP_C = test_keymap.c
@@ -0,0 +1,193 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "process_quantum.h"
+#include "process_tri_layer.h"
+
+bool process_record_modules(uint16_t keycode, keyrecord_t *record);
+
+static bool user_blocks_grave_escape = false;
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    return !(user_blocks_grave_escape && keycode == QK_GRAVE_ESCAPE);
+}
+}
+
+// The keycodes of a fully featured keymap, most of them plain keys
+static const std::vector<uint16_t> keymap_keycodes = {
+    KC_ESC, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0, KC_MINS, KC_EQL, KC_BSPC,                                            //
+    KC_TAB, KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P, KC_LBRC, KC_RBRC, KC_BSLS,                                           //
+    LCTL_T(KC_CAPS), KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN, KC_QUOT, KC_ENT,                                         //
+    KC_LSFT, KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH, KC_RSFT,                                                    //
+    KC_LCTL, KC_LGUI, KC_LALT, LT(1, KC_SPC), KC_RALT, MO(1), OSM(MOD_LSFT), KC_RCTL,                                                        //
+    QK_GRAVE_ESCAPE, QK_REPEAT_KEY, QK_LAYER_LOCK, QK_LEADER, QK_CAPS_WORD_TOGGLE, TL_LOWR, TL_UPPR, TD(0), PB_1, UC(0x00E9), QK_DYNAMIC_TAPPING_TERM_PRINT, //
+};
+
+static uint64_t cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+class ProcessRecordDispatch : public TestFixture {
+   public:
+    void TearDown() override {
+        user_blocks_grave_escape = false;
+        TestFixture::TearDown();
+    }
+
+    // Every handler in order, the way process_record_quantum used to call them
+    static bool CallEveryHandler(uint16_t keycode, keyrecord_t *record) {
+        for (uint8_t i = 0; i < process_record_handler_count; i++) {
+            if (!process_record_handlers[i].handler(keycode, record)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(ProcessRecordDispatch, PlainKeysPassEveryHandler) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessRecordDispatch, FeatureKeycodesReachTheirHandler) {
+    TestDriver driver;
+    KeymapKey  grave_escape = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+    KeymapKey  lower        = KeymapKey(0, 1, 0, TL_LOWR);
+    set_keymap({grave_escape, lower});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    grave_escape.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    grave_escape.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessRecordDispatch, KeyboardHandlersRunFirst) {
+    TestDriver driver;
+    KeymapKey  grave_escape = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+    set_keymap({grave_escape});
+
+    // process_record_user comes before grave escape, so it can still take its key away
+    user_blocks_grave_escape = true;
+    EXPECT_NO_REPORT(driver);
+    tap_key(grave_escape);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessRecordDispatch, HandlersKeepTheirOrder) {
+    ASSERT_GE(process_record_handler_count, 2);
+
+    // Keyboard code sees every key before the features, and process_quantum comes last
+    const process_record_handler_t &last = process_record_handlers[process_record_handler_count - 1];
+    EXPECT_EQ(last.handler, process_quantum);
+    EXPECT_EQ(last.first, 0x0000);
+    EXPECT_EQ(last.last, 0xFFFF);
+
+    int8_t modules = -1, kb = -1, tri_layer = -1;
+    for (uint8_t i = 0; i < process_record_handler_count; i++) {
+        EXPECT_LE(process_record_handlers[i].first, process_record_handlers[i].last);
+        if (process_record_handlers[i].handler == process_record_modules) modules = i;
+        if (process_record_handlers[i].handler == process_record_kb) kb = i;
+        if (process_record_handlers[i].handler == process_tri_layer) tri_layer = i;
+    }
+    EXPECT_EQ(kb, modules + 1);
+    EXPECT_GT(tri_layer, kb);
+}
+
+TEST_F(ProcessRecordDispatch, MeasuresCyclesPerPlainKeyEvent) {
+    using clock      = std::chrono::steady_clock;
+    const int rounds = 2000;
+
+    // Plain keys only, which every handler lets through to the end
+    std::vector<uint16_t> plain;
+    for (uint16_t keycode : keymap_keycodes) {
+        if (IS_BASIC_KEYCODE(keycode)) plain.push_back(keycode);
+    }
+
+    keyrecord_t record      = {};
+    record.event.type       = KEY_EVENT;
+    auto        start       = clock::now();
+    uint64_t    start_cycle = cycles();
+    for (int round = 0; round < rounds; round++) {
+        for (uint16_t keycode : plain) {
+            for (bool pressed : {true, false}) {
+                record.event.pressed = pressed;
+                CallEveryHandler(keycode, &record);
+            }
+        }
+    }
+    double every_cycles = (double)(cycles() - start_cycle) / (rounds * plain.size() * 2);
+    double every_ns     = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * plain.size() * 2);
+
+    start       = clock::now();
+    start_cycle = cycles();
+    for (int round = 0; round < rounds; round++) {
+        for (uint16_t keycode : plain) {
+            for (bool pressed : {true, false}) {
+                record.event.pressed = pressed;
+                process_record_handlers_dispatch(keycode, &record);
+            }
+        }
+    }
+    double dispatched_cycles = (double)(cycles() - start_cycle) / (rounds * plain.size() * 2);
+    double dispatched_ns     = std::chrono::duration<double, std::nano>(clock::now() - start).count() / (rounds * plain.size() * 2);
+
+    printf("%u handlers enabled\n", process_record_handler_count);
+    printf("Host time per plain key event: every handler %.0fns (%.0f cycles), dispatched %.0fns (%.0f cycles)\n", every_ns, every_cycles, dispatched_ns, dispatched_cycles);
+}
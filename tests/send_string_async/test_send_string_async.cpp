@@ -0,0 +1,264 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string_async.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+struct CallbackRecord {
+    send_string_async_token_t token;
+    bool                      completed;
+};
+
+static std::vector<CallbackRecord> callbacks;
+
+static void record_callback(send_string_async_token_t token, bool completed, void *cb_arg) {
+    callbacks.push_back({token, completed});
+}
+
+static send_string_async_token_t queue_with_callback(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_with_delay_impl(send_string_get_next_ram, &state, sizeof(state), interval, record_callback, NULL);
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        callbacks.clear();
+    }
+
+    void TearDown() override {
+        send_string_async_cancel_all();
+    }
+
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    // Reconstructs the letters typed from the recorded reports
+    std::string TypedText(void) const {
+        std::string       text;
+        report_keyboard_t previous = {};
+        for (const auto &report : reports) {
+            for (uint8_t key : report.keys) {
+                if (key < KC_A || key > KC_Z || ReportHasKey(previous, key)) {
+                    continue;
+                }
+                text += (char)(key - KC_A + ((report.mods & MOD_BIT(KC_LEFT_SHIFT)) ? 'A' : 'a'));
+            }
+            previous = report;
+        }
+        return text;
+    }
+
+    static bool ReportHasKey(const report_keyboard_t &report, uint8_t keycode) {
+        for (uint8_t key : report.keys) {
+            if (key == keycode) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void IdleUntilDone(unsigned limit) {
+        for (unsigned i = 0; i < limit && send_string_async_is_active(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_is_active());
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(SendStringAsync, TypesStringFromMainLoop) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    send_string_async_token_t token = send_string_async("Hello");
+    EXPECT_NE(token, INVALID_SEND_STRING_ASYNC_TOKEN);
+    EXPECT_TRUE(send_string_async_is_pending(token));
+
+    // Nothing is typed until the main loop runs
+    EXPECT_TRUE(reports.empty());
+
+    IdleUntilDone(100);
+    EXPECT_FALSE(send_string_async_is_pending(token));
+    EXPECT_EQ(TypedText(), "Hello");
+
+    // Everything is released afterwards
+    ASSERT_FALSE(reports.empty());
+    EXPECT_EQ(reports.back().mods, 0);
+    EXPECT_FALSE(ReportHasKey(reports.back(), KC_O));
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, KeepsScanningWhileLongStringPlays) {
+    TestDriver driver;
+    KeymapKey  key_f1(0, 0, 0, KC_F1);
+    set_keymap({key_f1});
+    RecordReports(driver);
+
+    std::string macro;
+    for (int i = 0; i < 2048; i++) {
+        macro += (char)('a' + (i % 26));
+    }
+    send_string_async(macro.c_str());
+
+    // The key budget per loop keeps each pass short
+    run_one_scan_loop();
+    EXPECT_LE(reports.size(), SEND_STRING_ASYNC_MAX_KEYS_PER_TASK);
+    idle_for(100);
+    EXPECT_TRUE(send_string_async_is_active());
+
+    // A key pressed partway through the macro is reported straight away
+    key_f1.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(send_string_async_is_active());
+    EXPECT_TRUE(ReportHasKey(reports.back(), KC_F1));
+
+    key_f1.release();
+    run_one_scan_loop();
+    EXPECT_TRUE(send_string_async_is_active());
+    EXPECT_FALSE(ReportHasKey(reports.back(), KC_F1));
+
+    IdleUntilDone(2 * 2048);
+    EXPECT_EQ(TypedText(), macro);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, DelayIsScheduledNotSlept) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    send_string_async("a" SS_DELAY(50) "b");
+
+    // Typing never stalls the main loop
+    for (int i = 0; i < 20; i++) {
+        uint32_t before = timer_read32();
+        keyboard_task();
+        EXPECT_EQ(timer_read32(), before);
+        advance_time(1);
+    }
+    EXPECT_EQ(TypedText(), "a");
+    EXPECT_TRUE(send_string_async_is_active());
+
+    idle_for(40);
+    EXPECT_EQ(TypedText(), "ab");
+    EXPECT_FALSE(send_string_async_is_active());
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, IntervalIsHonoured) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    send_string_async_with_delay("abc", 10);
+    run_one_scan_loop();
+    EXPECT_EQ(TypedText(), "a");
+    idle_for(15);
+    EXPECT_EQ(TypedText(), "a");
+    idle_for(10);
+    EXPECT_EQ(TypedText(), "ab");
+
+    IdleUntilDone(100);
+    EXPECT_EQ(TypedText(), "abc");
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, CompletionCallbacksInOrder) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    send_string_async_token_t first  = queue_with_callback("ab", 0);
+    send_string_async_token_t second = queue_with_callback("cd", 0);
+    EXPECT_NE(first, second);
+
+    IdleUntilDone(100);
+    EXPECT_EQ(TypedText(), "abcd");
+    ASSERT_EQ(callbacks.size(), 2);
+    EXPECT_EQ(callbacks[0].token, first);
+    EXPECT_TRUE(callbacks[0].completed);
+    EXPECT_EQ(callbacks[1].token, second);
+    EXPECT_TRUE(callbacks[1].completed);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesKeys) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    send_string_async_token_t first  = queue_with_callback("ABC", 10);
+    send_string_async_token_t second = queue_with_callback("def", 0);
+
+    // Shift has been pressed for the first character
+    run_one_scan_loop();
+    ASSERT_FALSE(reports.empty());
+    EXPECT_EQ(reports.back().mods, MOD_BIT(KC_LEFT_SHIFT));
+
+    EXPECT_TRUE(send_string_async_cancel(first));
+    EXPECT_FALSE(send_string_async_cancel(first));
+    EXPECT_FALSE(send_string_async_is_pending(first));
+    EXPECT_EQ(reports.back().mods, 0);
+    ASSERT_EQ(callbacks.size(), 1);
+    EXPECT_EQ(callbacks[0].token, first);
+    EXPECT_FALSE(callbacks[0].completed);
+
+    // The next string carries on
+    reports.clear();
+    IdleUntilDone(100);
+    EXPECT_EQ(TypedText(), "def");
+    ASSERT_EQ(callbacks.size(), 2);
+    EXPECT_EQ(callbacks[1].token, second);
+    EXPECT_TRUE(callbacks[1].completed);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, RejectsWhenQueueIsFull) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    for (int i = 0; i < SEND_STRING_ASYNC_QUEUE_SIZE; i++) {
+        EXPECT_NE(send_string_async("x"), INVALID_SEND_STRING_ASYNC_TOKEN);
+    }
+    EXPECT_EQ(send_string_async("y"), INVALID_SEND_STRING_ASYNC_TOKEN);
+
+    IdleUntilDone(100);
+    EXPECT_EQ(TypedText(), std::string(SEND_STRING_ASYNC_QUEUE_SIZE, 'x'));
+    EXPECT_NE(send_string_async("z"), INVALID_SEND_STRING_ASYNC_TOKEN);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
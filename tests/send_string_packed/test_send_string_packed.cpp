@@ -0,0 +1,205 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::Invoke;
+
+class SendStringPacked : public TestFixture {
+   public:
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    // Reconstructs what the host would have typed from the recorded reports, reading new keys in report order
+    std::string TypedText(void) const {
+        std::string       text;
+        report_keyboard_t previous = {};
+        for (const auto &report : reports) {
+            bool shifted = report.mods & MOD_BIT(KC_LEFT_SHIFT);
+            for (uint8_t key : report.keys) {
+                if (key == KC_NO || ReportHasKey(previous, key)) {
+                    continue;
+                }
+                switch (key) {
+                    case KC_A ... KC_Z:
+                        text += (char)(key - KC_A + (shifted ? 'A' : 'a'));
+                        break;
+                    case KC_1 ... KC_9:
+                        text += (char)(key - KC_1 + '1');
+                        break;
+                    case KC_0:
+                        text += '0';
+                        break;
+                    case KC_SPACE:
+                        text += ' ';
+                        break;
+                    default:
+                        text += '?';
+                        break;
+                }
+            }
+            previous = report;
+        }
+        return text;
+    }
+
+    static bool ReportHasKey(const report_keyboard_t &report, uint8_t keycode) {
+        for (uint8_t key : report.keys) {
+            if (key == keycode) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(SendStringPacked, DistinctKeysShareReports) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("abc");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, RepeatedKeyStartsNewReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("aab");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, ModifierChangeStartsNewReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("aBCd");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, SpecialSequencesAreNotPacked) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C, KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string("ab" SS_TAP(X_F1) "cd");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, RespectsFreeReportSlots) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    register_code(KC_X);
+    send_string("abcdefg");
+    unregister_code(KC_X);
+
+    // One slot is taken by the held key, leaving five for the string
+    ASSERT_EQ(reports.size(), 6);
+    EXPECT_TRUE(ReportHasKey(reports[1], KC_E));
+    EXPECT_FALSE(ReportHasKey(reports[1], KC_F));
+    EXPECT_TRUE(ReportHasKey(reports[3], KC_F));
+    EXPECT_TRUE(ReportHasKey(reports[3], KC_G));
+    EXPECT_EQ(TypedText(), "xabcdefg");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, FewerReportsPerCharacter) {
+    TestDriver        driver;
+    const std::string text = "The quick brown fox jumps over the lazy dog 0123456789";
+
+    // Before: one character at a time, as send_char() still does
+    RecordReports(driver);
+    for (char c : text) {
+        send_char(c);
+    }
+    size_t      unpacked_reports = reports.size();
+    std::string unpacked_text    = TypedText();
+
+    // After: packed into shared reports
+    RecordReports(driver);
+    send_string(text.c_str());
+    size_t      packed_reports = reports.size();
+    std::string packed_text    = TypedText();
+
+    EXPECT_EQ(unpacked_text, text);
+    EXPECT_EQ(packed_text, text);
+
+    // Two reports per character, plus two more for the shifted "T"
+    EXPECT_EQ(unpacked_reports, 2 * text.size() + 2);
+
+    // Under half a report per character
+    EXPECT_EQ(packed_reports, 24);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringPacked, UnicodeDigitsArePacked) {
+    TestDriver driver;
+    RecordReports(driver);
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    register_unicode(0x1F9D9);
+
+    // Ctrl+Shift+U, then "1f9d" and "9" (the repeated 9 needs its own report), then space to finish
+    bool found = false;
+    for (const auto &report : reports) {
+        if (ReportHasKey(report, KC_1) && ReportHasKey(report, KC_F) && ReportHasKey(report, KC_9) && ReportHasKey(report, KC_D)) {
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+    EXPECT_EQ(TypedText(), "U1f9d9 ");
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,288 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "serial.h"
+#include "split_simulator.h"
+#include "sync_timer.h"
+#include "transactions.h"
+
+// The slave half's copies, as renamed by the split simulator build
+extern layer_state_t                slave_layer_state;
+extern split_shared_memory_t *const slave_split_shmem;
+uint8_t              slave_get_mods(void);
+uint32_t             slave_sync_timer_read32(void);
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class SplitSerialFramed : public TestFixture {
+   public:
+    void SetUp() override {
+        split_simulator_reset();
+    }
+
+    void TearDown() override {
+        split_simulator_reset();
+    }
+
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    void SetConfig(void (*change)(split_simulator_config_t *config)) {
+        split_simulator_config_t config;
+        split_simulator_get_config(&config);
+        change(&config);
+        split_simulator_set_config(&config);
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(SplitSerialFramed, KeysOnBothHalvesAreReported) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_left, key_right});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_left.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_right.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_right.release();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_left.release();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSerialFramed, WritesAreSentTogetherBeforeTheScanEnds) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    set_keymap({key_left});
+
+    RecordReports(driver);
+    idle_for(100);
+
+    split_simulator_stats_t before, after;
+    split_simulator_get_total_stats(&before);
+    uint32_t layer_transactions = split_simulator_get_stats(PUT_LAYER_STATE)->transactions;
+    uint32_t layer_transfers    = split_simulator_get_stats(PUT_LAYER_STATE)->transfers;
+    uint32_t mods_transactions  = split_simulator_get_stats(PUT_MODS)->transactions;
+
+    layer_on(2);
+    register_mods(MOD_BIT(KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    split_simulator_get_total_stats(&after);
+
+    // The layer and mods are queued into one frame, which is sent after the matrix checksum poll, so the line was
+    // only turned around twice
+    EXPECT_EQ(split_simulator_get_stats(PUT_LAYER_STATE)->transactions, layer_transactions + 1);
+    EXPECT_EQ(split_simulator_get_stats(PUT_MODS)->transactions, mods_transactions + 1);
+    EXPECT_EQ(split_simulator_get_stats(PUT_LAYER_STATE)->transfers, layer_transfers);
+    EXPECT_EQ(after.transfers - before.transfers, 4);
+    EXPECT_EQ(after.failures, 0);
+
+    // The lock-step protocol would have needed a handshake both ways, then the data, for each of them
+    EXPECT_LT(after.transfers - before.transfers, 3 * (after.transactions - before.transactions));
+
+    // They reached the slave within the same scan, which applies them on its next one
+    EXPECT_EQ(slave_split_shmem->layers.layer_state, layer_state);
+    EXPECT_EQ(slave_split_shmem->mods.real_mods, MOD_BIT(KC_LEFT_SHIFT));
+    split_simulator_task();
+    EXPECT_EQ(slave_layer_state, layer_state);
+    EXPECT_EQ(slave_get_mods(), MOD_BIT(KC_LEFT_SHIFT));
+
+    unregister_mods(MOD_BIT(KC_LEFT_SHIFT));
+    layer_off(2);
+    run_one_scan_loop();
+    split_simulator_task();
+    EXPECT_EQ(slave_layer_state, layer_state);
+    EXPECT_EQ(slave_get_mods(), 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSerialFramed, SlaveSyncTimerFollowsTheMaster) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    idle_for(20);
+
+    // Scan slowly, as a keyboard that throttles its scanning does, with the slave applying whatever it has received
+    // right after each of the master's passes
+    for (int i = 0; i < 20; i++) {
+        advance_time(24);
+        run_one_scan_loop();
+        split_simulator_task();
+
+        // The master stamps the time it sends with SYNC_TIMER_OFFSET, to cover the transfer
+        EXPECT_NEAR((int32_t)(slave_sync_timer_read32() - sync_timer_read32()), 0, 2);
+    }
+    EXPECT_GE(split_simulator_get_stats(PUT_SYNC_TIMER)->transactions, 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSerialFramed, OneTurnaroundPerFrame) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    // Each poll of the matrix checksum is one frame out and one reply back
+    const split_simulator_stats_t *checksum = split_simulator_get_stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_GE(checksum->transactions, 100);
+    EXPECT_EQ(checksum->failures, 0);
+    EXPECT_EQ(checksum->transfers, 2 * checksum->transactions);
+
+    // The periodic writes never needed a transfer of their own
+    EXPECT_GT(split_simulator_get_stats(PUT_SYNC_TIMER)->transactions, 0);
+    EXPECT_EQ(split_simulator_get_stats(PUT_SYNC_TIMER)->transfers, 0);
+    EXPECT_GT(split_simulator_get_stats(PUT_LAYER_STATE)->transactions, 0);
+    EXPECT_EQ(split_simulator_get_stats(PUT_LAYER_STATE)->transfers, 0);
+
+    split_simulator_stats_t total;
+    split_simulator_get_total_stats(&total);
+    EXPECT_EQ(total.failures, 0);
+    EXPECT_LT(total.transfers, 2 * total.transactions);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_right.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_right.release();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSerialFramed, CorruptedFramesAreRejected) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_left, key_right});
+
+    SetConfig([](split_simulator_config_t *config) {
+        config->corruption_rate = 20;
+        config->seed            = 0x5EED;
+    });
+
+    RecordReports(driver);
+    for (int i = 0; i < 20; i++) {
+        key_right.press();
+        idle_for(25);
+        key_right.release();
+        idle_for(25);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    split_simulator_stats_t total;
+    split_simulator_get_total_stats(&total);
+    EXPECT_GT(total.corrupted, 0);
+    EXPECT_GT(total.failures, 0);
+
+    // Every press still gets through, and the frame checks keep garbage out of the reports
+    int presses = 0;
+    for (const auto &report : reports) {
+        EXPECT_TRUE(report == (report_keyboard_t){} || (report.keys[0] == KC_B && report.mods == 0));
+        if (report.keys[0] == KC_B) {
+            presses++;
+        }
+    }
+    EXPECT_EQ(presses, 20);
+    EXPECT_EQ(slave_layer_state, layer_state);
+}
+
+TEST_F(SplitSerialFramed, DisconnectedSlaveIsIgnored) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    KeymapKey  key_right_layer(1, 0, 2, KC_B);
+    set_keymap({key_right, key_right_layer});
+
+    SetConfig([](split_simulator_config_t *config) { config->connected = false; });
+
+    EXPECT_NO_REPORT(driver);
+    key_right.press();
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    const split_simulator_stats_t *checksum = split_simulator_get_stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_EQ(checksum->failures, checksum->transactions);
+    EXPECT_GE(checksum->wire_us, checksum->failures * SPLIT_SIMULATOR_TIMEOUT_US);
+
+    // Writes held back while the slave was away are delivered once it is back
+    layer_on(1);
+    SetConfig([](split_simulator_config_t *config) { config->connected = true; });
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(slave_layer_state, layer_state);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_right.release();
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitSerialFramed, QueuedWritesOutlastAFullFrame) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+    idle_for(20);
+
+    SetConfig([](split_simulator_config_t *config) { config->connected = false; });
+
+    // A write is queued as delivered, then more pile up behind it until the frame is full and can't be sent
+    split_shmem->layers.layer_state = 1 << 3;
+    EXPECT_TRUE(soft_serial_transaction(PUT_LAYER_STATE));
+
+    int queued = 0;
+    while (queued < NUM_TOTAL_TRANSACTIONS * 256 && soft_serial_transaction(PUT_SYNC_TIMER)) {
+        queued++;
+    }
+    EXPECT_GT(queued, 0);
+    EXPECT_EQ(split_simulator_get_stats(PUT_SYNC_TIMER)->failures, 1);
+
+    // Once the slave answers again, the first read takes everything that was queued along with it
+    SetConfig([](split_simulator_config_t *config) { config->connected = true; });
+    EXPECT_TRUE(soft_serial_transaction(GET_SLAVE_MATRIX_CHECKSUM));
+    EXPECT_EQ(slave_split_shmem->layers.layer_state, (layer_state_t)(1 << 3));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,112 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "split_simulator.h"
+#include "transactions.h"
+
+// The slave half's copy, as renamed by the split simulator build
+extern layer_state_t slave_layer_state;
+}
+
+using testing::_;
+
+class SplitTransactionBudget : public TestFixture {
+   public:
+    void SetUp() override {
+        split_simulator_reset();
+        split_transactions_reset_stats();
+    }
+
+    void TearDown() override {
+        split_simulator_reset();
+    }
+
+    void SetBaudRate(uint32_t baud_rate) {
+        split_simulator_config_t config;
+        split_simulator_get_config(&config);
+        config.baud_rate = baud_rate;
+        split_simulator_set_config(&config);
+    }
+};
+
+TEST_F(SplitTransactionBudget, FastLineRunsEveryGroup) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    EXPECT_NO_REPORT(driver);
+    layer_on(1);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    split_transactions_stats_t stats;
+    split_transactions_get_stats(&stats);
+    EXPECT_GE(stats.passes, 100);
+    EXPECT_EQ(stats.over_budget, 0);
+    EXPECT_EQ(stats.late, 0);
+
+    // Only the periodic forced resync of every group can overrun
+    EXPECT_LT(stats.skipped, stats.passes / 10);
+    EXPECT_EQ(slave_layer_state, layer_state);
+
+    layer_off(1);
+    idle_for(2);
+    EXPECT_EQ(slave_layer_state, layer_state);
+}
+
+TEST_F(SplitTransactionBudget, SlowLineDefersSyncButNotKeys) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    // Polling the slave's matrix alone now takes longer than the budget
+    SetBaudRate(2400);
+    idle_for(50);
+
+    split_transactions_stats_t stats;
+    split_transactions_get_stats(&stats);
+    EXPECT_EQ(stats.over_budget, stats.passes);
+    EXPECT_GT(stats.skipped, 0);
+    EXPECT_GT(stats.late, 0);
+    EXPECT_GT(stats.max_pass_us, SPLIT_TRANSACTION_BUDGET_US);
+
+    // Keys keep coming through on every pass
+    EXPECT_REPORT(driver, (KC_B));
+    key_right.press();
+    idle_for(DEBOUNCE + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Lower priority state still arrives, once it has waited long enough to be forced through
+    uint32_t changed_at = timer_read32();
+    layer_on(1);
+    for (int i = 0; i < 50 && slave_layer_state != layer_state; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_EQ(slave_layer_state, layer_state);
+    EXPECT_GT(timer_elapsed32(changed_at), SPLIT_TRANSACTION_MAX_DEFER_MS);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_right.release();
+    idle_for(DEBOUNCE + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_off(1);
+}
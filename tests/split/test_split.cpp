@@ -0,0 +1,260 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "split_simulator.h"
+#include "transactions.h"
+
+// The slave half's copy, as renamed by the split simulator build
+extern layer_state_t slave_layer_state;
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+class Split : public TestFixture {
+   public:
+    void SetUp() override {
+        split_simulator_reset();
+    }
+
+    void TearDown() override {
+        split_simulator_reset();
+    }
+
+    // Records every keyboard report, rather than expecting each one individually
+    void RecordReports(TestDriver &driver) {
+        reports.clear();
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([this](report_keyboard_t &report) { reports.push_back(report); }));
+    }
+
+    // Presses a key, and returns how many milliseconds passed before the host saw it
+    uint32_t PressLatency(TestDriver &driver, KeymapKey &key) {
+        uint32_t pressed_at  = timer_read32();
+        uint32_t reported_at = 0;
+        EXPECT_REPORT(driver, (key.code)).WillOnce(Invoke([&reported_at](report_keyboard_t &) { reported_at = timer_read32(); }));
+
+        key.press();
+        for (int i = 0; i < 1000 && !reported_at; i++) {
+            run_one_scan_loop();
+        }
+        VERIFY_AND_CLEAR(driver);
+        return reported_at - pressed_at;
+    }
+
+    void Release(TestDriver &driver, KeymapKey &key) {
+        EXPECT_EMPTY_REPORT(driver);
+        key.release();
+        idle_for(50);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    void SetConfig(void (*change)(split_simulator_config_t *config)) {
+        split_simulator_config_t config;
+        split_simulator_get_config(&config);
+        change(&config);
+        split_simulator_set_config(&config);
+    }
+
+    std::vector<report_keyboard_t> reports;
+};
+
+TEST_F(Split, KeysOnBothHalvesAreReported) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_left, key_right});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_left.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_right.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_right.release();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    Release(driver, key_left);
+}
+
+TEST_F(Split, SlaveKeyLatency) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_left, key_right});
+
+    uint32_t left_latency = PressLatency(driver, key_left);
+    Release(driver, key_left);
+    uint32_t right_latency = PressLatency(driver, key_right);
+    Release(driver, key_right);
+
+    // Both halves debounce the same way, and the slave's matrix is picked up on the master's next scan. Time spent on
+    // the wire can push either one into the next millisecond.
+    EXPECT_GE(left_latency, DEBOUNCE);
+    EXPECT_LE(left_latency, DEBOUNCE + 1);
+    EXPECT_GE(right_latency, DEBOUNCE);
+    EXPECT_LE(right_latency, DEBOUNCE + 2);
+}
+
+TEST_F(Split, SlowLineAddsLatency) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    uint32_t fast_latency = PressLatency(driver, key_right);
+    Release(driver, key_right);
+
+    SetConfig([](split_simulator_config_t *config) { config->baud_rate = 9600; });
+    uint32_t slow_latency = PressLatency(driver, key_right);
+    Release(driver, key_right);
+
+    EXPECT_GT(slow_latency, fast_latency);
+}
+
+TEST_F(Split, TransactionThroughput) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    // Each byte is 10 bits on the wire, and each transfer pays the latency
+    const uint32_t byte_us = (10 * 1000000 + SPLIT_SIMULATOR_BAUD_RATE - 1) / SPLIT_SIMULATOR_BAUD_RATE;
+
+    // The master polls the slave's matrix checksum every scan: the handshake both ways, then the checksum
+    const split_simulator_stats_t *checksum = split_simulator_get_stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_GE(checksum->transactions, 100);
+    EXPECT_EQ(checksum->failures, 0);
+    EXPECT_EQ(checksum->bytes, 3 * checksum->transactions);
+    EXPECT_EQ(checksum->wire_us, checksum->transactions * 3 * (SPLIT_SIMULATOR_LATENCY_US + byte_us));
+
+    // The matrix itself only crosses when it changes
+    const split_simulator_stats_t *matrix = split_simulator_get_stats(GET_SLAVE_MATRIX_DATA);
+    uint32_t                       idle   = matrix->transactions;
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_right.press();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(matrix->transactions, idle + 1);
+    EXPECT_EQ(matrix->bytes, 2 * matrix->transactions + matrix->transactions * sizeof(matrix_row_t) * MATRIX_ROWS_PER_HAND);
+
+    // Throughput can never beat the line rate
+    split_simulator_stats_t total;
+    split_simulator_get_total_stats(&total);
+    EXPECT_LT((uint64_t)total.bytes * 10 * 1000000 / total.wire_us, SPLIT_SIMULATOR_BAUD_RATE);
+
+    Release(driver, key_right);
+}
+
+TEST_F(Split, LayerStateReachesSlave) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    set_keymap({key_left});
+
+    EXPECT_NO_REPORT(driver);
+    layer_on(2);
+    EXPECT_NE(slave_layer_state, layer_state);
+
+    // The master sends it on its next scan, and the slave applies it on its own next scan
+    idle_for(2);
+    EXPECT_EQ(slave_layer_state, layer_state);
+    EXPECT_EQ(split_simulator_get_stats(PUT_LAYER_STATE)->transactions, 1);
+    EXPECT_EQ(split_simulator_get_stats(PUT_LAYER_STATE)->bytes, 2 + sizeof(layer_state_t));
+
+    layer_off(2);
+    idle_for(2);
+    EXPECT_EQ(slave_layer_state, layer_state);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Split, CorruptedBytesDoNotAddKeys) {
+    TestDriver driver;
+    KeymapKey  key_left(0, 0, 0, KC_A);
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_left, key_right});
+
+    SetConfig([](split_simulator_config_t *config) {
+        config->corruption_rate = 20;
+        config->seed            = 0x5EED;
+    });
+
+    RecordReports(driver);
+    for (int i = 0; i < 20; i++) {
+        key_right.press();
+        idle_for(25);
+        key_right.release();
+        idle_for(25);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    split_simulator_stats_t total;
+    split_simulator_get_total_stats(&total);
+    EXPECT_GT(total.corrupted, 0);
+    EXPECT_GT(total.failures, 0);
+
+    // Every press still gets through, and checksums keep garbage out of the reports
+    int presses = 0;
+    for (const auto &report : reports) {
+        EXPECT_TRUE(report == (report_keyboard_t){} || (report.keys[0] == KC_B && report.mods == 0));
+        if (report.keys[0] == KC_B) {
+            presses++;
+        }
+    }
+    EXPECT_EQ(presses, 20);
+}
+
+TEST_F(Split, DisconnectedSlaveIsIgnored) {
+    TestDriver driver;
+    KeymapKey  key_right(0, 0, 2, KC_B);
+    set_keymap({key_right});
+
+    SetConfig([](split_simulator_config_t *config) { config->connected = false; });
+
+    EXPECT_NO_REPORT(driver);
+    key_right.press();
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    // Each failed transaction waits out the timeout
+    const split_simulator_stats_t *checksum = split_simulator_get_stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_EQ(checksum->failures, checksum->transactions);
+    EXPECT_GE(checksum->wire_us, checksum->failures * SPLIT_SIMULATOR_TIMEOUT_US);
+
+    // The master reconnects on its next attempt
+    SetConfig([](split_simulator_config_t *config) { config->connected = true; });
+    EXPECT_REPORT(driver, (KC_B));
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    Release(driver, key_right);
+}
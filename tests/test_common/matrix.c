@@ -18,7 +18,31 @@
 #include "test_matrix.h"
 #include <string.h>
 
-static matrix_row_t matrix[MATRIX_ROWS] = {};
+#ifdef SPLIT_KEYBOARD
+#    include "split_simulator.h"
+
+// Both halves share their switches through the split simulator, and scan them using the common matrix code, which
+// debounces each half's rows and syncs them with the other half
+#    define switches split_simulator_switches
+
+extern uint8_t thisHand;
+
+void matrix_init_custom(void) {
+    clear_all_keys();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    bool changed = memcmp(current_matrix, &switches[thisHand], sizeof(matrix_row_t) * MATRIX_ROWS_PER_HAND) != 0;
+    memcpy(current_matrix, &switches[thisHand], sizeof(matrix_row_t) * MATRIX_ROWS_PER_HAND);
+    return changed;
+}
+#elif defined(ANALOG_MATRIX_ENABLE)
+#    include "analog_matrix_mock.h"
+
+// The analog matrix scans the mock ADC using the common matrix code, and pressing a switch bottoms out its key
+#    define switches analog_matrix_mock_switches
+#else
+static matrix_row_t switches[MATRIX_ROWS] = {};
 
 void matrix_init(void) {
     clear_all_keys();
@@ -31,29 +55,30 @@ uint8_t matrix_scan(void) {
 }
 
 matrix_row_t matrix_get_row(uint8_t row) {
-    return matrix[row];
+    return switches[row];
+}
+
+bool matrix_is_on(uint8_t row, uint8_t col) {
+    return (switches[row] & ((matrix_row_t)1 << col));
 }
 
 void matrix_print(void) {}
+#endif
 
 void matrix_init_kb(void) {}
 
 void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
-    matrix[row] |= (matrix_row_t)1 << col;
+    switches[row] |= (matrix_row_t)1 << col;
 }
 
 void release_key(uint8_t col, uint8_t row) {
-    matrix[row] &= ~((matrix_row_t)1 << col);
-}
-
-bool matrix_is_on(uint8_t row, uint8_t col) {
-    return (matrix[row] & ((matrix_row_t)1 << col));
+    switches[row] &= ~((matrix_row_t)1 << col);
 }
 
 void clear_all_keys(void) {
-    memset(matrix, 0, sizeof(matrix));
+    memset(switches, 0, sizeof(switches));
 }
 
 void led_set(uint8_t usb_led) {}
@@ -24,6 +24,10 @@ extern "C" {
 #include "eeconfig.h"
 #include "keyboard.h"
 
+#ifdef SPLIT_KEYBOARD
+#    include "split_simulator.h"
+#endif
+
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
 }
@@ -49,6 +53,9 @@ void TestFixture::SetUpTestCase() {
     eeconfig_update_debug(&debug_config);
 
     TestDriver driver;
+#ifdef SPLIT_KEYBOARD
+    split_simulator_init();
+#endif
     keyboard_init();
 
     test_logger.info() << "test fixture setup-up end." << std::endl;
@@ -179,6 +186,9 @@ void TestFixture::run_one_scan_loop() {
 void TestFixture::idle_for(unsigned time) {
     test_logger.trace() << +time << " keyboard task " << (time > 1 ? "loops" : "loop") << std::endl;
     for (unsigned i = 0; i < time; i++) {
+#ifdef SPLIT_KEYBOARD
+        split_simulator_task();
+#endif
         keyboard_task();
         housekeeping_task();
         advance_time(1);
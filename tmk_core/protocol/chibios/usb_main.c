@@ -525,8 +525,8 @@ void raw_hid_task(void) {
 
 #ifdef MIDI_ENABLE
 
-void send_midi_packet(MIDI_EventPacket_t *event) {
-    send_report(USB_ENDPOINT_IN_MIDI, (uint8_t *)event, sizeof(MIDI_EventPacket_t));
+void send_midi_packets(MIDI_EventPacket_t *events, uint8_t count) {
+    send_report(USB_ENDPOINT_IN_MIDI, (uint8_t *)events, count * sizeof(MIDI_EventPacket_t));
 }
 
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {
@@ -663,8 +663,11 @@ USB_ClassInfo_MIDI_Device_t USB_MIDI_Interface = {
 
 // clang-format on
 
-void send_midi_packet(MIDI_EventPacket_t *event) {
-    MIDI_Device_SendEventPacket(&USB_MIDI_Interface, event);
+void send_midi_packets(MIDI_EventPacket_t *events, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        MIDI_Device_SendEventPacket(&USB_MIDI_Interface, &events[i]);
+    }
+    MIDI_Device_Flush(&USB_MIDI_Interface);
 }
 
 bool recv_midi_packet(MIDI_EventPacket_t *const event) {